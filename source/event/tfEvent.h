@@ -41,6 +41,9 @@ namespace TissueForge::event {
         REMOVE
     };
 
+    struct EventScheduler;
+    struct EventBaseList;
+
     // Base class of all events
     struct CAPI_EXPORT EventBase {
 
@@ -72,9 +75,23 @@ namespace TissueForge::event {
          */
         virtual HRESULT invoke() = 0;
 
+        /**
+         * Next time at which an event can fire, for events that only depend on time. 
+         * 
+         * Events that return a non-negative value are scheduled and only evaluated 
+         * once the simulation time reaches the returned value. 
+         * Events that return a negative value are evaluated every step. 
+         * An event that can no longer fire returns infinity. 
+         */
+        virtual FloatP_t nextEvalTime() { return -1; }
+
         EventBase() : 
             last_fired(0.0), 
-            times_fired(0)
+            times_fired(0), 
+            owner(NULL), 
+            listIndex(-1), 
+            schedulerIndex(-1), 
+            removalPending(false)
         {}
         virtual ~EventBase() {}
 
@@ -95,9 +112,29 @@ namespace TissueForge::event {
         }
 
         /**
-         * @brief Designates event for removal
+         * @brief Designates event for removal. 
+         * 
+         * An event in an event list is no longer evaluated and is removed 
+         * at the end of the current, or otherwise next, evaluation of the list. 
          */
-        void remove() { flags.push_front(EventFlag::REMOVE); }
+        void remove();
+
+    private:
+
+        friend EventScheduler;
+        friend EventBaseList;
+
+        // Owning event list, if any
+        EventBaseList *owner;
+
+        // Location in the owning event list
+        int listIndex;
+
+        // Location in the owning event scheduler
+        int schedulerIndex;
+
+        // Flag for whether removal is pending in the owning event list
+        bool removalPending;
 
     };
 
@@ -20,6 +20,11 @@
 #include "tfEventList.h"
 
 #include <tfLogger.h>
+#include <tfTrace.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 
 using namespace TissueForge;
@@ -29,57 +34,249 @@ HRESULT event::event_func_invoke(event::EventBase &event, const FloatP_t &time)
     return event.eval(time);
 }
 
-std::vector<event::EventBase*>::iterator event::EventBaseList::findEventIterator(event::EventBase *event) {
-    for(std::vector<event::EventBase*>::iterator itr = events.begin(); itr != events.end(); ++itr)
-        if(*itr == event) 
-            return itr;
-    return events.end();
+bool event::EventScheduler::less(const size_t &i, const size_t &j) const {
+    const Entry &ei = heap[i], &ej = heap[j];
+    return ei.time < ej.time || (ei.time == ej.time && ei.order < ej.order);
+}
+
+void event::EventScheduler::place(const size_t &i, const event::EventScheduler::Entry &entry) {
+    heap[i] = entry;
+    heap[i].event->schedulerIndex = i;
+}
+
+void event::EventScheduler::siftUp(size_t i) {
+    Entry entry = heap[i];
+    while(i > 0) {
+        size_t parent = (i - 1) / 2;
+        const Entry &pe = heap[parent];
+        if(pe.time < entry.time || (pe.time == entry.time && pe.order < entry.order)) 
+            break;
+        place(i, pe);
+        i = parent;
+    }
+    place(i, entry);
+}
+
+void event::EventScheduler::siftDown(size_t i) {
+    const size_t n = heap.size();
+    Entry entry = heap[i];
+    while(true) {
+        size_t child = 2 * i + 1;
+        if(child >= n) 
+            break;
+        if(child + 1 < n && less(child + 1, child)) 
+            child++;
+        const Entry &ce = heap[child];
+        if(entry.time < ce.time || (entry.time == ce.time && entry.order < ce.order)) 
+            break;
+        place(i, ce);
+        i = child;
+    }
+    place(i, entry);
+}
+
+void event::EventScheduler::insert(event::EventBase *event, const FloatP_t &time) {
+    if(has(event)) 
+        remove(event);
+
+    heap.push_back({time, counter++, event});
+    siftUp(heap.size() - 1);
+}
+
+HRESULT event::EventScheduler::remove(event::EventBase *event) {
+    if(!has(event)) 
+        return 1;
+
+    size_t i = event->schedulerIndex;
+    event->schedulerIndex = -1;
+
+    Entry last = heap.back();
+    heap.pop_back();
+    if(i == heap.size()) 
+        return S_OK;
+
+    place(i, last);
+    if(i > 0 && less(i, (i - 1) / 2)) 
+        siftUp(i);
+    else 
+        siftDown(i);
+
+    return S_OK;
+}
+
+bool event::EventScheduler::has(event::EventBase *event) const {
+    return event->schedulerIndex >= 0 && (size_t)event->schedulerIndex < heap.size() && heap[event->schedulerIndex].event == event;
+}
+
+FloatP_t event::EventScheduler::nextTime() const {
+    return heap.empty() ? std::numeric_limits<FloatP_t>::infinity() : heap.front().time;
+}
+
+event::EventBase *event::EventScheduler::pop() {
+    if(heap.empty()) 
+        return NULL;
+
+    EventBase *result = heap.front().event;
+    remove(result);
+    return result;
+}
+
+void event::EventScheduler::clear() {
+    for(auto &e : heap) 
+        e.event->schedulerIndex = -1;
+    heap.clear();
+}
+
+void event::EventBaseList::schedule(event::EventBase *event) {
+    FloatP_t nextTime = event->nextEvalTime();
+    if(nextTime < 0) 
+        predicated.push_back(event);
+    else if(std::isfinite(nextTime)) 
+        scheduler.insert(event, nextTime);
+}
+
+void event::EventBaseList::unschedule(event::EventBase *event) {
+    if(scheduler.remove(event) == S_OK) 
+        return;
+
+    auto itr = std::find(predicated.begin(), predicated.end(), event);
+    if(itr != predicated.end()) 
+        predicated.erase(itr);
 }
 
 event::EventBaseList::~EventBaseList() {
     events.clear();
     toRemove.clear();
+    predicated.clear();
+    scheduler.clear();
+    fired.clear();
 }
 
-void event::EventBaseList::addEvent(event::EventBase *event) { events.push_back(event); }
+void event::EventBase::remove() {
+    flags.push_front(EventFlag::REMOVE);
+    if(owner) 
+        owner->markRemoval(this);
+}
+
+void event::EventBaseList::markRemoval(event::EventBase *event) {
+    if(event->removalPending) 
+        return;
+
+    event->removalPending = true;
+    toRemove.push_back(event);
+}
+
+void event::EventBaseList::purge() {
+    std::vector<EventBase*> pending;
+    pending.swap(toRemove);
+    for(auto e : pending) {
+        e->removalPending = false;
+        removeEvent(e);
+    }
+}
+
+void event::EventBaseList::addEvent(event::EventBase *event) {
+    event->owner = this;
+    event->listIndex = events.size();
+    events.push_back(event);
+    schedule(event);
+}
 
 HRESULT event::EventBaseList::removeEvent(event::EventBase *event) {
-    auto itr = findEventIterator(event);
-    if (itr == events.end()) return 1;
-    delete *itr;
-    events.erase(itr);
+    if(event->listIndex < 0 || (size_t)event->listIndex >= events.size() || events[event->listIndex] != event) 
+        return 1;
+
+    unschedule(event);
+
+    if(event->removalPending) {
+        auto itr = std::find(toRemove.begin(), toRemove.end(), event);
+        if(itr != toRemove.end()) 
+            toRemove.erase(itr);
+    }
+    event->owner = NULL;
+
+    EventBase *last = events.back();
+    events[event->listIndex] = last;
+    last->listIndex = event->listIndex;
+    events.pop_back();
+
+    delete event;
     return S_OK;
 }
 
+HRESULT event::EventBaseList::rescheduleEvent(event::EventBase *event) {
+    if(event->listIndex < 0 || (size_t)event->listIndex >= events.size() || events[event->listIndex] != event) 
+        return 1;
+
+    unschedule(event);
+    schedule(event);
+    return S_OK;
+}
+
+static bool eventFlaggedForRemoval(event::EventBase *e) {
+    for(auto flag : e->flags) 
+        if(flag == event::EventFlag::REMOVE) 
+            return true;
+    return false;
+}
+
 HRESULT event::EventBaseList::eval(const FloatP_t &time) {
-    for (auto &e : events) {
-        auto result = e->eval(time);
+    TF_TRACE_SCOPE(TRACE_EVENT, "events");
+    HRESULT result = S_OK;
+
+    // Events designated for removal since the last evaluation are removed without evaluation
+    purge();
+
+    // Events added during evaluation are first evaluated in the next evaluation
+    const size_t numPredicated = predicated.size();
+    for(size_t i = 0; i < numPredicated && i < predicated.size(); i++) {
+        EventBase *e = predicated[i];
+        if(e->removalPending) 
+            continue;
+
+        {
+            TF_TRACE_SCOPE(TRACE_EVENT, "predicated");
+            result = e->eval(time);
+        }
         if (result < 0) {
             TF_Log(LOG_DEBUG) << "Event returned error code. Aborting.";
-            return result;
+            break;
         }
 
-        for (auto flag : e->flags) {
+        if(eventFlaggedForRemoval(e)) 
+            markRemoval(e);
+    }
+
+    // Fired events are rescheduled after all due events are processed, 
+    //  so that an event is evaluated at most once per step
+    while(result >= 0 && scheduler.nextTime() <= time) {
+        EventBase *e = scheduler.pop();
 
-            switch (flag)
-            {
-            case event::EventFlag::REMOVE:
-                toRemove.push_back(e);
-                break;
-            
-            default:
-                break;
-            }
+        if(e->removalPending) 
+            continue;
 
+        {
+            TF_TRACE_SCOPE(TRACE_EVENT, "scheduled");
+            result = e->eval(time);
+        }
+        fired.push_back(e);
+        if (result < 0) {
+            TF_Log(LOG_DEBUG) << "Event returned error code. Aborting.";
+            break;
         }
+
+        if(eventFlaggedForRemoval(e)) 
+            markRemoval(e);
     }
 
-    for (auto e : toRemove)
-        removeEvent(e);
+    for(auto e : fired) 
+        if(!e->removalPending) 
+            schedule(e);
+    fired.clear();
 
-    toRemove.clear();
+    purge();
 
-    return S_OK;
+    return result < 0 ? result : S_OK;
 }
 
 HRESULT event::eventListEval(event::EventBaseList *eventList, const FloatP_t &time) {
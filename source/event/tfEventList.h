@@ -33,15 +33,88 @@ namespace TissueForge::event {
 
     HRESULT event_func_invoke(EventBase &event, const FloatP_t &time);
 
+    /**
+     * @brief Priority queue of events keyed on their next evaluation time. 
+     * 
+     * Events are stored in a binary min-heap and track their own location in the heap, 
+     * so that insertion, removal and retrieval of the next event are all O(log n). 
+     * Events with the same time are ordered by insertion. 
+     */
+    struct CAPI_EXPORT EventScheduler {
+
+        EventScheduler() : counter(0) {}
+
+        /** Insert an event with a time of next evaluation */
+        void insert(EventBase *event, const FloatP_t &time);
+
+        /** Remove an event; returns 1 if the event is not scheduled */
+        HRESULT remove(EventBase *event);
+
+        /** Test whether an event is scheduled */
+        bool has(EventBase *event) const;
+
+        /** Time of the next scheduled event; infinity if empty */
+        FloatP_t nextTime() const;
+
+        /** Remove and return the next scheduled event; NULL if empty */
+        EventBase *pop();
+
+        size_t size() const { return heap.size(); }
+        bool empty() const { return heap.empty(); }
+        void clear();
+
+    private:
+
+        struct Entry {
+            FloatP_t time;
+            size_t order;
+            EventBase *event;
+        };
+
+        std::vector<Entry> heap;
+        size_t counter;
+
+        inline bool less(const size_t &i, const size_t &j) const;
+        inline void place(const size_t &i, const Entry &entry);
+        void siftUp(size_t i);
+        void siftDown(size_t i);
+
+    };
+
+    /**
+     * @brief List of events. 
+     * 
+     * Events that only depend on time are scheduled by their next evaluation time 
+     * and incur no cost while dormant. 
+     * All other events are evaluated every step in the order in which they were added. 
+     * Events designated for removal are removed at the end of the current, or otherwise next, 
+     * evaluation, whether or not they are due. 
+     */
     struct CAPI_EXPORT EventBaseList {
 
     private:
 
-        inline std::vector<EventBase*>::iterator findEventIterator(EventBase *event);
         std::vector<EventBase*> toRemove;
 
+        // Events evaluated every step
+        std::vector<EventBase*> predicated;
+
+        // Events evaluated when their time arrives
+        EventScheduler scheduler;
+
+        // Events fired during the current evaluation, pending rescheduling
+        std::vector<EventBase*> fired;
+
+        void schedule(EventBase *event);
+        void unschedule(EventBase *event);
+        void markRemoval(EventBase *event);
+        void purge();
+
+        friend EventBase;
+
     public:
 
+        // All events of the list
         std::vector<EventBase*> events;
 
         ~EventBaseList();
@@ -50,6 +123,25 @@ namespace TissueForge::event {
         HRESULT removeEvent(EventBase *event);
         HRESULT eval(const FloatP_t &time);
 
+        /**
+         * @brief Updates the scheduling of an event. 
+         * 
+         * Required when the timing of an event is changed to an earlier time after it was added. 
+         * 
+         * @param event event to reschedule
+         * @return HRESULT 
+         */
+        HRESULT rescheduleEvent(EventBase *event);
+
+        /** Number of events evaluated every step */
+        size_t numPredicated() const { return predicated.size(); }
+
+        /** Number of events waiting for their time of evaluation */
+        size_t numScheduled() const { return scheduler.size(); }
+
+        /** Number of events of the list */
+        size_t numEvents() const { return events.size(); }
+
     };
 
     inline HRESULT eventListEval(EventBaseList *eventList, const FloatP_t &time);
@@ -109,6 +109,11 @@ HRESULT event::ParticleTimeEvent::eval(const FloatP_t &time) {
     return result;
 }
 
+FloatP_t event::ParticleTimeEvent::nextEvalTime() {
+    if(predicateMethod) return -1;
+    return defaultTimeEventNextEvalTime(this->next_time, this->start_time, this->end_time);
+}
+
 event::ParticleTimeEvent::operator event::TimeEvent&() const {
     event::TimeEvent *e = new event::TimeEvent(period, NULL, NULL, NULL, start_time, end_time);
     return *e;
@@ -171,7 +171,9 @@ namespace TissueForge {
             ParticleHandle *targetParticle;
 
             /**
-            * @brief Next time at which an evaluation occurs
+            * @brief Next time at which an evaluation occurs. 
+            * 
+            * Setting an earlier time on a registered event requires rescheduling it with its event list. 
             */
             FloatP_t next_time;
 
@@ -190,7 +192,7 @@ namespace TissueForge {
             */
             FloatP_t end_time;
             
-            ParticleTimeEvent() {}
+            ParticleTimeEvent() : invokeMethod(NULL), predicateMethod(NULL) {}
             ParticleTimeEvent(
                 ParticleType *targetType, 
                 const FloatP_t &period, 
@@ -206,6 +208,7 @@ namespace TissueForge {
             virtual HRESULT predicate();
             virtual HRESULT invoke();
             virtual HRESULT eval(const FloatP_t &time);
+            virtual FloatP_t nextEvalTime();
 
             operator TimeEvent&() const;
 
@@ -23,6 +23,8 @@
 #include <tfEngine.h>
 #include <tfUniverse.h>
 
+#include <algorithm>
+
 
 using namespace TissueForge;
 
@@ -35,6 +37,13 @@ HRESULT event::defaultTimeEventPredicateEval(const FloatP_t &next_time, const Fl
     return result;
 }
 
+FloatP_t event::defaultTimeEventNextEvalTime(const FloatP_t &next_time, const FloatP_t &start_time, const FloatP_t &end_time) {
+    FloatP_t result = start_time > 0 ? std::max(next_time, start_time) : next_time;
+    if(end_time > 0 && result > end_time) 
+        return std::numeric_limits<FloatP_t>::infinity();
+    return std::max(result, (FloatP_t)0);
+}
+
 event::TimeEvent::~TimeEvent() {}
 
 FloatP_t event::timeEventSetNextTimeExponential(event::TimeEvent &event, const FloatP_t &time) {
@@ -64,7 +73,7 @@ event::TimeEventNextTimeSetter* event::getTimeEventNextTimeSetterN(std::string s
 
 HRESULT event::TimeEvent::predicate() { 
     if(predicateMethod) return (*predicateMethod)(*this);
-    return 1;
+    return defaultTimeEventPredicateEval(this->next_time, this->start_time, this->end_time);
 }
 
 HRESULT event::TimeEvent::invoke() {
@@ -78,6 +87,11 @@ HRESULT event::TimeEvent::eval(const FloatP_t &time) {
     return result;
 }
 
+FloatP_t event::TimeEvent::nextEvalTime() {
+    if(predicateMethod) return -1;
+    return defaultTimeEventNextEvalTime(this->next_time, this->start_time, this->end_time);
+}
+
 FloatP_t event::TimeEvent::getNextTime(const FloatP_t &current_time) {
     return (*nextTimeSetter)(*this, current_time);
 }
@@ -41,6 +41,11 @@ namespace TissueForge::event {
 
     CAPI_FUNC(HRESULT) defaultTimeEventPredicateEval(const FloatP_t &next_time, const FloatP_t &start_time=-1, const FloatP_t &end_time=-1);
 
+    /**
+     * @brief Next time at which the default time event predicate can be satisfied; infinity if never
+     */
+    CAPI_FUNC(FloatP_t) defaultTimeEventNextEvalTime(const FloatP_t &next_time, const FloatP_t &start_time=-1, const FloatP_t &end_time=-1);
+
     CAPI_FUNC(FloatP_t) timeEventSetNextTimeExponential(TimeEvent &event, const FloatP_t &time);
     CAPI_FUNC(FloatP_t) timeEventSetNextTimeDeterministic(TimeEvent &event, const FloatP_t &time);
 
@@ -69,7 +74,9 @@ namespace TissueForge::event {
 
     struct CAPI_EXPORT TimeEvent : EventBase {
         /**
-         * @brief Next time of evaluation
+         * @brief Next time of evaluation. 
+         * 
+         * Setting an earlier time on a registered event requires rescheduling it with its event list. 
          */
         FloatP_t next_time;
 
@@ -112,6 +119,7 @@ namespace TissueForge::event {
         HRESULT predicate();
         HRESULT invoke();
         HRESULT eval(const FloatP_t &time);
+        FloatP_t nextEvalTime();
 
     protected:
 
@@ -23,6 +23,7 @@
 #include <tfLogger.h>
 #include <tf_util.h>
 #include <tfError.h>
+#include <tfTrace.h>
 
 #include <fstream>
 #include <iostream>
@@ -290,6 +291,8 @@ namespace TissueForge::io {
 
     HRESULT FIO::toFile(const std::string &saveFilePath) { 
 
+        TF_TRACE_SCOPE(TRACE_IO, "save");
+
         MetaData metaData;
         IOElement tfData = generateIORootElement();
 
@@ -33,6 +33,14 @@ namespace TissueForge::io {
         return ThreeDFIO::toFile(format, filePath, pRefinements);
     }
 
+    HRESULT toFile3DFInstanced(const std::string &filePath, const unsigned int &pRefinements) {
+        return ThreeDFIO::toFileInstanced(filePath, pRefinements);
+    }
+
+    HRESULT toFile3DFPointCloud(const std::string &filePath, const bool &binary) {
+        return ThreeDFIO::toFilePointCloud(filePath, binary);
+    }
+
     HRESULT toFile(const std::string &saveFilePath) {
         return FIO::toFile(saveFilePath);
     }
@@ -56,6 +56,30 @@ namespace TissueForge::io {
      */
     CPPAPI_FUNC(HRESULT) toFile3DF(const std::string &format, const std::string &filePath, const unsigned int &pRefinements=0);
 
+    /**
+     * @brief Export particles to a binary glTF file as instances of one shared sphere mesh. 
+     * 
+     * Particles are streamed to file in chunks, so that large simulations 
+     * can be exported without generating the geometry of every particle. 
+     * 
+     * @param filePath path of file
+     * @param pRefinements refinements of the shared sphere mesh
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) toFile3DFInstanced(const std::string &filePath, const unsigned int &pRefinements=0);
+
+    /**
+     * @brief Export particles to a PLY file as a point cloud with per-point radius and color. 
+     * 
+     * Particles are streamed to file in chunks, so that large simulations 
+     * can be exported without generating the geometry of every particle. 
+     * 
+     * @param filePath path of file
+     * @param binary flag to write binary data; otherwise writes ASCII data
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) toFile3DFPointCloud(const std::string &filePath, const bool &binary=true);
+
     /**
      * @brief Save a simulation to file
      * 
@@ -18,10 +18,15 @@
  ******************************************************************************/
 
 #include <assimp/postprocess.h>
+#include <Magnum/Trade/MeshData.h>
+#include <Magnum/Primitives/Icosphere.h>
 
 #include <tfEngine.h>
 #include <rendering/tfStyle.h>
+#include <tfError.h>
 #include <tfParticleList.h>
+#include <tfTaskScheduler.h>
+#include <tfTrace.h>
 #include "generators/tfThreeDFAngleMeshGenerator.h"
 #include "generators/tfThreeDFBondMeshGenerator.h"
 #include "generators/tfThreeDFDihedralMeshGenerator.h"
@@ -29,6 +34,19 @@
 
 #include "tfThreeDFIO.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+
+/** Number of particles gathered and written at a time during streamed export */
+#define THREEDF_EXPORT_CHUNK_SIZE 16384
+
 
 namespace TissueForge::io {
 
@@ -63,6 +81,8 @@ namespace TissueForge::io {
 
     HRESULT ThreeDFIO::toFile(const std::string &format, const std::string &filePath, const unsigned int &pRefinements) {
 
+        TF_TRACE_SCOPE(TRACE_IO, "3DF export");
+
         // Build structure
 
         ThreeDFStructure structure;
@@ -152,4 +172,334 @@ namespace TissueForge::io {
         return S_OK;
     }
 
+
+    // Streamed export
+
+
+    /** Per-particle data of a streamed export */
+    struct ThreeDFParticleRecord {
+        float position[3];
+        float radius;
+        float color[3];
+        int32_t id;
+        int32_t typeId;
+    };
+
+    /** Ids of the particles of each type that are exported, as rendered */
+    static std::vector<std::vector<int32_t> > threeDFExportedParticles() {
+        std::vector<std::vector<int32_t> > result(_Engine.nr_types);
+
+        const int pidEnd = engine_partid_end(&_Engine);
+        for(int pid = 0; pid < pidEnd; pid++) {
+            Particle *p = _Engine.s.partlist[pid];
+            if(!p || p->flags & PARTICLE_CLUSTER) 
+                continue;
+
+            rendering::Style *style = p->style ? p->style : _Engine.types[p->typeId].style;
+            if(style && !style->getVisible()) 
+                continue;
+
+            result[p->typeId].push_back(pid);
+        }
+
+        return result;
+    }
+
+    /** Gathers the data of a chunk of particles */
+    static void threeDFGatherChunk(const int32_t *pids, const size_t &numParts, std::vector<ThreeDFParticleRecord> &records) {
+        records.resize(numParts);
+
+        parallel_for(
+            numParts, 
+            [&pids, &records](int i) -> void {
+                Particle *p = _Engine.s.partlist[pids[i]];
+                ThreeDFParticleRecord &r = records[i];
+
+                const FVector3 x = p->global_position();
+                r.position[0] = x[0]; r.position[1] = x[1]; r.position[2] = x[2];
+                r.radius = p->radius;
+
+                rendering::Style *style = p->style ? p->style : _Engine.types[p->typeId].style;
+                const fVector4 color = style ? style->map_color(p) : fVector4(1.f);
+                r.color[0] = color[0]; r.color[1] = color[1]; r.color[2] = color[2];
+
+                r.id = p->id;
+                r.typeId = p->typeId;
+            }
+        );
+    }
+
+    template <typename T> 
+    static void threeDFWrite(std::ostream &os, const T &value) {
+        os.write((const char*)&value, sizeof(T));
+    }
+
+    static std::string threeDFJSONString(const std::string &s) {
+        std::ostringstream os;
+        os << '"';
+        for(auto c : s) {
+            if(c == '"' || c == '\\') 
+                os << '\\' << c;
+            else if((unsigned char)c >= 0x20) 
+                os << c;
+        }
+        os << '"';
+        return os.str();
+    }
+
+    static uint8_t threeDFColorByte(const float &c) {
+        return (uint8_t)std::lround(255.f * std::min(std::max(c, 0.f), 1.f));
+    }
+
+    static HRESULT threeDFCloseFile(std::ofstream &file, const std::string &filePath) {
+        file.close();
+        if(file.fail()) 
+            return tf_error(E_FAIL, ("Failed to write file: " + filePath).c_str());
+
+        TF_Log(LOG_INFORMATION) << "Exported to " << filePath;
+
+        return S_OK;
+    }
+
+    HRESULT ThreeDFIO::toFileInstanced(const std::string &filePath, const unsigned int &pRefinements) {
+
+        TF_TRACE_SCOPE(TRACE_IO, "3DF instanced export");
+
+        auto pidsByType = threeDFExportedParticles();
+
+        std::vector<unsigned int> typeIds;
+        for(unsigned int i = 0; i < pidsByType.size(); i++) 
+            if(!pidsByType[i].empty()) 
+                typeIds.push_back(i);
+
+        if(typeIds.empty()) 
+            return tf_error(E_FAIL, "No data to export");
+
+        // Generate the shared unit sphere
+
+        Magnum::Trade::MeshData icoSphere = Magnum::Primitives::icosphereSolid(pRefinements);
+        auto mg_positions = icoSphere.positions3DAsArray();
+        auto mg_normals = icoSphere.normalsAsArray();
+        auto mg_indices = icoSphere.indicesAsArray();
+
+        const uint32_t numVerts = mg_positions.size();
+        const uint32_t numIndices = mg_indices.size();
+
+        fVector3 posMin(std::numeric_limits<float>::max()), posMax(std::numeric_limits<float>::lowest());
+        for(uint32_t i = 0; i < numVerts; i++) 
+            for(unsigned int k = 0; k < 3; k++) {
+                posMin[k] = std::min(posMin[k], mg_positions[i][k]);
+                posMax[k] = std::max(posMax[k], mg_positions[i][k]);
+            }
+
+        // Describe the scene; the binary buffer holds the sphere positions, normals and indices, 
+        // followed by the interleaved translation, scale and color of each instance by type
+
+        const uint32_t instanceStride = 9 * sizeof(float);
+        uint64_t binLength = 2 * 3 * sizeof(float) * numVerts + sizeof(uint32_t) * numIndices;
+
+        std::ostringstream nodes, meshes, materials, bufferViews, accessors;
+        nodes << std::setprecision(std::numeric_limits<float>::max_digits10);
+        materials << std::setprecision(std::numeric_limits<float>::max_digits10);
+        accessors << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        bufferViews << "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" << 3 * sizeof(float) * numVerts << ",\"target\":34962},";
+        bufferViews << "{\"buffer\":0,\"byteOffset\":" << 3 * sizeof(float) * numVerts << ",\"byteLength\":" << 3 * sizeof(float) * numVerts << ",\"target\":34962},";
+        bufferViews << "{\"buffer\":0,\"byteOffset\":" << 2 * 3 * sizeof(float) * numVerts << ",\"byteLength\":" << sizeof(uint32_t) * numIndices << ",\"target\":34963}";
+
+        accessors << "{\"bufferView\":0,\"componentType\":5126,\"count\":" << numVerts << ",\"type\":\"VEC3\"";
+        accessors << ",\"min\":[" << posMin[0] << "," << posMin[1] << "," << posMin[2] << "]";
+        accessors << ",\"max\":[" << posMax[0] << "," << posMax[1] << "," << posMax[2] << "]},";
+        accessors << "{\"bufferView\":1,\"componentType\":5126,\"count\":" << numVerts << ",\"type\":\"VEC3\"},";
+        accessors << "{\"bufferView\":2,\"componentType\":5125,\"count\":" << numIndices << ",\"type\":\"SCALAR\"}";
+
+        for(unsigned int k = 0; k < typeIds.size(); k++) {
+            ParticleType *pType = &_Engine.types[typeIds[k]];
+            const size_t numParts = pidsByType[typeIds[k]].size();
+            const unsigned int viewIdx = 3 + k;
+            const unsigned int accIdx = 3 + 3 * k;
+            const fVector3 color = pType->style ? pType->style->color : fVector3(1.f);
+            const std::string name = threeDFJSONString(pType->name);
+            const char *sep = k > 0 ? "," : "";
+
+            nodes << sep << "{\"name\":" << name << ",\"mesh\":" << k;
+            nodes << ",\"extensions\":{\"EXT_mesh_gpu_instancing\":{\"attributes\":{";
+            nodes << "\"TRANSLATION\":" << accIdx << ",\"SCALE\":" << accIdx + 1 << ",\"_COLOR_0\":" << accIdx + 2 << "}}}}";
+
+            meshes << sep << "{\"name\":" << name << ",\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1},\"indices\":2,\"material\":" << k << "}]}";
+
+            materials << sep << "{\"name\":" << name << ",\"pbrMetallicRoughness\":{";
+            materials << "\"baseColorFactor\":[" << color[0] << "," << color[1] << "," << color[2] << ",1]";
+            materials << ",\"metallicFactor\":0,\"roughnessFactor\":0.5}}";
+
+            bufferViews << ",{\"buffer\":0,\"byteOffset\":" << binLength << ",\"byteLength\":" << instanceStride * numParts;
+            bufferViews << ",\"byteStride\":" << instanceStride << "}";
+
+            for(unsigned int j = 0; j < 3; j++) 
+                accessors << ",{\"bufferView\":" << viewIdx << ",\"byteOffset\":" << 3 * sizeof(float) * j 
+                          << ",\"componentType\":5126,\"count\":" << numParts << ",\"type\":\"VEC3\"}";
+
+            binLength += instanceStride * numParts;
+        }
+
+        std::ostringstream json;
+        json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"Tissue Forge\"}";
+        json << ",\"extensionsUsed\":[\"EXT_mesh_gpu_instancing\"]";
+        json << ",\"scene\":0,\"scenes\":[{\"nodes\":[";
+        for(unsigned int k = 0; k < typeIds.size(); k++) 
+            json << (k > 0 ? "," : "") << k;
+        json << "]}]";
+        json << ",\"nodes\":[" << nodes.str() << "]";
+        json << ",\"meshes\":[" << meshes.str() << "]";
+        json << ",\"materials\":[" << materials.str() << "]";
+        json << ",\"buffers\":[{\"byteLength\":" << binLength << "}]";
+        json << ",\"bufferViews\":[" << bufferViews.str() << "]";
+        json << ",\"accessors\":[" << accessors.str() << "]}";
+
+        std::string jsonStr = json.str();
+        while(jsonStr.size() % 4 != 0) 
+            jsonStr += ' ';
+
+        // GLB lengths are 32-bit
+        const uint64_t glbLength = 12 + 8 + (uint64_t)jsonStr.size() + 8 + binLength;
+        if(glbLength > std::numeric_limits<uint32_t>::max()) 
+            return tf_error(E_FAIL, "Too much data for a single GLB file");
+
+        // Write the header, description and sphere
+
+        std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!file.is_open()) 
+            return tf_error(E_FAIL, ("Could not open file: " + filePath).c_str());
+
+        file.write("glTF", 4);
+        threeDFWrite(file, (uint32_t)2);
+        threeDFWrite(file, (uint32_t)glbLength);
+
+        threeDFWrite(file, (uint32_t)jsonStr.size());
+        file.write("JSON", 4);
+        file.write(jsonStr.data(), jsonStr.size());
+
+        threeDFWrite(file, (uint32_t)binLength);
+        file.write("BIN\0", 4);
+        for(uint32_t i = 0; i < numVerts; i++) 
+            for(unsigned int k = 0; k < 3; k++) 
+                threeDFWrite(file, (float)mg_positions[i][k]);
+        for(uint32_t i = 0; i < numVerts; i++) 
+            for(unsigned int k = 0; k < 3; k++) 
+                threeDFWrite(file, (float)mg_normals[i][k]);
+        for(uint32_t i = 0; i < numIndices; i++) 
+            threeDFWrite(file, (uint32_t)mg_indices[i]);
+
+        // Stream the instances
+
+        std::vector<ThreeDFParticleRecord> records;
+        std::vector<float> buff;
+        for(auto typeId : typeIds) {
+            const std::vector<int32_t> &pids = pidsByType[typeId];
+
+            for(size_t start = 0; start < pids.size(); start += THREEDF_EXPORT_CHUNK_SIZE) {
+                const size_t numParts = std::min<size_t>(THREEDF_EXPORT_CHUNK_SIZE, pids.size() - start);
+                threeDFGatherChunk(&pids[start], numParts, records);
+
+                buff.resize(9 * numParts);
+                for(size_t i = 0; i < numParts; i++) {
+                    const ThreeDFParticleRecord &r = records[i];
+                    float *b = &buff[9 * i];
+                    b[0] = r.position[0]; b[1] = r.position[1]; b[2] = r.position[2];
+                    b[3] = r.radius;      b[4] = r.radius;      b[5] = r.radius;
+                    b[6] = r.color[0];    b[7] = r.color[1];    b[8] = r.color[2];
+                }
+                file.write((const char*)buff.data(), buff.size() * sizeof(float));
+            }
+        }
+
+        return threeDFCloseFile(file, filePath);
+    }
+
+    HRESULT ThreeDFIO::toFilePointCloud(const std::string &filePath, const bool &binary) {
+
+        TF_TRACE_SCOPE(TRACE_IO, "3DF point cloud export");
+
+        auto pidsByType = threeDFExportedParticles();
+
+        size_t numPoints = 0;
+        for(auto &pids : pidsByType) 
+            numPoints += pids.size();
+
+        if(numPoints == 0) 
+            return tf_error(E_FAIL, "No data to export");
+
+        std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!file.is_open()) 
+            return tf_error(E_FAIL, ("Could not open file: " + filePath).c_str());
+
+        // Binary data is written in the byte order of the writing machine
+
+        const uint16_t byteOrderTest = 1;
+        const bool littleEndian = *(const uint8_t*)&byteOrderTest == 1;
+
+        file << "ply\n";
+        if(!binary) 
+            file << "format ascii 1.0\n";
+        else if(littleEndian) 
+            file << "format binary_little_endian 1.0\n";
+        else 
+            file << "format binary_big_endian 1.0\n";
+        file << "comment Tissue Forge point cloud\n";
+        file << "element vertex " << numPoints << "\n";
+        file << "property float x\n";
+        file << "property float y\n";
+        file << "property float z\n";
+        file << "property float radius\n";
+        file << "property uchar red\n";
+        file << "property uchar green\n";
+        file << "property uchar blue\n";
+        file << "property int id\n";
+        file << "property int type\n";
+        file << "end_header\n";
+
+        // Stream the points
+
+        const size_t recordSize = 4 * sizeof(float) + 3 * sizeof(uint8_t) + 2 * sizeof(int32_t);
+
+        std::vector<ThreeDFParticleRecord> records;
+        std::vector<char> buff;
+        std::ostringstream ss;
+        ss << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        for(auto &pids : pidsByType) {
+            for(size_t start = 0; start < pids.size(); start += THREEDF_EXPORT_CHUNK_SIZE) {
+                const size_t numParts = std::min<size_t>(THREEDF_EXPORT_CHUNK_SIZE, pids.size() - start);
+                threeDFGatherChunk(&pids[start], numParts, records);
+
+                if(binary) {
+                    buff.resize(recordSize * numParts);
+                    for(size_t i = 0; i < numParts; i++) {
+                        const ThreeDFParticleRecord &r = records[i];
+                        const uint8_t color[3] = {threeDFColorByte(r.color[0]), threeDFColorByte(r.color[1]), threeDFColorByte(r.color[2])};
+                        char *b = &buff[recordSize * i];
+                        std::memcpy(b, r.position, 3 * sizeof(float));   b += 3 * sizeof(float);
+                        std::memcpy(b, &r.radius, sizeof(float));        b += sizeof(float);
+                        std::memcpy(b, color, 3 * sizeof(uint8_t));      b += 3 * sizeof(uint8_t);
+                        std::memcpy(b, &r.id, sizeof(int32_t));          b += sizeof(int32_t);
+                        std::memcpy(b, &r.typeId, sizeof(int32_t));
+                    }
+                    file.write(buff.data(), buff.size());
+                }
+                else {
+                    ss.str("");
+                    for(size_t i = 0; i < numParts; i++) {
+                        const ThreeDFParticleRecord &r = records[i];
+                        ss << r.position[0] << " " << r.position[1] << " " << r.position[2] << " " << r.radius << " ";
+                        ss << (int)threeDFColorByte(r.color[0]) << " " << (int)threeDFColorByte(r.color[1]) << " " << (int)threeDFColorByte(r.color[2]) << " ";
+                        ss << r.id << " " << r.typeId << "\n";
+                    }
+                    file << ss.str();
+                }
+            }
+        }
+
+        return threeDFCloseFile(file, filePath);
+    }
+
 };
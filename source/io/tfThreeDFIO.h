@@ -46,6 +46,36 @@ namespace TissueForge::io {
          * @return HRESULT 
          */
         static HRESULT toFile(const std::string &format, const std::string &filePath, const unsigned int &pRefinements=0);
+
+        /**
+         * @brief Export particles to a binary glTF file as instances of one shared sphere mesh. 
+         * 
+         * Particles are written in chunks while the file is written, without generating 
+         * their geometry. Each particle type is a node that instances a unit sphere 
+         * using the EXT_mesh_gpu_instancing extension, with the color of the type as material. 
+         * Each instance has a translation, a scale equal to the particle radius and 
+         * the color of the particle in the custom attribute _COLOR_0. 
+         * Invisible particles and clusters are not written. 
+         * 
+         * @param filePath path of file
+         * @param pRefinements refinements of the shared sphere mesh
+         * @return HRESULT 
+         */
+        static HRESULT toFileInstanced(const std::string &filePath, const unsigned int &pRefinements=0);
+
+        /**
+         * @brief Export particles to a PLY file as a point cloud. 
+         * 
+         * Particles are written in chunks while the file is written, without generating 
+         * their geometry. Each point has a position (x, y, z), radius, color (red, green, blue), 
+         * particle id (id) and particle type id (type). 
+         * Invisible particles and clusters are not written. 
+         * 
+         * @param filePath path of file
+         * @param binary flag to write binary data; otherwise writes ASCII data
+         * @return HRESULT 
+         */
+        static HRESULT toFilePointCloud(const std::string &filePath, const bool &binary=true);
     };
 
 };
@@ -0,0 +1,445 @@
+/*******************************************************************************
+ * This file is part of Tissue Forge.
+ * Copyright (c) 2022-2024 T.J. Sego
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ ******************************************************************************/
+
+
+#include "tfTrajectory.h"
+
+#include <tfEngine.h>
+#include <tfBond.h>
+#include <tfParticle.h>
+#include <tfError.h>
+#include <tfLogger.h>
+#include <tfTaskScheduler.h>
+#include <tfTrace.h>
+#include <state/tfStateVector.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace TissueForge;
+
+
+/** Snapshot of the selected particle data of one frame */
+struct TrajectoryFrame {
+    uint64_t step;
+    double time;
+    uint32_t fields;
+    std::vector<int32_t> ids;
+    std::vector<int32_t> typeIds;
+    std::vector<float> positions;
+    std::vector<float> velocities;
+    std::vector<uint32_t> speciesCounts;
+    std::vector<float> speciesValues;
+    std::vector<int32_t> bonds;
+};
+
+/** State of a trajectory being written */
+struct TrajectoryState {
+    std::ofstream file;
+    unsigned int fields;
+    unsigned int stride;
+
+    /** Snapshot buffers; only ever resized when a trajectory starts */
+    std::vector<TrajectoryFrame> frames;
+
+    /** Buffers available for capture */
+    std::deque<TrajectoryFrame*> framesFree;
+
+    /** Captured buffers waiting to be written, in order of capture */
+    std::deque<TrajectoryFrame*> framesPending;
+
+    /** File offset of each written frame */
+    std::vector<uint64_t> offsets;
+
+    /** 
+     * Written id of each particle by particle id once particles are renumbered during the trajectory; 
+     * empty until then, when particle ids are written as they are 
+     */
+    std::vector<int32_t> writtenIds;
+
+    /** Next written id of particles created after renumbering */
+    int32_t nextWrittenId;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::thread worker;
+    bool stopping;
+    bool failed;
+};
+
+static io::TrajectoryWriter *_writer = NULL;
+static TrajectoryState *_state = NULL;
+static unsigned int _numFrames = 0;
+
+
+template <typename T> 
+static void TrajectoryWriter_write(std::ofstream &file, const T &value) {
+    file.write((const char*)&value, sizeof(T));
+}
+
+template <typename T> 
+static void TrajectoryWriter_write(std::ofstream &file, const std::vector<T> &values) {
+    if(!values.empty()) 
+        file.write((const char*)values.data(), values.size() * sizeof(T));
+}
+
+template <typename T> 
+static uint64_t TrajectoryWriter_numBytes(const std::vector<T> &values) {
+    return values.size() * sizeof(T);
+}
+
+static void TrajectoryWriter_writeFrame(std::ofstream &file, const TrajectoryFrame &frame) {
+    const uint64_t chunkSize = sizeof(uint64_t) + sizeof(double) + 4 * sizeof(uint32_t) 
+        + TrajectoryWriter_numBytes(frame.ids) 
+        + TrajectoryWriter_numBytes(frame.typeIds) 
+        + TrajectoryWriter_numBytes(frame.positions) 
+        + TrajectoryWriter_numBytes(frame.velocities) 
+        + TrajectoryWriter_numBytes(frame.speciesCounts) 
+        + TrajectoryWriter_numBytes(frame.speciesValues) 
+        + TrajectoryWriter_numBytes(frame.bonds);
+
+    file.write("FRME", 4);
+    TrajectoryWriter_write(file, chunkSize);
+    TrajectoryWriter_write(file, frame.step);
+    TrajectoryWriter_write(file, frame.time);
+    TrajectoryWriter_write(file, frame.fields);
+    TrajectoryWriter_write(file, (uint32_t)frame.ids.size());
+    TrajectoryWriter_write(file, (uint32_t)frame.speciesValues.size());
+    TrajectoryWriter_write(file, (uint32_t)(frame.bonds.size() / 2));
+    TrajectoryWriter_write(file, frame.ids);
+    TrajectoryWriter_write(file, frame.typeIds);
+    TrajectoryWriter_write(file, frame.positions);
+    TrajectoryWriter_write(file, frame.velocities);
+    TrajectoryWriter_write(file, frame.speciesCounts);
+    TrajectoryWriter_write(file, frame.speciesValues);
+    TrajectoryWriter_write(file, frame.bonds);
+}
+
+static void TrajectoryWriter_work(TrajectoryState *state) {
+    trace::setThreadName("trajectory writer");
+
+    std::unique_lock<std::mutex> lock(state->lock);
+    while(true) {
+        state->cv.wait(lock, [state]() -> bool { return !state->framesPending.empty() || state->stopping; });
+        if(state->framesPending.empty()) 
+            return;
+
+        // Keep the frame pending while writing, so that flushing waits for it
+        TrajectoryFrame *frame = state->framesPending.front();
+        lock.unlock();
+
+        bool failed = false;
+        if(!state->failed) {
+            TF_TRACE_SCOPE(TRACE_IO, "trajectory write", (int32_t)frame->step);
+            state->offsets.push_back((uint64_t)(std::streamoff)state->file.tellp());
+            TrajectoryWriter_writeFrame(state->file, *frame);
+            failed = !state->file.good();
+        }
+
+        lock.lock();
+        if(failed) {
+            state->failed = true;
+            TF_Log(LOG_ERROR) << "Failed to write trajectory frame at step " << frame->step;
+        }
+        state->framesPending.pop_front();
+        state->framesFree.push_back(frame);
+        state->cv.notify_all();
+    }
+}
+
+static int32_t TrajectoryWriter_writtenId(TrajectoryState *state, const int32_t &pid) {
+    if(state->writtenIds.empty()) 
+        return pid;
+
+    if(pid >= state->writtenIds.size()) 
+        state->writtenIds.resize(pid + 1, -1);
+    int32_t &result = state->writtenIds[pid];
+    if(result < 0) 
+        result = state->nextWrittenId++;
+    return result;
+}
+
+static HRESULT TrajectoryWriter_capture(TrajectoryState *state) {
+    TF_TRACE_SCOPE(TRACE_IO, "trajectory capture", (int32_t)_Engine.time);
+
+    TrajectoryFrame *frame;
+    {
+        std::unique_lock<std::mutex> lock(state->lock);
+        if(state->framesFree.empty()) {
+            TF_Log(LOG_DEBUG) << "Waiting for a trajectory snapshot buffer";
+            state->cv.wait(lock, [state]() -> bool { return !state->framesFree.empty(); });
+        }
+        if(state->failed) 
+            return S_OK;
+        frame = state->framesFree.front();
+        state->framesFree.pop_front();
+    }
+
+    const unsigned int fields = state->fields;
+    frame->step = _Engine.time;
+    frame->time = _Engine.time * _Engine.dt;
+    frame->fields = fields;
+
+    // Gather particles; buffers keep their capacity between frames
+
+    frame->ids.clear();
+    const int pidEnd = engine_partid_end(&_Engine);
+    for(int pid = 0; pid < pidEnd; pid++) 
+        if(_Engine.s.partlist[pid]) 
+            frame->ids.push_back(pid);
+    const size_t numParts = frame->ids.size();
+
+    frame->typeIds.resize(fields & io::TRAJECTORY_TYPE ? numParts : 0);
+    frame->positions.resize(fields & io::TRAJECTORY_POSITION ? 3 * numParts : 0);
+    frame->velocities.resize(fields & io::TRAJECTORY_VELOCITY ? 3 * numParts : 0);
+    frame->speciesCounts.resize(fields & io::TRAJECTORY_SPECIES ? numParts : 0);
+
+    parallel_for(
+        numParts, 
+        [&frame, &fields](int i) -> void {
+            Particle *p = _Engine.s.partlist[frame->ids[i]];
+            if(fields & io::TRAJECTORY_TYPE) 
+                frame->typeIds[i] = p->typeId;
+            if(fields & io::TRAJECTORY_POSITION) {
+                const FVector3 x = p->global_position();
+                float *buff = &frame->positions[3 * i];
+                buff[0] = x[0]; buff[1] = x[1]; buff[2] = x[2];
+            }
+            if(fields & io::TRAJECTORY_VELOCITY) {
+                float *buff = &frame->velocities[3 * i];
+                buff[0] = p->velocity[0]; buff[1] = p->velocity[1]; buff[2] = p->velocity[2];
+            }
+            if(fields & io::TRAJECTORY_SPECIES) 
+                frame->speciesCounts[i] = p->state_vector ? p->state_vector->size : 0;
+        }
+    );
+
+    frame->speciesValues.clear();
+    if(fields & io::TRAJECTORY_SPECIES) {
+        std::vector<size_t> speciesOffsets(numParts, 0);
+        size_t numSpeciesValues = 0;
+        for(size_t i = 0; i < numParts; i++) {
+            speciesOffsets[i] = numSpeciesValues;
+            numSpeciesValues += frame->speciesCounts[i];
+        }
+        frame->speciesValues.resize(numSpeciesValues);
+        parallel_for(
+            numParts, 
+            [&frame, &speciesOffsets](int i) -> void {
+                const uint32_t n = frame->speciesCounts[i];
+                if(n == 0) 
+                    return;
+                const FloatP_t *fvec = _Engine.s.partlist[frame->ids[i]]->state_vector->fvec;
+                float *buff = &frame->speciesValues[speciesOffsets[i]];
+                for(uint32_t k = 0; k < n; k++) 
+                    buff[k] = fvec[k];
+            }
+        );
+    }
+
+    frame->bonds.clear();
+    if(fields & io::TRAJECTORY_BONDS) {
+        for(int i = 0; i < _Engine.nr_bonds; i++) {
+            Bond &b = _Engine.bonds[i];
+            if(b.flags & BOND_ACTIVE) {
+                frame->bonds.push_back(TrajectoryWriter_writtenId(state, b.i));
+                frame->bonds.push_back(TrajectoryWriter_writtenId(state, b.j));
+            }
+        }
+    }
+
+    // Particle ids are only replaced by their written ids once the data of all particles is gathered
+
+    if(!state->writtenIds.empty()) 
+        for(auto &pid : frame->ids) 
+            pid = TrajectoryWriter_writtenId(state, pid);
+
+    {
+        std::unique_lock<std::mutex> lock(state->lock);
+        state->framesPending.push_back(frame);
+    }
+    state->cv.notify_all();
+    _numFrames++;
+
+    return S_OK;
+}
+
+
+io::TrajectoryWriter::TrajectoryWriter() {
+    name = "TrajectoryWriter";
+}
+
+HRESULT io::TrajectoryWriter::start(
+    const std::string &filePath, 
+    const unsigned int &fields, 
+    const unsigned int &stride, 
+    const unsigned int &numBuffers) 
+{
+    if(_state) 
+        return tf_error(E_FAIL, "A trajectory is already being written");
+    if(stride == 0) 
+        return tf_error(E_FAIL, "Trajectory stride must be positive");
+    if(numBuffers < 2) 
+        return tf_error(E_FAIL, "Trajectory writer requires at least two snapshot buffers");
+
+    if(!_writer) {
+        _writer = new TrajectoryWriter();
+        if(_writer->registerEngine() != S_OK) {
+            delete _writer;
+            _writer = NULL;
+            return tf_error(E_FAIL, "Could not register trajectory writer");
+        }
+    }
+
+    TrajectoryState *state = new TrajectoryState();
+    state->file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!state->file.is_open()) {
+        delete state;
+        return tf_error(E_FAIL, ("Could not open trajectory file " + filePath).c_str());
+    }
+
+    state->fields = fields;
+    state->stride = stride;
+    state->stopping = false;
+    state->failed = false;
+    state->nextWrittenId = 0;
+    state->frames.resize(numBuffers);
+    for(auto &frame : state->frames) 
+        state->framesFree.push_back(&frame);
+
+    state->file.write("TFTRAJ01", 8);
+    TrajectoryWriter_write(state->file, (uint32_t)1);
+    TrajectoryWriter_write(state->file, (uint32_t)fields);
+
+    state->worker = std::thread(TrajectoryWriter_work, state);
+
+    _numFrames = 0;
+    _state = state;
+
+    TF_Log(LOG_INFORMATION) << "Writing trajectory to " << filePath << " every " << stride << " step(s)";
+
+    return S_OK;
+}
+
+HRESULT io::TrajectoryWriter::stop() {
+    if(!_state) 
+        return S_OK;
+
+    TrajectoryState *state = _state;
+    _state = NULL;
+
+    {
+        std::unique_lock<std::mutex> lock(state->lock);
+        state->stopping = true;
+    }
+    state->cv.notify_all();
+    state->worker.join();
+
+    // Write the index of frames
+
+    const uint64_t indexOffset = (uint64_t)(std::streamoff)state->file.tellp();
+    state->file.write("INDX", 4);
+    TrajectoryWriter_write(state->file, (uint64_t)state->offsets.size());
+    TrajectoryWriter_write(state->file, state->offsets);
+    TrajectoryWriter_write(state->file, indexOffset);
+    state->file.write("TFTRAJIX", 8);
+    state->file.close();
+
+    const bool failed = state->failed || state->file.fail();
+    delete state;
+
+    if(failed) 
+        return tf_error(E_FAIL, "Failed to write trajectory");
+    return S_OK;
+}
+
+HRESULT io::TrajectoryWriter::flush() {
+    if(!_state) 
+        return S_OK;
+
+    std::unique_lock<std::mutex> lock(_state->lock);
+    _state->cv.wait(lock, []() -> bool { return _state->framesPending.empty(); });
+    _state->file.flush();
+    return _state->failed ? E_FAIL : S_OK;
+}
+
+HRESULT io::TrajectoryWriter::capture() {
+    if(!_state) 
+        return tf_error(E_FAIL, "No trajectory is being written");
+
+    return TrajectoryWriter_capture(_state);
+}
+
+bool io::TrajectoryWriter::isWriting() {
+    return _state != NULL;
+}
+
+unsigned int io::TrajectoryWriter::numFrames() {
+    return _numFrames;
+}
+
+HRESULT io::TrajectoryWriter::postStepJoin() {
+    if(!_state || _Engine.time % _state->stride != 0) 
+        return S_OK;
+
+    return TrajectoryWriter_capture(_state);
+}
+
+HRESULT io::TrajectoryWriter::renumberParticles(const std::vector<int> &newIds) {
+    if(!_state) 
+        return S_OK;
+
+    // Particles keep the id written before they were first renumbered
+
+    const bool first = _state->writtenIds.empty();
+    if(first) 
+        _state->nextWrittenId = newIds.size();
+
+    std::vector<int32_t> writtenIds(newIds.size(), -1);
+    for(size_t pid = 0; pid < newIds.size(); pid++) {
+        const int newId = newIds[pid];
+        if(newId < 0 || newId >= writtenIds.size()) 
+            continue;
+        if(first) 
+            writtenIds[newId] = pid;
+        else if(pid < _state->writtenIds.size()) 
+            writtenIds[newId] = _state->writtenIds[pid];
+    }
+    _state->writtenIds.swap(writtenIds);
+
+    return S_OK;
+}
+
+HRESULT io::TrajectoryWriter::releaseParticle(const int &pid) {
+    // A recycled id is written as a new particle
+    if(_state && pid < _state->writtenIds.size()) 
+        _state->writtenIds[pid] = -1;
+
+    return S_OK;
+}
+
+HRESULT io::TrajectoryWriter::finalize() {
+    return stop();
+}
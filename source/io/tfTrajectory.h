@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * This file is part of Tissue Forge.
+ * Copyright (c) 2022-2024 T.J. Sego
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ ******************************************************************************/
+
+
+#ifndef _SOURCE_IO_TFTRAJECTORY_H_
+#define _SOURCE_IO_TFTRAJECTORY_H_
+
+#include <tf_port.h>
+#include <tfSubEngine.h>
+
+#include <string>
+
+
+namespace TissueForge::io {
+
+
+    /**
+     * @brief Per-particle data written to a trajectory
+     */
+    enum TrajectoryField : unsigned int {
+        TRAJECTORY_POSITION = 1 << 0,   /**< global position */
+        TRAJECTORY_VELOCITY = 1 << 1,   /**< velocity */
+        TRAJECTORY_TYPE     = 1 << 2,   /**< particle type id */
+        TRAJECTORY_SPECIES  = 1 << 3,   /**< species values, if any */
+        TRAJECTORY_BONDS    = 1 << 4    /**< particle ids of active bonds */
+    };
+
+    /**
+     * @brief Writes selected particle data to a binary trajectory file during simulation. 
+     * 
+     * Every few steps, the writer copies the selected data into a pooled snapshot buffer 
+     * and a background thread appends it to file while the engine keeps stepping. 
+     * The engine only waits when all snapshot buffers are still waiting to be written. 
+     * 
+     * Renumbering particles during a trajectory does not change the id written for a particle. 
+     * Particles created after renumbering are written with ids beyond those issued before renumbering. 
+     * 
+     * All values are stored in the byte order of the writing machine. 
+     * The file begins with the eight characters "TFTRAJ01", a format version (uint32) 
+     * and the written fields (uint32). 
+     * Each frame is a chunk that begins with the four characters "FRME", 
+     * the size of the rest of the chunk (uint64), step (uint64), time (float64), 
+     * fields (uint32), number of particles (uint32), number of species values (uint32) and 
+     * number of bonds (uint32). The chunk continues with particle ids (int32 per particle) 
+     * and then, when written, type ids (int32 per particle), positions (3 float32 per particle), 
+     * velocities (3 float32 per particle), species counts (uint32 per particle) followed by 
+     * species values (float32) and bonded particle ids (2 int32 per bond). 
+     * 
+     * When the writer stops, it appends an index chunk that begins with "INDX" 
+     * and the number of frames (uint64), followed by the file offset of each frame (uint64). 
+     * The file ends with the offset of the index chunk (uint64) and the eight characters "TFTRAJIX", 
+     * so that any frame can be found without reading the frames before it. 
+     */
+    struct CAPI_EXPORT TrajectoryWriter : SubEngine {
+
+        /**
+         * @brief Start writing a trajectory. 
+         * 
+         * Only one trajectory can be written at a time. 
+         * 
+         * @param filePath path of file; an existing file is overwritten
+         * @param fields written per-particle data; a combination of @ref TrajectoryField
+         * @param stride number of steps between frames
+         * @param numBuffers number of pooled snapshot buffers; at least two
+         */
+        static HRESULT start(
+            const std::string &filePath, 
+            const unsigned int &fields=TRAJECTORY_POSITION | TRAJECTORY_TYPE, 
+            const unsigned int &stride=1, 
+            const unsigned int &numBuffers=2
+        );
+
+        /**
+         * @brief Write all pending frames, write the index and close the file
+         */
+        static HRESULT stop();
+
+        /**
+         * @brief Wait until all pending frames are written
+         */
+        static HRESULT flush();
+
+        /**
+         * @brief Capture a frame of the current state now, regardless of the stride
+         */
+        static HRESULT capture();
+
+        /**
+         * @brief Test whether a trajectory is being written
+         */
+        static bool isWriting();
+
+        /**
+         * @brief Get the number of frames captured since the trajectory started
+         */
+        static unsigned int numFrames();
+
+        HRESULT postStepJoin() override;
+        HRESULT renumberParticles(const std::vector<int> &newIds) override;
+        HRESULT releaseParticle(const int &pid) override;
+        HRESULT finalize() override;
+
+    private:
+
+        TrajectoryWriter();
+
+    };
+
+};
+
+#endif // _SOURCE_IO_TFTRAJECTORY_H_
@@ -40,6 +40,8 @@ namespace TissueForge {
             HRESULT invoke() {
                 if(!hasExecutorPyCallable() || !activeEvent) return E_ABORT;
 
+                GILAcquire gil;
+
                 PyObject *result = PyObject_CallObject(executorPyCallable, NULL);
 
                 if(result == NULL) {
@@ -19,7 +19,11 @@
 
 #include "tfForcePy.h"
 
+#include <tfError.h>
 #include <tfLogger.h>
+#include <tfEngine.h>
+#include <tfParticle.h>
+#include <state/tfStateVector.h>
 
 
 using namespace TissueForge;
@@ -28,6 +32,8 @@ using namespace TissueForge;
 FVector3 pyConstantForceFunction(PyObject *callable) {
     TF_Log(LOG_TRACE);
 
+    py::GILAcquire gil;
+
     PyObject *result = PyObject_CallObject(callable, NULL);
 
     if(result == NULL) {
@@ -99,6 +105,168 @@ py::CustomForcePy *py::CustomForcePy::fromForce(Force *f) {
     return (py::CustomForcePy*)f;
 }
 
+static void custom_batch_force(py::CustomForceBatchPy *cf, Particle *p, FPTYPE *f) {
+    if(p->id < 0 || (size_t)p->id >= cf->forces.size()) 
+        return;
+
+    FPTYPE scale = p->state_vector && cf->stateVectorIndex >= 0 ? p->state_vector->fvec[cf->stateVectorIndex] : 1.0;
+    const FVector3 &pf = cf->forces[p->id];
+    f[0] += pf[0] * scale;
+    f[1] += pf[1] * scale;
+    f[2] += pf[2] * scale;
+}
+
+static PyObject *pyBufferView(void *data, const Py_ssize_t &itemsize, const char *format, const int &ndim, Py_ssize_t *shape, Py_ssize_t *strides) {
+    Py_buffer view;
+    view.buf = data;
+    view.obj = NULL;
+    view.len = itemsize;
+    for(int i = 0; i < ndim; i++) 
+        view.len *= shape[i];
+    view.itemsize = itemsize;
+    view.readonly = 1;
+    view.ndim = ndim;
+    view.format = (char*)format;
+    view.shape = shape;
+    view.strides = strides;
+    view.suboffsets = NULL;
+    view.internal = NULL;
+    return PyMemoryView_FromBuffer(&view);
+}
+
+static void pyBufferViewRelease(PyObject *view) {
+    if(!view) 
+        return;
+    PyObject *result = PyObject_CallMethod(view, "release", NULL);
+    if(result) 
+        Py_DECREF(result);
+    else 
+        PyErr_Clear();
+    Py_DECREF(view);
+}
+
+py::CustomForceBatchPy::CustomForceBatchPy(PyObject *f, const FloatP_t &period) : 
+    CustomForce(), 
+    callable(f), 
+    updated(false)
+{
+    type = FORCE_CUSTOM;
+    func = (Force_EvalFcn)custom_batch_force;
+    userFunc = NULL;
+    lastUpdate = 0;
+    force = FVector3(0);
+
+    setPeriod(period);
+    if(callable) 
+        Py_IncRef(callable);
+}
+
+py::CustomForceBatchPy::~CustomForceBatchPy() {
+    if(callable) {
+        py::GILAcquire gil;
+        Py_DecRef(callable);
+    }
+}
+
+void py::CustomForceBatchPy::onTime(FloatP_t time) {
+    if(callable && (!updated || time >= lastUpdate + updateInterval)) {
+        lastUpdate = time;
+        update();
+    }
+}
+
+HRESULT py::CustomForceBatchPy::update() {
+    TF_Log(LOG_TRACE);
+
+    if(!callable || callable == Py_None) 
+        return S_OK;
+
+    updated = true;
+
+    std::vector<int32_t> ids;
+    std::vector<FloatP_t> positions;
+    for(int i = 0; i < _Engine.nr_types; i++) {
+        if(_Engine.forces[i] != this) 
+            continue;
+
+        ParticleList &parts = _Engine.types[i].parts;
+        ids.reserve(ids.size() + parts.nr_parts);
+        positions.reserve(positions.size() + 3 * parts.nr_parts);
+        for(int j = 0; j < parts.nr_parts; j++) {
+            Particle *p = _Engine.s.partlist[parts.parts[j]];
+            if(!p) 
+                continue;
+
+            FVector3 pos = p->global_position();
+            ids.push_back(p->id);
+            positions.push_back(pos[0]);
+            positions.push_back(pos[1]);
+            positions.push_back(pos[2]);
+        }
+    }
+
+    std::fill(forces.begin(), forces.end(), FVector3(0));
+    if(forces.size() < (size_t)_Engine.s.size_parts) 
+        forces.resize(_Engine.s.size_parts, FVector3(0));
+
+    if(ids.empty()) 
+        return S_OK;
+
+    py::GILAcquire gil;
+
+    Py_ssize_t idsShape[1] = {(Py_ssize_t)ids.size()};
+    Py_ssize_t idsStrides[1] = {sizeof(int32_t)};
+    Py_ssize_t posShape[2] = {(Py_ssize_t)ids.size(), 3};
+    Py_ssize_t posStrides[2] = {3 * sizeof(FloatP_t), sizeof(FloatP_t)};
+    const char *fpFormat = sizeof(FloatP_t) == sizeof(double) ? "d" : "f";
+
+    PyObject *pyids = pyBufferView(ids.data(), sizeof(int32_t), "i", 1, idsShape, idsStrides);
+    PyObject *pypos = pyBufferView(positions.data(), sizeof(FloatP_t), fpFormat, 2, posShape, posStrides);
+    PyObject *result = PyObject_CallFunctionObjArgs(callable, pyids, pypos, NULL);
+    pyBufferViewRelease(pyids);
+    pyBufferViewRelease(pypos);
+
+    if(result == NULL) {
+        TF_Log(LOG_CRITICAL) << py::pyerror_str();
+        PyErr_Clear();
+        return E_FAIL;
+    }
+
+    Py_buffer view;
+    if(PyObject_GetBuffer(result, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        Py_DECREF(result);
+        return tf_error(E_FAIL, "Batched force function must return a contiguous buffer");
+    }
+
+    HRESULT hr = S_OK;
+    if(!view.format || std::string(view.format).back() != fpFormat[0] || view.len != positions.size() * sizeof(FloatP_t)) {
+        hr = tf_error(E_FAIL, "Batched force function returned a buffer of incorrect type or size");
+    }
+    else {
+        const FloatP_t *data = (const FloatP_t*)view.buf;
+        for(size_t k = 0; k < ids.size(); k++) 
+            forces[ids[k]] = FVector3(data[3 * k], data[3 * k + 1], data[3 * k + 2]);
+    }
+
+    PyBuffer_Release(&view);
+    Py_DECREF(result);
+    return hr;
+}
+
+HRESULT py::CustomForceBatchPy::renumberParticles(const std::vector<int> &newIds) {
+    std::vector<FVector3> renumbered(forces.size(), FVector3(0));
+    for(size_t pid = 0; pid < forces.size() && pid < newIds.size(); pid++) 
+        if(newIds[pid] >= 0 && newIds[pid] < renumbered.size()) 
+            renumbered[newIds[pid]] = forces[pid];
+    forces.swap(renumbered);
+    return S_OK;
+}
+
+py::CustomForceBatchPy *py::CustomForceBatchPy::fromForce(Force *f) {
+    return dynamic_cast<py::CustomForceBatchPy*>(f);
+}
+
 
 namespace TissueForge::io { 
 
@@ -24,6 +24,8 @@
 #include "tf_py.h"
 #include <tfForce.h>
 
+#include <vector>
+
 
 namespace TissueForge {
 
@@ -63,6 +65,65 @@ namespace TissueForge {
 
         };
 
+        /**
+         * @brief A custom force with a value per particle, evaluated in batches by a python function. 
+         * 
+         * Rather than calling into the python layer per particle, the python function is called 
+         * once per update with the ids and positions of all particles of the types to which 
+         * the force is bound, and returns the force on each particle. 
+         * Forces are updated at the end of a step and applied during subsequent steps. 
+         */
+        struct CAPI_EXPORT CustomForceBatchPy : CustomForce {
+            PyObject *callable;
+
+            /**
+             * @brief Force on each particle, by particle id
+             */
+            std::vector<FVector3> forces;
+
+            /**
+             * @brief Creates an instance from an underlying custom python function
+             * 
+             * @param f python function. Takes a buffer of particle ids with shape (N,) and a buffer of particle 
+             * positions with shape (N, 3), and returns a buffer of forces with shape (N, 3). 
+             * Buffers passed to the function are only valid during the call. 
+             * @param period period at which the force is updated. Updates every step by default. 
+             */
+            CustomForceBatchPy(PyObject *f, const FloatP_t &period=0);
+            virtual ~CustomForceBatchPy();
+
+            void onTime(FloatP_t time);
+
+            /**
+             * @brief Evaluates the underlying python function and updates the force on each particle
+             * 
+             * @return HRESULT 
+             */
+            HRESULT update();
+
+            /**
+             * @brief Moves the force on each particle to its new id
+             * 
+             * @param newIds new id of each particle by old id; -1 for unused ids
+             */
+            HRESULT renumberParticles(const std::vector<int> &newIds) override;
+
+            /**
+             * @brief Convert basic force to CustomForceBatchPy. 
+             * 
+             * If the basic force is not a CustomForceBatchPy, then NULL is returned. 
+             * 
+             * @param f 
+             * @return CustomForceBatchPy* 
+             */
+            static CustomForceBatchPy *fromForce(Force *f);
+
+        private:
+
+            bool updated;
+
+        };
+
     };
 
 
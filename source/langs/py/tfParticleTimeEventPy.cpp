@@ -85,6 +85,11 @@ HRESULT py::ParticleTimeEventPy::eval(const FloatP_t &time) {
     return result;
 }
 
+FloatP_t py::ParticleTimeEventPy::nextEvalTime() {
+    if(predicateExecutor && predicateExecutor->hasExecutorPyCallable()) return -1;
+    return event::defaultTimeEventNextEvalTime(this->next_time, this->start_time, this->end_time);
+}
+
 py::ParticleTimeEventPy *py::onParticleTimeEvent(
     ParticleType *targetType, 
     const FloatP_t &period, 
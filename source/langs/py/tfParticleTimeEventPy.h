@@ -67,6 +67,7 @@ namespace TissueForge {
             virtual HRESULT predicate();
             virtual HRESULT invoke();
             virtual HRESULT eval(const FloatP_t &time);
+            virtual FloatP_t nextEvalTime();
 
         private:
 
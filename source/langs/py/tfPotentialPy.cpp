@@ -24,6 +24,8 @@ using namespace TissueForge;
 
 
 static FloatP_t pyEval(PyObject *f, FloatP_t r) {
+	py::GILAcquire gil;
+
 	PyObject *py_r = cast<FloatP_t, PyObject*>(r);
 	PyObject *args = PyTuple_Pack(1, py_r);
 	PyObject *py_result = PyObject_CallObject(f, args);
@@ -272,6 +272,78 @@ static void parse_kwargs(PyObject *kwargs, Simulator::Config &conf) {
     }
     else perfcounter_period = NULL;
     
+    int *flux_integrator;
+    if((o = PyDict_GetItemString(kwargs, "flux_integrator"))) {
+        flux_integrator = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got flux_integrator: " << std::to_string(*flux_integrator);
+    }
+    else flux_integrator = NULL;
+
+    int *cell_order;
+    if((o = PyDict_GetItemString(kwargs, "cell_order"))) {
+        cell_order = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got cell_order: " << std::to_string(*cell_order);
+    }
+    else cell_order = NULL;
+
+    int *renumber_period;
+    if((o = PyDict_GetItemString(kwargs, "renumber_period"))) {
+        renumber_period = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got renumber_period: " << std::to_string(*renumber_period);
+    }
+    else renumber_period = NULL;
+
+    FloatP_t *pid_compaction;
+    if((o = PyDict_GetItemString(kwargs, "pid_compaction"))) {
+        pid_compaction = new FloatP_t(cast<PyObject, FloatP_t>(o));
+
+        TF_Log(LOG_INFORMATION) << "got pid_compaction: " << std::to_string(*pid_compaction);
+    }
+    else pid_compaction = NULL;
+
+    int *regrid_period;
+    if((o = PyDict_GetItemString(kwargs, "regrid_period"))) {
+        regrid_period = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got regrid_period: " << std::to_string(*regrid_period);
+    }
+    else regrid_period = NULL;
+
+    FloatP_t *regrid_occupancy;
+    if((o = PyDict_GetItemString(kwargs, "regrid_occupancy"))) {
+        regrid_occupancy = new FloatP_t(cast<PyObject, FloatP_t>(o));
+
+        TF_Log(LOG_INFORMATION) << "got regrid_occupancy: " << std::to_string(*regrid_occupancy);
+    }
+    else regrid_occupancy = NULL;
+
+    int *expand_margin;
+    if((o = PyDict_GetItemString(kwargs, "expand_margin"))) {
+        expand_margin = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got expand_margin: " << std::to_string(*expand_margin);
+    }
+    else expand_margin = NULL;
+
+    FloatP_t *langevin_friction;
+    if((o = PyDict_GetItemString(kwargs, "langevin_friction"))) {
+        langevin_friction = new FloatP_t(cast<PyObject, FloatP_t>(o));
+
+        TF_Log(LOG_INFORMATION) << "got langevin_friction: " << std::to_string(*langevin_friction);
+    }
+    else langevin_friction = NULL;
+
+    int *respa_steps;
+    if((o = PyDict_GetItemString(kwargs, "respa_steps"))) {
+        respa_steps = new int(cast<PyObject, int>(o));
+
+        TF_Log(LOG_INFORMATION) << "got respa_steps: " << std::to_string(*respa_steps);
+    }
+    else respa_steps = NULL;
+    
     int *logger_level;
     if((o = PyDict_GetItemString(kwargs, "logger_level"))) {
         logger_level = new int(cast<PyObject, int>(o));
@@ -322,6 +394,8 @@ static void parse_kwargs(PyObject *kwargs, Simulator::Config &conf) {
         switch (kind) {
             case FORWARD_EULER:
             case RUNGE_KUTTA_4:
+            case VELOCITY_VERLET:
+            case BAOAB:
                 conf.universeConfig.integrator = (EngineIntegrator)kind;
                 break;
             default: {
@@ -331,6 +405,20 @@ static void parse_kwargs(PyObject *kwargs, Simulator::Config &conf) {
             }
         }
     }
+    if(flux_integrator) {
+        int kind = *flux_integrator;
+        switch (kind) {
+            case FLUX_INTEGRATOR_EXPLICIT:
+            case FLUX_INTEGRATOR_SEMIIMPLICIT:
+                conf.universeConfig.fluxIntegrator = kind;
+                break;
+            default: {
+                std::string msg = "invalid flux integrator kind: ";
+                msg += std::to_string(kind);
+                tf_exp(std::logic_error(msg));
+            }
+        }
+    }
     if(dt) conf.universeConfig.dt = *dt;
 
     if(bcArgs) conf.universeConfig.setBoundaryConditions((BoundaryConditionsArgsContainer*)bcArgs);
@@ -342,6 +430,14 @@ static void parse_kwargs(PyObject *kwargs, Simulator::Config &conf) {
     if(throw_exc) conf.setThrowingExceptions(*throw_exc);
     if(perfcounters) conf.universeConfig.timers_mask = *perfcounters;
     if(perfcounter_period) conf.universeConfig.timer_output_period = *perfcounter_period;
+    if(cell_order) conf.universeConfig.cellOrder = *cell_order;
+    if(renumber_period) conf.universeConfig.renumberPeriod = *renumber_period;
+    if(pid_compaction) conf.universeConfig.pidCompaction = *pid_compaction;
+    if(regrid_period) conf.universeConfig.regridPeriod = *regrid_period;
+    if(regrid_occupancy) conf.universeConfig.regridOccupancy = *regrid_occupancy;
+    if(expand_margin) conf.universeConfig.expandMargin = *expand_margin;
+    if(langevin_friction) conf.universeConfig.langevinFriction = *langevin_friction;
+    if(respa_steps) conf.universeConfig.respaSteps = *respa_steps;
     if(logger_level) Logger::setLevel(*logger_level);
     if(clip_planes) {
         std::vector<std::tuple<fVector3, fVector3> > _clip_planes;
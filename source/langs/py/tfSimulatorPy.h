@@ -82,7 +82,11 @@ namespace TissueForge::py {
      * 
      *      threads: (int) number of threads; default is hardware maximum
      * 
-     *      integrator: (int) simulation integrator; default is FORWARD_EULER
+     *      integrator: (int) simulation integrator; one of FORWARD_EULER, RUNGE_KUTTA_4, VELOCITY_VERLET and BAOAB; default is FORWARD_EULER
+     * 
+     *      langevin_friction: (float) friction coefficient of the BAOAB integrator; default is 1
+     * 
+     *      respa_steps: (int) number of inner steps of the VELOCITY_VERLET integrator, during which bonded forces are evaluated; default is 1, which disables multiple time stepping
      * 
      *      dt: (float) time discretization; default is 0.01
      * 
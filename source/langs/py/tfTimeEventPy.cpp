@@ -61,6 +61,11 @@ HRESULT py::TimeEventPy::eval(const FloatP_t &time) {
     return result;
 }
 
+FloatP_t py::TimeEventPy::nextEvalTime() {
+    if(predicateExecutor) return -1;
+    return event::defaultTimeEventNextEvalTime(this->next_time, this->start_time, this->end_time);
+}
+
 FloatP_t py::TimeEventPy::getNextTime(const FloatP_t &current_time) {
     if(!nextTimeSetter || nextTimeSetter == NULL) return current_time + this->period;
     return (*this->nextTimeSetter)(*(event::TimeEvent*)this, current_time);
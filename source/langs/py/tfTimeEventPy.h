@@ -91,6 +91,7 @@ namespace TissueForge {
             HRESULT predicate();
             HRESULT invoke();
             HRESULT eval(const FloatP_t &time);
+            FloatP_t nextEvalTime();
 
         protected:
 
@@ -0,0 +1,31 @@
+/*******************************************************************************
+ * This file is part of Tissue Forge.
+ * Copyright (c) 2022-2024 T.J. Sego
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ ******************************************************************************/
+
+#include "tfUniversePy.h"
+
+#include <tfUniverse.h>
+
+
+using namespace TissueForge;
+
+
+HRESULT py::universe_step(const FloatP_t &until, const FloatP_t &dt) {
+    py::GILRelease gil;
+    return Universe::step(until, dt);
+}
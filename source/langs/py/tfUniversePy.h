@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * This file is part of Tissue Forge.
+ * Copyright (c) 2022-2024 T.J. Sego
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ ******************************************************************************/
+
+/**
+ * @file tfUniversePy.h
+ * 
+ */
+
+#ifndef _SOURCE_LANGS_PY_TFUNIVERSEPY_H_
+#define _SOURCE_LANGS_PY_TFUNIVERSEPY_H_
+
+#include "tf_py.h"
+
+
+namespace TissueForge::py {
+
+
+    /**
+     * @brief Integrates the universe with the GIL released. 
+     * 
+     * The GIL is re-acquired only at callbacks into the python layer 
+     * (events, custom forces, widgets), so that other python threads 
+     * can run while the engine steps. 
+     * 
+     * @param until runtime limit, in units of simulation time. Executes one step if not positive. 
+     * @param dt time step
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) universe_step(const FloatP_t &until=0, const FloatP_t &dt=0);
+
+};
+
+#endif // _SOURCE_LANGS_PY_TFUNIVERSEPY_H_
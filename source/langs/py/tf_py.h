@@ -158,6 +158,31 @@ namespace TissueForge {
     namespace py {
 
 
+        /**
+         * @brief Holds the GIL for the lifetime of an instance. 
+         * 
+         * Every callback into the python layer acquires the GIL, 
+         * since callbacks can occur while the engine runs with the GIL released. 
+         */
+        struct CAPI_EXPORT GILAcquire {
+            GILAcquire() : state(PyGILState_Ensure()) {}
+            ~GILAcquire() { PyGILState_Release(state); }
+
+        private:
+            PyGILState_STATE state;
+        };
+
+        /**
+         * @brief Releases the GIL for the lifetime of an instance, if held by the calling thread. 
+         */
+        struct CAPI_EXPORT GILRelease {
+            GILRelease() : state(PyGILState_Check() ? PyEval_SaveThread() : NULL) {}
+            ~GILRelease() { if(state) PyEval_RestoreThread(state); }
+
+        private:
+            PyThreadState *state;
+        };
+
         CAPI_FUNC(PyObject*) Import_ImportString(const std::string &name);
         CAPI_FUNC(PyObject*) iPython_Get();
         CAPI_FUNC(bool) terminalInteractiveShell();
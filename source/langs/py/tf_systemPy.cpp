@@ -215,6 +215,16 @@ HRESULT py::view_reshape(const iVector2 &windowSize) { return system::viewReshap
 
 std::string py::performance_counters() { return system::performanceCounters(); }
 
+HRESULT py::start_trace(const unsigned int &capacity) { return system::startTrace(capacity); }
+
+HRESULT py::stop_trace() { return system::stopTrace(); }
+
+HRESULT py::clear_trace() { return system::clearTrace(); }
+
+bool py::is_tracing() { return system::isTracing(); }
+
+HRESULT py::export_trace(const std::string &filePath) { return system::exportTrace(filePath); }
+
 std::unordered_map<std::string, bool> py::cpu_info() { return system::cpu_info(); }
 
 std::unordered_map<std::string, bool> py::compile_flags() {
@@ -344,6 +354,8 @@ rendering::ArrowData *py::get_render_arrow(const int &arrowId) { return system::
 static void _pyVoidFunction(PyObject* callable) {
     TF_Log(LOG_TRACE);
 
+    py::GILAcquire gil;
+
     PyObject* result = PyObject_CallObject(callable, NULL);
 
     if(result == NULL) {
@@ -359,6 +371,8 @@ template <typename T>
 void _pyTFunction(PyObject* callable, const T& arg) {
     TF_Log(LOG_TRACE);
 
+    py::GILAcquire gil;
+
     PyObject* pyarg = cast<T, PyObject*>(arg);
     PyObject* pyargs = PyTuple_Pack(1, pyarg);
     PyObject* result = PyObject_CallObject(callable, pyargs);
@@ -29,6 +29,7 @@
 
 #include <rendering/tfUniverseRenderer.h>
 #include <rendering/tfArrowRenderer.h>
+#include <tfTrace.h>
 
 #include <list>
 #include <unordered_map>
@@ -640,6 +641,48 @@ namespace TissueForge::py {
    CPPAPI_FUNC(HRESULT) view_reshape(const iVector2 &windowSize);
 
    CPPAPI_FUNC(std::string) performance_counters();
+
+   /**
+   * @brief Start tracing engine phases, runner tasks, subengines, events and I/O. 
+   * 
+   * Each thread records into its own ring buffer, which retains the most recent events. 
+   * Previously recorded events are discarded. 
+   * 
+   * @param capacity number of events retained per thread
+   * @return HRESULT 
+   */
+   CPPAPI_FUNC(HRESULT) start_trace(const unsigned int &capacity=TF_TRACE_CAPACITY_DEFAULT);
+
+   /**
+   * @brief Stop tracing. Recorded events are retained for export. 
+   * 
+   * @return HRESULT 
+   */
+   CPPAPI_FUNC(HRESULT) stop_trace();
+
+   /**
+   * @brief Discard all recorded trace events
+   * 
+   * @return HRESULT 
+   */
+   CPPAPI_FUNC(HRESULT) clear_trace();
+
+   /**
+   * @brief Test whether tracing is active
+   * 
+   * @return true if tracing
+   */
+   CPPAPI_FUNC(bool) is_tracing();
+
+   /**
+   * @brief Export recorded trace events to file in Chrome trace event JSON format. 
+   * 
+   * The file can be viewed with chrome://tracing or the Perfetto UI. 
+   * 
+   * @param filePath path of the file
+   * @return HRESULT 
+   */
+   CPPAPI_FUNC(HRESULT) export_trace(const std::string &filePath);
    
    /**
    * @brief Get CPU info
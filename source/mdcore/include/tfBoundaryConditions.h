@@ -29,7 +29,10 @@
 #include <types/tf_types.h>
 #include <io/tf_io.h>
 
+#include <algorithm>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 
 namespace TissueForge {
@@ -221,6 +224,190 @@ namespace TissueForge {
         );
     };
 
+    /**
+     * @brief A boundary of arbitrary geometry, defined by a signed distance field 
+     * sampled on a regular grid. 
+     * 
+     * The signed distance is positive in the simulation domain and negative in the wall. 
+     * A particle interacts with the wall by the potential of the boundary for its type, 
+     * evaluated at the interpolated signed distance along the gradient of the field. 
+     * Particles closer to the wall than the minimum distance of the potential, 
+     * including particles that penetrated the wall, are evaluated at the minimum distance. 
+     * Interactions are only evaluated in cells that are near the wall. 
+     * 
+     * Boundaries are owned by the engine once created. 
+     */
+    struct CAPI_EXPORT BoundarySDF {
+
+        /**
+         * @brief Condition of the boundary, which holds its potentials and radius
+         */
+        BoundaryCondition condition;
+
+        /**
+         * @brief Position of the first sample
+         */
+        FVector3 origin;
+
+        /**
+         * @brief Distance between samples
+         */
+        FPTYPE spacing;
+
+        /**
+         * @brief Number of samples along each direction
+         */
+        iVector3 shape;
+
+        /**
+         * @brief Signed distance at each sample, with the first index varying fastest
+         */
+        std::vector<FPTYPE> values;
+
+        /**
+         * @brief Interpolate the signed distance and its gradient at a position. 
+         * 
+         * Positions outside of the grid are clamped to the grid. 
+         * 
+         * @param x global position
+         * @param grad gradient of the signed distance; ignored when NULL
+         * @return signed distance
+         */
+        inline FPTYPE interpolate(const FPTYPE *x, FPTYPE *grad) const {
+            int ind[3];
+            FPTYPE t[3];
+            for(int k = 0; k < 3; k++) {
+                FPTYPE u = std::max(FPTYPE(0), std::min((x[k] - origin[k]) * ispacing, FPTYPE(shape[k] - 1)));
+                ind[k] = std::min((int)u, shape[k] - 2);
+                t[k] = u - ind[k];
+            }
+
+            const int sy = shape[0], sz = shape[0] * shape[1];
+            const FPTYPE *v = &values[ind[0] + sy * ind[1] + sz * ind[2]];
+            const FPTYPE c00 = v[0]       + t[0] * (v[1]           - v[0]);
+            const FPTYPE c10 = v[sy]      + t[0] * (v[sy + 1]      - v[sy]);
+            const FPTYPE c01 = v[sz]      + t[0] * (v[sz + 1]      - v[sz]);
+            const FPTYPE c11 = v[sy + sz] + t[0] * (v[sy + sz + 1] - v[sy + sz]);
+            const FPTYPE c0 = c00 + t[1] * (c10 - c00);
+            const FPTYPE c1 = c01 + t[1] * (c11 - c01);
+
+            if(grad) {
+                const FPTYPE d00 = v[1]           - v[0];
+                const FPTYPE d10 = v[sy + 1]      - v[sy];
+                const FPTYPE d01 = v[sz + 1]      - v[sz];
+                const FPTYPE d11 = v[sy + sz + 1] - v[sy + sz];
+                const FPTYPE d0 = d00 + t[1] * (d10 - d00);
+                const FPTYPE d1 = d01 + t[1] * (d11 - d01);
+                grad[0] = (d0 + t[2] * (d1 - d0)) * ispacing;
+                grad[1] = ((c10 - c00) + t[2] * ((c11 - c01) - (c10 - c00))) * ispacing;
+                grad[2] = (c1 - c0) * ispacing;
+            }
+
+            return c0 + t[2] * (c1 - c0);
+        }
+
+        /**
+         * @brief Get the signed distance at a position
+         * 
+         * @param position global position
+         */
+        FPTYPE distance(const FVector3 &position) const;
+
+        /**
+         * @brief Get the unit normal of the wall at a position, pointing into the simulation domain
+         * 
+         * @param position global position
+         */
+        FVector3 normal(const FVector3 &position) const;
+
+        /**
+         * @brief Get the largest signed distance at which any particle interacts with the wall; 
+         * negative when the boundary has no potentials. 
+         */
+        FPTYPE range() const;
+
+        /**
+         * @brief Set the potential of the boundary for a particle type
+         * 
+         * @param ptype particle type
+         * @param pot potential
+         */
+        HRESULT set_potential(struct ParticleType *ptype, struct Potential *pot);
+
+        /**
+         * @brief Remove the boundary from the simulation and destroy it
+         */
+        HRESULT destroy();
+
+        /**
+         * @brief Create a boundary from samples of a signed distance field
+         * 
+         * @param origin position of the first sample
+         * @param spacing distance between samples
+         * @param shape number of samples along each direction; at least 2
+         * @param values signed distance at each sample, with the first index varying fastest
+         * @param name name of the boundary
+         * @return new boundary, or NULL on failure
+         */
+        static BoundarySDF *create(
+            const FVector3 &origin, 
+            const FPTYPE &spacing, 
+            const iVector3 &shape, 
+            const std::vector<FPTYPE> &values, 
+            const std::string &name="sdf"
+        );
+
+        /**
+         * @brief Create a boundary from a closed triangle mesh. 
+         * 
+         * The wall is the interior of the mesh, or its exterior when inverted. 
+         * Distances are computed exactly within a band about the mesh surface, 
+         * and are propagated between neighboring samples beyond it. 
+         * The band should be no smaller than the range of the potentials of the boundary. 
+         * 
+         * @param vertices mesh vertex positions
+         * @param triangles vertex indices of each mesh triangle
+         * @param spacing distance between samples
+         * @param band width of the band of exact distances; larger than the sample spacing
+         * @param invert flag to make the exterior of the mesh the wall
+         * @param name name of the boundary
+         * @return new boundary, or NULL on failure
+         */
+        static BoundarySDF *fromMesh(
+            const std::vector<FVector3> &vertices, 
+            const std::vector<iVector3> &triangles, 
+            const FPTYPE &spacing, 
+            const FPTYPE &band, 
+            const bool &invert=false, 
+            const std::string &name="sdf"
+        );
+
+        /**
+         * @brief Get all boundaries of the simulation
+         */
+        static std::vector<BoundarySDF*> all();
+
+        ~BoundarySDF();
+
+    private:
+
+        FPTYPE ispacing;
+        std::string _name;
+        std::vector<struct Potential*> _potentials;
+
+        BoundarySDF() {}
+    };
+
+    /**
+     * @brief Flag the cells of the space that are near a boundary of arbitrary geometry. 
+     * 
+     * Must be called whenever boundaries, their potentials, or the cells of the space change. 
+     * 
+     * @param s The #space. 
+     * @param sdfs boundaries
+     */
+    HRESULT boundary_sdf_flag_cells(struct space *s, const std::vector<BoundarySDF*> &sdfs);
+
     struct CAPI_EXPORT BoundaryConditionsArgsContainer {
         int *bcValue;
         std::unordered_map<std::string, unsigned int> *bcVals;
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <thread>
 #include <set>
+#include <vector>
 
 
 #define engine_bonds_chunk               100
@@ -47,6 +48,9 @@
 #define engine_maxgpu                    10
 #define engine_pshake_steps              20
 #define engine_maxKcutoff                2
+#define engine_regrid_occupancy          8
+#define engine_regrid_tolerance          0.25
+#define engine_regrid_cellsperrunner     4
 
 #define engine_split_MPI		1
 #define engine_split_GPU		2
@@ -88,7 +92,9 @@ namespace TissueForge {
 
 	enum EngineIntegrator {
 		FORWARD_EULER,
-		RUNGE_KUTTA_4
+		RUNGE_KUTTA_4,
+		VELOCITY_VERLET,
+		BAOAB
 	};
 
 	/** Timmer IDs. */
@@ -152,7 +158,13 @@ namespace TissueForge {
 		INTEGRATOR_UPDATE_PERSISTENTFORCE    = 1 << 0, 
 
 		// intermediate flux values are being calculated between time steps
-		INTEGRATOR_FLUX_SUBSTEP 			 = 1 << 1
+		INTEGRATOR_FLUX_SUBSTEP 			 = 1 << 1, 
+
+		// all flux substeps of the current step were integrated from the flux stencil
+		INTEGRATOR_FLUX_STENCIL 			 = 1 << 2, 
+
+		// subengines have started the current step and have not yet been joined
+		INTEGRATOR_SUBENGINES_PENDING 		 = 1 << 3
 	};
 
 
@@ -185,6 +197,25 @@ namespace TissueForge {
 
 		FPTYPE temperature;
 
+		/** Friction coefficient of the BAOAB Langevin integrator */
+		FPTYPE langevin_friction;
+
+		/** 
+		 * Number of inner steps per step of the velocity-Verlet integrator, 
+		 * during which bonded forces are evaluated. Nonbonded forces are evaluated once per step. 
+		 * Disabled when less than two. 
+		 */
+		int respa_steps;
+
+		/** Total energy when drift tracking began */
+		FPTYPE energy_ref;
+
+		/** Drift of total energy since energy_ref, relative to the larger of |energy_ref| and one */
+		FPTYPE energy_drift;
+
+		/** Step when drift tracking began; negative when not tracking */
+		long energy_ref_time;
+
 		// Boltzmann constant
 		FPTYPE K;
 
@@ -215,6 +246,9 @@ namespace TissueForge {
 		int step_flux = 0;
 		FPTYPE dt_flux;
 
+		/** Integrator of flux substeps, one of #FluxIntegrator. */
+		int flux_integrator = 0;
+
 		/** Mutexes, conditions and counters for the barrier */
 		pthread_mutex_t barrier_mutex;
 		pthread_cond_t barrier_cond;
@@ -238,8 +272,38 @@ namespace TissueForge {
 		/** Lists of cells to exchange with other nodes. */
 		struct engine_comm *send, *recv;
 
-		/** Recycled particle ids */
-		std::set<unsigned int> pids_avail;
+		/** Recycled particle ids, most recently freed last */
+		std::vector<int> pids_avail;
+
+		/** End of the particle ids reserved by engine_next_partid_range */
+		int pids_reserved;
+
+		/** 
+		 * Period, in steps, of renumbering particles by cell. Disabled when not positive. 
+		 * 
+		 * Renumbering changes particle ids; see engine_renumber_parts for which references are updated. 
+		 */
+		int renumber_period;
+
+		/** 
+		 * Fraction of recycled ids among all issued particle ids above which 
+		 * particles are renumbered at the end of a step. Disabled when not positive. 
+		 * 
+		 * Renumbering changes particle ids; see engine_renumber_parts for which references are updated. 
+		 */
+		FPTYPE pids_compaction;
+
+		/** Period, in steps, of re-sizing the grid of cells to the particle density. Disabled when not positive. */
+		int regrid_period;
+
+		/** Target mean number of particles per cell, as seen by a particle, when sizing the grid of cells. */
+		FPTYPE regrid_occupancy;
+
+		/** Step of the last check for re-sizing the grid of cells; negative if never checked. */
+		long regrid_time;
+
+		/** Number of empty layers of cells kept between the particles and each non-periodic face of the domain. Disabled when not positive. */
+		int expand_margin;
 
 		/** List of bonds. */
 		struct Bond *bonds;
@@ -263,6 +327,9 @@ namespace TissueForge {
 		// mutex for anything that modifies the *number* of bonds.
 		std::mutex bonds_mutex;
 
+		/** Ids of the active bonds of each particle, indexed by particle id */
+		std::vector<std::vector<int32_t> > part_bonds;
+
 		/** List of exclusions. */
 		struct exclusion *exclusions;
 
@@ -298,6 +365,9 @@ namespace TissueForge {
 		/** Allocated size of angles array */
 		int angles_size;
 
+		/** Ids of the active angles of each particle, indexed by particle id */
+		std::vector<std::vector<int32_t> > part_angles;
+
 		/** List of dihedrals. */
 		struct Dihedral *dihedrals;
 
@@ -315,6 +385,9 @@ namespace TissueForge {
 		/** Allocated size of dihedrals array */
 		int dihedrals_size;
 
+		/** Ids of the active dihedrals of each particle, indexed by particle id */
+		std::vector<std::vector<int32_t> > part_dihedrals;
+
 		/** The Comm object for mpi. */
 	#ifdef WITH_MPI
 		MPI_Comm comm;
@@ -403,6 +476,12 @@ namespace TissueForge {
 
 		BoundaryConditions boundary_conditions;
 
+		/**
+		 * @brief Boundaries of arbitrary geometry, owned by the engine.
+		 * 
+		 */
+		std::vector<BoundarySDF*> boundary_sdfs;
+
 		/**
 		 * @brief Borrowed references to registered subengines.
 		 * 
@@ -634,6 +713,56 @@ namespace TissueForge {
 	 */
 	int engine_bond_alloc (struct engine *e, struct Bond **result);
 
+	/**
+	 * @brief Allocates a batch of new bonds, reusing deleted bonds first 
+	 * and growing the bonds array at most once. 
+	 * 
+	 * @param e engine
+	 * @param nr number of bonds to allocate
+	 * @param ids ids of the allocated bonds; must hold at least @p nr entries
+	 */
+	HRESULT engine_bond_alloc_n(struct engine *e, int nr, int32_t *ids);
+
+	/**
+	 * @brief Add an active bond to the per-particle bond index. 
+	 * 
+	 * Called when a bond becomes active, after its particles are assigned. 
+	 */
+	CAPI_FUNC(HRESULT) engine_bond_index_add(struct engine *e, int bid);
+
+	/**
+	 * @brief Remove an active bond from the per-particle bond index. 
+	 * 
+	 * Called when a bond is destroyed, before its data is cleared. 
+	 */
+	CAPI_FUNC(HRESULT) engine_bond_index_remove(struct engine *e, int bid);
+
+	/**
+	 * @brief Add an active angle to the per-particle angle index. 
+	 */
+	CAPI_FUNC(HRESULT) engine_angle_index_add(struct engine *e, int aid);
+
+	/**
+	 * @brief Remove an active angle from the per-particle angle index. 
+	 */
+	CAPI_FUNC(HRESULT) engine_angle_index_remove(struct engine *e, int aid);
+
+	/**
+	 * @brief Add an active dihedral to the per-particle dihedral index. 
+	 */
+	CAPI_FUNC(HRESULT) engine_dihedral_index_add(struct engine *e, int did);
+
+	/**
+	 * @brief Remove an active dihedral from the per-particle dihedral index. 
+	 */
+	CAPI_FUNC(HRESULT) engine_dihedral_index_remove(struct engine *e, int did);
+
+	/**
+	 * @brief Rebuild the per-particle bond, angle and dihedral indices 
+	 * from the active bonded interactions. 
+	 */
+	CAPI_FUNC(HRESULT) engine_bonded_index_rebuild(struct engine *e);
+
 	/**
 	 * External C apps should call this to get a particle type ptr.
 	 */
@@ -668,6 +797,9 @@ namespace TissueForge {
 	/**
 	 * @brief Add parts to space at given coordinates.
 	 * 
+	 * Particles with a negative id are assigned ids from one range reserved 
+	 * with engine_next_partid_range. 
+	 * 
 	 * @param e The #engine.
 	 * @param nr_parts Number of parts to add
 	 * @param parts pointers to newly allocated particles
@@ -894,6 +1026,32 @@ namespace TissueForge {
 	 */
 	CAPI_FUNC(HRESULT) engine_step(struct engine *e);
 
+	/**
+	 * @brief Relax the particles to a local minimum of potential energy
+	 * with the FIRE algorithm.
+	 *
+	 * Each iteration evaluates the same forces as a time step, including bonded
+	 * interactions and subengines, and treats all particles as Newtonian.
+	 * Time does not advance, fluxes are not evaluated,
+	 * and particle velocities are zero on return.
+	 * Not supported with CUDA, MPI or Verlet lists.
+	 *
+	 * @param e The #engine on which to run.
+	 * @param ftol convergence tolerance on the magnitude of the force on any particle
+	 * @param etol convergence tolerance on the relative change in potential energy of an iteration; disabled when zero
+	 * @param max_steps maximum number of iterations
+	 * @param dt_max maximum time step of an iteration; ten times the engine time step when non-positive
+	 * @param nr_steps number of iterations performed until convergence, or -1 when not converged; ignored when NULL
+	 */
+	CAPI_FUNC(HRESULT) engine_minimize(
+		struct engine *e, 
+		FPTYPE ftol, 
+		FPTYPE etol, 
+		int max_steps, 
+		FPTYPE dt_max, 
+		int *nr_steps
+	);
+
 	/**
 	 * @brief Set all the engine timers to 0.
 	 *
@@ -1001,6 +1159,72 @@ namespace TissueForge {
 	 */
 	CAPI_FUNC(HRESULT) engine_verlet_update(struct engine *e);
 
+	/**
+	 * @brief Reserve storage for a total number of particles, 
+	 * so that adding up to that many particles does not reallocate. 
+	 * 
+	 * @param e The #engine.
+	 * @param nr_parts total number of particles
+	 */
+	CAPI_FUNC(HRESULT) engine_reserve_parts(struct engine *e, unsigned int nr_parts);
+
+	/**
+	 * @brief Suggest dimensions in cells of the grid of the space for the current particles. 
+	 * 
+	 * Cells are sized to hold #regrid_occupancy particles at the density seen by a particle, 
+	 * and no smaller than the cutoff. Cells are refined when there are too few for the runners to share. 
+	 * 
+	 * @param e The #engine.
+	 * @param cdim suggested dimensions in cells
+	 */
+	CAPI_FUNC(HRESULT) engine_regrid_suggest(struct engine *e, int *cdim);
+
+	/**
+	 * @brief Replace the grid of the space with a grid of the given dimensions in cells. 
+	 * 
+	 * Particles are moved to the new cells, and the tasks and queues are rebuilt. 
+	 * Must only be called between steps. Not supported with CUDA or MPI. 
+	 * 
+	 * @param e The #engine.
+	 * @param cdim dimensions in cells
+	 */
+	CAPI_FUNC(HRESULT) engine_regrid(struct engine *e, const int *cdim);
+
+	/**
+	 * @brief Re-size the grid of the space to the current particles, when the suggested 
+	 * number of cells differs from the current number by more than #engine_regrid_tolerance. 
+	 * 
+	 * Does nothing with CUDA or MPI. 
+	 * 
+	 * @param e The #engine.
+	 * @param force re-size to the suggested grid whenever it differs from the current grid
+	 */
+	CAPI_FUNC(HRESULT) engine_regrid_auto(struct engine *e, bool force);
+
+	/**
+	 * @brief Add or remove layers of cells on the faces of the domain. 
+	 * 
+	 * Particles keep their global positions, and the tasks and queues are rebuilt. 
+	 * Boundary conditions move with the faces of the domain. 
+	 * Must only be called between steps. Not supported with CUDA or MPI. 
+	 * 
+	 * @param e The #engine.
+	 * @param lower number of layers to add to each lower face; negative to remove layers
+	 * @param upper number of layers to add to each upper face; negative to remove layers
+	 */
+	CAPI_FUNC(HRESULT) engine_expand(struct engine *e, const int *lower, const int *upper);
+
+	/**
+	 * @brief Grow or shrink the domain along its non-periodic dimensions to keep 
+	 * between #expand_margin and twice #expand_margin empty layers of cells 
+	 * between the particles and each face. 
+	 * 
+	 * Does nothing when #expand_margin is not positive, or with CUDA or MPI. 
+	 * 
+	 * @param e The #engine.
+	 */
+	CAPI_FUNC(HRESULT) engine_expand_auto(struct engine *e);
+
 	/**
 	 * gets the next available particle id to use when creating a new particle.
 	 */
@@ -1008,9 +1232,31 @@ namespace TissueForge {
 
 	/**
 	 * gets the next available particle ids to use when creating a new particle.
+	 * 
+	 * Recycled ids are used first, and the remainder is reserved with engine_next_partid_range. 
 	 */
 	CAPI_FUNC(HRESULT) engine_next_partids(struct engine *e, int nr_ids, int *ids);
 
+	/**
+	 * @brief Gets a contiguous range of new particle ids, without recycling ids. 
+	 * 
+	 * The range is reserved, so that later requests for ids do not return it 
+	 * before its particles are added. 
+	 * Particle storage is reserved for the whole range. 
+	 * 
+	 * @param e The #engine.
+	 * @param nr_ids number of ids
+	 * @param first first id of the range
+	 */
+	CAPI_FUNC(HRESULT) engine_next_partid_range(struct engine *e, int nr_ids, int *first);
+
+	/**
+	 * @brief Gets the number of particle ids issued, including recycled and reserved ids. 
+	 * 
+	 * All particle ids are less than this number. 
+	 */
+	CAPI_FUNC(int) engine_partid_end(struct engine *e);
+
 	/**
 	 * internal method to clear data before calculating forces on all objects
 	 */
@@ -1021,6 +1267,14 @@ namespace TissueForge {
 	 */
 	HRESULT engine_force(struct engine *e);
 
+	/**
+	 * internal method to join subengines that started the current step. 
+	 * 
+	 * Subengines work concurrently with the evaluation of particle forces 
+	 * until joined, which occurs once per step and before integration.
+	 */
+	HRESULT engine_subengines_join(struct engine *e);
+
 	/**
 	 * Deletes a particle from the engine based on particle id.
 	 *
@@ -1031,6 +1285,18 @@ namespace TissueForge {
 	 */
 	CAPI_FUNC(HRESULT) engine_del_particle(struct engine *e, int pid);
 
+	/**
+	 * Renumbers all particles in the order of the cells of the space. 
+	 *
+	 * Afterwards, particle ids are contiguous, and bonds, angles, dihedrals, 
+	 * exclusions, clusters, type lists, particle handles allocated with new 
+	 * (including all handles held by the language interfaces), custom forces 
+	 * and registered subengines refer to the new ids. 
+	 * Particle ids, particle handles held by value and particle lists held elsewhere 
+	 * are not updated and refer to other particles afterwards. 
+	 */
+	CAPI_FUNC(HRESULT) engine_renumber_parts(struct engine *e);
+
 	// keep track of how frequently step is called, get average
 	// steps per second, averaged over past 10 steps.
 	CAPI_FUNC(FPTYPE) engine_steps_per_second();
@@ -1044,6 +1310,26 @@ namespace TissueForge {
 
 	CAPI_FUNC(FPTYPE) engine_temperature(struct engine *e);
 
+	/**
+	 * @brief Get the relative drift of total energy since tracking began. 
+	 * 
+	 * Total energy is the kinetic energy at the beginning of a step 
+	 * plus the potential energy evaluated during the step. 
+	 * The change in total energy is divided by the magnitude of the reference energy, 
+	 * or by one when the reference energy is smaller than one in magnitude, 
+	 * in which case the drift is the absolute change. 
+	 * 
+	 * @param e The #engine.
+	 */
+	CAPI_FUNC(FPTYPE) engine_energy_drift(struct engine *e);
+
+	/**
+	 * @brief Restart tracking of total energy drift at the next step. 
+	 * 
+	 * @param e The #engine.
+	 */
+	CAPI_FUNC(HRESULT) engine_energy_drift_reset(struct engine *e);
+
 	#ifdef WITH_MPI
 
 	/**
@@ -42,6 +42,13 @@ namespace TissueForge {
         FLUX_UPTAKE = 2
     };
 
+    enum FluxIntegrator {
+        FLUX_INTEGRATOR_EXPLICIT = 0,       // explicit Euler, clipped at zero
+        FLUX_INTEGRATOR_SEMIIMPLICIT = 1    // implicit in the consumption of each species
+    };
+
+    struct engine;
+
 
     // keep track of the ids of the particle types, to determine
     // the reaction direction.
@@ -288,6 +295,20 @@ namespace TissueForge {
      */
     HRESULT Fluxes_integrate(int cellId);
 
+    /**
+     * cache the pairwise flux stencil of all real cells.
+     * 
+     * the stencil lists, for every particle, the neighbors within the cutoff 
+     * with which it shares fluxes, and the kernel weights of those fluxes. 
+     * it remains valid as long as particles do not move. 
+     */
+    HRESULT Fluxes_stencil_build(struct engine *e);
+
+    /**
+     * evaluate and integrate one flux substep from the cached flux stencil.
+     */
+    HRESULT Fluxes_stencil_step(struct engine *e, FPTYPE dt);
+
 
 };
 
@@ -31,6 +31,7 @@
 #include <io/tf_io.h>
 
 #include <limits>
+#include <vector>
 
 
 namespace TissueForge { 
@@ -214,6 +215,13 @@ namespace TissueForge {
         virtual void onTime(FPTYPE time);
 
         virtual FVector3 getValue();
+
+        /**
+         * notify this user force object that particles were renumbered. 
+         * 
+         * @param newIds new id of each particle by old id; -1 for unused ids
+         */
+        virtual HRESULT renumberParticles(const std::vector<int> &newIds) { return S_OK; }
         
         /**
          * sets the value of the force to a vector
@@ -309,6 +309,11 @@ namespace TissueForge {
      * from cell to cell.
      * 
      * This is a safe way to work with a particle. 
+     * 
+     * Handles allocated with new, which include all handles of the particles 
+     * and all handles held by the language interfaces, are tracked by the engine 
+     * and continue to refer to their particle when particles are renumbered. 
+     * Handles held by value are not updated when particles are renumbered. 
      */
     struct CAPI_EXPORT ParticleHandle {
         /** Particle id */
@@ -336,6 +341,9 @@ namespace TissueForge {
         ParticleHandle() : id(0) {}
         ParticleHandle(const int &id) : id(id) {}
 
+        static void *operator new(size_t size);
+        static void operator delete(void *ptr);
+
         virtual std::string str() const;
 
         virtual ParticleHandle* fission();
@@ -1081,6 +1089,13 @@ namespace TissueForge {
      */
     CAPI_FUNC(Particle*) Particle_Get(ParticleHandle *pypart);
 
+    /**
+     * Updates the id of all tracked particle handles after particles are renumbered. 
+     * 
+     * @param newIds new id of each particle by old id; -1 for unused ids
+     */
+    CPPAPI_FUNC(HRESULT) Particle_RenumberHandles(const std::vector<int> &newIds);
+
 
     ParticleHandle* Particle_split(
         Particle* self,
@@ -29,6 +29,7 @@
 #include <io/tf_io.h>
 #include <types/tf_types.h>
 
+#include <unordered_map>
 #include <vector>
 
 
@@ -54,10 +55,24 @@ namespace TissueForge {
         int32_t nr_parts;
         int32_t size_parts;
         uint16_t flags;
+
+        /** 
+         * Slot index, the position of each particle id in parts. 
+         * Built on demand by lookups of large lists and maintained by insertion and removal. 
+         * Its size follows the size of the list, not the largest particle id. 
+         */
+        std::unordered_map<int32_t, int32_t> *slots;
         
         // frees the memory associated with the parts list.
         void free();
 
+        /**
+         * @brief Discard the slot index. 
+         * 
+         * Must be called after modifying parts directly. 
+         */
+        void resetIndex();
+
         /**
          * @brief Reserve enough storage for a given number of items.
          * 
@@ -92,6 +107,13 @@ namespace TissueForge {
          */
         uint16_t extend(const ParticleList &other);
 
+        /**
+         * @brief inserts a batch of ids
+         * 
+         * @param ids ids to insert
+         */
+        uint16_t extend(const std::vector<int32_t> &ids);
+
         /** Test whether the list has an id */
         bool has(const int32_t &pid);
 
@@ -40,6 +40,9 @@
 /** Maximum number of interactions per particle in the Verlet list. */
 #define space_verlet_maxpairs           800
 
+/** Maximum number of levels of the large particle grid. */
+#define space_largegrid_maxlevels       8
+
 /* some useful macros */
 /** Converts the index triplet (@c i, @c j, @c k) to the cell id in the
     #space @c s. */
@@ -70,6 +73,13 @@ namespace TissueForge {
         SPACE_FREESLIP_FULL       = (1 << 6) | (1 << 7) | (1 << 8),
     };
 
+    /** Orderings of the traversal of cells. */
+    enum SpaceCellOrder {
+        space_cellorder_rowmajor  = 0,
+        space_cellorder_morton,
+        space_cellorder_hilbert
+    };
+
 
     /** Struct for Verlet list entries. */
     struct verlet_entry {
@@ -121,6 +131,40 @@ namespace TissueForge {
 
     };
 
+    /** A level of the large particle grid. */
+    struct space_largegrid_level {
+
+        /** Cell edge lengths and their inverse. */
+        FPTYPE h[3], ih[3];
+
+        /** Level dimension in cells. */
+        int cdim[3];
+
+        /** Offset of each cell into the list of particle indices, with one more entry than cells. */
+        std::vector<int> offsets;
+
+        /** Indices of particles in the large particle cell, sorted by cell. */
+        std::vector<int> parts;
+
+    };
+
+    /**
+     * @brief Hierarchical grid of large particles. 
+     * 
+     * Large particles are binned into levels by their interaction range. 
+     * Each level is a uniform grid with cells no smaller than the interaction range 
+     * of its particles, so that a particle only visits neighboring cells of each level. 
+     */
+    struct space_largegrid {
+
+        /** Number of levels. */
+        int nr_levels;
+
+        /** Levels of the grid, from shortest to longest range. */
+        struct space_largegrid_level levels[space_largegrid_maxlevels];
+
+    };
+
     /**
      * The space structure
      */
@@ -156,12 +200,21 @@ namespace TissueForge {
         /** Array of cells spanning the space. */
         struct space_cell *cells;
 
+        /** Ordering of the lists of cell ids and of the tasks, one of #SpaceCellOrder. */
+        int cellorder;
+
         /** The total number of tasks. */
         int nr_tasks, tasks_size;
 
         /** Array of tasks. */
         struct task *tasks;
 
+        /** 
+         * Generation of the cells and tasks, which changes whenever cells or tasks 
+         * are rebuilt or reordered. Unique among all spaces. 
+         */
+        unsigned int generation;
+
         /** Condition/mutex to signal task availability. */
         pthread_mutex_t tasks_mutex;
         pthread_cond_t tasks_avail;
@@ -181,6 +234,9 @@ namespace TissueForge {
         /** store the large particles in the large parts cell, its special */
         space_cell largeparts;
 
+        /** Grid of the large particles, rebuilt every step. */
+        struct space_largegrid largegrid;
+
         /** Array of pointers to the #cell of individual parts, sorted by their ID. */
         struct space_cell **celllist;
 
@@ -271,6 +327,34 @@ namespace TissueForge {
         const struct BoundaryConditions *bc
     );
 
+    /**
+     * @brief Replace the cells of a space with a grid of the given dimensions in cells. 
+     * 
+     * Particles are moved to the cells of the new grid by their global positions, 
+     * and the tasks over the cells are regenerated. 
+     * The ordering of the traversal of cells is preserved. 
+     * 
+     * @param s The #space. 
+     * @param cdim Dimensions in cells; each must be at least 1, or 3 when periodic. 
+     * @param bc The boundary conditions. 
+     */
+    CAPI_FUNC(HRESULT) space_regrid(struct space *s, const int *cdim, const struct BoundaryConditions *bc);
+
+    /**
+     * @brief Add or remove layers of cells on the faces of a space.
+     *
+     * Cells keep their dimensions, and the origin of the space moves with its lower faces.
+     * Particles keep their global positions, and the tasks over the cells are regenerated.
+     * Layers can only be added or removed along non-periodic dimensions,
+     * and only layers without particles can be removed.
+     *
+     * @param s The #space.
+     * @param lower Number of layers to add to each lower face; negative to remove layers.
+     * @param upper Number of layers to add to each upper face; negative to remove layers.
+     * @param bc The boundary conditions.
+     */
+    CAPI_FUNC(HRESULT) space_resize(struct space *s, const int *lower, const int *upper, const struct BoundaryConditions *bc);
+
     /** 
      * @brief Get the sort-ID and flip the cells if necessary.
      *
@@ -310,11 +394,22 @@ namespace TissueForge {
     /**
      * @brief Grow the parts allocated to a #space
      * 
+     * Storage grows geometrically, so that the allocated size 
+     * increases by at least @p size_incr. 
+     * 
      * @param s The #space on which to operate.
-     * @param size_incr The increment in size.
+     * @param size_incr The minimum increment in size.
      */
     CAPI_FUNC(HRESULT) space_growparts(struct space *s, unsigned int size_incr);
 
+    /**
+     * @brief Reserve parts allocated to a #space
+     * 
+     * @param s The #space on which to operate.
+     * @param size_parts The minimum allocated size.
+     */
+    CAPI_FUNC(HRESULT) space_reserveparts(struct space *s, unsigned int size_parts);
+
     /**
      * @brief Add a #part to a #space at the given coordinates. The given
      * particle p is only used for the attributes, it itself is not added,
@@ -396,6 +491,25 @@ namespace TissueForge {
      */
     CAPI_FUNC(HRESULT) space_prepare(struct space *s);
 
+    /**
+     * @brief Bin the large particles of a space into its large particle grid. 
+     * 
+     * @param s A pointer to the #space.
+     */
+    CAPI_FUNC(HRESULT) space_largegrid_build(struct space *s);
+
+    /**
+     * @brief Order the traversal of the cells of a space. 
+     * 
+     * Cell ids are unchanged. The lists of real, ghost and marked cells and 
+     * the tasks are sorted along a space-filling curve, so that neighbouring 
+     * entries refer to neighbouring cells. 
+     * 
+     * @param s A pointer to the #space.
+     * @param order ordering, one of #SpaceCellOrder
+     */
+    CAPI_FUNC(HRESULT) space_set_cellorder(struct space *s, int order);
+
     /**
      * @brief Get the absolute position of a particle
      *
@@ -69,6 +69,8 @@ namespace TissueForge {
                 cell_periodic_front    = 1 << 15,
                 cell_periodic_back     = 1 << 16,
 
+                cell_flag_sdf          = 1 << 17,
+
                 cell_periodic_x        = cell_periodic_left | cell_periodic_right,
                 cell_periodic_y        = cell_periodic_front | cell_periodic_back,
                 cell_periodic_z        = cell_periodic_top | cell_periodic_bottom,
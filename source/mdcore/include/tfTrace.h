@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * This file is part of mdcore.
+ * Copyright (c) 2022-2024 T.J. Sego
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/**
+ * @file tfTrace.h
+ *
+ * Low-overhead tracing of engine phases, runner tasks, subengines, events and I/O.
+ *
+ * Each thread records timestamped events into its own ring buffer, so recording
+ * never synchronizes between threads. When a buffer is full, its oldest events are overwritten.
+ * The buffer of a thread that exits is reused by the next new thread, so short-lived threads do not accumulate buffers.
+ * When tracing is not active, a traced scope costs a single relaxed atomic load.
+ *
+ * Recorded events can be exported on demand in the Chrome trace event format,
+ * which can be viewed with chrome://tracing or the Perfetto UI.
+ * Starting, stopping, clearing and exporting should only occur between simulation steps.
+ *
+ */
+
+#ifndef _MDCORE_INCLUDE_TFTRACE_H_
+#define _MDCORE_INCLUDE_TFTRACE_H_
+
+#include <tf_port.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+
+namespace TissueForge::trace {
+
+
+    /** Category of a traced event */
+    enum TraceCategory : uint8_t {
+        TRACE_ENGINE = 0,   // engine phases
+        TRACE_RUNNER,       // runner tasks
+        TRACE_BONDED,       // bonded interaction chunks
+        TRACE_SUBENGINE,    // subengine hooks
+        TRACE_EVENT,        // event processing
+        TRACE_IO,           // file I/O
+        TRACE_LAST
+    };
+
+    /** A completed traced event */
+    struct TraceEvent {
+
+        /** Begin and end time, in nanoseconds */
+        uint64_t begin, end;
+
+        /** Name of the event; must have static storage or outlive the trace */
+        const char *name;
+
+        /** Optional event arguments (e.g., cell ids of a runner task); -1 if unused */
+        int32_t arg0, arg1;
+
+        /** Event category */
+        TraceCategory category;
+    };
+
+    /** Default number of events held by each per-thread ring buffer */
+    #define TF_TRACE_CAPACITY_DEFAULT (1 << 16)
+
+    /** Flag signaling that tracing is active. Read through @ref isActive. */
+    CPPAPI_FUNC(std::atomic<bool>) _traceActive;
+
+    /**
+     * @brief Test whether tracing is active
+     */
+    inline bool isActive() { return _traceActive.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the current trace time, in nanoseconds
+     */
+    CPPAPI_FUNC(uint64_t) now();
+
+    /**
+     * @brief Start tracing.
+     *
+     * Previously recorded events are discarded.
+     *
+     * @param capacity number of events held by each per-thread ring buffer
+     * @return HRESULT
+     */
+    CPPAPI_FUNC(HRESULT) start(const unsigned int &capacity=TF_TRACE_CAPACITY_DEFAULT);
+
+    /**
+     * @brief Stop tracing. Recorded events are retained until cleared or tracing restarts.
+     *
+     * @return HRESULT
+     */
+    CPPAPI_FUNC(HRESULT) stop();
+
+    /**
+     * @brief Discard all recorded events
+     *
+     * @return HRESULT
+     */
+    CPPAPI_FUNC(HRESULT) clear();
+
+    /**
+     * @brief Get the number of currently recorded events over all threads
+     */
+    CPPAPI_FUNC(size_t) numEvents();
+
+    /**
+     * @brief Name the calling thread in exported traces
+     *
+     * @param name name of the thread
+     */
+    CPPAPI_FUNC(void) setThreadName(const std::string &name);
+
+    /**
+     * @brief Record a completed event on the calling thread.
+     *
+     * Does nothing when tracing is not active.
+     *
+     * @param category event category
+     * @param name event name
+     * @param begin begin time, from @ref now
+     * @param end end time, from @ref now
+     * @param arg0 first argument; -1 if unused
+     * @param arg1 second argument; -1 if unused
+     */
+    CPPAPI_FUNC(void) record(
+        const TraceCategory &category,
+        const char *name,
+        const uint64_t &begin,
+        const uint64_t &end,
+        const int32_t &arg0=-1,
+        const int32_t &arg1=-1
+    );
+
+    /**
+     * @brief Get recorded events in Chrome trace event JSON format
+     */
+    CPPAPI_FUNC(std::string) toChromeJSON();
+
+    /**
+     * @brief Write recorded events to file in Chrome trace event JSON format
+     *
+     * @param filePath path of the file
+     * @return HRESULT
+     */
+    CPPAPI_FUNC(HRESULT) toFile(const std::string &filePath);
+
+
+    /** Records an event spanning the lifetime of an instance */
+    struct TraceScope {
+
+        TraceScope(const TraceCategory &category, const char *name, const int32_t &arg0=-1, const int32_t &arg1=-1) :
+            name{name}, arg0{arg0}, arg1{arg1}, category{category}, active{isActive()}
+        {
+            if(active)
+                begin = now();
+        }
+
+        ~TraceScope() {
+            if(active)
+                record(category, name, begin, now(), arg0, arg1);
+        }
+
+    private:
+        const char *name;
+        int32_t arg0, arg1;
+        TraceCategory category;
+        bool active;
+        uint64_t begin;
+    };
+
+};
+
+
+#define TF_TRACE_CONCAT_IMPL(a, b) a##b
+#define TF_TRACE_CONCAT(a, b) TF_TRACE_CONCAT_IMPL(a, b)
+
+/** Trace the enclosing scope, with optional integer arguments */
+#define TF_TRACE_SCOPE(category, ...) \
+    TissueForge::trace::TraceScope TF_TRACE_CONCAT(_tf_trace_scope_, __LINE__)(TissueForge::trace::category, __VA_ARGS__)
+
+#endif // _MDCORE_INCLUDE_TFTRACE_H_
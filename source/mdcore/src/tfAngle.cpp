@@ -670,6 +670,8 @@ HRESULT TissueForge::Angle_Destroy(Angle *a) {
                 return error(MDCERR_cuda);
         #endif
 
+        engine_angle_index_remove(&_Engine, a->id);
+
         bzero(a, sizeof(Angle));
         _Engine.nr_active_angles -= 1;
     }
@@ -729,6 +731,7 @@ AngleHandle *TissueForge::Angle::create(Potential *potential, ParticleHandle *p1
     if(angle->i >=0 && angle->j >=0 && angle->k >=0) {
         angle->flags = angle->flags | ANGLE_ACTIVE;
         _Engine.nr_active_angles++;
+        engine_angle_index_add(&_Engine, id);
     }
     
     AngleHandle *handle = new AngleHandle(id);
@@ -932,15 +935,9 @@ AngleHandle::AngleHandle(const int &_id) : id(_id) {
 }
 
 std::vector<int32_t> TissueForge::Angle_IdsForParticle(int32_t pid) {
-    std::vector<int32_t> angles;
-    for (int i = 0; i < _Engine.nr_angles; ++i) {
-        Angle *a = &_Engine.angles[i];
-        if((a->flags & ANGLE_ACTIVE) && (a->i == pid || a->j == pid || a->k == pid)) {
-            assert(i == a->id);
-            angles.push_back(a->id);
-        }
-    }
-    return angles;
+    if(pid < 0 || pid >= _Engine.part_angles.size()) 
+        return {};
+    return _Engine.part_angles[pid];
 }
 
 
@@ -28,6 +28,8 @@
 #include <iostream>
 #include <sstream>
 #include <unordered_set>
+#include <algorithm>
+#include <cmath>
 #include <rendering/tfStyle.h>
 
 /* Include some conditional headers. */
@@ -53,6 +55,7 @@
 #include <tfLogger.h>
 #include <tf_util.h>
 #include <tfError.h>
+#include <tfTaskScheduler.h>
 #include <io/tfFIO.h>
 #include <tf_mdcore_io.h>
 #include <tf_metrics.h>
@@ -583,7 +586,8 @@ HRESULT TissueForge::bond_evalf(struct Bond *bonds, int N, struct engine *e, FPT
     
 }
 
-HRESULT TissueForge::BondHandle::_init(
+static HRESULT Bond_setup(
+    Bond *bond, 
     uint32_t flags, 
     int32_t i, 
     int32_t j, 
@@ -591,16 +595,6 @@ HRESULT TissueForge::BondHandle::_init(
     FPTYPE bond_energy, 
     struct Potential *potential) 
 {
-    // check whether this handle has previously been initialized and return without error if so
-    if (this->id > 0 && _Engine.nr_bonds > 0) return S_OK;
-
-    Bond *bond = NULL;
-    
-    int result = engine_bond_alloc(&_Engine, &bond);
-    
-    if(result < 0) 
-        return error(MDCERR_malloc);
-    
     bond->flags = flags;
     bond->i = i;
     bond->j = j;
@@ -612,13 +606,12 @@ HRESULT TissueForge::BondHandle::_init(
     if(bond->i >= 0 && bond->j >= 0) {
         bond->flags = bond->flags | BOND_ACTIVE;
         _Engine.nr_active_bonds++;
+        engine_bond_index_add(&_Engine, bond->id);
     }
 
     if(potential) {
         bond->potential = potential;
     }
-    
-    this->id = result;
 
     #ifdef HAVE_CUDA
     if(_Engine.bonds_cuda) 
@@ -626,11 +619,34 @@ HRESULT TissueForge::BondHandle::_init(
             return error(MDCERR_cuda);
     #endif
 
-    TF_Log(LOG_TRACE) << "Created bond: " << this->id  << ", i: " << bond->i << ", j: " << bond->j;
+    TF_Log(LOG_TRACE) << "Created bond: " << bond->id  << ", i: " << bond->i << ", j: " << bond->j;
 
     return S_OK;
 }
 
+HRESULT TissueForge::BondHandle::_init(
+    uint32_t flags, 
+    int32_t i, 
+    int32_t j, 
+    FPTYPE half_life, 
+    FPTYPE bond_energy, 
+    struct Potential *potential) 
+{
+    // check whether this handle has previously been initialized and return without error if so
+    if (this->id > 0 && _Engine.nr_bonds > 0) return S_OK;
+
+    Bond *bond = NULL;
+    
+    int result = engine_bond_alloc(&_Engine, &bond);
+    
+    if(result < 0) 
+        return error(MDCERR_malloc);
+    
+    this->id = result;
+
+    return Bond_setup(bond, flags, i, j, half_life, bond_energy, potential);
+}
+
 rendering::Style *TissueForge::Bond::styleDef() {
     return Bond_StylePtr;
 }
@@ -828,53 +844,117 @@ static void make_pairlist(
     FPTYPE cutoff, std::vector<std::pair<ParticleType*, ParticleType*>* > *paircheck_list,
     PairList& pairs) 
 {
-    int i, j;
-    struct Particle *part_i, *part_j;
-    FVector4 dx;
-    FVector4 pix, pjx;
- 
-    /* get the space and cutoff */
-    pix[3] = FPTYPE_ZERO;
-    
-    FPTYPE r2;
-    
-    FPTYPE c2 = cutoff * cutoff;
-    
-    // TODO: more effecient to caclulate everythign in reference frame
-    // of outer particle.
-    
-    /* loop over all particles */
-    for(i = 1 ; i < parts.nr_parts ; i++) {
-        
-        /* get the particle */
-        part_i = _Engine.s.partlist[parts.parts[i]];
-        
-        // global position
-        FPTYPE *oi = _Engine.s.celllist[part_i->id]->origin;
-        pix[0] = part_i->x[0] + oi[0];
-        pix[1] = part_i->x[1] + oi[1];
-        pix[2] = part_i->x[2] + oi[2];
-        
-        /* loop over all other particles */
-        for(j = 0 ; j < i ; j++) {
-            
-            /* get the other particle */
-            part_j = _Engine.s.partlist[parts.parts[j]];
-            
-            // global position
-            FPTYPE *oj = _Engine.s.celllist[part_j->id]->origin;
-            pjx[0] = part_j->x[0] + oj[0];
-            pjx[1] = part_j->x[1] + oj[1];
-            pjx[2] = part_j->x[2] + oj[2];
-            
-            /* get the distance between both particles */
-            r2 = fptype_r2(pix.data(), pjx.data(), dx.data());
-            
-            if(r2 <= c2 && pair_check(paircheck_list, part_i->typeId, part_j->typeId)) {
-                pairs.push_back(Pair{part_i->id,part_j->id});
+    struct space *s = &_Engine.s;
+    const int nr_parts = parts.nr_parts;
+    if(nr_parts < 2 || cutoff <= FPTYPE_ZERO) 
+        return;
+
+    const FPTYPE c2 = cutoff * cutoff;
+
+    // Bin the particles into a temporary grid with cells no smaller than the cutoff
+    const bool periodic[3] = {
+        bool(s->period & space_periodic_x), 
+        bool(s->period & space_periodic_y), 
+        bool(s->period & space_periodic_z)
+    };
+    int cdim[3];
+    for(int k = 0; k < 3; k++) 
+        cdim[k] = std::max(1, (int)(s->dim[k] / cutoff));
+    // keep no more cells than particles for short cutoffs
+    FPTYPE cells_per_part = (FPTYPE)cdim[0] * cdim[1] * cdim[2] / nr_parts;
+    if(cells_per_part > 1.0) {
+        FPTYPE f = std::cbrt(cells_per_part);
+        for(int k = 0; k < 3; k++) 
+            cdim[k] = std::max(1, (int)(cdim[k] / f));
+    }
+    const int nr_cells = cdim[0] * cdim[1] * cdim[2];
+
+    std::vector<FVector3> pos(nr_parts);
+    std::vector<int> part_cell(nr_parts);
+    std::vector<int> cell_start(nr_cells + 1, 0);
+    for(int pi = 0; pi < nr_parts; pi++) {
+        Particle *part = s->partlist[parts.parts[pi]];
+        FPTYPE *o = s->celllist[part->id]->origin;
+        int ci[3];
+        for(int k = 0; k < 3; k++) {
+            pos[pi][k] = part->x[k] + o[k];
+            ci[k] = std::max(0, std::min(cdim[k] - 1, (int)((pos[pi][k] - s->origin[k]) * cdim[k] / s->dim[k])));
+        }
+        part_cell[pi] = celldims_cellid(cdim, ci[0], ci[1], ci[2]);
+        cell_start[part_cell[pi] + 1]++;
+    }
+    for(int cid = 0; cid < nr_cells; cid++) 
+        cell_start[cid + 1] += cell_start[cid];
+    std::vector<int> cell_parts(nr_parts);
+    {
+        std::vector<int> cell_fill(cell_start.begin(), cell_start.end() - 1);
+        for(int pi = 0; pi < nr_parts; pi++) 
+            cell_parts[cell_fill[part_cell[pi]]++] = pi;
+    }
+
+    // Generate candidates per cell in parallel, against this and all greater neighboring cells
+    std::vector<PairList> cell_pairs(nr_cells);
+    auto func = [&](int cid) -> void {
+        const int ci[3] = {cid / (cdim[1] * cdim[2]), (cid / cdim[2]) % cdim[1], cid % cdim[2]};
+
+        int nbs[27];
+        int nr_nbs = 0;
+        for(int di = -1; di <= 1; di++) 
+            for(int dj = -1; dj <= 1; dj++) 
+                for(int dk = -1; dk <= 1; dk++) {
+                    int cj[3] = {ci[0] + di, ci[1] + dj, ci[2] + dk};
+                    bool valid = true;
+                    for(int k = 0; k < 3; k++) {
+                        if(cj[k] < 0 || cj[k] >= cdim[k]) {
+                            if(!periodic[k]) 
+                                valid = false;
+                            cj[k] = (cj[k] + cdim[k]) % cdim[k];
+                        }
+                    }
+                    if(!valid) 
+                        continue;
+                    int nid = celldims_cellid(cdim, cj[0], cj[1], cj[2]);
+                    // small periodic grids wrap onto the same neighbor more than once
+                    if(nid >= cid && std::find(nbs, nbs + nr_nbs, nid) == nbs + nr_nbs) 
+                        nbs[nr_nbs++] = nid;
+                }
+
+        PairList &result = cell_pairs[cid];
+        for(int a = cell_start[cid]; a < cell_start[cid + 1]; a++) {
+            const int pi = cell_parts[a];
+            Particle *part_i = s->partlist[parts.parts[pi]];
+
+            for(int n = 0; n < nr_nbs; n++) {
+                const int nid = nbs[n];
+                for(int b = nid == cid ? a + 1 : cell_start[nid]; b < cell_start[nid + 1]; b++) {
+                    const int pj = cell_parts[b];
+
+                    // minimum image distance
+                    FPTYPE r2 = FPTYPE_ZERO;
+                    for(int k = 0; k < 3; k++) {
+                        FPTYPE dx = pos[pi][k] - pos[pj][k];
+                        if(periodic[k]) 
+                            dx -= s->dim[k] * std::round(dx / s->dim[k]);
+                        r2 += dx * dx;
+                    }
+                    if(r2 > c2) 
+                        continue;
+
+                    Particle *part_j = s->partlist[parts.parts[pj]];
+                    if(pair_check(paircheck_list, part_i->typeId, part_j->typeId)) 
+                        result.push_back(Pair{part_i->id, part_j->id});
+                }
             }
-        } /* loop over all other particles */
-    } /* loop over all particles */
+        }
+    };
+    parallel_for(nr_cells, func);
+
+    size_t nr_pairs = 0;
+    for(auto &cp : cell_pairs) 
+        nr_pairs += cp.size();
+    pairs.reserve(pairs.size() + nr_pairs);
+    for(auto &cp : cell_pairs) 
+        pairs.insert(pairs.end(), cp.begin(), cp.end());
 }
 
 static bool Bond_destroyingAll = false;
@@ -890,6 +970,8 @@ HRESULT TissueForge::Bond_Destroy(struct Bond *b) {
                 return error(MDCERR_cuda);
         #endif
 
+        engine_bond_index_remove(&_Engine, b->id);
+
         // this clears the BOND_ACTIVE flag
         bzero(b, sizeof(Bond));
         _Engine.nr_active_bonds -= 1;
@@ -926,9 +1008,21 @@ std::vector<BondHandle> TissueForge::BondHandle::pairwise(
     std::vector<BondHandle> bonds;
     
     make_pairlist(parts, cutoff, ppairs, pairs);
-    
-    for(auto &pair : pairs) 
-        bonds.emplace_back(pot, pair.i, pair.j, half_life, bond_energy, flags);
+    if(pairs.empty()) 
+        return bonds;
+
+    // allocate all bonds at once
+    std::vector<int32_t> bids(pairs.size());
+    if(engine_bond_alloc_n(&_Engine, bids.size(), bids.data()) != S_OK) {
+        error(MDCERR_malloc);
+        return bonds;
+    }
+
+    bonds.reserve(pairs.size());
+    for(int k = 0; k < pairs.size(); k++) {
+        Bond_setup(&_Engine.bonds[bids[k]], flags, pairs[k].i, pairs[k].j, half_life, bond_energy, pot);
+        bonds.emplace_back(bids[k]);
+    }
     
     return bonds;
 }
@@ -1050,15 +1144,9 @@ HRESULT TissueForge::Bond_Energy (Bond *b, FPTYPE *epot_out) {
 }
 
 std::vector<int32_t> TissueForge::Bond_IdsForParticle(int32_t pid) {
-    std::vector<int32_t> bonds;
-    for (int i = 0; i < _Engine.nr_bonds; ++i) {
-        Bond *b = &_Engine.bonds[i];
-        if((b->flags & BOND_ACTIVE) && (b->i == pid || b->j == pid)) {
-            assert(i == b->id);
-            bonds.push_back(b->id);
-        }
-    }
-    return bonds;
+    if(pid < 0 || pid >= _Engine.part_bonds.size()) 
+        return {};
+    return _Engine.part_bonds[pid];
 }
 
 bool pair_check(std::vector<std::pair<ParticleType*, ParticleType*>* > *pairs, short a_typeid, short b_typeid) {
@@ -19,15 +19,20 @@
 
 #include <tfBoundaryConditions.h>
 #include <tfSpace.h>
+#include <tfSpace_cell.h>
 #include <tfEngine.h>
+#include <tfParticle.h>
+#include <tfPotential.h>
 #include <tfLogger.h>
 #include <tfError.h>
 #include <io/tfFIO.h>
 #include <state/tfStateVector.h>
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 #include <cstring>
+#include <limits>
 #include <unordered_map>
 #include <tf_mdcore_io.h>
 
@@ -219,22 +224,24 @@ static void check_periodicy(BoundaryCondition *low_bc, BoundaryCondition *high_b
 void BoundaryConditions::boundedPosition(FVector3& position) {
     BoundaryConditions& _bc = _Engine.boundary_conditions;
 
+    const FVector3 origin = engine_origin();
     const FVector3 dim = engine_dimensions();
     PeriodicFlags perFlags[] = {space_periodic_x, space_periodic_y, space_periodic_z};
     for(int i = 0; i < 3; i++) {
-        if(position[i] > dim[i]) {
+        const FPTYPE upper = origin[i] + dim[i];
+        if(position[i] > upper) {
             if(_bc.periodic & perFlags[i]) {
-                while(position[i] > dim[i]) 
+                while(position[i] > upper) 
                     position[i] -= dim[i];
             } 
-            else position[i] = dim[i];
+            else position[i] = upper;
         }
-        else if(position[i] < FPTYPE_ZERO) {
+        else if(position[i] < origin[i]) {
             if(_bc.periodic & perFlags[i]) {
-                while(position[i] < FPTYPE_ZERO) 
+                while(position[i] < origin[i]) 
                     position[i] += dim[i];
             } 
-            else position[i] = FPTYPE_ZERO;
+            else position[i] = origin[i];
         }
     }
 }
@@ -732,6 +739,302 @@ void TissueForge::apply_boundary_particle_crossing(
     }
 }
 
+FPTYPE BoundarySDF::distance(const FVector3 &position) const {
+    return interpolate(position.data(), NULL);
+}
+
+FVector3 BoundarySDF::normal(const FVector3 &position) const {
+    FVector3 result;
+    interpolate(position.data(), result.data());
+    const FPTYPE len = result.length();
+    return len > FPTYPE_EPSILON ? result / len : FVector3(0);
+}
+
+FPTYPE BoundarySDF::range() const {
+    FPTYPE result = -1;
+    for(int i = 0; i < engine::nr_types; i++) {
+        Potential *pot = condition.potenntials[i];
+        if(pot) 
+            result = std::max(result, pot->b + engine::types[i].radius + condition.radius);
+    }
+    return result;
+}
+
+HRESULT BoundarySDF::set_potential(struct ParticleType *ptype, struct Potential *pot) {
+    condition.set_potential(ptype, pot);
+    return boundary_sdf_flag_cells(&_Engine.s, _Engine.boundary_sdfs);
+}
+
+HRESULT BoundarySDF::destroy() {
+    auto itr = std::find(_Engine.boundary_sdfs.begin(), _Engine.boundary_sdfs.end(), this);
+    if(itr != _Engine.boundary_sdfs.end()) 
+        _Engine.boundary_sdfs.erase(itr);
+
+    TF_Log(LOG_INFORMATION) << "Destroying boundary " << _name;
+
+    delete this;
+    return boundary_sdf_flag_cells(&_Engine.s, _Engine.boundary_sdfs);
+}
+
+BoundarySDF::~BoundarySDF() {}
+
+BoundarySDF *BoundarySDF::create(
+    const FVector3 &origin, 
+    const FPTYPE &spacing, 
+    const iVector3 &shape, 
+    const std::vector<FPTYPE> &values, 
+    const std::string &name) 
+{
+    if(_Engine.flags & engine_flag_cuda) {
+        tf_error(E_FAIL, "Signed distance field boundaries are not supported with CUDA");
+        return NULL;
+    }
+    if(spacing <= 0) {
+        tf_error(E_FAIL, "Sample spacing must be positive");
+        return NULL;
+    }
+    if(shape[0] < 2 || shape[1] < 2 || shape[2] < 2) {
+        tf_error(E_FAIL, "At least two samples are required along each direction");
+        return NULL;
+    }
+    if(values.size() != (size_t)shape[0] * shape[1] * shape[2]) {
+        tf_error(E_FAIL, "Number of samples does not match the shape");
+        return NULL;
+    }
+
+    BoundarySDF *result = new BoundarySDF();
+    result->origin = origin;
+    result->spacing = spacing;
+    result->ispacing = 1.0 / spacing;
+    result->shape = shape;
+    result->values = values;
+    result->_name = name;
+    result->_potentials = std::vector<Potential*>(engine::max_type, NULL);
+
+    BoundaryCondition &bc = result->condition;
+    bc.kind = BOUNDARY_POTENTIAL;
+    bc.id = -1;
+    bc.velocity = FVector3(0);
+    bc.restore = 1.0;
+    bc.name = result->_name.c_str();
+    bc.normal = FVector3(0);
+    bc.potenntials = result->_potentials.data();
+    bc.radius = 0;
+
+    _Engine.boundary_sdfs.push_back(result);
+
+    TF_Log(LOG_INFORMATION) << "Created boundary " << name << " with " << shape[0] << "x" << shape[1] << "x" << shape[2] << " samples";
+
+    if(boundary_sdf_flag_cells(&_Engine.s, _Engine.boundary_sdfs) != S_OK) {
+        result->destroy();
+        return NULL;
+    }
+
+    return result;
+}
+
+/** Squared distance from a point to a triangle */
+static FPTYPE boundary_sdf_triangle_distance2(const FVector3 &p, const FVector3 &a, const FVector3 &b, const FVector3 &c) {
+    const FVector3 ab = b - a, ac = c - a, ap = p - a;
+    const FPTYPE d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if(d1 <= 0 && d2 <= 0) 
+        return ap.dot();
+
+    const FVector3 bp = p - b;
+    const FPTYPE d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if(d3 >= 0 && d4 <= d3) 
+        return bp.dot();
+
+    const FPTYPE vc = d1 * d4 - d3 * d2;
+    if(vc <= 0 && d1 >= 0 && d3 <= 0) 
+        return (ap - ab * (d1 / (d1 - d3))).dot();
+
+    const FVector3 cp = p - c;
+    const FPTYPE d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if(d6 >= 0 && d5 <= d6) 
+        return cp.dot();
+
+    const FPTYPE vb = d5 * d2 - d1 * d6;
+    if(vb <= 0 && d2 >= 0 && d6 <= 0) 
+        return (ap - ac * (d2 / (d2 - d6))).dot();
+
+    const FPTYPE va = d3 * d6 - d5 * d4;
+    if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) 
+        return (bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))).dot();
+
+    const FPTYPE denom = 1.0 / (va + vb + vc);
+    return (ap - ab * (vb * denom) - ac * (vc * denom)).dot();
+}
+
+BoundarySDF *BoundarySDF::fromMesh(
+    const std::vector<FVector3> &vertices, 
+    const std::vector<iVector3> &triangles, 
+    const FPTYPE &spacing, 
+    const FPTYPE &band, 
+    const bool &invert, 
+    const std::string &name) 
+{
+    if(vertices.empty() || triangles.empty()) {
+        tf_error(E_FAIL, "No mesh given");
+        return NULL;
+    }
+    if(spacing <= 0 || band <= 0) {
+        tf_error(E_FAIL, "Sample spacing and band must be positive");
+        return NULL;
+    }
+    for(auto &t : triangles) 
+        for(int k = 0; k < 3; k++) 
+            if(t[k] < 0 || t[k] >= (int)vertices.size()) {
+                tf_error(E_FAIL, "Invalid mesh vertex index");
+                return NULL;
+            }
+
+    // Grid covering the mesh and its band
+    FVector3 lo = vertices[0], hi = vertices[0];
+    for(auto &v : vertices) 
+        for(int k = 0; k < 3; k++) {
+            lo[k] = std::min(lo[k], v[k]);
+            hi[k] = std::max(hi[k], v[k]);
+        }
+    const FPTYPE pad = band + spacing;
+    const FVector3 origin = lo - FVector3(pad);
+    iVector3 shape;
+    for(int k = 0; k < 3; k++) 
+        shape[k] = std::max(2, (int)std::ceil((hi[k] - lo[k] + 2 * pad) / spacing) + 1);
+    const int sy = shape[0], sz = shape[0] * shape[1];
+
+    // Unsigned distances within the band of each triangle
+    std::vector<FPTYPE> dist2((size_t)sz * shape[2], band * band);
+    for(auto &t : triangles) {
+        const FVector3 &a = vertices[t[0]], &b = vertices[t[1]], &c = vertices[t[2]];
+        int i0[3], i1[3];
+        for(int k = 0; k < 3; k++) {
+            i0[k] = std::max(0, (int)std::floor((std::min({a[k], b[k], c[k]}) - band - origin[k]) / spacing));
+            i1[k] = std::min(shape[k] - 1, (int)std::ceil((std::max({a[k], b[k], c[k]}) + band - origin[k]) / spacing));
+        }
+        for(int k = i0[2]; k <= i1[2]; k++) 
+            for(int j = i0[1]; j <= i1[1]; j++) 
+                for(int i = i0[0]; i <= i1[0]; i++) {
+                    const FVector3 p = origin + FVector3(i, j, k) * spacing;
+                    FPTYPE &d2 = dist2[i + sy * j + sz * k];
+                    d2 = std::min(d2, boundary_sdf_triangle_distance2(p, a, b, c));
+                }
+    }
+
+    // Distances beyond the band, propagated between neighboring samples by two chamfer sweeps, 
+    // so that the field keeps a gradient deep inside and far outside of the wall
+    const FPTYPE dist_far = std::numeric_limits<FPTYPE>::max();
+    std::vector<FPTYPE> dist(dist2.size());
+    for(size_t idx = 0; idx < dist2.size(); idx++) 
+        dist[idx] = dist2[idx] < band * band ? std::sqrt(dist2[idx]) : dist_far;
+
+    if(std::all_of(dist.begin(), dist.end(), [&dist_far](const FPTYPE &d) -> bool { return d == dist_far; })) {
+        tf_error(E_FAIL, "No samples within the band; the band must be wider than the sample spacing");
+        return NULL;
+    }
+
+    auto chamfer_sweep = [&dist, &shape, &sy, &sz, &spacing, &dist_far](const int &dir) -> void {
+        const int kb = dir > 0 ? 0 : shape[2] - 1, ke = dir > 0 ? shape[2] : -1;
+        const int jb = dir > 0 ? 0 : shape[1] - 1, je = dir > 0 ? shape[1] : -1;
+        const int ib = dir > 0 ? 0 : shape[0] - 1, ie = dir > 0 ? shape[0] : -1;
+        for(int k = kb; k != ke; k += dir) 
+            for(int j = jb; j != je; j += dir) 
+                for(int i = ib; i != ie; i += dir) {
+                    FPTYPE &d = dist[i + sy * j + sz * k];
+                    // Neighbors already visited in this sweep
+                    for(int dk = -1; dk <= 0; dk++) 
+                        for(int dj = -1; dj <= (dk < 0 ? 1 : 0); dj++) 
+                            for(int di = -1; di <= (dk < 0 || dj < 0 ? 1 : -1); di++) {
+                                const int ni = i + dir * di, nj = j + dir * dj, nk = k + dir * dk;
+                                if(ni < 0 || ni >= shape[0] || nj < 0 || nj >= shape[1] || nk < 0 || nk >= shape[2]) 
+                                    continue;
+                                const FPTYPE dn = dist[ni + sy * nj + sz * nk];
+                                if(dn < dist_far) 
+                                    d = std::min(d, dn + spacing * std::sqrt(FPTYPE(di * di + dj * dj + dk * dk)));
+                            }
+                }
+    };
+    chamfer_sweep(1);
+    chamfer_sweep(-1);
+
+    // Inside the mesh by the parity of crossings of rays along z, 
+    // slightly offset from the samples to avoid hitting mesh edges
+    const FPTYPE jitter[2] = {FPTYPE(1.0e-4) * spacing * FPTYPE(0.5773502), FPTYPE(1.0e-4) * spacing * FPTYPE(0.3141593)};
+    std::vector<std::vector<FPTYPE> > crossings(sz);
+    for(auto &t : triangles) {
+        const FVector3 &a = vertices[t[0]], &b = vertices[t[1]], &c = vertices[t[2]];
+        int i0[2], i1[2];
+        for(int k = 0; k < 2; k++) {
+            i0[k] = std::max(0, (int)std::floor((std::min({a[k], b[k], c[k]}) - origin[k]) / spacing));
+            i1[k] = std::min(shape[k] - 1, (int)std::ceil((std::max({a[k], b[k], c[k]}) - origin[k]) / spacing));
+        }
+        for(int j = i0[1]; j <= i1[1]; j++) 
+            for(int i = i0[0]; i <= i1[0]; i++) {
+                const FPTYPE px = origin[0] + i * spacing + jitter[0];
+                const FPTYPE py = origin[1] + j * spacing + jitter[1];
+                const FPTYPE w0 = (b[0] - a[0]) * (py - a[1]) - (b[1] - a[1]) * (px - a[0]);
+                const FPTYPE w1 = (c[0] - b[0]) * (py - b[1]) - (c[1] - b[1]) * (px - b[0]);
+                const FPTYPE w2 = (a[0] - c[0]) * (py - c[1]) - (a[1] - c[1]) * (px - c[0]);
+                const FPTYPE area = w0 + w1 + w2;
+                if(area == 0 || w0 * area < 0 || w1 * area < 0 || w2 * area < 0) 
+                    continue;
+                crossings[i + sy * j].push_back((w1 * a[2] + w2 * b[2] + w0 * c[2]) / area);
+            }
+    }
+
+    std::vector<FPTYPE> values(dist2.size());
+    for(int j = 0; j < shape[1]; j++) 
+        for(int i = 0; i < shape[0]; i++) {
+            std::vector<FPTYPE> &zs = crossings[i + sy * j];
+            std::sort(zs.begin(), zs.end());
+            for(int k = 0; k < shape[2]; k++) {
+                const FPTYPE z = origin[2] + k * spacing;
+                const bool inside = (std::lower_bound(zs.begin(), zs.end(), z) - zs.begin()) % 2 == 1;
+                const int idx = i + sy * j + sz * k;
+                values[idx] = (inside != invert ? -1 : 1) * dist[idx];
+            }
+        }
+
+    return create(origin, spacing, shape, values, name);
+}
+
+std::vector<BoundarySDF*> BoundarySDF::all() {
+    return _Engine.boundary_sdfs;
+}
+
+HRESULT TissueForge::boundary_sdf_flag_cells(struct space *s, const std::vector<BoundarySDF*> &sdfs) {
+    if(s == NULL) 
+        return tf_error(E_FAIL, "No space");
+
+    std::vector<FPTYPE> ranges;
+    for(auto &sdf : sdfs) 
+        ranges.push_back(sdf->range());
+
+    const FPTYPE hdiag = 0.5 * std::sqrt(s->h[0] * s->h[0] + s->h[1] * s->h[1] + s->h[2] * s->h[2]);
+    int nr_flagged = 0;
+    for(int cid = 0; cid < s->nr_cells; cid++) {
+        space_cell *c = &s->cells[cid];
+        c->flags &= ~cell_flag_sdf;
+
+        FPTYPE x[3];
+        for(int k = 0; k < 3; k++) 
+            x[k] = c->origin[k] + 0.5 * s->h[k];
+
+        // A cell is near a wall when any of its points may be within range of the wall
+        for(size_t i = 0; i < sdfs.size(); i++) {
+            if(ranges[i] >= 0 && std::abs(sdfs[i]->interpolate(x, NULL)) - hdiag - sdfs[i]->spacing <= ranges[i]) {
+                c->flags |= cell_flag_sdf;
+                nr_flagged++;
+                break;
+            }
+        }
+    }
+
+    TF_Log(LOG_DEBUG) << "Flagged " << nr_flagged << " cells near boundaries";
+
+    return S_OK;
+}
+
 std::string BoundaryConditions::toString() {
     return io::toString(*this);
 }
@@ -788,6 +788,7 @@ DihedralHandle *TissueForge::Dihedral::create(Potential *potential,
     if(dihedral->i >= 0 && dihedral->j >= 0 && dihedral->k >= 0 && dihedral->l >= 0) {
         dihedral->flags |= DIHEDRAL_ACTIVE;
         _Engine.nr_active_dihedrals++;
+        engine_dihedral_index_add(&_Engine, id);
     }
 
     DihedralHandle *handle = new DihedralHandle(id);
@@ -983,6 +984,8 @@ HRESULT TissueForge::Dihedral_Destroy(Dihedral *d) {
     if(!d) return error(MDCERR_null);
 
     if(d->flags & DIHEDRAL_ACTIVE) {
+        engine_dihedral_index_remove(&_Engine, d->id);
+
         bzero(d, sizeof(Dihedral));
         _Engine.nr_active_dihedrals -= 1;
     }
@@ -996,15 +999,9 @@ HRESULT TissueForge::Dihedral_DestroyAll() {
 }
 
 std::vector<int32_t> TissueForge::Dihedral_IdsForParticle(int32_t pid) {
-    std::vector<int32_t> dihedrals;
-    for (int i = 0; i < _Engine.nr_dihedrals; ++i) {
-        Dihedral *d = &_Engine.dihedrals[i];
-        if((d->flags & DIHEDRAL_ACTIVE) && (d->i == pid || d->j == pid || d->k == pid || d->l == pid)) {
-            assert(i == d->id);
-            dihedrals.push_back(d->id);
-        }
-    }
-    return dihedrals;
+    if(pid < 0 || pid >= _Engine.part_dihedrals.size()) 
+        return {};
+    return _Engine.part_dihedrals[pid];
 }
 
 
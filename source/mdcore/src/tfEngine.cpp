@@ -72,6 +72,9 @@
 #include <tfLogger.h>
 #include <tf_util.h>
 #include <tfError.h>
+#include <tfTrace.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #pragma clang diagnostic ignored "-Wwritable-strings"
@@ -1196,6 +1199,30 @@ HRESULT cuda::engine_fromCUDA(struct engine *e) {
 
 #endif
 
+/**
+ * @brief Initialize the queues of an engine and fill them with the tasks of its space. 
+ * 
+ * @param e The #engine.
+ */
+static HRESULT engine_queues_fill(struct engine *e) {
+
+	int i;
+	struct space *s = &e->s;
+
+	for(i = 0 ; i < e->nr_queues ; i++)
+		if(queue_init(&e->queues[i], 2*s->nr_tasks/e->nr_queues, s, s->tasks) != S_OK)
+			return error(MDCERR_queue);
+	/* Tasks ordered along a curve are handed out in contiguous blocks,
+	   so that each queue works on a compact region of space. */
+	for(i = 0 ; i < s->nr_tasks ; i++) {
+		int qid = s->cellorder == space_cellorder_rowmajor ? i % e->nr_queues : (int)((long)i * e->nr_queues / s->nr_tasks);
+		if(queue_insert(&e->queues[ qid ], &s->tasks[i]) < 0)
+			return error(MDCERR_queue);
+	}
+
+	return S_OK;
+}
+
 HRESULT TissueForge::engine_start(struct engine *e, int nr_runners, int nr_queues) {
 
 	int cid, pid, k, i;
@@ -1289,12 +1316,8 @@ HRESULT TissueForge::engine_start(struct engine *e, int nr_runners, int nr_queue
 		e->nr_queues = nr_queues;
 
 		/* Initialize  and fill the queues. */
-		for(i = 0 ; i < e->nr_queues ; i++)
-			if(queue_init(&e->queues[i], 2*s->nr_tasks/e->nr_queues, s, s->tasks) != S_OK)
-				return error(MDCERR_queue);
-		for(i = 0 ; i < s->nr_tasks ; i++)
-			if(queue_insert(&e->queues[ i % e->nr_queues ], &s->tasks[i]) < 0)
-				return error(MDCERR_queue);
+		if(engine_queues_fill(e) != S_OK)
+			return error(MDCERR_queue);
 
 		/* (Allocate the runners */
 				if((e->runners = (struct runner *)malloc(sizeof(struct runner) * nr_runners)) == NULL)
@@ -1323,6 +1346,7 @@ HRESULT TissueForge::engine_start(struct engine *e, int nr_runners, int nr_queue
 HRESULT TissueForge::engine_nonbond_eval(struct engine *e) {
 
 	TF_Log(LOG_TRACE);
+	TF_TRACE_SCOPE(TRACE_ENGINE, "nonbond");
 
 	int k;
 
@@ -1380,28 +1404,64 @@ HRESULT TissueForge::engine_step(struct engine *e) {
 	int i;
     util::WallTime wt;
     util::PerformanceTimer t(engine_timer_step);
+    TF_TRACE_SCOPE(TRACE_ENGINE, "step", (int32_t)(e->time + 1));
     update_steps_per_second();
     
 	/* increase the time stepper */
 	e->time += 1;
 
+	/* Keep empty layers of cells between the particles and the non-periodic faces of the domain. */
+	if(e->expand_margin > 0) {
+		TF_TRACE_SCOPE(TRACE_ENGINE, "expand");
+		if(engine_expand_auto(e) != S_OK) 
+			return error(MDCERR_engine);
+	}
+
+	/* Periodically re-size the grid of cells to the particle density. */
+	if(e->regrid_period > 0 && (e->regrid_time < 0 || e->time - e->regrid_time >= e->regrid_period)) {
+		TF_TRACE_SCOPE(TRACE_ENGINE, "regrid");
+		e->regrid_time = e->time;
+		if(engine_regrid_auto(e, false) != S_OK) 
+			return error(MDCERR_engine);
+	}
+
 	if(engine_force_prep(e) != S_OK) 
 		return error(MDCERR_engine);
 
-	// Pre-step subengines
-	for(auto &se : e->subengines) 
+	// Pre-step subengines; these are joined by the integrator once particle forces are calculated
+	for(auto &se : e->subengines) {
+		TF_TRACE_SCOPE(TRACE_SUBENGINE, se->name);
 		if((i = se->preStepStart()) != S_OK) 
 			return error(MDCERR_subengine);
-	for(auto &se : e->subengines) 
-		if((i = se->preStepJoin()) != S_OK) 
-			return error(MDCERR_subengine);
+	}
+	e->integrator_flags |= INTEGRATOR_SUBENGINES_PENDING;
 
-	if(engine_advance(e) != S_OK) 
-		return error(MDCERR_engine);
+	{
+		TF_TRACE_SCOPE(TRACE_ENGINE, "advance");
+		if(engine_advance(e) != S_OK) 
+			return error(MDCERR_engine);
+	}
+
+	// Join any subengines that the integrator did not
+	if(engine_subengines_join(e) != S_OK) 
+		return error(MDCERR_subengine);
+
+	/* Track the drift of total energy. */
+	FPTYPE energy = e->s.epot;
+	for(i = 0; i < engine::nr_types; i++) 
+		energy += engine::types[i].kinetic_energy;
+	if(e->energy_ref_time < 0) {
+		e->energy_ref = energy;
+		e->energy_ref_time = e->time;
+	}
+	// Absolute when the reference energy is near zero, so that drift stays finite and continuous
+	e->energy_drift = (energy - e->energy_ref) / std::max<FPTYPE>(fabs(e->energy_ref), FPTYPE_ONE);
+	TF_Log(LOG_DEBUG) << "step: " << e->time << ", total energy: " << energy << ", drift: " << e->energy_drift;
 
     /* Shake the particle positions? */
     if(e->nr_rigids > 0) {
         util::PerformanceTimer tr(engine_timer_rigid);
+        TF_TRACE_SCOPE(TRACE_ENGINE, "rigid");
 
 		/* Resolve the constraints. */
 		if(engine_rigid_eval(e) != 0)
@@ -1413,12 +1473,28 @@ HRESULT TissueForge::engine_step(struct engine *e) {
     }
 
 	// Post-step subengines
-	for(auto &se : e->subengines) 
+	for(auto &se : e->subengines) {
+		TF_TRACE_SCOPE(TRACE_SUBENGINE, se->name);
 		if((i = se->postStepStart()) != S_OK) 
 			return error(MDCERR_subengine);
-	for(auto &se : e->subengines) 
+	}
+	for(auto &se : e->subengines) {
+		TF_TRACE_SCOPE(TRACE_SUBENGINE, se->name);
 		if((i = se->postStepJoin()) != S_OK) 
 			return error(MDCERR_subengine);
+	}
+
+	/* Periodically restore the locality of particle ids, or compact them when too many are recycled. */
+	if(e->renumber_period > 0 && e->time % e->renumber_period == 0) {
+		TF_TRACE_SCOPE(TRACE_ENGINE, "renumber");
+		if(engine_renumber_parts(e) != S_OK) 
+			return error(MDCERR_engine);
+	}
+	else if(e->pids_compaction > 0 && e->pids_avail.size() > e->pids_compaction * engine_partid_end(e)) {
+		TF_TRACE_SCOPE(TRACE_ENGINE, "renumber");
+		if(engine_renumber_parts(e) != S_OK) 
+			return error(MDCERR_engine);
+	}
 
 	TF_Log(LOG_TRACE);
 
@@ -1436,13 +1512,19 @@ HRESULT TissueForge::engine_force_prep(struct engine *e) {
 	
     // clear the energy on the types
     // TODO: should go in prepare space for better performance
-    engine_kinetic_energy(e);
+    {
+        TF_TRACE_SCOPE(TRACE_ENGINE, "kinetic");
+        engine_kinetic_energy(e);
+    }
 	e->timers[engine_timer_kinetic] += getticks() - tic;
 
     /* prepare the space, sets forces to zero */
     tic = getticks();
-    if(space_prepare(&e->s) != S_OK)
-        return error(MDCERR_space);
+    {
+        TF_TRACE_SCOPE(TRACE_ENGINE, "prepare");
+        if(space_prepare(&e->s) != S_OK)
+            return error(MDCERR_space);
+    }
     e->timers[engine_timer_prepare] += getticks() - tic;
 
     /* Make sure the verlet lists are up to date. */
@@ -1450,6 +1532,7 @@ HRESULT TissueForge::engine_force_prep(struct engine *e) {
 
         /* Start the clock. */
         tic = getticks();
+        TF_TRACE_SCOPE(TRACE_ENGINE, "verlet");
 
         /* Check particle movement and update cells if necessary. */
         if(engine_verlet_update(e) != S_OK) {
@@ -1465,6 +1548,7 @@ HRESULT TissueForge::engine_force_prep(struct engine *e) {
        node boundaries. */
     else { // if(e->flags & engine_flag_async) {
         tic = getticks();
+        TF_TRACE_SCOPE(TRACE_ENGINE, "shuffle");
         if(engine_shuffle(e) != S_OK) {
             return error(MDCERR_space);
         }
@@ -1549,11 +1633,32 @@ HRESULT TissueForge::engine_force(struct engine *e) {
     }
     e->timers[engine_timer_bonded] += getticks() - tic;
 
+    /* Add forces of subengines that started this step. */
+    if(engine_subengines_join(e) != S_OK) 
+        return error(MDCERR_subengine);
+
 	TF_Log(LOG_TRACE);
 
     return S_OK;
 }
 
+HRESULT TissueForge::engine_subengines_join(struct engine *e) {
+
+    if(!(e->integrator_flags & INTEGRATOR_SUBENGINES_PENDING)) 
+        return S_OK;
+    e->integrator_flags &= ~INTEGRATOR_SUBENGINES_PENDING;
+
+    TF_TRACE_SCOPE(TRACE_ENGINE, "join");
+
+    for(auto &se : e->subengines) {
+        TF_TRACE_SCOPE(TRACE_SUBENGINE, se->name);
+        if(se->preStepJoin() != S_OK) 
+            return error(MDCERR_subengine);
+    }
+
+    return S_OK;
+}
+
 HRESULT TissueForge::engine_barrier(struct engine *e) {
 
 	/* lock the barrier mutex */
@@ -1627,6 +1732,10 @@ HRESULT TissueForge::engine_finalize(struct engine *e) {
 		if((j = se->finalize()) != S_OK) 
 			return error(MDCERR_subengine);
 
+	for(auto &sdf : e->boundary_sdfs) 
+		delete sdf;
+	e->boundary_sdfs.clear();
+
     /* Shut down the runners, if they were started. */
     if(e->runners != NULL) {
         for(k = 0 ; k < e->nr_runners ; k++)
@@ -1737,6 +1846,14 @@ HRESULT TissueForge::engine_init(struct engine *e, const FPTYPE *origin, const F
 
     e->integrator_flags = 0;
 
+	e->renumber_period = 0;
+	e->pids_compaction = 0;
+	e->pids_reserved = 0;
+	e->regrid_period = 0;
+	e->regrid_occupancy = engine_regrid_occupancy;
+	e->regrid_time = -1;
+	e->expand_margin = 0;
+
 	e->nr_fluxsteps = nr_fluxsteps;
 
     /* init the space with the given parameters */
@@ -1805,6 +1922,11 @@ HRESULT TissueForge::engine_init(struct engine *e, const FPTYPE *origin, const F
     e->nr_dihedrals = 0;
 	e->nr_active_dihedrals = 0;
 
+    /* Init the bonded indices. */
+    e->part_bonds.clear();
+    e->part_angles.clear();
+    e->part_dihedrals.clear();
+
 
     /* Init the sets. */
     e->sets = NULL;
@@ -1857,6 +1979,11 @@ HRESULT TissueForge::engine_init(struct engine *e, const FPTYPE *origin, const F
     e->recv = NULL;
 
     e->integrator = EngineIntegrator::FORWARD_EULER;
+    e->langevin_friction = 1.0;
+    e->respa_steps = 1;
+    e->energy_ref = 0.0;
+    e->energy_drift = 0.0;
+    e->energy_ref_time = -1;
 
     e->flags |= engine_flag_initialized;
 
@@ -1924,6 +2051,16 @@ FPTYPE TissueForge::engine_kinetic_energy(struct engine *e)
     return total;
 }
 
+FPTYPE TissueForge::engine_energy_drift(struct engine *e) {
+	return e->energy_drift;
+}
+
+HRESULT TissueForge::engine_energy_drift_reset(struct engine *e) {
+	e->energy_ref_time = -1;
+	e->energy_drift = 0.0;
+	return S_OK;
+}
+
 FPTYPE TissueForge::engine_temperature(struct engine *e)
 {
     return e->temperature;
@@ -1976,6 +2113,20 @@ HRESULT TissueForge::engine_addparts(struct engine *e, int nr_parts, struct Part
 		for(int j = 0; j < num_workers; j++) 
 			type_counts[i] += worker_type_counts[j][i];
 
+	// Assign new ids from one reserved range
+	int nr_new = 0;
+	for(int i = 0; i < nr_parts; i++) 
+		if(parts[i]->id < 0) 
+			nr_new++;
+	if(nr_new > 0) {
+		int pid = 0;
+		if(engine_next_partid_range(e, nr_new, &pid) != S_OK) 
+			return error(MDCERR_engine);
+		for(int i = 0; i < nr_parts; i++) 
+			if(parts[i]->id < 0) 
+				parts[i]->id = pid++;
+	}
+
     // Add parts
 	if(space_addparts (&(e->s), nr_parts, parts, x) != 0) {
         return error(MDCERR_space);
@@ -2008,35 +2159,240 @@ struct ParticleType* TissueForge::engine_type(int id)
     return NULL;
 }
 
+HRESULT TissueForge::engine_reserve_parts(struct engine *e, unsigned int nr_parts)
+{
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(nr_parts <= e->s.size_parts) 
+		return S_OK;
+
+	if(space_reserveparts(&e->s, nr_parts) != S_OK) 
+		return error(MDCERR_space);
+
+	#if defined(HAVE_CUDA)
+		if(e->flags & engine_flag_cuda && cuda::engine_cuda_refresh_particles(e) != S_OK)
+			return error(MDCERR_malloc);
+	#endif
+
+	return S_OK;
+}
+
+/**
+ * @brief Refill the queues with the tasks of a rebuilt space. 
+ * 
+ * @param e The #engine. 
+ */
+static HRESULT engine_queues_refill(struct engine *e) {
+	if(e->queues == NULL) 
+		return S_OK;
+
+	for(int i = 0 ; i < e->nr_queues ; i++) {
+		free(e->queues[i].ind);
+		if(lock_destroy(&e->queues[i].lock) != 0) 
+			return error(MDCERR_lock);
+	}
+	return engine_queues_fill(e);
+}
+
+HRESULT TissueForge::engine_regrid_suggest(struct engine *e, int *cdim) {
+	if(e == NULL || cdim == NULL) 
+		return error(MDCERR_null);
+
+	struct space *s = &e->s;
+	int k, cdim_max[3];
+
+	/* Density as seen by a particle, from the current cells. */
+	FPTYPE nr_parts = 0.0, nr_pairs = 0.0;
+	for(int cid = 0 ; cid < s->nr_real ; cid++) {
+		FPTYPE count = s->cells[s->cid_real[cid]].count;
+		nr_parts += count;
+		nr_pairs += count * count;
+	}
+	FPTYPE density = nr_parts > 0 ? nr_pairs / (nr_parts * s->h[0] * s->h[1] * s->h[2]) : 0.0;
+
+	/* Edge length of cells holding the target occupancy, no smaller than the cutoff. */
+	FPTYPE occupancy = e->regrid_occupancy > 0 ? e->regrid_occupancy : engine_regrid_occupancy;
+	FPTYPE h = density > 0 ? std::cbrt(occupancy / density) : std::max(s->dim[0], std::max(s->dim[1], s->dim[2]));
+	h = std::max(h, s->cutoff);
+	for(k = 0 ; k < 3 ; k++) {
+		cdim_max[k] = std::max(1, (int)std::floor(s->dim[k] / s->cutoff));
+		cdim[k] = std::max(1, std::min(cdim_max[k], (int)std::floor(s->dim[k] / h)));
+	}
+
+	/* Refine the longest cells while there are too few cells for the runners to share. */
+	const int nr_cells_min = engine_regrid_cellsperrunner * std::max(1, e->nr_runners);
+	while(cdim[0] * cdim[1] * cdim[2] < nr_cells_min) {
+		int kmax = -1;
+		for(k = 0 ; k < 3 ; k++) 
+			if(cdim[k] < cdim_max[k] && (kmax < 0 || s->dim[k] / cdim[k] > s->dim[kmax] / cdim[kmax])) 
+				kmax = k;
+		if(kmax < 0) 
+			break;
+		cdim[kmax]++;
+	}
+
+	/* Periodic dimensions need at least three cells. */
+	for(k = 0 ; k < 3 ; k++) 
+		if(s->period & (space_periodic_x << k)) 
+			cdim[k] = std::max(cdim[k], 3);
+
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_regrid(struct engine *e, const int *cdim) {
+	if(e == NULL || cdim == NULL) 
+		return error(MDCERR_null);
+	if(e->flags & (engine_flag_cuda | engine_flag_mpi)) 
+		return error(MDCERR_nyi);
+
+	TF_Log(LOG_INFORMATION) << "engine: regridding from cell dimensions = [" << e->s.cdim[0] << ", " << e->s.cdim[1] << ", " << e->s.cdim[2] << "] to [" << cdim[0] << ", " << cdim[1] << ", " << cdim[2] << "]";
+
+	if(space_regrid(&e->s, cdim, &e->boundary_conditions) != S_OK || 
+		boundary_sdf_flag_cells(&e->s, e->boundary_sdfs) != S_OK) 
+		return error(MDCERR_space);
+
+	if(engine_queues_refill(e) != S_OK) 
+		return error(MDCERR_queue);
+
+	TF_Log(LOG_INFORMATION) << "engine: n_cells: " << e->s.nr_cells << ", nr tasks: " << e->s.nr_tasks;
+
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_regrid_auto(struct engine *e, bool force) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(e->flags & (engine_flag_cuda | engine_flag_mpi)) 
+		return S_OK;
+
+	int cdim[3];
+	if(engine_regrid_suggest(e, cdim) != S_OK) 
+		return error(MDCERR_engine);
+
+	const int nr_cells = cdim[0] * cdim[1] * cdim[2];
+	if(cdim[0] == e->s.cdim[0] && cdim[1] == e->s.cdim[1] && cdim[2] == e->s.cdim[2]) 
+		return S_OK;
+	if(!force && std::abs(nr_cells - e->s.nr_cells) <= engine_regrid_tolerance * e->s.nr_cells) 
+		return S_OK;
+
+	return engine_regrid(e, cdim);
+}
+
+HRESULT TissueForge::engine_expand(struct engine *e, const int *lower, const int *upper) {
+	if(e == NULL || lower == NULL || upper == NULL) 
+		return error(MDCERR_null);
+	if(e->flags & (engine_flag_cuda | engine_flag_mpi)) 
+		return error(MDCERR_nyi);
+
+	if(space_resize(&e->s, lower, upper, &e->boundary_conditions) != S_OK || 
+		boundary_sdf_flag_cells(&e->s, e->boundary_sdfs) != S_OK) 
+		return error(MDCERR_space);
+
+	if(engine_queues_refill(e) != S_OK) 
+		return error(MDCERR_queue);
+
+	TF_Log(LOG_INFORMATION) << "engine: resized domain to origin = [" << e->s.origin[0] << ", " << e->s.origin[1] << ", " << e->s.origin[2] << "], dimensions = [" << e->s.dim[0] << ", " << e->s.dim[1] << ", " << e->s.dim[2] << "], cell dimensions = [" << e->s.cdim[0] << ", " << e->s.cdim[1] << ", " << e->s.cdim[2] << "]";
+
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_expand_auto(struct engine *e) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(e->expand_margin <= 0 || e->flags & (engine_flag_cuda | engine_flag_mpi)) 
+		return S_OK;
+
+	struct space *s = &e->s;
+	int k, lo[3], hi[3], lower[3], upper[3];
+
+	/* Find the occupied layers of cells along each dimension. */
+	for(k = 0 ; k < 3 ; k++) {
+		lo[k] = s->cdim[k];
+		hi[k] = -1;
+	}
+	for(int cid = 0 ; cid < s->nr_real ; cid++) {
+		struct space_cell *c = &s->cells[s->cid_real[cid]];
+		if(c->count == 0) 
+			continue;
+		for(k = 0 ; k < 3 ; k++) {
+			lo[k] = std::min(lo[k], c->loc[k]);
+			hi[k] = std::max(hi[k], c->loc[k]);
+		}
+	}
+	for(int pid = 0 ; pid < s->largeparts.count ; pid++) 
+		for(k = 0 ; k < 3 ; k++) {
+			int ind = std::floor(s->largeparts.parts[pid].x[k] * s->ih[k]);
+			lo[k] = std::min(lo[k], ind);
+			hi[k] = std::max(hi[k], ind);
+		}
+	if(hi[0] < 0) 
+		return S_OK;
+
+	/* Keep between one and two margins of empty layers on each non-periodic face. */
+	const int margin = e->expand_margin;
+	bool resize = false;
+	for(k = 0 ; k < 3 ; k++) {
+		lower[k] = upper[k] = 0;
+		if(s->period & (space_periodic_x << k)) 
+			continue;
+
+		const int free_lower = lo[k];
+		const int free_upper = s->cdim[k] - 1 - hi[k];
+		if(free_lower < margin || free_lower > 2 * margin) 
+			lower[k] = margin - free_lower;
+		if(free_upper < margin || free_upper > 2 * margin) 
+			upper[k] = margin - free_upper;
+		resize |= lower[k] != 0 || upper[k] != 0;
+	}
+
+	return resize ? engine_expand(e, lower, upper) : S_OK;
+}
+
+int TissueForge::engine_partid_end(struct engine *e)
+{
+	return std::max<int>(e->s.nr_parts + e->pids_avail.size(), e->pids_reserved);
+}
+
 int TissueForge::engine_next_partid(struct engine *e)
 {
 	if(e->pids_avail.empty()) 
-		return e->s.nr_parts;
+		return engine_partid_end(e);
 
-	std::set<unsigned int>::iterator itr = e->pids_avail.begin();
-	unsigned int pid = *itr;
-	e->pids_avail.erase(itr);
+	int pid = e->pids_avail.back();
+	e->pids_avail.pop_back();
 
 	return pid;
 }
 
 HRESULT TissueForge::engine_next_partids(struct engine *e, int nr_ids, int *ids) { 
-	int j = e->pids_avail.size();
-	for(int i = 0; i < nr_ids; i++) {
-		if(!e->pids_avail.empty()) {
-			std::set<unsigned int>::iterator itr = e->pids_avail.begin();
-			ids[i] = *itr;
-			e->pids_avail.erase(itr);
-		} 
-		else {
-			ids[i] = e->s.nr_parts + j;
-			j++;
-		}
+	int nr_recycled = std::min<int>(nr_ids, e->pids_avail.size());
+	for(int i = 0; i < nr_recycled; i++) {
+		ids[i] = e->pids_avail.back();
+		e->pids_avail.pop_back();
 	}
+	if(nr_recycled == nr_ids) 
+		return S_OK;
+
+	int pid_first;
+	if(engine_next_partid_range(e, nr_ids - nr_recycled, &pid_first) != S_OK) 
+		return error(MDCERR_engine);
+	for(int i = nr_recycled; i < nr_ids; i++) 
+		ids[i] = pid_first++;
 
 	return S_OK;
 }
 
+HRESULT TissueForge::engine_next_partid_range(struct engine *e, int nr_ids, int *first) {
+	if(e == NULL || first == NULL) 
+		return error(MDCERR_null);
+
+	*first = engine_partid_end(e);
+	if(engine_reserve_parts(e, *first + nr_ids) != S_OK) 
+		return error(MDCERR_engine);
+	e->pids_reserved = *first + nr_ids;
+	return S_OK;
+}
+
 CAPI_FUNC(HRESULT) TissueForge::engine_del_particle(struct engine *e, int pid)
 {
     TF_Log(LOG_DEBUG) << "time: " << e->time * e->dt << ", deleting particle id: " << pid;
@@ -2076,11 +2432,135 @@ CAPI_FUNC(HRESULT) TissueForge::engine_del_particle(struct engine *e, int pid)
 		Dihedral_Destroy(&_Engine.dihedrals[dihedrals[i]]);
 	}
 
-	e->pids_avail.insert(pid);
+	e->pids_avail.push_back(pid);
+
+	for(auto &se : e->subengines) 
+		if(se->releaseParticle(pid) != S_OK) 
+			return error(MDCERR_subengine);
 
     return space_del_particle(&e->s, pid);
 }
 
+HRESULT TissueForge::engine_renumber_parts(struct engine *e) {
+	if(e->flags & (engine_flag_cuda | engine_flag_mpi | engine_flag_sets)) 
+		return tf_error(E_FAIL, "Particle renumbering is not supported by the current engine configuration");
+	if(e->nr_rigids > 0) 
+		return tf_error(E_FAIL, "Particle renumbering is not supported with rigid constraints");
+
+	struct space *s = &e->s;
+	const int size_parts = s->size_parts;
+
+	// Assign new ids in the order of the cells, followed by the large particles
+	std::vector<int> newIds(size_parts, -1);
+	int nr_ids = 0;
+	auto assign_cell = [&newIds, &nr_ids](space_cell *c) -> void {
+		for(int k = 0; k < c->count; k++) {
+			int pid = c->parts[k].id;
+			if(pid >= 0 && pid < newIds.size() && newIds[pid] < 0) 
+				newIds[pid] = nr_ids++;
+		}
+	};
+	for(int cid = 0; cid < s->nr_marked; cid++) 
+		assign_cell(&s->cells[s->cid_marked[cid]]);
+	assign_cell(&s->largeparts);
+	for(int pid = 0; pid < size_parts; pid++) 
+		if(s->partlist[pid] && newIds[pid] < 0) 
+			newIds[pid] = nr_ids++;
+
+	bool changed = !e->pids_avail.empty();
+	for(int pid = 0; pid < size_parts && !changed; pid++) 
+		changed = s->partlist[pid] && newIds[pid] != pid;
+	if(!changed) 
+		return S_OK;
+
+	TF_Log(LOG_INFORMATION) << "renumbering " << nr_ids << " particles";
+
+	auto remap = [&newIds](int32_t &pid) -> void {
+		if(pid >= 0 && pid < newIds.size() && newIds[pid] >= 0) 
+			pid = newIds[pid];
+	};
+
+	// Particles and the lookup tables
+	std::vector<Particle*> partlist(s->partlist, s->partlist + size_parts);
+	std::vector<space_cell*> celllist(s->celllist, s->celllist + size_parts);
+	for(int pid = 0; pid < size_parts; pid++) {
+		s->partlist[pid] = NULL;
+		s->celllist[pid] = NULL;
+	}
+	for(int pid = 0; pid < size_parts; pid++) {
+		Particle *p = partlist[pid];
+		if(!p) 
+			continue;
+		s->partlist[newIds[pid]] = p;
+		s->celllist[newIds[pid]] = celllist[pid];
+	}
+	parallel_for(nr_ids, [&s, &remap](int pid) -> void {
+		Particle *p = s->partlist[pid];
+		p->id = pid;
+		remap(p->clusterId);
+		for(int k = 0; k < p->nr_parts; k++) 
+			remap(p->parts[k]);
+	});
+	e->pids_avail.clear();
+	e->pids_reserved = 0;
+
+	// Type lists, sorted for traversal in the new order
+	for(int tid = 0; tid < engine::nr_types; tid++) {
+		ParticleList &parts = e->types[tid].parts;
+		for(int k = 0; k < parts.nr_parts; k++) 
+			remap(parts.parts[k]);
+		std::sort(parts.parts, parts.parts + parts.nr_parts);
+		parts.resetIndex();
+	}
+
+	// Bonded interactions
+	for(int bid = 0; bid < e->nr_bonds; bid++) {
+		Bond *b = &e->bonds[bid];
+		if(!(b->flags & BOND_ACTIVE)) 
+			continue;
+		remap(b->i);
+		remap(b->j);
+	}
+	for(int aid = 0; aid < e->nr_angles; aid++) {
+		Angle *a = &e->angles[aid];
+		if(!(a->flags & ANGLE_ACTIVE)) 
+			continue;
+		remap(a->i);
+		remap(a->j);
+		remap(a->k);
+	}
+	for(int did = 0; did < e->nr_dihedrals; did++) {
+		Dihedral *d = &e->dihedrals[did];
+		if(!(d->flags & DIHEDRAL_ACTIVE)) 
+			continue;
+		remap(d->i);
+		remap(d->j);
+		remap(d->k);
+		remap(d->l);
+	}
+	engine_bonded_index_rebuild(e);
+	for(int xid = 0; xid < e->nr_exclusions; xid++) {
+		remap(e->exclusions[xid].i);
+		remap(e->exclusions[xid].j);
+	}
+
+	s->verlet_rebuild = 1;
+
+	// Tracked handles and other owners of particle ids
+	if(Particle_RenumberHandles(newIds) != S_OK) 
+		return error(MDCERR_particle);
+
+	for(auto &cf : e->custom_forces) 
+		if(cf->renumberParticles(newIds) != S_OK) 
+			return error(MDCERR_engine);
+
+	for(auto &se : e->subengines) 
+		if(se->renumberParticles(newIds) != S_OK) 
+			return error(MDCERR_subengine);
+
+	return S_OK;
+}
+
 FVector3 TissueForge::engine_origin() {
 	return {
         _Engine.s.origin[0],
@@ -2098,7 +2578,7 @@ FVector3 TissueForge::engine_dimensions() {
 }
 
 FVector3 TissueForge::engine_center() {
-    return engine_dimensions() / 2.;
+    return engine_origin() + engine_dimensions() / 2.;
 }
 
 HRESULT TissueForge::engine_reset(struct engine *e) {
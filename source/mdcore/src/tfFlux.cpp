@@ -30,6 +30,10 @@
 #include <tf_util.h>
 #include <io/tfFIO.h>
 #include <tf_mdcore_io.h>
+#include <tfTask.h>
+#include <tfTaskScheduler.h>
+
+#include <vector>
 
 
 using namespace TissueForge;
@@ -205,6 +209,245 @@ HRESULT TissueForge::Fluxes_integrate(int cellId) {
     return Fluxes_integrate(&_Engine.s.cells[cellId]);
 }
 
+/** A neighbor of a particle in the flux stencil */
+struct FluxStencilEntry {
+    Particle *other;
+    Fluxes *fluxes;
+
+    /** Offset of the kernel weights of the fluxes; negative weights are beyond the flux cutoff */
+    int32_t weights;
+
+    /** Whether the particle is the first of the pair when evaluating fluxes */
+    bool first;
+};
+
+/** The flux stencil of a cell */
+struct FluxStencilCell {
+    space_cell *cell;
+
+    /** Entries of each particle of the cell, by particle index */
+    std::vector<int32_t> offsets;
+    std::vector<FluxStencilEntry> entries;
+    std::vector<FPTYPE> weights;
+
+    /** Consumption rates of each species of each particle, by particle index */
+    std::vector<int32_t> rate_offsets;
+    std::vector<FPTYPE> rates;
+};
+
+
+static std::vector<FluxStencilCell> flux_stencil;
+
+static std::vector<std::vector<int> > flux_stencil_tasks;
+
+static unsigned int flux_stencil_generation = 0;
+
+
+HRESULT TissueForge::Fluxes_stencil_build(struct engine *e) {
+    struct space *s = &e->s;
+
+    // Tasks of each cell are fixed until the cells or tasks of the space are rebuilt or reordered
+    if(flux_stencil_generation != s->generation) {
+        flux_stencil_tasks = std::vector<std::vector<int> >(s->nr_cells);
+        for(int tid = 0; tid < s->nr_tasks; tid++) {
+            const task &t = s->tasks[tid];
+            if(t.type == task_type_self) 
+                flux_stencil_tasks[t.i].push_back(tid);
+            else if(t.type == task_type_pair) {
+                flux_stencil_tasks[t.i].push_back(tid);
+                flux_stencil_tasks[t.j].push_back(tid);
+            }
+        }
+        flux_stencil_generation = s->generation;
+    }
+
+    flux_stencil.resize(s->nr_real);
+
+    auto func = [s](int _cid) -> void {
+        FluxStencilCell &sc = flux_stencil[_cid];
+        space_cell *c = &s->cells[s->cid_real[_cid]];
+        const FPTYPE cutoff2 = s->cutoff2;
+
+        sc.cell = c;
+        sc.offsets.resize(c->count + 1);
+        sc.entries.clear();
+        sc.weights.clear();
+        sc.rate_offsets.resize(c->count + 1);
+
+        int nr_rates = 0;
+        for(int i = 0; i < c->count; i++) {
+            Particle *p = &c->parts[i];
+            sc.offsets[i] = sc.entries.size();
+            sc.rate_offsets[i] = nr_rates;
+            if(!p->state_vector) 
+                continue;
+            nr_rates += p->state_vector->size;
+
+            for(auto tid : flux_stencil_tasks[c - s->cells]) {
+                space_cell *ci = &s->cells[s->tasks[tid].i], *cj, *co;
+                FPTYPE shift[3] = {0.0, 0.0, 0.0}, pix[3], dx[3];
+
+                if(s->tasks[tid].type == task_type_self) {
+                    co = c;
+                }
+                else {
+                    cj = &s->cells[s->tasks[tid].j];
+                    space_getsid(s, &ci, &cj, shift);
+                    if(ci == c) {
+                        co = cj;
+                    }
+                    else {
+                        co = ci;
+                        for(int k = 0; k < 3; k++) 
+                            shift[k] = -shift[k];
+                    }
+                }
+                for(int k = 0; k < 3; k++) 
+                    pix[k] = p->x[k] - shift[k];
+
+                for(int j = 0; j < co->count; j++) {
+                    Particle *o = &co->parts[j];
+                    if(o == p || !o->state_vector) 
+                        continue;
+
+                    FPTYPE r2 = fptype_r2(pix, o->x, dx);
+                    if(r2 > cutoff2) 
+                        continue;
+
+                    Fluxes *fluxes = get_fluxes(p, o);
+                    if(!fluxes) 
+                        continue;
+
+                    Flux *flux = &fluxes->fluxes[0];
+                    FPTYPE r = FPTYPE_SQRT(r2);
+                    FluxStencilEntry entry;
+                    entry.other = o;
+                    entry.fluxes = fluxes;
+                    entry.weights = sc.weights.size();
+                    entry.first = p->id < o->id || (p->id == o->id && p < o);
+                    for(int k = 0; k < flux->size; k++) {
+                        FPTYPE term = 1 - r / flux->cutoff[k];
+                        sc.weights.push_back(r > flux->cutoff[k] ? -FPTYPE_ONE : term * term);
+                    }
+                    sc.entries.push_back(entry);
+                }
+            }
+        }
+        sc.offsets[c->count] = sc.entries.size();
+        sc.rate_offsets[c->count] = nr_rates;
+        sc.rates.assign(nr_rates, FPTYPE_ZERO);
+    };
+    parallel_for(s->nr_real, func);
+
+    return S_OK;
+}
+
+HRESULT TissueForge::Fluxes_stencil_step(struct engine *e, FPTYPE dt) {
+    const bool implicit = e->flux_integrator == FLUX_INTEGRATOR_SEMIIMPLICIT;
+
+    // Accumulate the fluxes of each particle from its own entries only, so that cells are independent
+    auto func_eval = [implicit](int _cid) -> void {
+        FluxStencilCell &sc = flux_stencil[_cid];
+        space_cell *c = sc.cell;
+
+        for(int i = 0; i < c->count; i++) {
+            Particle *p = &c->parts[i];
+            if(!p->state_vector) 
+                continue;
+            FPTYPE *q = p->state_vector->q;
+            FPTYPE *rates = &sc.rates[sc.rate_offsets[i]];
+            const FPTYPE *fvec = p->state_vector->fvec;
+
+            // Production and consumption; consumption is divided by the consumed amount when implicit
+            auto accumulate = [implicit, q, rates, fvec](int32_t idx, FPTYPE dq, FPTYPE decay) -> void {
+                if(!implicit) {
+                    q[idx] += dq - decay;
+                    return;
+                }
+                FPTYPE consumed = decay;
+                if(dq >= FPTYPE_ZERO) 
+                    q[idx] += dq;
+                else 
+                    consumed -= dq;
+                if(fvec[idx] > FPTYPE_ZERO) 
+                    rates[idx] += consumed / fvec[idx];
+            };
+
+            for(int n = sc.offsets[i]; n < sc.offsets[i + 1]; n++) {
+                const FluxStencilEntry &entry = sc.entries[n];
+                Particle *part_i = entry.first ? p : entry.other;
+                Particle *part_j = entry.first ? entry.other : p;
+                Flux *flux = &entry.fluxes->fluxes[0];
+                const FPTYPE *weights = &sc.weights[entry.weights];
+
+                for(int k = 0; k < flux->size; ++k) {
+                    if(weights[k] < FPTYPE_ZERO) 
+                        continue;
+
+                    // NOTE: same resolution of the reaction direction as flux_eval_ex
+                    Particle *pi = part_i->typeId == flux->type_ids[k].a ? part_i : part_j;
+                    Particle *pj = part_j->typeId == flux->type_ids[k].b ? part_j : part_i;
+
+                    int32_t ii = flux->indices_a[k];
+                    int32_t ij = flux->indices_b[k];
+                    FPTYPE ssi = pi->state_vector->fvec[ii];
+                    FPTYPE ssj = pj->state_vector->fvec[ij];
+                    FPTYPE dq = weights[k];
+
+                    switch(flux->kinds[k]) {
+                        case FLUX_FICK:
+                            dq *= flux_fick(flux, k, ssi, ssj);
+                            break;
+                        case FLUX_SECRETE:
+                            dq *= flux_secrete(flux, k, ssi, ssj);
+                            break;
+                        case FLUX_UPTAKE:
+                            dq *= flux_uptake(flux, k, ssi, ssj);
+                            break;
+                        default:
+                            assert(0);
+                    }
+
+                    FPTYPE half_decay = flux->decay_coef[k] / 2.f;
+                    if(pi == p) 
+                        accumulate(ii, -dq, half_decay * ssi);
+                    else 
+                        accumulate(ij, dq, half_decay * ssj);
+                }
+            }
+        }
+    };
+
+    auto func_integrate = [implicit, dt](int _cid) -> void {
+        FluxStencilCell &sc = flux_stencil[_cid];
+        space_cell *c = sc.cell;
+
+        if(!implicit) {
+            Fluxes_integrate(c, dt);
+            return;
+        }
+
+        for(int i = 0; i < c->count; i++) {
+            state::StateVector *sv = c->parts[i].state_vector;
+            if(!sv) 
+                continue;
+            FPTYPE *rates = &sc.rates[sc.rate_offsets[i]];
+            for(int k = 0; k < sv->size; ++k) {
+                sv->species_flags[k] = (uint32_t)sv->species->item(k)->flags();
+                if(!(sv->species_flags[k] & state::SpeciesFlags::SPECIES_KONSTANT)) 
+                    sv->fvec[k] = FPTYPE_FMAX(FPTYPE_ZERO, (sv->fvec[k] + dt * sv->q[k]) / (FPTYPE_ONE + dt * rates[k]));
+                sv->q[k] = 0;
+                rates[k] = 0;
+            }
+        }
+    };
+
+    parallel_for(flux_stencil.size(), func_eval);
+    parallel_for(flux_stencil.size(), func_integrate);
+
+    return S_OK;
+}
+
 Fluxes *TissueForge::Fluxes::addFlux(
     FluxKind kind, 
     Fluxes *fluxes,
@@ -44,7 +44,9 @@
 #include <cmath>
 #include <stdlib.h>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <typeinfo>
 
 
@@ -180,9 +182,9 @@ static FVector3 particle_posdefault() {
     RandomType &randEng = randomEngine();
     auto eng_origin = engine_origin();
     auto eng_dims = engine_dimensions();
-    std::uniform_real_distribution<FPTYPE> x(eng_origin[0], eng_dims[0]);
-    std::uniform_real_distribution<FPTYPE> y(eng_origin[1], eng_dims[1]);
-    std::uniform_real_distribution<FPTYPE> z(eng_origin[2], eng_dims[2]);
+    std::uniform_real_distribution<FPTYPE> x(eng_origin[0], eng_origin[0] + eng_dims[0]);
+    std::uniform_real_distribution<FPTYPE> y(eng_origin[1], eng_origin[1] + eng_dims[1]);
+    std::uniform_real_distribution<FPTYPE> z(eng_origin[2], eng_origin[2] + eng_dims[2]);
     return {x(randEng), y(randEng), z(randEng)};
 }
 
@@ -921,6 +923,43 @@ Particle* TissueForge::Particle_Get(ParticleHandle *pypart) {
     return _Engine.s.partlist[pypart->id];
 }
 
+static std::mutex &particleHandles_lock() {
+    static std::mutex lock;
+    return lock;
+}
+
+static std::unordered_set<void*> &particleHandles_tracked() {
+    static std::unordered_set<void*> handles;
+    return handles;
+}
+
+void *TissueForge::ParticleHandle::operator new(size_t size) {
+    void *ptr = ::operator new(size);
+    std::lock_guard<std::mutex> lock(particleHandles_lock());
+    particleHandles_tracked().insert(ptr);
+    return ptr;
+}
+
+void TissueForge::ParticleHandle::operator delete(void *ptr) {
+    if(!ptr) 
+        return;
+    {
+        std::lock_guard<std::mutex> lock(particleHandles_lock());
+        particleHandles_tracked().erase(ptr);
+    }
+    ::operator delete(ptr);
+}
+
+HRESULT TissueForge::Particle_RenumberHandles(const std::vector<int> &newIds) {
+    std::lock_guard<std::mutex> lock(particleHandles_lock());
+    for(auto ptr : particleHandles_tracked()) {
+        ParticleHandle *ph = (ParticleHandle*)ptr;
+        if(ph->id >= 0 && ph->id < newIds.size() && newIds[ph->id] >= 0) 
+            ph->id = newIds[ph->id];
+    }
+    return S_OK;
+}
+
 ParticleHandle *TissueForge::Particle::handle() {
     
     if(!this->_handle) this->_handle = new ParticleHandle(this->id);
@@ -1064,9 +1103,10 @@ std::vector<int> TissueForge::Particles_New(
         return {};
     }
 
-    if(_Engine.s.nr_parts + nr_parts > _Engine.s.size_parts) { 
-        int size_incr = (int((_Engine.s.nr_parts - _Engine.s.size_parts + nr_parts) / space_partlist_incr) + 1) * space_partlist_incr;
-        if(space_growparts(&_Engine.s, size_incr) != S_OK) { 
+    // Grow storage geometrically before the new ids are reserved
+    const int pid_end = engine_partid_end(&_Engine) + nr_parts;
+    if(pid_end > _Engine.s.size_parts) { 
+        if(space_growparts(&_Engine.s, pid_end - _Engine.s.size_parts) != S_OK) { 
             error(MDCERR_space);
             return {};
         }
@@ -1277,16 +1317,16 @@ ParticleList TissueForge::ParticleHandle::getBondedNeighbors() {
     auto id = self->id;
     
     ParticleList list;
+    if(id >= _Engine.part_bonds.size()) 
+        return list;
     
-    for(int i = 0; i < _Engine.nr_bonds; ++i) {
-        Bond *b = &_Engine.bonds[i];
-        if(b->flags & BOND_ACTIVE) {
-            if(b->i == id) {
-                list.insert(b->j);
-            }
-            else if(b->j == id) {
-                list.insert(b->i);
-            }
+    for(auto &bid : _Engine.part_bonds[id]) {
+        Bond *b = &_Engine.bonds[bid];
+        if(b->i == id) {
+            list.insert(b->j);
+        }
+        else if(b->j == id) {
+            list.insert(b->i);
         }
     }
     return list;
@@ -1298,16 +1338,18 @@ std::vector<int32_t> TissueForge::ParticleHandle::getBondedNeighborIds() {
     auto id = self->id;
     
     std::vector<int32_t> list;
-    
-    for(int i = 0; i < _Engine.nr_bonds; ++i) {
-        Bond *b = &_Engine.bonds[i];
-        if(b->flags & BOND_ACTIVE) {
-            if(b->i == id) {
-                list.push_back(b->j);
-            }
-            else if(b->j == id) {
-                list.push_back(b->i);
-            }
+    if(id >= _Engine.part_bonds.size()) 
+        return list;
+    
+    auto &bids = _Engine.part_bonds[id];
+    list.reserve(bids.size());
+    for(auto &bid : bids) {
+        Bond *b = &_Engine.bonds[bid];
+        if(b->i == id) {
+            list.push_back(b->j);
+        }
+        else if(b->j == id) {
+            list.push_back(b->i);
         }
     }
     return list;
@@ -1320,14 +1362,13 @@ std::vector<BondHandle> TissueForge::ParticleHandle::getBonds() {
     TF_PARTICLE_SELFW(this, bonds)
 
     auto id = self->id;
-    bonds.reserve(_Engine.nr_active_bonds);
+    if(id >= _Engine.part_bonds.size()) 
+        return bonds;
     
-    for(int i = 0; i < _Engine.bonds_size; ++i) {
-        Bond *b = &_Engine.bonds[i];
-        if((b->flags & BOND_ACTIVE) && (b->i == id || b->j == id)) {
-            bonds.push_back(BondHandle(i));
-        }
-    }
+    auto &bids = _Engine.part_bonds[id];
+    bonds.reserve(bids.size());
+    for(auto &bid : bids) 
+        bonds.push_back(BondHandle(bid));
 
     return bonds;
 }
@@ -1339,14 +1380,13 @@ std::vector<AngleHandle> TissueForge::ParticleHandle::getAngles() {
     TF_PARTICLE_SELFW(this, angles)
 
     auto id = self->id;
-    angles.reserve(_Engine.nr_active_angles);
+    if(id >= _Engine.part_angles.size()) 
+        return angles;
     
-    for(int i = 0; i < _Engine.angles_size; ++i) {
-        Angle *a = &_Engine.angles[i];
-        if((a->flags & ANGLE_ACTIVE) && (a->i == id || a->j == id || a->k == id)) {
-            angles.push_back(AngleHandle(i));
-        }
-    }
+    auto &aids = _Engine.part_angles[id];
+    angles.reserve(aids.size());
+    for(auto &aid : aids) 
+        angles.push_back(AngleHandle(aid));
 
     return angles;
 }
@@ -1358,14 +1398,13 @@ std::vector<DihedralHandle> TissueForge::ParticleHandle::getDihedrals() {
     TF_PARTICLE_SELFW(this, dihedrals)
 
     auto id = self->id;
-    dihedrals.reserve(_Engine.nr_active_dihedrals);
+    if(id >= _Engine.part_dihedrals.size()) 
+        return dihedrals;
     
-    for(int i = 0; i < _Engine.dihedrals_size; ++i) {
-        Dihedral *d = &_Engine.dihedrals[i];
-        if((d->flags & DIHEDRAL_ACTIVE) && (d->i == id || d->j == id || d->k == id || d->l == id)) {
-            dihedrals.push_back(DihedralHandle(i));
-        }
-    }
+    auto &dids = _Engine.part_dihedrals[id];
+    dihedrals.reserve(dids.size());
+    for(auto &did : dids) 
+        dihedrals.push_back(DihedralHandle(did));
 
     return dihedrals;
 }
@@ -1475,11 +1514,12 @@ HRESULT particles_ex_load(std::vector<ParticleHandle*> selfs, std::vector<Partic
     if(selfs.size() != parts.size()) 
         return error(MDCERR_bad_el_input);
 
-    FPTYPE **positions = (FPTYPE**)malloc(sizeof(FPTYPE*) * parts.size());
     std::vector<int> part_ids(parts.size(), 0);
     if(engine_next_partids(&_Engine, part_ids.size(), part_ids.data()) != S_OK) 
         return error(MDCERR_engine);
 
+    FPTYPE **positions = (FPTYPE**)malloc(sizeof(FPTYPE*) * parts.size());
+
     for(int i = 0; i < parts.size(); i++) {
         Particle *part = parts[i];
         part->id = part_ids[i];
@@ -24,6 +24,7 @@
 #include <io/tfFIO.h>
 #include <tf_mdcore_io.h>
 
+#include <algorithm>
 #include <cstdarg>
 #include <iostream>
 
@@ -35,6 +36,57 @@ using namespace TissueForge;
 #define PARTLIST_IMMUTABLE_CHECK_HRESULT(list) { if(!(list->flags & PARTICLELIST_MUTABLE)) return PARTLIST_IMMUTABLE_ERR; }
 #define PARTLIST_IMMUTABLE_CHECK_LISTSZ(list) { if(!(list->flags & PARTICLELIST_MUTABLE)) { PARTLIST_IMMUTABLE_ERR; return list->nr_parts; } }
 
+// Smallest list for which lookups build a slot index rather than scan
+#define PARTLIST_INDEX_MIN  32
+
+
+static size_t ParticleList_growsize(const size_t &size_parts, const size_t &size_req) {
+    size_t result = std::max<size_t>(size_parts + space_partlist_incr, size_parts * 1.414);
+    return std::max(result, size_req);
+}
+
+static HRESULT ParticleList_buildslots(ParticleList *list) {
+    list->slots = new std::unordered_map<int32_t, int32_t>();
+    list->slots->reserve(list->nr_parts);
+    for(int32_t i = 0; i < list->nr_parts; i++) 
+        (*list->slots)[list->parts[i]] = i;
+    return S_OK;
+}
+
+// Gets the position of an id, or -1 if the list does not have it
+static int32_t ParticleList_find(ParticleList *list, const int32_t &pid) {
+    if(!list->slots && list->nr_parts >= PARTLIST_INDEX_MIN) 
+        ParticleList_buildslots(list);
+
+    if(list->slots) {
+        auto itr = list->slots->find(pid);
+        return itr == list->slots->end() ? -1 : itr->second;
+    }
+
+    for(int32_t i = 0; i < list->nr_parts; i++) 
+        if(list->parts[i] == pid) 
+            return i;
+    return -1;
+}
+
+static HRESULT ParticleList_extend(ParticleList *list, const int32_t *ids, const int32_t &nr_ids) {
+    if(nr_ids == 0) 
+        return S_OK;
+
+    if(list->nr_parts + nr_ids > list->size_parts) {
+        HRESULT result = list->reserve(ParticleList_growsize(list->size_parts, list->nr_parts + nr_ids));
+        if(result != S_OK) 
+            return result;
+    }
+    
+    memcpy(&list->parts[list->nr_parts], ids, sizeof(int32_t) * nr_ids);
+    if(list->slots) 
+        for(int32_t i = 0; i < nr_ids; ++i) 
+            (*list->slots)[ids[i]] = list->nr_parts + i;
+    list->nr_parts += nr_ids;
+    return S_OK;
+}
+
 
 void TissueForge::ParticleList::free() {
     if(this->flags & PARTICLELIST_OWNDATA && size_parts > 0 && this->parts) {
@@ -43,6 +95,13 @@ void TissueForge::ParticleList::free() {
     this->parts = 0;
     this->nr_parts = 0;
     this->size_parts = 0;
+    resetIndex();
+}
+
+void TissueForge::ParticleList::resetIndex() {
+    if(this->slots) 
+        delete this->slots;
+    this->slots = 0;
 }
 
 HRESULT TissueForge::ParticleList::reserve(size_t _nr_parts) {
@@ -68,9 +127,11 @@ uint16_t TissueForge::ParticleList::insert(int32_t id)
     PARTLIST_IMMUTABLE_CHECK_LISTSZ(this)
 
     if(nr_parts == size_parts) 
-        reserve(size_parts + space_partlist_incr);
+        reserve(ParticleList_growsize(size_parts, nr_parts + 1));
     
     parts[nr_parts] = id;
+    if(slots) 
+        (*slots)[id] = nr_parts;
 
     return nr_parts++;
 }
@@ -88,13 +149,9 @@ uint16_t TissueForge::ParticleList::remove(int32_t id)
 {
     PARTLIST_IMMUTABLE_CHECK_LISTSZ(this)
 
-    int i = 0;
-    for(; i < nr_parts; i++) {
-        if(parts[i] == id)
-            break;
-    }
+    int i = ParticleList_find(this, id);
     
-    if(i == nr_parts) {
+    if(i < 0) {
         tf_error(E_FAIL, "type does not contain particle id");
         return this->nr_parts;
     }
@@ -103,6 +160,11 @@ uint16_t TissueForge::ParticleList::remove(int32_t id)
     if(i < nr_parts) {
         parts[i] = parts[nr_parts];
     }
+    if(slots) {
+        slots->erase(id);
+        if(i < nr_parts) 
+            (*slots)[parts[i]] = i;
+    }
     
     return i;
 }
@@ -110,16 +172,19 @@ uint16_t TissueForge::ParticleList::remove(int32_t id)
 uint16_t TissueForge::ParticleList::extend(const ParticleList &other) {
     PARTLIST_IMMUTABLE_CHECK_LISTSZ(this)
 
-    if(other.nr_parts > size_parts) reserve(other.nr_parts);
-    for(int i = 0; i < other.nr_parts; ++i) this->insert(other.parts[i]);
+    ParticleList_extend(this, other.parts, other.nr_parts);
+    return this->nr_parts;
+}
+
+uint16_t TissueForge::ParticleList::extend(const std::vector<int32_t> &ids) {
+    PARTLIST_IMMUTABLE_CHECK_LISTSZ(this)
+
+    ParticleList_extend(this, ids.data(), ids.size());
     return this->nr_parts;
 }
 
 bool TissueForge::ParticleList::has(const int32_t &pid) {
-    for(size_t i = 0; i < nr_parts; i++) 
-        if(parts[i] == pid) 
-            return true;
-    return false;
+    return ParticleList_find(this, pid) >= 0;
 }
 
 bool TissueForge::ParticleList::has(ParticleHandle *part) {
@@ -161,7 +226,8 @@ TissueForge::ParticleList::ParticleList() :
     flags(PARTICLELIST_OWNDATA | PARTICLELIST_MUTABLE), 
     size_parts(0), 
     nr_parts(0),
-    parts(0)
+    parts(0), 
+    slots(0)
 {}
 
 TissueForge::ParticleList::ParticleList(uint16_t init_size, uint16_t _flags) : ParticleList() {
@@ -370,8 +436,7 @@ std::vector<FVector3> TissueForge::ParticleList::sphericalPositions(FVector3 *or
     FVector3 _origin;
     if(origin) _origin = *origin;
     else{
-        auto center = FVector3(_Engine.s.dim[0], _Engine.s.dim[1], _Engine.s.dim[2]);
-        _origin = center / 2;
+        _origin = engine_center();
     }
     
     for(int i = 0; i < this->nr_parts; ++i) {
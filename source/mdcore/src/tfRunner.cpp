@@ -56,6 +56,7 @@
 #include <tfEngine.h>
 #include <tfRunner.h>
 #include <tfLogger.h>
+#include <tfTrace.h>
 
 
 using namespace TissueForge;
@@ -216,6 +217,7 @@ HRESULT TissueForge::runner_run(struct runner *r) {
 
     /* give a hoot */
     TF_Log(LOG_INFORMATION) << "runner_run: runner " << r->id << " is up and running on queue " << myqid << " (tasks)";
+    trace::setThreadName("runner " + std::to_string(r->id));
 
     /* main loop, in which the runner should stay forever... */
     while(1) {
@@ -309,16 +311,19 @@ HRESULT TissueForge::runner_run(struct runner *r) {
 
             /* Check task type... */
             switch(t->type) {
-                case task_type_sort:
+                case task_type_sort: {
                     TIMER_TIC_ND
+                    TF_TRACE_SCOPE(TRACE_RUNNER, "sort", t->i);
                     if(s->verlet_rebuild && e->step_flux == 0)
                         if(runner_dosort(r, &s->cells[ t->i ], t->flags) != S_OK)
                             return error(MDCERR_runner);
                     s->cells_taboo[ t->i ] = 0;
                     TIMER_TOC(runner_timer_sort);
                     break;
-                case task_type_self:
+                }
+                case task_type_self: {
                     TIMER_TIC_ND
+                    TF_TRACE_SCOPE(TRACE_RUNNER, "self", t->i);
                     if(e->integrator_flags & INTEGRATOR_FLUX_SUBSTEP) {
                         if(runner_doself_fluxonly(r, &s->cells[ t->i ]) != S_OK)
                             return error(MDCERR_runner);
@@ -330,8 +335,10 @@ HRESULT TissueForge::runner_run(struct runner *r) {
                     s->cells_taboo[ t->i ] = 0;
                     TIMER_TOC(runner_timer_self);
                     break;
-                case task_type_pair:
+                }
+                case task_type_pair: {
                     TIMER_TIC_ND
+                    TF_TRACE_SCOPE(TRACE_RUNNER, "pair", t->i, t->j);
                     if(e->integrator_flags & INTEGRATOR_FLUX_SUBSTEP) {
                         if(runner_dopair_fluxonly(r, &s->cells[ t->i ], &s->cells[ t->j ], t->flags) != S_OK)
                             return error(MDCERR_runner);
@@ -344,6 +351,7 @@ HRESULT TissueForge::runner_run(struct runner *r) {
                     s->cells_taboo[ t->j ] = 0;
                     TIMER_TOC(runner_timer_pair);
                     break;
+                }
                 default:
                     return error(MDCERR_tasktype);
             }
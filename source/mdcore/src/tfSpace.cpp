@@ -50,7 +50,12 @@
 #include <tfTaskScheduler.h>
 #include <tfLogger.h>
 #include <tfError.h>
+#include <tf_util.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <random>
 #include <iostream>
@@ -70,6 +75,9 @@ static std::vector<std::mt19937> generators;
 // instance of class std::normal_distribution with 0 mean, and 1 stdev
 static std::vector<std::normal_distribution<FPTYPE>> distributions;
 
+/** Last issued generation of the cells and tasks of a space */
+static std::atomic<unsigned int> space_generation_last{0};
+
 
 int TissueForge::space_getsid(
     struct space *s, 
@@ -202,10 +210,289 @@ HRESULT TissueForge::space_prepare(struct space *s) {
     };
     parallel_for(s->nr_marked, func_reset_cells);
 
+    if(space_largegrid_build(s) != S_OK) 
+        return error(MDCERR_space);
+
     /* what else could happen? */
     return S_OK;
 }
 
+/**
+ * Bounds on the range of potentials, in terms of center distance, 
+ * where the range of a potential between particles with radii ri and rj is 
+ * no greater than max(b_plain, b_scaled * (ri + rj), b_shifted + ri + rj). 
+ */
+struct space_potential_range {
+    FPTYPE b_plain = 0, b_scaled = 0, b_shifted = 0;
+    bool bounded = true;
+
+    void add(Potential *pot) {
+        if(pot == NULL) 
+            return;
+
+        if(pot->kind == POTENTIAL_KIND_COMBINATION) {
+            add(pot->pca);
+            add(pot->pcb);
+            return;
+        }
+
+        if(pot->kind == POTENTIAL_KIND_BYPARTICLES || pot->flags & POTENTIAL_PERIODIC) 
+            bounded = false;
+        else if(pot->flags & POTENTIAL_SCALED) 
+            b_scaled = std::max(b_scaled, pot->b);
+        else if(pot->flags & POTENTIAL_SHIFTED) 
+            b_shifted = std::max(b_shifted, pot->b - std::min(pot->r0_plusone, FPTYPE_ZERO));
+        else 
+            b_plain = std::max(b_plain, pot->b);
+    }
+
+    FPTYPE range(const FPTYPE &ri, const FPTYPE &rj) const {
+        return std::max({b_plain, b_scaled * (ri + rj), b_shifted + ri + rj});
+    }
+};
+
+HRESULT TissueForge::space_largegrid_build(struct space *s) {
+    
+    space_largegrid *g = &s->largegrid;
+    space_cell *large = &s->largeparts;
+    const int count = large->count;
+
+    g->nr_levels = 0;
+    if(count == 0) 
+        return S_OK;
+
+    // Bound the interaction range of every potential. 
+    // Any particle that interacts with a large particle is either another large particle, 
+    // which is visited by the large particle cell itself, or has a radius no larger than the cutoff. 
+    space_potential_range prange;
+    for(int i = 0; i < _Engine.max_type * _Engine.max_type; i++) {
+        prange.add(_Engine.p[i]);
+        prange.add(_Engine.p_cluster[i]);
+    }
+
+    std::vector<int> level_ids(count, 0);
+    std::vector<FPTYPE> level_sizes;
+
+    if(!prange.bounded) {
+        // Cannot bound the range: revert to a single cell
+        level_sizes.push_back(std::numeric_limits<FPTYPE>::max());
+    }
+    else {
+        std::vector<FPTYPE> ranges(count);
+        FPTYPE rmin = std::numeric_limits<FPTYPE>::max();
+        for(int j = 0; j < count; j++) {
+            ranges[j] = std::max(prange.range(s->cutoff, large->parts[j].radius), s->cutoff);
+            rmin = std::min(rmin, ranges[j]);
+        }
+
+        // Level l has a cell size of rmin * 2^l; the last level takes any longer ranges
+        for(int j = 0; j < count; j++) {
+            int l = std::ceil(std::log2(ranges[j] / rmin) - FPTYPE_EPSILON);
+            l = std::max(0, std::min(l, space_largegrid_maxlevels - 1));
+            level_ids[j] = l;
+            if(l >= (int)level_sizes.size()) 
+                level_sizes.resize(l + 1, 0);
+            level_sizes[l] = std::max({level_sizes[l], rmin * std::pow(FPTYPE(2), l), ranges[j]});
+        }
+    }
+
+    // Drop empty levels
+    std::vector<int> level_map(level_sizes.size(), -1);
+    for(int j = 0; j < count; j++) 
+        level_map[level_ids[j]] = 0;
+    for(int l = 0; l < (int)level_sizes.size(); l++) {
+        if(level_map[l] < 0) 
+            continue;
+
+        level_map[l] = g->nr_levels;
+        space_largegrid_level &level = g->levels[g->nr_levels];
+        for(int k = 0; k < 3; k++) {
+            level.cdim[k] = std::max(1, (int)std::floor(s->dim[k] / std::min(level_sizes[l], s->dim[k])));
+            level.h[k] = s->dim[k] / level.cdim[k];
+            level.ih[k] = 1.0 / level.h[k];
+        }
+        g->nr_levels++;
+    }
+
+    for(int l = 0; l < g->nr_levels; l++) {
+        space_largegrid_level &level = g->levels[l];
+        level.offsets.assign(level.cdim[0] * level.cdim[1] * level.cdim[2] + 1, 0);
+    }
+
+    // Sort particles by level and cell
+    std::vector<int> cellids(count);
+    for(int j = 0; j < count; j++) {
+        level_ids[j] = level_map[level_ids[j]];
+        space_largegrid_level &level = g->levels[level_ids[j]];
+        int ind[3];
+        for(int k = 0; k < 3; k++) 
+            ind[k] = std::max(0, std::min(level.cdim[k] - 1, (int)((large->parts[j].x[k] + large->origin[k] - s->origin[k]) * level.ih[k])));
+        cellids[j] = celldims_cellid(level.cdim, ind[0], ind[1], ind[2]);
+        level.offsets[cellids[j] + 1]++;
+    }
+
+    for(int l = 0; l < g->nr_levels; l++) {
+        space_largegrid_level &level = g->levels[l];
+        for(int c = 1; c < (int)level.offsets.size(); c++) 
+            level.offsets[c] += level.offsets[c - 1];
+        level.parts.resize(level.offsets.back());
+    }
+
+    std::vector<std::vector<int> > cursors(g->nr_levels);
+    for(int l = 0; l < g->nr_levels; l++) 
+        cursors[l] = g->levels[l].offsets;
+    for(int j = 0; j < count; j++) {
+        space_largegrid_level &level = g->levels[level_ids[j]];
+        level.parts[cursors[level_ids[j]][cellids[j]]++] = j;
+    }
+
+    return S_OK;
+}
+
+/** Spread the lowest 21 bits of an integer to every third bit. */
+static uint64_t space_morton_spread(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8) & 0x100f00f00f00f00f;
+    v = (v | v << 4) & 0x10c30c30c30c30c3;
+    v = (v | v << 2) & 0x1249249249249249;
+    return v;
+}
+
+/** Position of a cell along a Z-order curve. */
+static uint64_t space_morton_key(const unsigned int *ind) {
+    return space_morton_spread(ind[0]) << 2 | space_morton_spread(ind[1]) << 1 | space_morton_spread(ind[2]);
+}
+
+/** 
+ * Position of a cell along a Hilbert curve on a grid of 2^bits cells per side. 
+ * 
+ * Transforms the cell coordinates to their transposed Hilbert index 
+ * (J. Skilling, AIP Conf. Proc. 707, 381 (2004)) and interleaves the result. 
+ */
+static uint64_t space_hilbert_key(const unsigned int *ind, int bits) {
+    unsigned int x[3] = {ind[0], ind[1], ind[2]};
+    unsigned int M = 1u << (bits - 1), P, Q, t;
+
+    for(Q = M; Q > 1; Q >>= 1) {
+        P = Q - 1;
+        for(int i = 0; i < 3; i++) {
+            if(x[i] & Q) 
+                x[0] ^= P;
+            else {
+                t = (x[0] ^ x[i]) & P;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    for(int i = 1; i < 3; i++) 
+        x[i] ^= x[i - 1];
+    t = 0;
+    for(Q = M; Q > 1; Q >>= 1) 
+        if(x[2] & Q) 
+            t ^= Q - 1;
+    for(int i = 0; i < 3; i++) 
+        x[i] ^= t;
+
+    uint64_t key = 0;
+    for(int b = bits - 1; b >= 0; b--) 
+        for(int i = 0; i < 3; i++) 
+            key = key << 1 | ((x[i] >> b) & 1);
+    return key;
+}
+
+HRESULT TissueForge::space_set_cellorder(struct space *s, int order) {
+    if(s == NULL) 
+        return error(MDCERR_null);
+    if(order < space_cellorder_rowmajor || order > space_cellorder_hilbert) 
+        return error(MDCERR_range);
+
+    // Key each cell by its position along the curve
+    int bits = 1;
+    while((1 << bits) < std::max(s->cdim[0], std::max(s->cdim[1], s->cdim[2]))) 
+        bits++;
+
+    std::vector<uint64_t> keys(s->nr_cells);
+    for(int i = 0; i < s->cdim[0]; i++) 
+        for(int j = 0; j < s->cdim[1]; j++) 
+            for(int k = 0; k < s->cdim[2]; k++) {
+                int cid = space_cellid(s, i, j, k);
+                unsigned int ind[3] = {(unsigned int)i, (unsigned int)j, (unsigned int)k};
+                if(order == space_cellorder_morton) 
+                    keys[cid] = space_morton_key(ind);
+                else if(order == space_cellorder_hilbert) 
+                    keys[cid] = space_hilbert_key(ind, bits);
+                else 
+                    keys[cid] = cid;
+            }
+
+    std::vector<int> cids(s->nr_cells);
+    for(int cid = 0; cid < s->nr_cells; cid++) 
+        cids[cid] = cid;
+    std::stable_sort(cids.begin(), cids.end(), [&keys](int a, int b) -> bool { return keys[a] < keys[b]; });
+
+    /* Refill the cid lists with marked, local and ghost cells. */
+    s->nr_real = 0; s->nr_ghost = 0; s->nr_marked = 0;
+    for(auto cid : cids) {
+        if(!(s->cells[cid].flags & cell_flag_marked)) 
+            continue;
+        s->cid_marked[ s->nr_marked++ ] = cid;
+        if(s->cells[cid].flags & cell_flag_ghost) {
+            s->cells[cid].id = -s->nr_cells;
+            s->cid_ghost[ s->nr_ghost++ ] = cid;
+        }
+        else {
+            s->cells[cid].id = s->nr_real;
+            s->cid_real[ s->nr_real++ ] = cid;
+        }
+    }
+
+    /* Sort the tasks by the key of their first cell, sorts before the pairs that wait on them. */
+    const uint64_t key_none = std::numeric_limits<uint64_t>::max();
+    auto task_key = [&](const struct task &t, int c) -> uint64_t {
+        if(t.type != task_type_self && t.type != task_type_pair && t.type != task_type_sort) 
+            return key_none;
+        int cid = c == 0 || t.j < 0 ? t.i : t.j;
+        return cid >= 0 && cid < s->nr_cells ? keys[cid] : key_none;
+    };
+    std::vector<int> tids(s->nr_tasks);
+    for(int tid = 0; tid < s->nr_tasks; tid++) 
+        tids[tid] = tid;
+    std::stable_sort(tids.begin(), tids.end(), [&](int a, int b) -> bool {
+        const struct task &ta = s->tasks[a], &tb = s->tasks[b];
+        uint64_t ka = task_key(ta, 0), kb = task_key(tb, 0);
+        if(ka != kb) 
+            return ka < kb;
+        bool sa = ta.type == task_type_sort, sb = tb.type == task_type_sort;
+        if(sa != sb) 
+            return sa;
+        return task_key(ta, 1) < task_key(tb, 1);
+    });
+
+    std::vector<int> tids_new(s->nr_tasks);
+    for(int tid = 0; tid < s->nr_tasks; tid++) 
+        tids_new[tids[tid]] = tid;
+
+    std::vector<struct task> tasks(s->tasks, s->tasks + s->nr_tasks);
+    for(int tid = 0; tid < s->nr_tasks; tid++) {
+        struct task &t = s->tasks[tid];
+        t = tasks[tids[tid]];
+        for(int k = 0; k < t.nr_unlock; k++) 
+            t.unlock[k] = &s->tasks[tids_new[t.unlock[k] - s->tasks]];
+    }
+    for(int cid = 0; cid < s->nr_cells; cid++) 
+        if(s->cells[cid].sort) 
+            s->cells[cid].sort = &s->tasks[tids_new[s->cells[cid].sort - s->tasks]];
+
+    s->cellorder = order;
+    s->generation = ++space_generation_last;
+
+    return S_OK;
+}
+
 HRESULT TissueForge::space_shuffle(struct space *s) {
 
     int k, cid, pid, delta[3];
@@ -403,27 +690,31 @@ HRESULT space_gpos_cellindices(struct space *s, FPTYPE x, FPTYPE y, FPTYPE z, in
 }
 
 HRESULT TissueForge::space_growparts(struct space *s, unsigned int size_incr) { 
+    unsigned int size_parts = std::max<unsigned int>(s->size_parts * 1.414, s->size_parts + size_incr);
+    return space_reserveparts(s, size_parts);
+}
+
+HRESULT TissueForge::space_reserveparts(struct space *s, unsigned int size_parts) { 
     int k;
     struct Particle **temp;
     struct space_cell **tempc;
 
-    int size_parts = s->size_parts;
-    s->size_parts += size_incr;
+    if(s == NULL) 
+        return error(MDCERR_null);
+    if(size_parts <= s->size_parts) 
+        return S_OK;
 
-    if((temp = (struct Particle **)malloc(sizeof(struct Particle *) * s->size_parts)) == NULL)
+    if((temp = (struct Particle **)realloc(s->partlist, sizeof(struct Particle *) * size_parts)) == NULL)
         return error(MDCERR_malloc);
-    if((tempc = (struct space_cell **)malloc(sizeof(struct space_cell *) * s->size_parts)) == NULL)
-        return error(MDCERR_malloc);
-    memcpy(temp, s->partlist, sizeof(struct Particle *) * size_parts);
-    memcpy(tempc, s->celllist, sizeof(struct space_cell *) * size_parts);
-    free(s->partlist);
-    free(s->celllist);
     s->partlist = temp;
+    if((tempc = (struct space_cell **)realloc(s->celllist, sizeof(struct space_cell *) * size_parts)) == NULL)
+        return error(MDCERR_malloc);
     s->celllist = tempc;
-    for(k = size_parts; k < s->size_parts; k++) {
+    for(k = s->size_parts; k < size_parts; k++) {
         s->partlist[k] = NULL;
         s->celllist[k] = NULL;
     }
+    s->size_parts = size_parts;
 
     return S_OK;
 }
@@ -498,7 +789,7 @@ HRESULT TissueForge::space_addpart(struct space *s, struct Particle *p, FPTYPE *
     /* Increase the number of parts. */
     s->nr_parts++;
     
-    if(p->id < 0 || p->id >= s->nr_parts) {
+    if(p->id < 0 || p->id >= s->size_parts) {
         return error(MDCERR_id);
     }
     
@@ -533,9 +824,8 @@ HRESULT TissueForge::space_addparts(struct space *s, int nr_parts, struct Partic
         return error(MDCERR_null);
 
     /* do we need to extend the partlist? */
-    int size_incr = (int((s->nr_parts - s->size_parts + nr_parts) / space_partlist_incr) + 1) * space_partlist_incr;
-    if(size_incr > 0) {
-        if(space_growparts(s, size_incr) != S_OK) 
+    if(s->nr_parts + nr_parts > s->size_parts) {
+        if(space_growparts(s, s->nr_parts + nr_parts - s->size_parts) != S_OK) 
             return error(MDCERR_space);
 
         #if defined(HAVE_CUDA)
@@ -711,56 +1001,40 @@ struct task *TissueForge::space_addtask(struct space *s, int type, int subtype,
 
 }
 
-HRESULT TissueForge::space_init(
-    struct space *s, 
-    const FPTYPE *origin, 
-    const FPTYPE *dim,
-    FPTYPE *L, 
-    FPTYPE cutoff, 
-    const struct BoundaryConditions *bc) 
-{
+/** Initialize the random generators of the cells */
+static void space_init_generators(const int &nr_cells) {
+    generators.resize(nr_cells);
+    distributions.resize(nr_cells);
+    for(int i = 0; i < nr_cells; ++i) {
+        generators[i] = std::mt19937(i);
+        distributions[i] = std::normal_distribution<FPTYPE>(0.f, 1.f);
+    }
+}
+
+/**
+ * @brief Make the cells of a space for its dimensions in cells and cutoff, and generate their tasks. 
+ * 
+ * @param s The #space. 
+ * @param bc The boundary conditions. 
+ */
+static HRESULT space_init_cells(struct space *s, const struct BoundaryConditions *bc) {
 
     int i, j, k, l[3], ii, jj, kk;
     int id1, id2, sid;
     FPTYPE o[3], lh[3];
     struct space_cell *ci, *cj;
-    
-    /* check inputs */
-    if(s == NULL || origin == NULL || dim == NULL || L == NULL)
-        return error(MDCERR_null);
-
-    /* Clear the space. */
-    bzero(s, sizeof(struct space));
 
-    /* set origin and compute the dimensions */
-    for(i = 0 ; i < 3 ; i++) {
-        s->origin[i] = origin[i];
-        s->dim[i] = dim[i];
-        s->cdim[i] = floor(dim[i] / L[i]);
-    }
-
-    /* remember the cutoff */
-    s->cutoff = cutoff;
-    s->cutoff2 = cutoff*cutoff;
-
-    /* set the periodicity */
-    s->period = bc->periodic;
+    s->generation = ++space_generation_last;
 
     /* allocate the cells */
     s->nr_cells = s->cdim[0] * s->cdim[1] * s->cdim[2];
     s->cells = (struct space_cell *)malloc(sizeof(struct space_cell) * s->nr_cells);
-    bzero(s->cells, sizeof(struct space_cell) * s->nr_cells);
     
-    /** init random generators for cells */
-    generators.resize(s->nr_cells);
-    distributions.resize(s->nr_cells);
-    for(int i = 0; i < s->nr_cells; ++i) {
-        generators[i] = std::mt19937(i);
-        distributions[i] = std::normal_distribution<FPTYPE>(0.f, 1.f);
-    }
+    space_init_generators(s->nr_cells);
     
     if(s->cells == NULL)
         return error(MDCERR_malloc);
+    bzero(s->cells, sizeof(struct space_cell) * s->nr_cells);
 
     /* get the dimensions of each cell */
     for(i = 0 ; i < 3 ; i++) {
@@ -772,11 +1046,11 @@ HRESULT TissueForge::space_init(
     
     /* initialize the cells  */
     for(l[0] = 0 ; l[0] < s->cdim[0] ; l[0]++) {
-        o[0] = origin[0] + l[0] * s->h[0];
+        o[0] = s->origin[0] + l[0] * s->h[0];
         for(l[1] = 0 ; l[1] < s->cdim[1] ; l[1]++) {
-            o[1] = origin[1] + l[1] * s->h[1];
+            o[1] = s->origin[1] + l[1] * s->h[1];
             for(l[2] = 0 ; l[2] < s->cdim[2] ; l[2]++) {
-                o[2] = origin[2] + l[2] * s->h[2];
+                o[2] = s->origin[2] + l[2] * s->h[2];
                 
                 space_cell *c = &(s->cells[space_cellid(s,l[0],l[1],l[2])]);
                 
@@ -881,7 +1155,7 @@ HRESULT TissueForge::space_init(
 
     /* Get the span of the cells we will search for pairs. */
     for(k = 0 ; k < 3 ; k++)
-        s->span[k] = ceil(cutoff * s->ih[k]);
+        s->span[k] = ceil(s->cutoff * s->ih[k]);
 
     /* allocate the tasks array (pessimistic guess) */
     s->tasks_size = s->nr_cells *((2*s->span[0] + 1) * (2*s->span[1] + 1) * (2*s->span[2] + 1) + 1);
@@ -1025,6 +1299,45 @@ HRESULT TissueForge::space_init(
         return error(MDCERR_malloc);
     bzero(s->cells_owner, sizeof(char) * s->nr_cells);
 
+    return S_OK;
+}
+
+HRESULT TissueForge::space_init(
+    struct space *s, 
+    const FPTYPE *origin, 
+    const FPTYPE *dim,
+    FPTYPE *L, 
+    FPTYPE cutoff, 
+    const struct BoundaryConditions *bc) 
+{
+
+    int i, k, l[3];
+    
+    /* check inputs */
+    if(s == NULL || origin == NULL || dim == NULL || L == NULL)
+        return error(MDCERR_null);
+
+    /* Clear the space. */
+    bzero(s, sizeof(struct space));
+
+    /* set origin and compute the dimensions */
+    for(i = 0 ; i < 3 ; i++) {
+        s->origin[i] = origin[i];
+        s->dim[i] = dim[i];
+        s->cdim[i] = floor(dim[i] / L[i]);
+    }
+
+    /* remember the cutoff */
+    s->cutoff = cutoff;
+    s->cutoff2 = cutoff*cutoff;
+
+    /* set the periodicity */
+    s->period = bc->periodic;
+
+    /* make the cells and their tasks */
+    if(space_init_cells(s, bc) != S_OK) 
+        return error(MDCERR_space);
+
     /* allocate the initial partlist */
     if((s->partlist = (struct Particle **)malloc(sizeof(struct Particle *) * space_partlist_incr)) == NULL)
         return error(MDCERR_malloc);
@@ -1060,6 +1373,235 @@ HRESULT TissueForge::space_init(
 
 }
 
+/**
+ * @brief Free the cells of a space and their tasks. 
+ * 
+ * @param s The #space. 
+ */
+static void space_free_cells(struct space *s) {
+    for(int cid = 0; s->cells && cid < s->nr_cells; cid++) {
+        struct space_cell *c = &s->cells[cid];
+        aligned_Free(c->parts);
+        aligned_Free(c->incomming);
+        free(c->sortlist);
+        free(c->oldx);
+        pthread_mutex_destroy(&c->cell_mutex);
+        pthread_cond_destroy(&c->cell_cond);
+    }
+    free(s->cells);
+    free(s->cid_real);
+    free(s->cid_ghost);
+    free(s->cid_marked);
+    free(s->tasks);
+    free(s->cells_taboo);
+    free(s->cells_owner);
+
+    s->cells = NULL;
+    s->cid_real = s->cid_ghost = s->cid_marked = NULL;
+    s->nr_cells = s->nr_real = s->nr_ghost = s->nr_marked = 0;
+    s->tasks = NULL;
+    s->nr_tasks = s->tasks_size = 0;
+    s->cells_taboo = s->cells_owner = NULL;
+}
+
+/**
+ * @brief Move the cells of a space and their tasks, along with the grid that they define, to another space. 
+ * 
+ * The source is left without cells. 
+ * 
+ * @param dst The destination #space. 
+ * @param src The source #space. 
+ */
+static void space_move_cells(struct space *dst, struct space *src) {
+    for(int k = 0 ; k < 3 ; k++) {
+        dst->origin[k] = src->origin[k];
+        dst->dim[k] = src->dim[k];
+        dst->cdim[k] = src->cdim[k];
+        dst->span[k] = src->span[k];
+        dst->h[k] = src->h[k];
+        dst->ih[k] = src->ih[k];
+    }
+    dst->cells = src->cells;
+    dst->cid_real = src->cid_real;
+    dst->cid_ghost = src->cid_ghost;
+    dst->cid_marked = src->cid_marked;
+    dst->nr_cells = src->nr_cells;
+    dst->nr_real = src->nr_real;
+    dst->nr_ghost = src->nr_ghost;
+    dst->nr_marked = src->nr_marked;
+    dst->tasks = src->tasks;
+    dst->nr_tasks = src->nr_tasks;
+    dst->tasks_size = src->tasks_size;
+    dst->cells_taboo = src->cells_taboo;
+    dst->cells_owner = src->cells_owner;
+    dst->cellorder = src->cellorder;
+
+    src->cells = NULL;
+    src->cid_real = src->cid_ghost = src->cid_marked = NULL;
+    src->nr_cells = src->nr_real = src->nr_ghost = src->nr_marked = 0;
+    src->tasks = NULL;
+    src->nr_tasks = src->tasks_size = 0;
+    src->cells_taboo = src->cells_owner = NULL;
+}
+
+/**
+ * @brief Replace the cells of a space with a grid of the given origin and dimensions. 
+ * 
+ * @param s The #space. 
+ * @param origin Origin of the new grid. 
+ * @param dim Dimensions of the new grid. 
+ * @param cdim Dimensions in cells of the new grid. 
+ * @param bc The boundary conditions. 
+ */
+static HRESULT space_rebuild(
+    struct space *s, 
+    const FPTYPE *origin, 
+    const FPTYPE *dim, 
+    const int *cdim, 
+    const struct BoundaryConditions *bc) 
+{
+
+    int i, k, cid, pid, nr_parts;
+    struct space_cell *c;
+    struct Particle *parts = NULL;
+    struct space s_old;
+
+    /* Collect the particles of all cells, with their global positions. */
+    nr_parts = 0;
+    for(cid = 0 ; cid < s->nr_cells ; cid++) 
+        nr_parts += s->cells[cid].count;
+    if(nr_parts > 0 && (parts = (struct Particle *)malloc(sizeof(struct Particle) * nr_parts)) == NULL) 
+        return error(MDCERR_malloc);
+    std::vector<FPTYPE> xparts(3 * nr_parts);
+
+    i = 0;
+    for(cid = 0 ; cid < s->nr_cells ; cid++) {
+        c = &s->cells[cid];
+        for(pid = 0 ; pid < c->count ; pid++, i++) {
+            memcpy(&parts[i], &c->parts[pid], sizeof(struct Particle));
+            for(k = 0 ; k < 3 ; k++) 
+                xparts[3 * i + k] = c->parts[pid].x[k] + c->origin[k];
+        }
+    }
+
+    /* Keep the current cells until the new cells hold all particles, so that a failure can restore them. */
+    bzero(&s_old, sizeof(struct space));
+    space_move_cells(&s_old, s);
+    for(k = 0 ; k < 3 ; k++) {
+        s->origin[k] = origin[k];
+        s->dim[k] = dim[k];
+        s->cdim[k] = cdim[k];
+    }
+
+    /* On failure, discard the new cells and point the particles back to their old cells. */
+    auto restore = [&s, &s_old, &parts]() -> void {
+        space_free_cells(s);
+        space_move_cells(s, &s_old);
+        space_init_generators(s->nr_cells);
+        s->generation = ++space_generation_last;
+
+        for(int cid = 0 ; cid < s->nr_cells ; cid++) {
+            struct space_cell *c = &s->cells[cid];
+            for(int pid = 0 ; pid < c->count ; pid++) {
+                s->partlist[c->parts[pid].id] = &c->parts[pid];
+                s->celllist[c->parts[pid].id] = c;
+            }
+        }
+
+        free(parts);
+    };
+
+    /* Build the new cells and their tasks. */
+    if(space_init_cells(s, bc) != S_OK || 
+        (s->cellorder != space_cellorder_rowmajor && space_set_cellorder(s, s->cellorder) != S_OK)) 
+    {
+        restore();
+        return error(MDCERR_space);
+    }
+
+    /* Put the particles in the new cells, by their global positions. */
+    for(i = 0 ; i < nr_parts ; i++) {
+        if(space_setpartp(s, &parts[i], &xparts[3 * i], NULL) != S_OK) {
+            restore();
+            return error(MDCERR_space);
+        }
+    }
+    free(parts);
+
+    /* Large particles stay in their cell, which moves with the origin. */
+    for(pid = 0 ; pid < s->largeparts.count ; pid++) 
+        for(k = 0 ; k < 3 ; k++) 
+            s->largeparts.parts[pid].x[k] += s_old.origin[k] - s->origin[k];
+    for(k = 0 ; k < 3 ; k++) {
+        s->largeparts.origin[k] = s->origin[k];
+        s->largeparts.dim[k] = s->h[k];
+    }
+
+    /* Release the old cells. */
+    space_free_cells(&s_old);
+
+    /* Trigger re-building the cells/sorts. */
+    s->verlet_rebuild = 1;
+    s->maxdx = 0.0;
+
+    return S_OK;
+}
+
+HRESULT TissueForge::space_regrid(struct space *s, const int *cdim, const struct BoundaryConditions *bc) {
+
+    int k;
+
+    /* check inputs */
+    if(s == NULL || cdim == NULL || bc == NULL)
+        return error(MDCERR_null);
+    for(k = 0 ; k < 3 ; k++) 
+        if(cdim[k] < 1 || (s->period & (space_periodic_x << k) && cdim[k] < 3)) 
+            return error(MDCERR_range);
+
+    FPTYPE origin[3] = {s->origin[0], s->origin[1], s->origin[2]};
+    FPTYPE dim[3] = {s->dim[0], s->dim[1], s->dim[2]};
+    return space_rebuild(s, origin, dim, cdim, bc);
+}
+
+HRESULT TissueForge::space_resize(struct space *s, const int *lower, const int *upper, const struct BoundaryConditions *bc) {
+
+    int k, cid, pid, ind;
+    int cdim[3];
+    FPTYPE origin[3], dim[3];
+    struct space_cell *c;
+
+    /* check inputs */
+    if(s == NULL || lower == NULL || upper == NULL || bc == NULL)
+        return error(MDCERR_null);
+    for(k = 0 ; k < 3 ; k++) {
+        if((lower[k] != 0 || upper[k] != 0) && s->period & (space_periodic_x << k)) 
+            return error(MDCERR_range);
+        cdim[k] = s->cdim[k] + lower[k] + upper[k];
+        if(cdim[k] < 1) 
+            return error(MDCERR_range);
+        origin[k] = s->origin[k] - lower[k] * s->h[k];
+        dim[k] = s->dim[k] + (lower[k] + upper[k]) * s->h[k];
+    }
+
+    /* Only empty layers can be removed. */
+    for(cid = 0 ; cid < s->nr_cells ; cid++) {
+        c = &s->cells[cid];
+        if(c->count == 0) 
+            continue;
+        for(k = 0 ; k < 3 ; k++) 
+            if(c->loc[k] < -lower[k] || c->loc[k] >= s->cdim[k] + upper[k]) 
+                return error(MDCERR_range);
+    }
+    for(pid = 0 ; pid < s->largeparts.count ; pid++) 
+        for(k = 0 ; k < 3 ; k++) {
+            ind = std::floor(s->largeparts.parts[pid].x[k] * s->ih[k]);
+            if(ind < -lower[k] || ind >= s->cdim[k] + upper[k]) 
+                return error(MDCERR_range);
+        }
+
+    return space_rebuild(s, origin, dim, cdim, bc);
+}
+
 int TissueForge::space_gettuple(struct space *s, struct celltuple **out, int wait) {
 
     int i, j, k;
@@ -22,6 +22,8 @@
 
 #include <tf_port.h>
 
+#include <vector>
+
 
 namespace TissueForge { 
 
@@ -48,12 +50,17 @@ namespace TissueForge {
         /**
          * @brief First call before forces are calculated for a step. 
          * 
+         * Work launched here can proceed concurrently with the calculation of particle forces 
+         * until the subengine is joined, and so must not modify particles in the meantime. 
+         * 
          * @return HRESULT 
          */
         virtual HRESULT preStepStart() { return S_OK; };
 
         /**
-         * @brief Last call before forces are calculated for a step.
+         * @brief Last call before particles are integrated for a step. 
+         * 
+         * Called after particle forces are calculated, so forces added here are integrated for the step. 
          * 
          * @return HRESULT 
          */
@@ -73,6 +80,22 @@ namespace TissueForge {
          */
         virtual HRESULT postStepJoin() { return S_OK; };
 
+        /**
+         * @brief Called after the engine renumbers particles. 
+         * 
+         * @param newIds new id of each particle by previous id; -1 if no particle had the previous id
+         * @return HRESULT 
+         */
+        virtual HRESULT renumberParticles(const std::vector<int> &newIds) { return S_OK; };
+
+        /**
+         * @brief Called after the engine deletes a particle, before its id can be recycled. 
+         * 
+         * @param pid id of the deleted particle
+         * @return HRESULT 
+         */
+        virtual HRESULT releaseParticle(const int &pid) { return S_OK; };
+
         /**
          * @brief Called during termination of a simulation, just before shutdown of Tissue Forge engine.
          * 
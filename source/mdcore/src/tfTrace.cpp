@@ -0,0 +1,303 @@
+/*******************************************************************************
+ * This file is part of mdcore.
+ * Copyright (c) 2022-2024 T.J. Sego
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <tfTrace.h>
+
+#include <tfError.h>
+#include <tfLogger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+
+using namespace TissueForge;
+
+
+std::atomic<bool> trace::_traceActive{false};
+
+
+/** Ring buffer of the events recorded by one thread */
+struct TraceBuffer {
+
+    std::vector<trace::TraceEvent> events;
+
+    /** Total number of events recorded since the last reset; only written by the owning thread */
+    std::atomic<uint64_t> count{0};
+
+    std::string name;
+
+    int tid;
+
+};
+
+static std::mutex trace_lock;
+static std::vector<std::unique_ptr<TraceBuffer> > trace_buffers;
+static unsigned int trace_capacity = TF_TRACE_CAPACITY_DEFAULT;
+static uint64_t trace_origin = 0;
+
+/** Buffers of exited threads, available for reuse by new threads */
+static std::vector<TraceBuffer*> trace_buffersFree;
+
+/** Owner of the buffer of a thread; returns the buffer for reuse when the thread exits */
+struct TraceBufferOwner {
+
+    TraceBuffer *buffer = NULL;
+
+    ~TraceBufferOwner() {
+        if(!buffer)
+            return;
+
+        std::lock_guard<std::mutex> lock(trace_lock);
+        trace_buffersFree.push_back(buffer);
+    }
+
+};
+
+static thread_local TraceBufferOwner trace_localBuffer;
+
+static const char *trace_categoryNames[] = {
+    "engine",
+    "runner",
+    "bonded",
+    "subengine",
+    "event",
+    "io"
+};
+
+
+static TraceBuffer *trace_getBuffer() {
+    if(trace_localBuffer.buffer)
+        return trace_localBuffer.buffer;
+
+    std::lock_guard<std::mutex> lock(trace_lock);
+
+    // Reuse the buffer of an exited thread, along with its trace id and recorded events
+    if(!trace_buffersFree.empty()) {
+        TraceBuffer *buffer = trace_buffersFree.back();
+        trace_buffersFree.pop_back();
+        buffer->name = "thread " + std::to_string(buffer->tid);
+        trace_localBuffer.buffer = buffer;
+        return buffer;
+    }
+
+    auto buffer = std::make_unique<TraceBuffer>();
+    buffer->tid = trace_buffers.size();
+    buffer->name = "thread " + std::to_string(buffer->tid);
+    // Storage is only allocated while tracing, or when tracing starts
+    if(trace::isActive())
+        buffer->events.resize(trace_capacity);
+    trace_localBuffer.buffer = buffer.get();
+    trace_buffers.push_back(std::move(buffer));
+    return trace_localBuffer.buffer;
+}
+
+static void trace_escape(std::ostream &os, const char *s) {
+    for(; *s; s++) {
+        switch(*s) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            default:
+                if((unsigned char)*s < 0x20) {
+                    char buff[8];
+                    std::snprintf(buff, sizeof(buff), "\\u%04x", (unsigned int)*s);
+                    os << buff;
+                }
+                else
+                    os << *s;
+        }
+    }
+}
+
+static void trace_writeTimestamp(std::ostream &os, const uint64_t &ns) {
+    char buff[32];
+    std::snprintf(buff, sizeof(buff), "%llu.%03llu", (unsigned long long)(ns / 1000), (unsigned long long)(ns % 1000));
+    os << buff;
+}
+
+uint64_t trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+HRESULT trace::start(const unsigned int &capacity) {
+    if(capacity == 0)
+        return tf_error(E_FAIL, "Trace capacity must be positive");
+
+    {
+        std::lock_guard<std::mutex> lock(trace_lock);
+
+        trace_capacity = capacity;
+        for(auto &buffer : trace_buffers) {
+            buffer->events.resize(trace_capacity);
+            buffer->count.store(0);
+        }
+        trace_origin = now();
+    }
+
+    setThreadName("main");
+
+    TF_Log(LOG_INFORMATION) << "Tracing started with capacity " << capacity << " per thread";
+
+    _traceActive.store(true);
+    return S_OK;
+}
+
+HRESULT trace::stop() {
+    _traceActive.store(false);
+
+    TF_Log(LOG_INFORMATION) << "Tracing stopped with " << numEvents() << " events";
+
+    return S_OK;
+}
+
+HRESULT trace::clear() {
+    std::lock_guard<std::mutex> lock(trace_lock);
+
+    for(auto &buffer : trace_buffers)
+        buffer->count.store(0);
+    trace_origin = now();
+
+    return S_OK;
+}
+
+size_t trace::numEvents() {
+    std::lock_guard<std::mutex> lock(trace_lock);
+
+    size_t result = 0;
+    for(auto &buffer : trace_buffers)
+        result += std::min<uint64_t>(buffer->count.load(std::memory_order_acquire), buffer->events.size());
+    return result;
+}
+
+void trace::setThreadName(const std::string &name) {
+    TraceBuffer *buffer = trace_getBuffer();
+
+    std::lock_guard<std::mutex> lock(trace_lock);
+    buffer->name = name;
+}
+
+void trace::record(
+    const TraceCategory &category,
+    const char *name,
+    const uint64_t &begin,
+    const uint64_t &end,
+    const int32_t &arg0,
+    const int32_t &arg1)
+{
+    if(!isActive())
+        return;
+
+    TraceBuffer *buffer = trace_getBuffer();
+    const size_t capacity = buffer->events.size();
+    if(capacity == 0)
+        return;
+
+    const uint64_t count = buffer->count.load(std::memory_order_relaxed);
+    TraceEvent &e = buffer->events[count % capacity];
+    e.begin = begin;
+    e.end = end;
+    e.name = name;
+    e.arg0 = arg0;
+    e.arg1 = arg1;
+    e.category = category;
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+static void trace_writeChromeJSON(std::ostream &os) {
+    std::lock_guard<std::mutex> lock(trace_lock);
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for(auto &buffer : trace_buffers) {
+        if(!first)
+            os << ",";
+        first = false;
+
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->tid << ",\"args\":{\"name\":\"";
+        trace_escape(os, buffer->name.c_str());
+        os << "\"}}";
+
+        const uint64_t count = buffer->count.load(std::memory_order_acquire);
+        const uint64_t capacity = buffer->events.size();
+        const uint64_t numEvents = std::min(count, capacity);
+        for(uint64_t i = count - numEvents; i < count; i++) {
+            const trace::TraceEvent &e = buffer->events[i % capacity];
+            if(e.begin < trace_origin)
+                continue;
+
+            os << ",{\"name\":\"";
+            trace_escape(os, e.name ? e.name : "");
+            os << "\",\"cat\":\"" << trace_categoryNames[e.category] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid;
+            os << ",\"ts\":";
+            trace_writeTimestamp(os, e.begin - trace_origin);
+            os << ",\"dur\":";
+            trace_writeTimestamp(os, e.end > e.begin ? e.end - e.begin : 0);
+
+            if(e.arg0 >= 0 || e.arg1 >= 0) {
+                const char *argName0 = e.category == trace::TRACE_RUNNER ? "cid_i" : "arg0";
+                const char *argName1 = e.category == trace::TRACE_RUNNER ? "cid_j" : "arg1";
+                os << ",\"args\":{";
+                if(e.arg0 >= 0)
+                    os << "\"" << argName0 << "\":" << e.arg0;
+                if(e.arg1 >= 0)
+                    os << (e.arg0 >= 0 ? "," : "") << "\"" << argName1 << "\":" << e.arg1;
+                os << "}";
+            }
+
+            os << "}";
+        }
+    }
+
+    os << "]}";
+}
+
+std::string trace::toChromeJSON() {
+    std::stringstream ss;
+    trace_writeChromeJSON(ss);
+    return ss.str();
+}
+
+HRESULT trace::toFile(const std::string &filePath) {
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if(!file.is_open())
+        return tf_error(E_FAIL, ("Could not open trace file: " + filePath).c_str());
+
+    trace_writeChromeJSON(file);
+    file.close();
+
+    if(file.fail())
+        return tf_error(E_FAIL, ("Failed to write trace file: " + filePath).c_str());
+
+    TF_Log(LOG_INFORMATION) << "Trace written to " << filePath;
+
+    return S_OK;
+}
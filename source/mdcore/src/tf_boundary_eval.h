@@ -201,6 +201,47 @@ namespace TissueForge {
     }
 
 
+    /**
+     * @brief Smallest distance between a particle and a wall at which a potential is evaluated
+     */
+    TF_ALWAYS_INLINE FPTYPE boundary_sdf_rmin(Potential *pot, FPTYPE ri, FPTYPE rj) {
+        FPTYPE r = pot->a;
+        if(pot->flags & POTENTIAL_SCALED) 
+            r = r * (ri + rj);
+        else if(pot->flags & POTENTIAL_SHIFTED) 
+            r = r + (ri + rj) - pot->r0_plusone;
+        return std::max(r, FPTYPE_EPSILON);
+    }
+
+    TF_ALWAYS_INLINE bool boundary_sdf_eval(BoundarySDF *sdf, const struct space_cell *cell, Particle *part, FPTYPE *epot) {
+
+        Potential *pot = sdf->condition.potenntials[part->typeId];
+        if(!pot) 
+            return false;
+
+        FPTYPE x[3], n[3];
+        for(int k = 0; k < 3; k++) 
+            x[k] = cell->origin[k] + part->x[k];
+        
+        const FPTYPE d = sdf->interpolate(x, n);
+        if(d > pot->b + part->radius + sdf->condition.radius) 
+            return false;
+
+        const FPTYPE nlen = FPTYPE_SQRT(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if(nlen < FPTYPE_EPSILON) 
+            return false;
+
+        // Particles closer than the minimum distance of the potential, including those that penetrated the wall, 
+        // are pushed out as if at the minimum distance
+        const FPTYPE r = std::max(d, boundary_sdf_rmin(pot, part->radius, sdf->condition.radius));
+        FPTYPE dx[3];
+        for(int k = 0; k < 3; k++) 
+            dx[k] = r * n[k] / nlen;
+
+        return boundary_potential_eval_ex(cell, pot, part, &sdf->condition, dx, r * r, epot);
+    }
+
+
     TF_ALWAYS_INLINE bool boundary_eval(BoundaryConditions *bc, const struct space_cell *cell, Particle *part, FPTYPE *epot ) {
         
         Potential *pot;
@@ -250,6 +291,11 @@ namespace TissueForge {
             dx[2] = -r;
             result |= boundary_potential_eval_ex(cell, pot, part, &bc->top, dx, r*r, epot);
         }
+
+        if(cell->flags & cell_flag_sdf) 
+            for(auto &sdf : _Engine.boundary_sdfs) 
+                result |= boundary_sdf_eval(sdf, cell, part, epot);
+        
         return result;
     }
 
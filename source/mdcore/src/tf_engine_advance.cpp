@@ -28,9 +28,15 @@
 #include <tfError.h>
 #include <tfLogger.h>
 #include <tfTaskScheduler.h>
+#include <tfTrace.h>
+#include <tf_util.h>
 
 #include <math.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include <sstream>
 #pragma clang diagnostic ignored "-Wwritable-strings"
 #include <iostream>
@@ -62,6 +68,8 @@ using namespace TissueForge;
 
 static HRESULT engine_advance_forward_euler(struct engine *e);
 static HRESULT engine_advance_runge_kutta_4(struct engine *e);
+static HRESULT engine_advance_verlet(struct engine *e);
+static HRESULT engine_advance_respa(struct engine *e);
 
 
 
@@ -85,6 +93,12 @@ HRESULT TissueForge::engine_advance(struct engine *e) {
     if(e->integrator == EngineIntegrator::FORWARD_EULER) {
         return engine_advance_forward_euler(e);
     }
+    else if(e->integrator == EngineIntegrator::VELOCITY_VERLET && e->respa_steps > 1) {
+        return engine_advance_respa(e);
+    }
+    else if(e->integrator == EngineIntegrator::VELOCITY_VERLET || e->integrator == EngineIntegrator::BAOAB) {
+        return engine_advance_verlet(e);
+    }
     else {
         return engine_advance_runge_kutta_4(e);
     }
@@ -115,9 +129,17 @@ static FQuaternion integrate_angular_velocity_2(const FVector3 &av, FPTYPE dt) {
     }
 }
 
+/** Ids of the real cells in staggered order; rebuilt when the grid of cells changes */
 static int *cell_staggered_ids(space *s) { 
+    static int *ids = NULL;
+    static int ids_cdim[3] = {0, 0, 0};
+    if(ids && ids_cdim[0] == s->cdim[0] && ids_cdim[1] == s->cdim[1] && ids_cdim[2] == s->cdim[2]) 
+        return ids;
+
+    for(int k = 0; k < 3; k++) 
+        ids_cdim[k] = s->cdim[k];
     int ind = 0;
-    int *ids = (int*)malloc(sizeof(int) * s->nr_real);
+    ids = (int*)realloc(ids, sizeof(int) * s->nr_real);
     for(int ii = 0; ii < 3; ii++) 
         for(int jj = 0; jj < 3; jj++) 
             for(int kk = 0; kk < 3; kk++) 
@@ -133,9 +155,108 @@ static int *cell_staggered_ids(space *s) {
 
 // FPTYPE dt, h[3], h2[3], maxv[3], maxv2[3], maxx[3], maxx2[3]; // h, h2: edge length of space cells.
 
+/**
+ * @brief Velocity-Verlet and BAOAB update of a Newtonian particle. 
+ * 
+ * The particle velocity holds the velocity predicted at the end of the step, 
+ * and vk[0] the acceleration with which the prediction was made, 
+ * so that velocity-dependent forces see velocities synchronized with positions 
+ * and only one force evaluation is needed per step. 
+ * 
+ * @param p particle
+ * @param mask frozen mask
+ * @param dt time step
+ * @param maxv maximum velocity
+ * @param maxv2 squared maximum velocity
+ * @param c1 Langevin velocity damping factor; ignored without a random number generator
+ * @param kT Langevin thermal energy; ignored without a random number generator
+ * @param rng random number generator of the BAOAB O-step; velocity-Verlet when NULL
+ */
+static inline void particle_advance_verlet(
+    Particle *p, const FPTYPE mask[3], const FPTYPE dt, const FPTYPE maxv[3], const FPTYPE maxv2[3], 
+    const FPTYPE c1, const FPTYPE kT, RandomType *rng) 
+{
+    FPTYPE a[3], v[3];
+    for(int k = 0; k < 3; k++) {
+        a[k] = mask[k] * p->f[k] * p->imass;
+        // synchronize with the new acceleration, then kick
+        v[k] = mask[k] * (p->v[k] + 0.5 * dt * (a[k] - p->vk[0][k])) + 0.5 * dt * a[k];
+    }
+
+    if(rng) {
+        // A
+        for(int k = 0; k < 3; k++) 
+            p->x[k] += 0.5 * dt * v[k];
+        // O
+        FPTYPE c2 = std::sqrt((1.0 - c1 * c1) * kT * p->imass);
+        std::normal_distribution<FPTYPE> dist(0.0, 1.0);
+        for(int k = 0; k < 3; k++) {
+            FPTYPE vk = mask[k] * (c1 * v[k] + c2 * dist(*rng));
+            v[k] = vk * vk <= maxv2[k] ? vk : vk / abs(vk) * maxv[k];
+        }
+        // A
+        for(int k = 0; k < 3; k++) 
+            p->x[k] += 0.5 * dt * v[k];
+    }
+    else {
+        for(int k = 0; k < 3; k++) {
+            v[k] = v[k] * v[k] <= maxv2[k] ? v[k] : v[k] / abs(v[k]) * maxv[k];
+            p->x[k] += dt * v[k];
+        }
+    }
+
+    for(int k = 0; k < 3; k++) {
+        p->v[k] = v[k] + 0.5 * dt * a[k];
+        p->vk[0][k] = a[k];
+    }
+}
+
+/**
+ * @brief Finish a multiple-time-step update of a Newtonian particle. 
+ * 
+ * Positions and velocities were already advanced by the inner steps. 
+ * The particle velocity is replaced by the velocity predicted at the end of the step 
+ * from the slow force, stored in vk[1], and the last fast force, stored in vk[2]. 
+ * 
+ * @param p particle
+ * @param mask frozen mask
+ * @param dt outer time step
+ * @param dt_inner inner time step
+ * @param maxv maximum velocity
+ * @param maxv2 squared maximum velocity
+ */
+static inline void particle_advance_respa(
+    Particle *p, const FPTYPE mask[3], const FPTYPE dt, const FPTYPE dt_inner, const FPTYPE maxv[3], const FPTYPE maxv2[3]) 
+{
+    for(int k = 0; k < 3; k++) {
+        FPTYPE v = mask[k] * (p->v[k] + 0.5 * (dt * p->vk[1][k] + dt_inner * p->vk[2][k]) * p->imass);
+        p->v[k] = v * v <= maxv2[k] ? v : v / abs(v) * maxv[k];
+        p->f[k] = p->vk[1][k] + p->vk[2][k];
+    }
+}
+
+/** Per-particle updates of cell_advance_forward_euler */
+enum CellAdvanceMode {
+    CELL_ADVANCE_EULER = 0, 
+    CELL_ADVANCE_VERLET, 
+    CELL_ADVANCE_RESPA, 
+    CELL_ADVANCE_FIRE
+};
+
+/**
+ * @brief Advance the particles of a cell and move them between cells. 
+ * 
+ * Newtonian particles are integrated according to @p mode, 
+ * with a BAOAB Langevin O-step when a random number generator is passed to velocity-Verlet. 
+ * In multiple-time-step mode, positions were already advanced, 
+ * and @p c1 is the inner time step. 
+ * In FIRE mode, all particles are integrated as Newtonian particles, 
+ * after mixing their velocity with their force as @p c1 * v + @p kT * f. 
+ */
 static inline void cell_advance_forward_euler(const FPTYPE dt, const FPTYPE h[3], const FPTYPE h2[3],
                    const FPTYPE maxv[3], const FPTYPE maxv2[3], const FPTYPE maxx[3],
-                   const FPTYPE maxx2[3], int cid)
+                   const FPTYPE maxx2[3], int cid, 
+                   const CellAdvanceMode mode=CELL_ADVANCE_EULER, const FPTYPE c1=1.0, const FPTYPE kT=0.0, RandomType *rng=NULL)
 {
     space *s = &_Engine.s;
     int pid = 0;
@@ -163,11 +284,37 @@ static inline void cell_advance_forward_euler(const FPTYPE dt, const FPTYPE h[3]
         };
         
         int delta[3];
-        if(engine::types[p->typeId].dynamics == PARTICLE_NEWTONIAN) {
+        if(mode == CELL_ADVANCE_FIRE) {
+            for(int k = 0 ; k < 3 ; k++) {
+                FPTYPE f = mask[k] * p->f[k];
+                FPTYPE dx = mask[k] * dt * (c1 * p->v[k] + kT * f + dt * f * p->imass);
+                dx = dx * dx <= maxx2[k] ? dx : dx / abs(dx) * maxx[k];
+                p->v[k] = dx / dt;
+                p->x[k] += dx;
+                delta[k] = std::isgreaterequal(p->x[k], h[k]) - std::isless(p->x[k], 0.0);
+            }
+        }
+        else if(engine::types[p->typeId].dynamics == PARTICLE_NEWTONIAN) {
+            if(mode != CELL_ADVANCE_EULER) {
+                if(mode == CELL_ADVANCE_VERLET) 
+                    particle_advance_verlet(p, mask, dt, maxv, maxv2, c1, kT, rng);
+                else 
+                    particle_advance_respa(p, mask, dt, c1, maxv, maxv2);
+                for(int k = 0 ; k < 3 ; k++) 
+                    delta[k] = std::isgreaterequal(p->x[k], h[k]) - std::isless(p->x[k], 0.0);
+            }
+            else {
+                for(int k = 0 ; k < 3 ; k++) {
+                    FPTYPE v = mask[k] * (p->v[k] + dt * p->f[k] * p->imass);
+                    p->v[k] = v * v <= maxv2[k] ? v : v / abs(v) * maxv[k];
+                    p->x[k] += dt * p->v[k];
+                    delta[k] = std::isgreaterequal(p->x[k], h[k]) - std::isless(p->x[k], 0.0);
+                }
+            }
+        }
+        else if(mode == CELL_ADVANCE_RESPA) {
             for(int k = 0 ; k < 3 ; k++) {
-                FPTYPE v = mask[k] * (p->v[k] + dt * p->f[k] * p->imass);
-                p->v[k] = v * v <= maxv2[k] ? v : v / abs(v) * maxv[k];
-                p->x[k] += dt * p->v[k];
+                p->f[k] = p->vk[1][k] + p->vk[2][k];
                 delta[k] = std::isgreaterequal(p->x[k], h[k]) - std::isless(p->x[k], 0.0);
             }
         }
@@ -306,14 +453,20 @@ HRESULT engine_advance_forward_euler(struct engine *e) {
 
     TF_Log(LOG_TRACE);
 
-    // do flux substeps, if any
-    if(!(e->flags & engine_flag_cuda) && e->nr_fluxsteps > 1) {
-        auto func = [](int cid) -> void { Fluxes_integrate(&_Engine.s.cells[cid], _Engine.dt_flux); };
-        for(e->step_flux = 0; e->step_flux < e->nr_fluxsteps - 1; e->step_flux++) {
-            if(engine_fluxonly_eval(e) != S_OK) 
+    // do flux substeps, if any. 
+    // particles do not move during substeps, so replay a cached stencil. 
+    // the last explicit substep is evaluated with the forces; implicit substeps are all done here. 
+    if(!(e->flags & engine_flag_cuda) && (e->nr_fluxsteps > 1 || e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT)) {
+        int nr_substeps = e->flux_integrator == FLUX_INTEGRATOR_EXPLICIT ? e->nr_fluxsteps - 1 : e->nr_fluxsteps;
+
+        if(Fluxes_stencil_build(e) != S_OK) 
+            return error(MDCERR_engine);
+        for(e->step_flux = 0; e->step_flux < nr_substeps; e->step_flux++) 
+            if(Fluxes_stencil_step(e, e->dt_flux) != S_OK) 
                 return error(MDCERR_engine);
-            parallel_for(e->s.nr_real, func);
-        }
+
+        if(e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT) 
+            e->integrator_flags |= INTEGRATOR_FLUX_STENCIL;
 
         TF_Log(LOG_TRACE);
     }
@@ -322,7 +475,9 @@ HRESULT engine_advance_forward_euler(struct engine *e) {
     // forward euler is a single step, so alwasy set this flag
     e->integrator_flags |= INTEGRATOR_UPDATE_PERSISTENTFORCE;
 
-    if (engine_force(e) != S_OK) {
+    HRESULT hr_force = engine_force(e);
+    e->integrator_flags &= ~INTEGRATOR_FLUX_STENCIL;
+    if (hr_force != S_OK) {
         TF_Log(LOG_CRITICAL);
         return error(MDCERR_engine);
     }
@@ -431,9 +586,9 @@ HRESULT engine_advance_forward_euler(struct engine *e) {
         // const FPTYPE maxv[3], const FPTYPE maxv2[3], const FPTYPE maxx[3],
         // const FPTYPE maxx2[3], FPTYPE *total_pot, int cid)
 
-        static int *staggered_ids = cell_staggered_ids(s);
+        int *staggered_ids = cell_staggered_ids(s);
         
-        auto func = [dt, &h, &h2, &maxv, &maxv2, &maxx, &maxx2](int cid) -> void {
+        auto func = [dt, &h, &h2, &maxv, &maxv2, &maxx, &maxx2, staggered_ids](int cid) -> void {
             int _cid = staggered_ids[cid];
             cell_advance_forward_euler(dt, h, h2, maxv, maxv2, maxx, maxx2, _cid);
             Fluxes_integrate(&_Engine.s.cells[_cid], _Engine.dt_flux);
@@ -441,7 +596,7 @@ HRESULT engine_advance_forward_euler(struct engine *e) {
         
         parallel_for(s->nr_real, func);
 
-        auto func_advance_clusters = [&h](int _cid) -> void {
+        auto func_advance_clusters = [&h, staggered_ids](int _cid) -> void {
             cell_advance_forward_euler_cluster(h, staggered_ids[_cid]);
         };
         parallel_for(s->nr_real, func_advance_clusters);
@@ -475,6 +630,345 @@ HRESULT engine_advance_forward_euler(struct engine *e) {
     return S_OK;
 }
 
+/**
+ * @brief Update the particle velocities and positions with velocity-Verlet, 
+ *      or BAOAB Langevin dynamics, and re-shuffle if appropriate. 
+ * 
+ * Forces are evaluated once per step. 
+ * 
+ * @param e The #engine on which to run.
+ */
+HRESULT engine_advance_verlet(struct engine *e) {
+
+    TF_Log(LOG_TRACE);
+
+    // verlet lists and mpi advance particles without moving them between cells here
+    if((e->flags & engine_flag_verlet) || (e->flags & engine_flag_mpi)) 
+        return engine_advance_forward_euler(e);
+
+    // do flux substeps, if any, as with forward euler.
+    if(!(e->flags & engine_flag_cuda) && (e->nr_fluxsteps > 1 || e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT)) {
+        int nr_substeps = e->flux_integrator == FLUX_INTEGRATOR_EXPLICIT ? e->nr_fluxsteps - 1 : e->nr_fluxsteps;
+
+        if(Fluxes_stencil_build(e) != S_OK) 
+            return error(MDCERR_engine);
+        for(e->step_flux = 0; e->step_flux < nr_substeps; e->step_flux++) 
+            if(Fluxes_stencil_step(e, e->dt_flux) != S_OK) 
+                return error(MDCERR_engine);
+
+        if(e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT) 
+            e->integrator_flags |= INTEGRATOR_FLUX_STENCIL;
+    }
+
+    // one force evaluation per step, so always set persistent forces
+    e->integrator_flags |= INTEGRATOR_UPDATE_PERSISTENTFORCE;
+
+    HRESULT hr_force = engine_force(e);
+    e->integrator_flags &= ~INTEGRATOR_FLUX_STENCIL;
+    if (hr_force != S_OK) {
+        TF_Log(LOG_CRITICAL);
+        return error(MDCERR_engine);
+    }
+
+    ticks tic = getticks();
+
+    struct space *s = &(e->s);
+    FPTYPE dt = e->dt, h[3], h2[3], maxv[3], maxv2[3], maxx[3], maxx2[3];
+    FPTYPE epot = 0.0, computed_volume = 0.0;
+    for(int k = 0 ; k < 3 ; k++) {
+        h[k] = s->h[k];
+        h2[k] = 2. * s->h[k];
+        maxx[k] = h[k] * e->particle_max_dist_fraction;
+        maxx2[k] = maxx[k] * maxx[k];
+        maxv[k] = maxx[k] / dt;
+        maxv2[k] = maxv[k] * maxv[k];
+    }
+
+    // langevin thermostat: draw one seed per cell so that cells can be advanced in parallel
+    bool langevin = e->integrator == EngineIntegrator::BAOAB;
+    FPTYPE c1 = langevin ? std::exp(- e->langevin_friction * dt) : 1.0;
+    FPTYPE kT = e->K * e->temperature;
+    std::vector<unsigned int> seeds;
+    if(langevin) {
+        RandomType &randEng = randomEngine();
+        seeds.resize(s->nr_real);
+        for(int cid = 0; cid < s->nr_real; cid++) 
+            seeds[cid] = randEng();
+    }
+
+    int *staggered_ids = cell_staggered_ids(s);
+
+    auto func = [&](int cid) -> void {
+        int _cid = staggered_ids[cid];
+        if(langevin) {
+            RandomType rng(seeds[cid]);
+            cell_advance_forward_euler(dt, h, h2, maxv, maxv2, maxx, maxx2, _cid, CELL_ADVANCE_VERLET, c1, kT, &rng);
+        }
+        else 
+            cell_advance_forward_euler(dt, h, h2, maxv, maxv2, maxx, maxx2, _cid, CELL_ADVANCE_VERLET);
+        Fluxes_integrate(&_Engine.s.cells[_cid], _Engine.dt_flux);
+    };
+    parallel_for(s->nr_real, func);
+
+    auto func_advance_clusters = [&h, staggered_ids](int _cid) -> void {
+        cell_advance_forward_euler_cluster(h, staggered_ids[_cid]);
+    };
+    parallel_for(s->nr_real, func_advance_clusters);
+
+    auto func_space_cell_welcome = [&](int _cid) -> void {
+        space_cell_welcome(&(s->cells[ s->cid_marked[_cid] ]), s->partlist);
+    };
+    parallel_for(s->nr_marked, func_space_cell_welcome);
+
+    for(int cid = 0; cid < s->nr_cells; cid++) {
+        epot += s->cells[cid].epot;
+        computed_volume += s->cells[cid].computed_volume;
+    }
+
+    s->epot += epot;
+    s->epot_nonbond += epot;
+    e->computed_volume = computed_volume;
+
+    VERIFY_PARTICLES();
+
+    e->timers[engine_timer_advance] += getticks() - tic;
+
+    TF_Log(LOG_TRACE);
+
+    return S_OK;
+}
+
+/**
+ * @brief Get the mask of a particle for multiple-time-step updates. 
+ * 
+ * @param p particle
+ * @param mask frozen mask
+ * @return true if the particle is advanced
+ */
+static inline bool particle_respa_mask(Particle *p, FPTYPE mask[3]) {
+    if(p->flags & PARTICLE_CLUSTER) 
+        return false;
+    mask[0] = (p->flags & PARTICLE_FROZEN_X) ? 0.0f : 1.0f;
+    mask[1] = (p->flags & PARTICLE_FROZEN_Y) ? 0.0f : 1.0f;
+    mask[2] = (p->flags & PARTICLE_FROZEN_Z) ? 0.0f : 1.0f;
+    return mask[0] + mask[1] + mask[2] > 0;
+}
+
+/**
+ * @brief Apply the slow force of a multiple-time-step update to the particles of a cell. 
+ * 
+ * Newtonian particles are synchronized with the new slow force and kicked over half an outer step. 
+ * Overdamped particles are displaced over an outer step. 
+ * The slow force is stored in vk[1] and forces are cleared for the fast evaluations. 
+ */
+static inline void cell_advance_respa_slow(const FPTYPE dt, const FPTYPE maxx[3], const FPTYPE maxx2[3], int cid) {
+    space_cell *c = &(_Engine.s.cells[ _Engine.s.cid_real[cid] ]);
+    FPTYPE mask[3];
+
+    for(int pid = 0; pid < c->count; pid++) {
+        Particle *p = &c->parts[pid];
+        if(particle_respa_mask(p, mask)) {
+            if(engine::types[p->typeId].dynamics == PARTICLE_NEWTONIAN) {
+                for(int k = 0; k < 3; k++) 
+                    p->v[k] = mask[k] * (p->v[k] + 0.5 * dt * (2.0 * p->f[k] - p->vk[1][k]) * p->imass);
+            }
+            else {
+                for(int k = 0; k < 3; k++) {
+                    FPTYPE dx = mask[k] * (dt * p->f[k] * p->imass);
+                    dx = dx * dx <= maxx2[k] ? dx : dx / abs(dx) * maxx[k];
+                    p->v[k] = dx / dt;
+                    p->x[k] += dx;
+                }
+            }
+        }
+        p->vk[1] = p->force;
+        p->force = FVector3(0.0);
+    }
+}
+
+/**
+ * @brief Apply the fast force of an inner step of a multiple-time-step update to the particles of a cell. 
+ * 
+ * The fast force is stored in vk[2] and forces are cleared for the next fast evaluation. 
+ */
+static inline void cell_advance_respa_fast(
+    const FPTYPE dt, const FPTYPE dt_inner, const FPTYPE maxv[3], const FPTYPE maxv2[3], const bool first, int cid) 
+{
+    space_cell *c = &(_Engine.s.cells[ _Engine.s.cid_real[cid] ]);
+    FPTYPE mask[3];
+
+    for(int pid = 0; pid < c->count; pid++) {
+        Particle *p = &c->parts[pid];
+        if(particle_respa_mask(p, mask)) {
+            if(engine::types[p->typeId].dynamics == PARTICLE_NEWTONIAN) {
+                for(int k = 0; k < 3; k++) {
+                    // the first kick also synchronizes with the fast force of the previous step
+                    FPTYPE dv = first ? p->f[k] - 0.5 * p->vk[2][k] : p->f[k];
+                    FPTYPE v = mask[k] * (p->v[k] + dt_inner * dv * p->imass);
+                    p->v[k] = v * v <= maxv2[k] ? v : v / abs(v) * maxv[k];
+                    p->x[k] += dt_inner * p->v[k];
+                }
+            }
+            else {
+                for(int k = 0; k < 3; k++) {
+                    FPTYPE dx = mask[k] * (dt_inner * p->f[k] * p->imass);
+                    dx = dx * dx <= maxv2[k] * dt_inner * dt_inner ? dx : dx / abs(dx) * maxv[k] * dt_inner;
+                    p->v[k] += dx / dt;
+                    p->x[k] += dx;
+                }
+            }
+        }
+        p->vk[2] = p->force;
+        p->force = FVector3(0.0);
+    }
+}
+
+/**
+ * @brief Update the particle velocities and positions with multiple-time-step velocity-Verlet (r-RESPA), 
+ *      and re-shuffle if appropriate. 
+ * 
+ * Nonbonded and single-body forces, and forces of subengines, are evaluated once per step 
+ * and applied as impulses at the ends of the step. 
+ * Bonded forces are evaluated every inner step. 
+ * 
+ * @param e The #engine on which to run.
+ */
+HRESULT engine_advance_respa(struct engine *e) {
+
+    TF_Log(LOG_TRACE);
+
+    if(e->flags & engine_flag_cuda) 
+        return engine_advance_verlet(e);
+    if((e->flags & engine_flag_verlet) || (e->flags & engine_flag_mpi)) 
+        return engine_advance_forward_euler(e);
+
+    // do flux substeps, if any, as with forward euler.
+    if(e->nr_fluxsteps > 1 || e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT) {
+        int nr_substeps = e->flux_integrator == FLUX_INTEGRATOR_EXPLICIT ? e->nr_fluxsteps - 1 : e->nr_fluxsteps;
+
+        if(Fluxes_stencil_build(e) != S_OK) 
+            return error(MDCERR_engine);
+        for(e->step_flux = 0; e->step_flux < nr_substeps; e->step_flux++) 
+            if(Fluxes_stencil_step(e, e->dt_flux) != S_OK) 
+                return error(MDCERR_engine);
+
+        if(e->flux_integrator != FLUX_INTEGRATOR_EXPLICIT) 
+            e->integrator_flags |= INTEGRATOR_FLUX_STENCIL;
+    }
+
+    e->integrator_flags |= INTEGRATOR_UPDATE_PERSISTENTFORCE;
+
+    // slow forces
+    ticks tic = getticks();
+    HRESULT hr_force = engine_nonbond_eval(e);
+    e->integrator_flags &= ~INTEGRATOR_FLUX_STENCIL;
+    if (hr_force != S_OK) {
+        TF_Log(LOG_CRITICAL);
+        return error(MDCERR_engine);
+    }
+    e->timers[engine_timer_nonbond] += getticks() - tic;
+
+    // forces of subengines are slow forces
+    if(engine_subengines_join(e) != S_OK) 
+        return error(MDCERR_subengine);
+
+    tic = getticks();
+
+    struct space *s = &(e->s);
+    const int nr_inner = e->respa_steps;
+    FPTYPE dt = e->dt, dt_inner = dt / nr_inner, h[3], h2[3], maxv[3], maxv2[3], maxx[3], maxx2[3];
+    FPTYPE epot = 0.0, computed_volume = 0.0;
+    for(int k = 0 ; k < 3 ; k++) {
+        h[k] = s->h[k];
+        h2[k] = 2. * s->h[k];
+        maxx[k] = h[k] * e->particle_max_dist_fraction;
+        maxx2[k] = maxx[k] * maxx[k];
+        maxv[k] = maxx[k] / dt;
+        maxv2[k] = maxv[k] * maxv[k];
+    }
+
+    auto func_slow = [dt, &maxx, &maxx2](int cid) -> void {
+        cell_advance_respa_slow(dt, maxx, maxx2, cid);
+    };
+    parallel_for(s->nr_real, func_slow);
+
+    e->timers[engine_timer_advance] += getticks() - tic;
+
+    // fast forces; bonded potential energies are those at the beginning of the step.
+    // bonded interactions see the inner time step, e.g., when decaying
+    FPTYPE epot_step = 0.0, epot_bond = 0.0, epot_angle = 0.0, epot_dihedral = 0.0, epot_exclusion = 0.0;
+    for(int i = 0; i < nr_inner; i++) {
+        tic = getticks();
+        e->dt = dt_inner;
+        hr_force = e->flags & engine_flag_sets ? engine_bonded_eval_sets(e) : engine_bonded_eval(e);
+        e->dt = dt;
+        if(hr_force != S_OK) {
+            TF_Log(LOG_CRITICAL);
+            return error(MDCERR_engine);
+        }
+        e->timers[engine_timer_bonded] += getticks() - tic;
+
+        if(i == 0) {
+            epot_step = s->epot;
+            epot_bond = s->epot_bond;
+            epot_angle = s->epot_angle;
+            epot_dihedral = s->epot_dihedral;
+            epot_exclusion = s->epot_exclusion;
+        }
+
+        tic = getticks();
+        auto func_fast = [dt, dt_inner, &maxv, &maxv2, i](int cid) -> void {
+            cell_advance_respa_fast(dt, dt_inner, maxv, maxv2, i == 0, cid);
+        };
+        parallel_for(s->nr_real, func_fast);
+        e->timers[engine_timer_advance] += getticks() - tic;
+    }
+    s->epot = epot_step;
+    s->epot_bond = epot_bond;
+    s->epot_angle = epot_angle;
+    s->epot_dihedral = epot_dihedral;
+    s->epot_exclusion = epot_exclusion;
+
+    tic = getticks();
+
+    // finish the step and move particles between cells
+    int *staggered_ids = cell_staggered_ids(s);
+
+    auto func = [dt, dt_inner, &h, &h2, &maxv, &maxv2, &maxx, &maxx2, staggered_ids](int cid) -> void {
+        int _cid = staggered_ids[cid];
+        cell_advance_forward_euler(dt, h, h2, maxv, maxv2, maxx, maxx2, _cid, CELL_ADVANCE_RESPA, dt_inner);
+        Fluxes_integrate(&_Engine.s.cells[_cid], _Engine.dt_flux);
+    };
+    parallel_for(s->nr_real, func);
+
+    auto func_advance_clusters = [&h, staggered_ids](int _cid) -> void {
+        cell_advance_forward_euler_cluster(h, staggered_ids[_cid]);
+    };
+    parallel_for(s->nr_real, func_advance_clusters);
+
+    auto func_space_cell_welcome = [&](int _cid) -> void {
+        space_cell_welcome(&(s->cells[ s->cid_marked[_cid] ]), s->partlist);
+    };
+    parallel_for(s->nr_marked, func_space_cell_welcome);
+
+    for(int cid = 0; cid < s->nr_cells; cid++) {
+        epot += s->cells[cid].epot;
+        computed_volume += s->cells[cid].computed_volume;
+    }
+
+    s->epot += epot;
+    s->epot_nonbond += epot;
+    e->computed_volume = computed_volume;
+
+    VERIFY_PARTICLES();
+
+    e->timers[engine_timer_advance] += getticks() - tic;
+
+    TF_Log(LOG_TRACE);
+
+    return S_OK;
+}
+
 #define CHECK_TOOFAST(p, h, h2) \
 {\
     for(int _k = 0; _k < 3; _k++) {\
@@ -519,6 +1013,9 @@ HRESULT engine_advance_runge_kutta_4(struct engine *e) {
     /* update the particle velocities and positions */
     if ((e->flags & engine_flag_verlet) || (e->flags & engine_flag_mpi)) {
 
+        if(engine_subengines_join(e) != S_OK) 
+            return error(MDCERR_subengine);
+
         /* Collect potential energy from ghosts. */
         for(cid = 0 ; cid < s->nr_ghost ; cid++)
             epot += s->cells[ s->cid_ghost[cid] ].epot;
@@ -757,3 +1254,192 @@ HRESULT engine_advance_runge_kutta_4(struct engine *e) {
     /* return quietly */
     return S_OK;
 }
+
+/* Parameters of the FIRE algorithm; see Bitzek et al., Phys. Rev. Lett. 97, 170201 (2006). */
+#define engine_fire_nmin        5
+#define engine_fire_finc        1.1
+#define engine_fire_fdec        0.5
+#define engine_fire_alpha       0.1
+#define engine_fire_falpha      0.99
+
+HRESULT TissueForge::engine_minimize(struct engine *e, FPTYPE ftol, FPTYPE etol, int max_steps, FPTYPE dt_max, int *nr_steps) {
+
+    TF_Log(LOG_TRACE);
+    TF_TRACE_SCOPE(TRACE_ENGINE, "minimize");
+
+    if(e->flags & (engine_flag_cuda | engine_flag_mpi | engine_flag_verlet)) 
+        return error(MDCERR_nyi);
+    if(ftol < 0 || etol < 0 || max_steps < 0) 
+        return tf_error(E_FAIL, "Minimization tolerances and number of steps must be non-negative");
+
+    space *s = &e->s;
+    FPTYPE h[3], h2[3], maxv[3], maxv2[3], maxx[3], maxx2[3];
+    for(int k = 0; k < 3; k++) {
+        h[k] = s->h[k];
+        h2[k] = 2. * s->h[k];
+        maxx[k] = h[k] * e->particle_max_dist_fraction;
+        maxx2[k] = maxx[k] * maxx[k];
+        maxv[k] = maxx[k] / e->dt;
+        maxv2[k] = maxv[k] * maxv[k];
+    }
+
+    // rest also clears the caches of all integrators, so that no force from before the relaxation carries into the next step
+    auto func_rest = [&s](int _cid) -> void {
+        space_cell *c = &s->cells[s->cid_real[_cid]];
+        for(int pid = 0; pid < c->count; pid++) {
+            Particle *p = &c->parts[pid];
+            p->v = FVector3(0.0);
+            for(int k = 0; k < 4; k++) 
+                p->vk[k] = FVector3(0.0);
+        }
+    };
+    parallel_for(s->nr_real, func_rest);
+
+    // per-cell power, squared speed, squared force and largest squared force on a particle
+    std::vector<FPTYPE> sums;
+    auto func_reduce = [&s, &sums](int _cid) -> void {
+        space_cell *c = &s->cells[s->cid_real[_cid]];
+        FPTYPE *sum = &sums[4 * _cid];
+        for(int pid = 0; pid < c->count; pid++) {
+            Particle *p = &c->parts[pid];
+            if(p->flags & PARTICLE_CLUSTER) 
+                continue;
+
+            FPTYPE f2 = 0.0;
+            for(int k = 0; k < 3; k++) {
+                if(p->flags & (PARTICLE_FROZEN_X << k)) 
+                    continue;
+                sum[0] += p->f[k] * p->v[k];
+                sum[1] += p->v[k] * p->v[k];
+                f2 += p->f[k] * p->f[k];
+            }
+            sum[2] += f2;
+            sum[3] = std::max(sum[3], f2);
+        }
+    };
+
+    HRESULT hr = S_OK;
+    FPTYPE dt = e->dt;
+    if(dt_max <= 0) 
+        dt_max = 10 * e->dt;
+    FPTYPE alpha = engine_fire_alpha;
+    FPTYPE epot_prev = 0.0, f2_max = 0.0;
+    int nr_positive = 0;
+    int result = -1;
+
+    // transport is not part of the relaxation
+    e->integrator_flags |= INTEGRATOR_FLUX_STENCIL;
+
+    for(int step = 0; step <= max_steps; step++) {
+
+        /* Evaluate the forces of the current configuration, as in a step. */
+        e->integrator_flags |= INTEGRATOR_UPDATE_PERSISTENTFORCE;
+        if((hr = engine_force_prep(e)) != S_OK) 
+            break;
+        for(auto &se : e->subengines) 
+            if((hr = se->preStepStart()) != S_OK) 
+                break;
+        if(hr != S_OK) 
+            break;
+        e->integrator_flags |= INTEGRATOR_SUBENGINES_PENDING;
+        if((hr = engine_force(e)) != S_OK) 
+            break;
+
+        sums.assign(4 * s->nr_real, 0.0);
+        parallel_for(s->nr_real, func_reduce);
+
+        FPTYPE power = 0.0, v2 = 0.0, f2 = 0.0, epot = 0.0;
+        f2_max = 0.0;
+        for(int cid = 0; cid < s->nr_real; cid++) {
+            power += sums[4 * cid];
+            v2 += sums[4 * cid + 1];
+            f2 += sums[4 * cid + 2];
+            f2_max = std::max(f2_max, sums[4 * cid + 3]);
+        }
+        for(int cid = 0; cid < s->nr_cells; cid++) 
+            epot += s->cells[cid].epot;
+        s->epot += epot;
+        s->epot_nonbond += epot;
+        epot = s->epot;
+
+        TF_Log(LOG_DEBUG) << "minimize: " << step << ", potential energy: " << epot << ", max force: " << std::sqrt(f2_max) << ", dt: " << dt;
+
+        /* Test for convergence. */
+        if(f2_max <= ftol * ftol || 
+            (step > 0 && etol > 0 && std::fabs(epot - epot_prev) <= 0.5 * etol * (std::fabs(epot) + std::fabs(epot_prev) + FPTYPE_EPSILON))) 
+        {
+            result = step;
+            break;
+        }
+        if(step == max_steps) 
+            break;
+        epot_prev = epot;
+
+        /* Steer the velocities toward the forces while moving downhill, and restart from rest otherwise. */
+        FPTYPE c_v, c_f;
+        if(power < 0) {
+            c_v = 0.0;
+            c_f = 0.0;
+            nr_positive = 0;
+            dt *= engine_fire_fdec;
+            alpha = engine_fire_alpha;
+        }
+        else {
+            c_v = 1.0 - alpha;
+            c_f = f2 > 0 ? alpha * std::sqrt(v2 / f2) : 0.0;
+            if(++nr_positive > engine_fire_nmin) {
+                dt = std::min<FPTYPE>(dt * engine_fire_finc, dt_max);
+                alpha *= engine_fire_falpha;
+            }
+        }
+
+        /* Move the particles and the particles between cells. */
+        int *staggered_ids = cell_staggered_ids(s);
+
+        auto func = [dt, c_v, c_f, &h, &h2, &maxv, &maxv2, &maxx, &maxx2, staggered_ids](int cid) -> void {
+            cell_advance_forward_euler(dt, h, h2, maxv, maxv2, maxx, maxx2, staggered_ids[cid], CELL_ADVANCE_FIRE, c_v, c_f);
+        };
+        parallel_for(s->nr_real, func);
+
+        auto func_advance_clusters = [&h, staggered_ids](int _cid) -> void {
+            cell_advance_forward_euler_cluster(h, staggered_ids[_cid]);
+        };
+        parallel_for(s->nr_real, func_advance_clusters);
+
+        auto func_space_cell_welcome = [&](int _cid) -> void {
+            space_cell_welcome(&(s->cells[ s->cid_marked[_cid] ]), s->partlist);
+        };
+        parallel_for(s->nr_marked, func_space_cell_welcome);
+
+        /* Let subengines follow the particles. */
+        for(auto &se : e->subengines) 
+            if((hr = se->postStepStart()) != S_OK) 
+                break;
+        if(hr != S_OK) 
+            break;
+        for(auto &se : e->subengines) 
+            if((hr = se->postStepJoin()) != S_OK) 
+                break;
+        if(hr != S_OK) 
+            break;
+    }
+
+    if(engine_subengines_join(e) != S_OK) 
+        hr = E_FAIL;
+    e->integrator_flags &= ~INTEGRATOR_FLUX_STENCIL;
+    if(hr != S_OK) 
+        return error(MDCERR_engine);
+
+    parallel_for(s->nr_real, func_rest);
+    engine_energy_drift_reset(e);
+
+    if(result < 0) 
+        TF_Log(LOG_WARNING) << "engine: minimization did not converge after " << max_steps << " iterations, max force: " << std::sqrt(f2_max);
+    else 
+        TF_Log(LOG_INFORMATION) << "engine: minimization converged after " << result << " iterations, potential energy: " << s->epot;
+
+    if(nr_steps) 
+        *nr_steps = result;
+
+    return S_OK;
+}
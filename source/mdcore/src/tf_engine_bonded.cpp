@@ -25,6 +25,8 @@
 #include <pthread.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 /* Include conditional headers. */
 #include <mdcore_config.h>
@@ -53,6 +55,7 @@
 #include <tfEngine.h>
 #include <tfLogger.h>
 #include <tfError.h>
+#include <tfTrace.h>
 
 #pragma clang diagnostic ignored "-Wwritable-strings"
 
@@ -130,6 +133,8 @@ HRESULT TissueForge::engine_bonded_eval_sets(struct engine *e) {
 				break;
 
 			/* Evaluate the bonded interaction in the set. */
+			TF_TRACE_SCOPE(TRACE_BONDED, "set", set_curr);
+
 			/* Do exclusions. */
 			tic = getticks();
 			exclusion_eval(e->sets[set_curr].exclusions, e->sets[set_curr].nr_exclusions, e, &epot_local_exclusion);
@@ -177,22 +182,34 @@ HRESULT TissueForge::engine_bonded_eval_sets(struct engine *e) {
 
 		/* Do exclusions. */
 		tic = getticks();
-		exclusion_eval(e->exclusions, e->nr_exclusions, e, &epot_exclusion);
+		{
+			TF_TRACE_SCOPE(TRACE_BONDED, "exclusions", e->nr_exclusions);
+			exclusion_eval(e->exclusions, e->nr_exclusions, e, &epot_exclusion);
+		}
 		e->timers[engine_timer_exclusions] += getticks() - tic;
 
 		/* Do bonds. */
 		tic = getticks();
-		bond_eval(e->bonds, e->nr_bonds, e, &epot_bond);
+		{
+			TF_TRACE_SCOPE(TRACE_BONDED, "bonds", e->nr_bonds);
+			bond_eval(e->bonds, e->nr_bonds, e, &epot_bond);
+		}
 		e->timers[engine_timer_bonds] += getticks() - tic;
 
 		/* Do angles. */
 		tic = getticks();
-		angle_eval(e->angles, e->nr_angles, e, &epot_angle);
+		{
+			TF_TRACE_SCOPE(TRACE_BONDED, "angles", e->nr_angles);
+			angle_eval(e->angles, e->nr_angles, e, &epot_angle);
+		}
 		e->timers[engine_timer_angles] += getticks() - tic;
 
 		/* Do dihedrals. */
 		tic = getticks();
-		dihedral_eval(e->dihedrals, e->nr_dihedrals, e, &epot_dihedral);
+		{
+			TF_TRACE_SCOPE(TRACE_BONDED, "dihedrals", e->nr_dihedrals);
+			dihedral_eval(e->dihedrals, e->nr_dihedrals, e, &epot_dihedral);
+		}
 		e->timers[engine_timer_dihedrals] += getticks() - tic;
 
 	}
@@ -200,26 +217,38 @@ HRESULT TissueForge::engine_bonded_eval_sets(struct engine *e) {
 
 	/* Do exclusions. */
 	tic = getticks();
-	if(exclusion_eval(e->exclusions, e->nr_exclusions, e, &epot_exclusion) != S_OK)
-		return error(MDCERR_exclusion);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "exclusions", e->nr_exclusions);
+		if(exclusion_eval(e->exclusions, e->nr_exclusions, e, &epot_exclusion) != S_OK)
+			return error(MDCERR_exclusion);
+	}
 	e->timers[engine_timer_exclusions] += getticks() - tic;
 
 	/* Do bonds. */
 	tic = getticks();
-	if(bond_eval(e->bonds, e->nr_bonds, e, &epot_bond) != S_OK)
-		return error(MDCERR_bond);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "bonds", e->nr_bonds);
+		if(bond_eval(e->bonds, e->nr_bonds, e, &epot_bond) != S_OK)
+			return error(MDCERR_bond);
+	}
 	e->timers[engine_timer_bonds] += getticks() - tic;
 
 	/* Do angles. */
 	tic = getticks();
-	if(angle_eval(e->angles, e->nr_angles, e, &epot_angle) != S_OK)
-		return error(MDCERR_angle);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "angles", e->nr_angles);
+		if(angle_eval(e->angles, e->nr_angles, e, &epot_angle) != S_OK)
+			return error(MDCERR_angle);
+	}
 	e->timers[engine_timer_angles] += getticks() - tic;
 
 	/* Do dihedrals. */
 	tic = getticks();
-	if(dihedral_eval(e->dihedrals, e->nr_dihedrals, e, &epot_dihedral) != S_OK)
-		return error(MDCERR_dihedral);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "dihedrals", e->nr_dihedrals);
+		if(dihedral_eval(e->dihedrals, e->nr_dihedrals, e, &epot_dihedral) != S_OK)
+			return error(MDCERR_dihedral);
+	}
 	e->timers[engine_timer_dihedrals] += getticks() - tic;
 
 #endif
@@ -1184,6 +1213,168 @@ int TissueForge::engine_bond_alloc (struct engine *e, Bond **out) {
     return result;
 }
 
+HRESULT TissueForge::engine_bond_alloc_n(struct engine *e, int nr, int32_t *ids) {
+
+	/* Check inputs. */
+	if(e == NULL || (nr > 0 && ids == NULL)) 
+		return error(MDCERR_null);
+
+	int k = 0;
+
+	// first take any deleted bonds we can re-use
+	if(e->nr_active_bonds < e->nr_bonds) 
+		for(int i = 0; i < e->nr_bonds && k < nr; ++i) 
+			if(!(e->bonds[i].flags & BOND_ACTIVE)) 
+				ids[k++] = i;
+
+	/* Grow the bonds array once for the remainder. */
+	int nr_needed = e->nr_bonds + nr - k;
+	if(nr_needed > e->bonds_size) {
+		int size_new = e->bonds_size;
+		while(size_new < nr_needed) 
+			size_new = std::max(size_new + 1, (int)(size_new * 1.414));
+		struct Bond *dummy;
+		if((dummy = (struct Bond *)malloc(sizeof(struct Bond) * size_new)) == NULL) 
+			return error(MDCERR_malloc);
+		memcpy(dummy, e->bonds, sizeof(struct Bond) * e->nr_bonds);
+		free(e->bonds);
+		e->bonds = dummy;
+		e->bonds_size = size_new;
+	}
+	for(; k < nr; ++k) 
+		ids[k] = e->nr_bonds++;
+
+	for(k = 0; k < nr; ++k) {
+		bzero(&e->bonds[ids[k]], sizeof(Bond));
+		e->bonds[ids[k]].id = ids[k];
+	}
+
+	TF_Log(LOG_TRACE) << "Allocated bonds: " << nr;
+
+	return S_OK;
+}
+
+static void engine_bonded_index_insert(std::vector<std::vector<int32_t> > &index, int pid, int32_t id) {
+	if(pid < 0) 
+		return;
+	if(pid >= index.size()) 
+		index.resize(pid + 1);
+	std::vector<int32_t> &ids = index[pid];
+	// participants may be repeated within an interaction; store each interaction once per particle
+	if(std::find(ids.begin(), ids.end(), id) == ids.end()) 
+		ids.push_back(id);
+}
+
+static void engine_bonded_index_erase(std::vector<std::vector<int32_t> > &index, int pid, int32_t id) {
+	if(pid < 0 || pid >= index.size()) 
+		return;
+	std::vector<int32_t> &ids = index[pid];
+	auto itr = std::find(ids.begin(), ids.end(), id);
+	if(itr != ids.end()) {
+		*itr = ids.back();
+		ids.pop_back();
+	}
+}
+
+HRESULT TissueForge::engine_bond_index_add(struct engine *e, int bid) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(bid < 0 || bid >= e->nr_bonds) 
+		return error(MDCERR_id);
+
+	Bond *b = &e->bonds[bid];
+	engine_bonded_index_insert(e->part_bonds, b->i, bid);
+	engine_bonded_index_insert(e->part_bonds, b->j, bid);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_bond_index_remove(struct engine *e, int bid) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(bid < 0 || bid >= e->nr_bonds) 
+		return error(MDCERR_id);
+
+	Bond *b = &e->bonds[bid];
+	engine_bonded_index_erase(e->part_bonds, b->i, bid);
+	engine_bonded_index_erase(e->part_bonds, b->j, bid);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_angle_index_add(struct engine *e, int aid) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(aid < 0 || aid >= e->nr_angles) 
+		return error(MDCERR_id);
+
+	Angle *a = &e->angles[aid];
+	engine_bonded_index_insert(e->part_angles, a->i, aid);
+	engine_bonded_index_insert(e->part_angles, a->j, aid);
+	engine_bonded_index_insert(e->part_angles, a->k, aid);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_angle_index_remove(struct engine *e, int aid) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(aid < 0 || aid >= e->nr_angles) 
+		return error(MDCERR_id);
+
+	Angle *a = &e->angles[aid];
+	engine_bonded_index_erase(e->part_angles, a->i, aid);
+	engine_bonded_index_erase(e->part_angles, a->j, aid);
+	engine_bonded_index_erase(e->part_angles, a->k, aid);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_dihedral_index_add(struct engine *e, int did) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(did < 0 || did >= e->nr_dihedrals) 
+		return error(MDCERR_id);
+
+	Dihedral *d = &e->dihedrals[did];
+	engine_bonded_index_insert(e->part_dihedrals, d->i, did);
+	engine_bonded_index_insert(e->part_dihedrals, d->j, did);
+	engine_bonded_index_insert(e->part_dihedrals, d->k, did);
+	engine_bonded_index_insert(e->part_dihedrals, d->l, did);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_dihedral_index_remove(struct engine *e, int did) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+	if(did < 0 || did >= e->nr_dihedrals) 
+		return error(MDCERR_id);
+
+	Dihedral *d = &e->dihedrals[did];
+	engine_bonded_index_erase(e->part_dihedrals, d->i, did);
+	engine_bonded_index_erase(e->part_dihedrals, d->j, did);
+	engine_bonded_index_erase(e->part_dihedrals, d->k, did);
+	engine_bonded_index_erase(e->part_dihedrals, d->l, did);
+	return S_OK;
+}
+
+HRESULT TissueForge::engine_bonded_index_rebuild(struct engine *e) {
+	if(e == NULL) 
+		return error(MDCERR_null);
+
+	e->part_bonds.clear();
+	e->part_angles.clear();
+	e->part_dihedrals.clear();
+
+	for(int bid = 0; bid < e->nr_bonds; bid++) 
+		if(e->bonds[bid].flags & BOND_ACTIVE) 
+			engine_bond_index_add(e, bid);
+	for(int aid = 0; aid < e->nr_angles; aid++) 
+		if(e->angles[aid].flags & ANGLE_ACTIVE) 
+			engine_angle_index_add(e, aid);
+	for(int did = 0; did < e->nr_dihedrals; did++) 
+		if(e->dihedrals[did].flags & DIHEDRAL_ACTIVE) 
+			engine_dihedral_index_add(e, did);
+
+	return S_OK;
+}
+
 HRESULT TissueForge::engine_bonded_eval(struct engine *e) {
 
 	FPTYPE epot_bond = 0.0, epot_angle = 0.0, epot_dihedral = 0.0, epot_exclusion = 0.0;
@@ -1312,26 +1503,38 @@ HRESULT TissueForge::engine_bonded_eval(struct engine *e) {
 
 	/* Do exclusions. */
 	tic = getticks();
-	if(exclusion_eval(e->exclusions, nr_exclusions, e, &epot_exclusion) != S_OK)
-		return error(MDCERR_exclusion);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "exclusions", nr_exclusions);
+		if(exclusion_eval(e->exclusions, nr_exclusions, e, &epot_exclusion) != S_OK)
+			return error(MDCERR_exclusion);
+	}
 	e->timers[engine_timer_exclusions] += getticks() - tic;
 
 	/* Do bonds. */
 	tic = getticks();
-	if(bond_eval(e->bonds, nr_bonds, e, &epot_bond) != S_OK)
-		return error(MDCERR_bond);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "bonds", nr_bonds);
+		if(bond_eval(e->bonds, nr_bonds, e, &epot_bond) != S_OK)
+			return error(MDCERR_bond);
+	}
 	e->timers[engine_timer_bonds] += getticks() - tic;
 
 	/* Do angles. */
 	tic = getticks();
-	if(angle_eval(e->angles, nr_angles, e, &epot_angle) != S_OK)
-		return error(MDCERR_angle);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "angles", nr_angles);
+		if(angle_eval(e->angles, nr_angles, e, &epot_angle) != S_OK)
+			return error(MDCERR_angle);
+	}
 	e->timers[engine_timer_angles] += getticks() - tic;
 
 	/* Do dihedrals. */
 	tic = getticks();
-	if(dihedral_eval(e->dihedrals, nr_dihedrals, e, &epot_dihedral) != S_OK)
-		return error(MDCERR_dihedral);
+	{
+		TF_TRACE_SCOPE(TRACE_BONDED, "dihedrals", nr_dihedrals);
+		if(dihedral_eval(e->dihedrals, nr_dihedrals, e, &epot_dihedral) != S_OK)
+			return error(MDCERR_dihedral);
+	}
 	e->timers[engine_timer_dihedrals] += getticks() - tic;
 
 
@@ -112,6 +112,7 @@ TF_FLATTEN HRESULT TissueForge::runner_dopair(struct runner *r,
     s = &(eng->s);
     cutoff = s->cutoff;
     cutoff2 = cutoff*cutoff;
+    const bool eval_fluxes = !(eng->integrator_flags & INTEGRATOR_FLUX_STENCIL);
     bias = sqrt(s->h[0]*s->h[0] + s->h[1]*s->h[1] + s->h[2]*s->h[2]);
     dscale = (FPTYPE)SHRT_MAX / (2 * bias);
     dmaxdist = 2 + dscale * (cutoff + 2*s->maxdx);
@@ -178,7 +179,7 @@ TF_FLATTEN HRESULT TissueForge::runner_dopair(struct runner *r,
             
             /* fetch the potential, if any */
             pot = get_potential(part_i, part_j);
-            fluxes = get_fluxes(part_i, part_j);
+            fluxes = eval_fluxes ? get_fluxes(part_i, part_j) : NULL;
 
             if(pot == NULL && fluxes == NULL) 
                 continue;
@@ -419,94 +420,84 @@ TF_FLATTEN HRESULT TissueForge::runner_dopair_fluxonly(struct runner *r,
 }
 
 static inline HRESULT particle_largecell_force(Particle *p, struct space_cell *c, FPTYPE& epot) {
-    FPTYPE w, r2, e, f, dx[4], pix[4];
-    space_cell *large = &_Engine.s.largeparts;
+    FPTYPE e, f, r2, dx[4], pix[4];
+    struct space *s = &_Engine.s;
+    space_cell *large = &s->largeparts;
+    space_largegrid *g = &s->largegrid;
     Potential *pot;
-    int k;
-    FPTYPE *pif = p->f;
-    
-    // TODO will be more local parts than large parts, so more efficient
-    // to translate large parts to local coordinate system once.
-    // but simpler to do this...
+    int k, ind[3], lo[3], hi[3];
+    bool periodic[3];
     
     for(k = 0; k < 3; ++k) {
         pix[k] = p->x[k] + c->origin[k];
+        periodic[k] = s->period & (space_periodic_x << k);
     }
+    pix[3] = FPTYPE_ZERO;
+    dx[3] = FPTYPE_ZERO;
     
-    
-    /* loop over the left particles */
-    for (int j = 0 ; j < large->count; ++j) {
-        
-        /* get a handle on the second particle */
-        Particle *part_j = &large->parts[j];
-        
-        /* fetch the potential, if any */
-        pot = get_potential(p, part_j);
-        if(pot == NULL)
-            continue;
-        
-        /* get the distance between both particles */
-        r2 = fptype_r2(pix, part_j->x, dx);
-        
-        /* is this within cutoff? */
-        // TODO add large particle cutoff...
-        //if (r2 > cutoff2)
-        //    continue;
-        
-#if defined(VECTORIZE)
-        /* add this interaction to the interaction queue. */
-        r2q[icount] = r2;
-        dxq[icount*3] = dx[0];
-        dxq[icount*3+1] = dx[1];
-        dxq[icount*3+2] = dx[2];
-        effi[icount] = pif;
-        effj[icount] = part_j->f;
-        potq[icount] = pot;
-        icount += 1;
-        
-        /* evaluate the interactions if the queue is full. */
-        if(icount == VEC_SIZE) {
-            
-#if defined(FPTYPE_SINGLE)
-#if VEC_SIZE==8
-            potential_eval_vec_8single(potq, r2q, e, f);
-#else
-            potential_eval_vec_4single(potq, r2q, e, f);
-#endif
-#elif defined(FPTYPE_DOUBLE)
-#if VEC_SIZE==4
-            potential_eval_vec_4double(potq, r2q, e, f);
-#else
-            potential_eval_vec_2double(potq, r2q, e, f);
-#endif
-#endif
-            
-            /* update the forces and the energy */
-            for(l = 0 ; l < VEC_SIZE ; l++) {
-                epot += e[l];
-                for(k = 0 ; k < 3 ; k++) {
-                    w = f[l] * dxq[l*3+k];
-                    effi[l][k] -= w;
-                    effj[l][k] += w;
-                }
+    /* loop over the levels of the large particle grid */
+    for(int l = 0; l < g->nr_levels; ++l) {
+        space_largegrid_level *level = &g->levels[l];
+
+        /* get the range of neighboring cells on this level */
+        for(k = 0; k < 3; ++k) {
+            ind[k] = std::max(0, std::min(level->cdim[k] - 1, (int)((pix[k] - s->origin[k]) * level->ih[k])));
+            if(level->cdim[k] < 3) {
+                lo[k] = 0;
+                hi[k] = level->cdim[k] - 1;
+            }
+            else if(periodic[k]) {
+                lo[k] = ind[k] - 1;
+                hi[k] = ind[k] + 1;
+            }
+            else {
+                lo[k] = std::max(0, ind[k] - 1);
+                hi[k] = std::min(level->cdim[k] - 1, ind[k] + 1);
             }
-            
-            /* re-set the counter. */
-            icount = 0;
         }
-#else
-        /* evaluate the interaction */
+
+        for(int ii = lo[0]; ii <= hi[0]; ++ii) {
+            int ci = (ii + level->cdim[0]) % level->cdim[0];
+            for(int jj = lo[1]; jj <= hi[1]; ++jj) {
+                int cj = (jj + level->cdim[1]) % level->cdim[1];
+                for(int kk = lo[2]; kk <= hi[2]; ++kk) {
+                    int ck = (kk + level->cdim[2]) % level->cdim[2];
+                    int cid = celldims_cellid(level->cdim, ci, cj, ck);
+
+                    /* loop over the large particles in the cell */
+                    for(int jdx = level->offsets[cid]; jdx < level->offsets[cid + 1]; ++jdx) {
+                        
+                        /* get a handle on the second particle */
+                        Particle *part_j = &large->parts[level->parts[jdx]];
+                        
+                        /* fetch the potential, if any */
+                        pot = get_potential(p, part_j);
+                        if(pot == NULL)
+                            continue;
+                        
+                        /* get the nearest image distance between both particles */
+                        r2 = FPTYPE_ZERO;
+                        for(k = 0; k < 3; ++k) {
+                            dx[k] = pix[k] - (part_j->x[k] + large->origin[k]);
+                            if(periodic[k]) 
+                                dx[k] -= s->dim[k] * std::round(dx[k] / s->dim[k]);
+                            r2 += dx[k] * dx[k];
+                        }
+                        
+                        /* evaluate the interaction */
 #ifdef EXPLICIT_POTENTIALS
-        potential_eval_expl(pot, r2, &e, &f);
+                        potential_eval_expl(pot, r2, &e, &f);
 #else
-        /* update the forces if part in range */
-        if(potential_eval_super_ex(c, pot, p, part_j, dx,  r2, &e)) {
-            /* tabulate the energy */
-            epot += e;
-        }
+                        /* update the forces if part in range */
+                        if(potential_eval_super_ex(c, pot, p, part_j, dx,  r2, &e)) {
+                            /* tabulate the energy */
+                            epot += e;
+                        }
 #endif // EXPLICIT_POTENTIALS
-#endif // VECTORIZE
-        
+                    }
+                }
+            }
+        }
     }
     return S_OK;
 }
@@ -545,7 +536,7 @@ TF_FLATTEN HRESULT TissueForge::runner_doself(struct runner *r, struct space_cel
     
     const unsigned cell_flags = c->flags;
     
-    const bool boundary = cell_flags & cell_active_any;
+    const bool boundary = cell_flags & (cell_active_any | cell_flag_sdf);
         
     //print_thread();
     
@@ -560,6 +551,7 @@ TF_FLATTEN HRESULT TissueForge::runner_doself(struct runner *r, struct space_cel
     forces = eng->forces;
     cutoff = s->cutoff;
     cutoff2 = s->cutoff2;
+    const bool eval_fluxes = !(eng->integrator_flags & INTEGRATOR_FLUX_STENCIL);
     pix[3] = FPTYPE_ZERO;
     
     /* Make local copies of the parts if requested. */
@@ -615,7 +607,7 @@ TF_FLATTEN HRESULT TissueForge::runner_doself(struct runner *r, struct space_cel
             part_j->number_density += number_density;
             
             pot = get_potential(part_i, part_j);
-            fluxes = get_fluxes(part_i, part_j);
+            fluxes = eval_fluxes ? get_fluxes(part_i, part_j) : NULL;
   
             if(pot == NULL && fluxes == NULL) 
                 continue;
@@ -34,6 +34,9 @@
 #include <Magnum/Math/Math.h>
 #include <Magnum/Math/Intersection.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 
 using namespace TissueForge;
 using namespace TissueForge::models::vertex;
@@ -96,6 +99,7 @@ Body::Body() :
     area{0.f}, 
     volume{0.f}, 
     density{0.f}, 
+    _geomSignature{0}, 
     typeId{-1},
     species{NULL}
 {
@@ -106,6 +110,90 @@ Body::~Body() {
     MESHOBJ_DELOBJ
 }
 
+static HRESULT Bodies_fromSurfaces(Body **b, const std::vector<std::vector<Surface*> > &surfaces) {
+    std::vector<HRESULT> resultPool(ThreadPool::size(), S_OK);
+    std::vector<std::unordered_map<Surface*, std::vector<Body*> > > toAddBodiesBySurfacePool(ThreadPool::size());
+    parallel_for(
+        ThreadPool::size(), 
+        [&b, &surfaces, &resultPool, &toAddBodiesBySurfacePool](int tid) -> void {
+            std::unordered_map<Surface*, std::vector<Body*> >& toAddBodiesBySurfaceThread = toAddBodiesBySurfacePool[tid];
+            for(int i = tid; i < surfaces.size(); i += ThreadPool::size()) {
+                const std::vector<Surface*>& surfaces_i = surfaces[i];
+                if(surfaces_i.size() < 4) {
+                    resultPool[tid] = E_FAIL;
+                    return;
+                }
+                Body* bi = b[i];
+                for(auto& s : surfaces_i) {
+                    if(bi->add(s) != S_OK) {
+                        resultPool[tid] = E_FAIL;
+                        return;
+                    }
+                    toAddBodiesBySurfaceThread[s].push_back(bi);
+                }
+            }
+        }
+    );
+    for(auto& resultThread : resultPool) 
+        if(resultThread != S_OK) 
+            return tf_error(resultThread, "A body requires at least 4 distinct surfaces");
+
+    std::unordered_map<Surface*, std::vector<Body*> > toAddBodiesBySurface;
+    for(auto& toAddBodiesBySurfaceThread : toAddBodiesBySurfacePool) 
+        for(auto& m : toAddBodiesBySurfaceThread) {
+            std::vector<Body*>& bodies_s = toAddBodiesBySurface[m.first];
+            bodies_s.insert(bodies_s.end(), m.second.begin(), m.second.end());
+        }
+    std::vector<Surface*> surfacesFlat;
+    surfacesFlat.reserve(toAddBodiesBySurface.size());
+    for(auto& m : toAddBodiesBySurface) 
+        surfacesFlat.push_back(m.first);
+
+    std::vector<HRESULT> resultSurfaces(surfacesFlat.size(), S_OK);
+    parallel_for(
+        surfacesFlat.size(), 
+        [&surfacesFlat, &toAddBodiesBySurface, &resultSurfaces](int i) -> void {
+            Surface* s = surfacesFlat[i];
+            const std::vector<Body*>& bodies_s = toAddBodiesBySurface[s];
+            if(bodies_s.size() + s->getBodies().size() > 2) 
+                resultSurfaces[i] = E_FAIL;
+            else 
+                for(auto& bi : bodies_s) 
+                    if(s->add(bi) != S_OK) 
+                        resultSurfaces[i] = E_FAIL;
+        }
+    );
+    for(auto& resultSurface : resultSurfaces) 
+        if(resultSurface != S_OK) 
+            return tf_error(resultSurface, "A surface can only define two bodies");
+
+    // same as updateInternals, but each object is updated once
+    const size_t numBodies = surfaces.size();
+    parallel_for(numBodies, [&b](int i) -> void { b[i]->positionChanged(); });
+    parallel_for(surfacesFlat.size(), [&surfacesFlat](int i) -> void { surfacesFlat[i]->refreshBodies(); });
+    parallel_for(numBodies, [&b](int i) -> void { b[i]->positionChanged(); });
+
+    return S_OK;
+}
+
+static std::vector<Body*> Bodies_create(const std::vector<std::vector<Surface*> > &_surfaces) {
+    Body_GETMESH(mesh, {});
+
+    std::vector<Body*> result(_surfaces.size(), 0);
+    Body** data = result.data();
+    if(mesh->create(&data, _surfaces.size()) != S_OK) {
+        TF_Log(LOG_ERROR);
+        return {};
+    }
+    if(Bodies_fromSurfaces(data, _surfaces) != S_OK) {
+        // Each body lists every surface that may refer to it, so removal also clears partial links
+        TF_Log(LOG_ERROR);
+        mesh->remove(data, result.size());
+        return {};
+    }
+    return result;
+}
+
 static Body *Body_create(const std::vector<SurfaceHandle> &_surfaces) {
     Body_GETMESH(mesh, NULL);
     Body *result;
@@ -155,6 +243,44 @@ BodyHandle Body::create(TissueForge::io::ThreeDFMeshData *ioMesh) {
     return create(_surfaces);
 }
 
+std::vector<BodyHandle> Body::create(const std::vector<std::vector<SurfaceHandle> > &_surfaces) {
+    if(_surfaces.empty()) 
+        return {};
+
+    std::vector<std::vector<Surface*> > _surfaces_objs(_surfaces.size());
+    std::vector<HRESULT> resultPool(ThreadPool::size(), S_OK);
+    parallel_for(
+        ThreadPool::size(), 
+        [&_surfaces, &_surfaces_objs, &resultPool](int tid) -> void {
+            for(int i = tid; i < _surfaces.size(); i += ThreadPool::size()) {
+                std::vector<Surface*>& _surfaces_objs_i = _surfaces_objs[i];
+                _surfaces_objs_i.reserve(_surfaces[i].size());
+                for(auto& s : _surfaces[i]) {
+                    Surface* _s = s.surface();
+                    if(!_s) {
+                        resultPool[tid] = E_FAIL;
+                        return;
+                    }
+                    _surfaces_objs_i.push_back(_s);
+                }
+            }
+        }
+    );
+    for(auto& resultThread : resultPool) 
+        if(resultThread != S_OK) {
+            TF_Log(LOG_ERROR);
+            return {};
+        }
+
+    std::vector<Body*> _result = Bodies_create(_surfaces_objs);
+    if(_result.empty()) 
+        return {};
+
+    std::vector<BodyHandle> result(_result.size());
+    parallel_for(result.size(), [&_result, &result](int i) -> void { result[i] = BodyHandle(_result[i]->objectId()); });
+    return result;
+}
+
 bool Body::definedBy(const Surface *obj) const { MESHOBJ_DEFINEDBY_DEF }
 
 bool Body::definedBy(const Vertex *obj) const { MESHOBJ_DEFINEDBY_DEF }
@@ -281,8 +407,7 @@ HRESULT Body::destroy(const std::vector<Body*>& toRemove) {
                         bodiesByTypeThread[btype].insert(b);
                     }
                     for(auto& s : b->getSurfaces()) 
-                        if(s->getBodies().size() == 1) 
-                            surfacesToRemoveThread.insert(s);
+                        surfacesToRemoveThread.insert(s);
                 }
             }
         }
@@ -338,17 +463,19 @@ HRESULT Body::destroy(const std::vector<Body*>& toRemove) {
 
     Mesh::get()->remove(bodiesToRemoveVec.data(), bodiesToRemoveVec.size());
 
-    // Destroy orphaned surfaces
+    // Destroy surfaces left without a body, including those shared by removed bodies
 
     size_t numSurfaces = 0;
     for(auto& surfacesToRemoveThread : surfacesToRemovePool) 
         numSurfaces += surfacesToRemoveThread.size();
-    std::vector<Surface*> surfacesToRemove;
+    std::unordered_set<Surface*> surfacesToRemove;
     surfacesToRemove.reserve(numSurfaces);
     for(auto& surfacesToRemoveThread : surfacesToRemovePool) 
         for(auto& s : surfacesToRemoveThread) 
-            surfacesToRemove.push_back(s);
-    Surface::destroy(surfacesToRemove);
+            if(s->_objId >= 0 && s->getBodies().empty()) 
+                surfacesToRemove.insert(s);
+    if(!surfacesToRemove.empty()) 
+        Surface::destroy(std::vector<Surface*>(surfacesToRemove.begin(), surfacesToRemove.end()));
 
     return S_OK;
 }
@@ -1205,6 +1332,44 @@ HRESULT BodyType::add(const BodyHandle &i) {
     return S_OK;
 }
 
+HRESULT BodyType::add(const std::vector<BodyHandle>& i) {
+    std::vector<Body*> _i(i.size());
+    std::vector<HRESULT> resultPool(ThreadPool::size(), S_OK);
+    std::vector<std::unordered_map<BodyType*, std::unordered_set<BodyHandle> > > bodyTypeMapPool(ThreadPool::size());
+    parallel_for(ThreadPool::size(), [&i, &_i, &bodyTypeMapPool, &resultPool](int tid) -> void {
+        std::unordered_map<BodyType*, std::unordered_set<BodyHandle> >& bodyTypeMapThread = bodyTypeMapPool[tid];
+        for(int j = tid; j < _i.size(); j += ThreadPool::size()) {
+            BodyHandle ij = i[j];
+            Body* _ij = ij ? ij.body() : NULL;
+            if(!_ij) {
+                resultPool[tid] = E_FAIL;
+                return;
+            }
+
+            _i[j] = _ij;
+            BodyType* btype = _ij->type();
+            if(btype) 
+                bodyTypeMapThread[btype].insert(ij);
+        }
+    });
+    for(auto& resultThread : resultPool) 
+        if(resultThread != S_OK) {
+            return tf_error(resultThread, "Failed to add object");
+        }
+
+    for(auto& bodyTypeMapThread : bodyTypeMapPool) 
+        for(auto& bt : bodyTypeMapThread) 
+            if(bt.first->remove({bt.second.begin(), bt.second.end()}) != S_OK) 
+                return E_FAIL;
+
+    const int btid = this->id;
+    parallel_for(_i.size(), [&_i, &btid](int j) -> void { _i[j]->typeId = btid; });
+    this->_instanceIds.reserve(this->_instanceIds.size() + i.size());
+    for(auto& b : i) this->_instanceIds.push_back(b.id);
+
+    return S_OK;
+}
+
 HRESULT BodyType::remove(const BodyHandle &i) {
     if(!i) 
         return tf_error(E_FAIL, "Invalid object");
@@ -1281,6 +1446,29 @@ BodyHandle BodyType::operator() (const std::vector<SurfaceHandle> &surfaces) {
     return BodyType_fromSurfaces(this, surfaces);
 }
 
+std::vector<BodyHandle> BodyType::operator() (const std::vector<std::vector<SurfaceHandle> > &surfaces) {
+    if(surfaces.empty()) 
+        return {};
+
+    std::vector<BodyHandle> b = Body::create(surfaces);
+    if(b.empty()) {
+        TF_Log(LOG_ERROR) << "Failed to create instances";
+        return {};
+    }
+
+    const FloatP_t density = this->density;
+    parallel_for(b.size(), [&b, &density](int i) -> void { b[i].body()->setDensity(density); });
+
+    if(add(b) != S_OK) {
+        TF_Log(LOG_ERROR);
+        std::vector<Body*> _b(b.size());
+        parallel_for(b.size(), [&b, &_b](int i) -> void { _b[i] = b[i].body(); });
+        Mesh::get()->remove(_b.data(), _b.size());
+        return {};
+    }
+    return b;
+}
+
 BodyHandle BodyType::operator() (TissueForge::io::ThreeDFMeshData* ioMesh, SurfaceType *stype) {
     std::vector<SurfaceHandle> surfaces;
     surfaces.reserve(ioMesh->faces.size());
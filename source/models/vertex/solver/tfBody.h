@@ -83,6 +83,9 @@ namespace TissueForge::models::vertex {
         /** mass density */
         FloatP_t density;
 
+        /** Signature of the surfaces at the last geometry update */
+        size_t _geomSignature;
+
     public:
 
         /** Object actors */
@@ -100,6 +103,9 @@ namespace TissueForge::models::vertex {
         /** Construct a body from a mesh */
         static BodyHandle create(TissueForge::io::ThreeDFMeshData *ioMesh);
 
+        /** Construct bodies from sets of surfaces */
+        static std::vector<BodyHandle> create(const std::vector<std::vector<SurfaceHandle> > &_surfaces);
+
         MESHOBJ_DEFINEDBY_DECL(Vertex);
         MESHOBJ_DEFINEDBY_DECL(Surface);
         MESHOBJ_CLASSDEF(MeshObjTypeLabel::BODY)
@@ -330,6 +336,7 @@ namespace TissueForge::models::vertex {
         friend Vertex;
         friend Mesh;
         friend BodyType;
+        friend MeshSolver;
 
     };
 
@@ -673,6 +680,13 @@ namespace TissueForge::models::vertex {
          */
         HRESULT add(const BodyHandle &i);
 
+        /**
+         * @brief Add instances
+         * 
+         * @param i instances
+         */
+        HRESULT add(const std::vector<BodyHandle>& i);
+
         /**
          * @brief Remove an instance
          * 
@@ -707,6 +721,11 @@ namespace TissueForge::models::vertex {
          */
         BodyHandle operator() (const std::vector<SurfaceHandle> &surfaces);
 
+        /**
+         * @brief Construct bodies of this type from sets of surfaces
+         */
+        std::vector<BodyHandle> operator() (const std::vector<std::vector<SurfaceHandle> > &surfaces);
+
         /**
          * @brief Construct a body of this type from a mesh
          */
@@ -66,6 +66,83 @@ HRESULT Mesh_checkStoredObj(T *obj) {
     }
 
 
+/** Sort ids and remove duplicates */
+static void Mesh_sortUnique(std::vector<unsigned int>& ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+
+/**
+ * @brief Get the ids of objects for bulk removal. 
+ * 
+ * Ids are sorted and unique, so that duplicate entries are only removed once. 
+ * Nothing is returned if any object is invalid. 
+ * 
+ * @param objs objects to remove
+ * @param numObjs number of objects to remove
+ * @param nObjs size of the inventory of the object type
+ * @param ids sorted unique ids of the objects
+ */
+template <typename T> 
+static HRESULT Mesh_idsForRemoval(
+    T** objs, 
+    const size_t& numObjs, 
+    const size_t& nObjs, 
+    std::vector<unsigned int>& ids
+) {
+    ids.clear();
+    ids.reserve(numObjs);
+    for(size_t i = 0; i < numObjs; i++) {
+        T* obj = objs[i];
+        if(TF_MESH_OBJCHECK(obj) || TF_MESH_OBJINVSIZECHECK(obj, nObjs)) {
+            ids.clear();
+            return E_FAIL;
+        }
+        ids.push_back(obj->_objId);
+    }
+    Mesh_sortUnique(ids);
+    return S_OK;
+}
+
+
+/**
+ * @brief Gather the unique ids of objects adjacent to a set of objects. 
+ * 
+ * Each thread scans a strided range of the objects into its own flat buffer. 
+ * Buffers are then concatenated, sorted and deduplicated, 
+ * so that work and memory scale with the number of adjacent objects, not with the inventory. 
+ * 
+ * @param ids ids of objects
+ * @param nAdj size of the inventory of the adjacent object type
+ * @param adj function that appends the ids of objects adjacent to an object
+ */
+template <typename F> 
+static std::vector<unsigned int> Mesh_gatherAdjacent(const std::vector<unsigned int>& ids, const size_t& nAdj, F adj) {
+    std::vector<std::vector<unsigned int> > adjPool(ThreadPool::size());
+    parallel_for(
+        ThreadPool::size(), 
+        [&ids, &adjPool, &adj](int tid) -> void {
+            std::vector<unsigned int>& adjThread = adjPool[tid];
+            for(size_t i = tid; i < ids.size(); i += ThreadPool::size()) 
+                adj(ids[i], adjThread);
+        }
+    );
+
+    size_t numAdj = 0;
+    for(auto& adjThread : adjPool) 
+        numAdj += adjThread.size();
+    std::vector<unsigned int> result;
+    result.reserve(numAdj);
+    for(auto& adjThread : adjPool) 
+        for(auto& adjId : adjThread) 
+            if(adjId < nAdj) 
+                result.push_back(adjId);
+    Mesh_sortUnique(result);
+    return result;
+}
+
+
 //////////
 // Mesh //
 //////////
@@ -483,6 +560,23 @@ Vertex *Mesh::getVertexByPID(const unsigned int &pid) const {
     return itr == verticesByPID.end() ? NULL : itr->second;
 }
 
+HRESULT Mesh::renumberParticles(const std::vector<int> &newIds) {
+    auto func_vertices = [this, &newIds](int vid) -> void {
+        Vertex &v = (*vertices)[vid];
+        if(v._objId >= 0 && v.pid >= 0 && v.pid < newIds.size() && newIds[v.pid] >= 0) 
+            v.pid = newIds[v.pid];
+    };
+    parallel_for(vertices->size(), func_vertices);
+
+    std::unordered_map<int, Vertex*> _verticesByPID;
+    _verticesByPID.reserve(verticesByPID.size());
+    for(auto &itr : verticesByPID) 
+        _verticesByPID[itr.second->pid] = itr.second;
+    verticesByPID = std::move(_verticesByPID);
+
+    return S_OK;
+}
+
 Vertex *Mesh::getVertex(const unsigned int &idx) {
     auto o = TF_MESH_GETPART(idx, (*vertices));
     return o && o->objectId() >= 0 ? o : NULL;
@@ -592,80 +686,47 @@ HRESULT Mesh::remove(Vertex *v) {
 HRESULT Mesh::remove(Vertex** v, const size_t& numObjs) {
     isDirty = true;
 
-    // check objects and get children, vertex ids and particle ids
+    // check objects
 
-    const size_t nObjs = vertices->size();
-    std::vector<HRESULT> statusPool(ThreadPool::size(), S_OK);
-    std::vector<std::unordered_set<Surface*> > childrenPool(ThreadPool::size());
-    std::vector<std::unordered_set<unsigned int> > idsToMakeAvailPool(ThreadPool::size());
-    std::vector<std::unordered_set<int> > pidsToErasePool(ThreadPool::size());
-    auto& this_verticesByPID = this->verticesByPID;
-    parallel_for(
-        ThreadPool::size(), 
-        [&v, &numObjs, &statusPool, &nObjs, &childrenPool, &idsToMakeAvailPool, &pidsToErasePool, &this_verticesByPID](int tid) -> void {
-            HRESULT& statusThread = statusPool[tid];
-            std::unordered_set<Surface*>& childrenThread = childrenPool[tid];
-            std::unordered_set<unsigned int>& idsToMakeAvailThread = idsToMakeAvailPool[tid];
-            std::unordered_set<int>& pidsToEraseThread = pidsToErasePool[tid];
-            for(int i = tid; i < numObjs; i += ThreadPool::size()) {
-                Vertex* obj = v[i];
-                if(TF_MESH_OBJCHECK(obj) || TF_MESH_OBJINVSIZECHECK(obj, nObjs)) {
-                    statusThread = E_FAIL;
-                    return;
-                }
-                for(auto& c : obj->getSurfaces()) 
-                    childrenThread.insert(c);
-                idsToMakeAvailThread.insert(obj->_objId);
-                auto itr = this_verticesByPID.find(obj->pid);
-                if(itr != this_verticesByPID.end()) 
-                    pidsToEraseThread.insert(obj->pid);
-            }
+    auto& this_objs = *(this->vertices);
+    std::vector<unsigned int> ids;
+    if(Mesh_idsForRemoval(v, numObjs, this_objs.size(), ids) != S_OK) {
+        TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
+        return E_FAIL;
+    }
+
+    // get children
+
+    std::vector<unsigned int> childIds = Mesh_gatherAdjacent(
+        ids, 
+        surfaces->size(), 
+        [&this_objs](const unsigned int& objId, std::vector<unsigned int>& result) -> void {
+            for(auto& c : this_objs[objId].surfaces) 
+                result.push_back(c->_objId);
         }
     );
-    for(auto& statusThread : statusPool) 
-        if(statusThread) {
-            TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
-            return E_FAIL;
-        }
+    std::vector<Surface*> childrenVec;
+    childrenVec.reserve(childIds.size());
+    for(auto& childId : childIds) 
+        childrenVec.push_back(&(*this->surfaces)[childId]);
 
-    size_t numChildren = 0;
-    for(auto& childrenThread : childrenPool) 
-        numChildren += childrenThread.size();
-    std::unordered_set<Surface*> children;
-    children.reserve(numChildren);
-    for(auto& childrenThread : childrenPool) 
-        for(auto& c : childrenThread) 
-            children.insert(c);
-    std::vector<Surface*> childrenVec(children.begin(), children.end());
-
-    // make ids available and remove particle id mappings
-    
-    for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-        this->vertexIdsAvail.insert(idsToMakeAvailThread.begin(), idsToMakeAvailThread.end());
-    for(auto& pidsToEraseThread : pidsToErasePool) 
-        for(auto& pid : pidsToEraseThread) 
-            this->verticesByPID.erase(pid);
-
-    // notify quality
+    // make ids available, remove particle id mappings, notify quality and log
 
-    if(_quality) 
-        for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-            for(auto& objId : idsToMakeAvailThread) 
-                _quality->includeVertex(objId);
+    for(auto& objId : ids) {
+        const int pid = this_objs[objId].pid;
+        if(pid >= 0) 
+            this->verticesByPID.erase(pid);
+        this->vertexIdsAvail.insert(objId);
+        if(_quality) 
+            _quality->includeVertex(objId);
+        if(_solver) 
+            _solver->log(MeshLogEventType::Destroy, {(int)objId}, {this_objs[objId].objType()});
+    }
 
     // clear objects
 
-    auto& this_objs = *(this->vertices);
-    parallel_for(numObjs, [&this_objs, &v](int i) -> void { this_objs[v[i]->_objId] = Vertex(); } );
-    nr_vertices -= numObjs;
-
-    // log
-
-    if(_solver) 
-        for(unsigned int i = 0; i < numObjs; i++) {
-            auto obj = v[i];
-            _solver->log(MeshLogEventType::Destroy, {obj->_objId}, {obj->objType()});
-        }
+    parallel_for(ids.size(), [&this_objs, &ids](int i) -> void { this_objs[ids[i]] = Vertex(); } );
+    nr_vertices -= ids.size();
 
     // remove children
 
@@ -710,103 +771,70 @@ HRESULT Mesh::remove(Surface *s) {
 HRESULT Mesh::remove(Surface** s, const size_t& numObjs) {
     isDirty = true;
 
-    // check objects, get children, ids and surfaces by vertex
+    // check objects
 
-    const size_t nObjs = surfaces->size();
-    std::vector<HRESULT> statusPool(ThreadPool::size(), S_OK);
-    std::vector<std::unordered_set<Vertex*> > verticesPool(ThreadPool::size());
-    std::vector<std::unordered_set<Body*> > childrenPool(ThreadPool::size());
-    std::vector<std::unordered_set<unsigned int> > idsToMakeAvailPool(ThreadPool::size());
-    std::vector<std::unordered_map<Vertex*, std::unordered_set<Surface*> > > surfacesByVerticesPool(ThreadPool::size());
-    parallel_for(
-        ThreadPool::size(), 
-        [&s, &numObjs, &nObjs, &statusPool, &verticesPool, &childrenPool, &idsToMakeAvailPool, &surfacesByVerticesPool](int tid) -> void {
-            HRESULT& statusThread = statusPool[tid];
-            std::unordered_set<Vertex*>& verticesThread = verticesPool[tid];
-            std::unordered_set<Body*>& childrenThread = childrenPool[tid];
-            std::unordered_set<unsigned int>& idsToMakeAvailThread = idsToMakeAvailPool[tid];
-            std::unordered_map<Vertex*, std::unordered_set<Surface*> >& surfacesByVerticesThread = surfacesByVerticesPool[tid];
-            for(int i = tid; i < numObjs; i += ThreadPool::size()) {
-                Surface* obj = s[i];
-                if(TF_MESH_OBJCHECK(obj) || TF_MESH_OBJINVSIZECHECK(obj, nObjs)) {
-                    statusThread = E_FAIL;
-                    return;
-                }
-                for(auto& c : obj->getBodies()) 
-                    childrenThread.insert(c);
-                idsToMakeAvailThread.insert(obj->_objId);
-                for(auto& v : obj->getVertices()) {
-                    verticesThread.insert(v);
-                    surfacesByVerticesThread[v].insert(obj);
-                }
-            }
+    auto& this_objs = *(this->surfaces);
+    std::vector<unsigned int> ids;
+    if(Mesh_idsForRemoval(s, numObjs, this_objs.size(), ids) != S_OK) {
+        TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
+        return E_FAIL;
+    }
+
+    // get children and affected vertices
+
+    std::vector<unsigned int> childIds = Mesh_gatherAdjacent(
+        ids, 
+        bodies->size(), 
+        [&this_objs](const unsigned int& objId, std::vector<unsigned int>& result) -> void {
+            const Surface& obj = this_objs[objId];
+            if(obj.b1) 
+                result.push_back(obj.b1->_objId);
+            if(obj.b2) 
+                result.push_back(obj.b2->_objId);
         }
     );
-    for(auto& statusThread : statusPool) 
-        if(statusThread != S_OK) {
-            TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
-            return E_FAIL;
+    std::vector<Body*> childrenVec;
+    childrenVec.reserve(childIds.size());
+    for(auto& childId : childIds) 
+        childrenVec.push_back(&(*this->bodies)[childId]);
+
+    std::vector<unsigned int> vertexIds = Mesh_gatherAdjacent(
+        ids, 
+        vertices->size(), 
+        [&this_objs](const unsigned int& objId, std::vector<unsigned int>& result) -> void {
+            for(auto& v : this_objs[objId].vertices) 
+                result.push_back(v->_objId);
         }
-
-    size_t numChildren = 0;
-    for(auto& childrenThread : childrenPool) 
-        numChildren += childrenThread.size();
-    std::unordered_set<Body*> children;
-    children.reserve(numChildren);
-    for(auto& childrenThread : childrenPool) 
-        children.insert(childrenThread.begin(), childrenThread.end());
-    std::vector<Body*> childrenVec(children.begin(), children.end());
-
-    size_t numVertices = 0;
-    for(auto& verticesThread : verticesPool) 
-        numVertices += verticesThread.size();
-    std::unordered_set<Vertex*> vertices;
-    vertices.reserve(numVertices);
-    for(auto& verticesThread : verticesPool) 
-        vertices.insert(verticesThread.begin(), verticesThread.end());
-    std::vector<Vertex*> verticesVec(vertices.begin(), vertices.end());
-
-    std::unordered_map<Vertex*, std::unordered_set<Surface*> > surfacesByVertices;
-    for(auto& surfacesByVerticesThread : surfacesByVerticesPool) 
-        for(auto& p : surfacesByVerticesThread) 
-            surfacesByVertices[p.first].insert(p.second.begin(), p.second.end());
+    );
 
     // remove surfaces from vertices
 
+    auto& this_vertices = *(this->vertices);
     parallel_for(
-        verticesVec.size(), 
-        [&verticesVec, &surfacesByVertices](int i) -> void {
-            Vertex* v = verticesVec[i];
-            for(auto& s : surfacesByVertices[v]) 
-                v->remove(s);
+        vertexIds.size(), 
+        [&this_vertices, &vertexIds, &ids](int i) -> void {
+            std::vector<Surface*>& vSurfaces = this_vertices[vertexIds[i]].surfaces;
+            vSurfaces.erase(
+                std::remove_if(vSurfaces.begin(), vSurfaces.end(), [&ids](Surface* vs) -> bool { return vs->_objId >= 0 && std::binary_search(ids.begin(), ids.end(), (unsigned int)vs->_objId); }), 
+                vSurfaces.end()
+            );
         }
     );
 
-    // make ids available
-    
-    for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-        this->surfaceIdsAvail.insert(idsToMakeAvailThread.begin(), idsToMakeAvailThread.end());
-
-    // notify quality
+    // make ids available, notify quality and log
 
-    if(_quality) 
-        for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-            for(auto& objId : idsToMakeAvailThread) 
-                _quality->includeSurface(objId);
+    for(auto& objId : ids) {
+        this->surfaceIdsAvail.insert(objId);
+        if(_quality) 
+            _quality->includeSurface(objId);
+        if(_solver) 
+            _solver->log(MeshLogEventType::Destroy, {(int)objId}, {this_objs[objId].objType()});
+    }
 
     // clear objects
 
-    auto& this_objs = *(this->surfaces);
-    parallel_for(numObjs, [&this_objs, &s](int i) -> void { this_objs[s[i]->_objId] = Surface(); } );
-    nr_surfaces -= numObjs;
-
-    // log
-
-    if(_solver) 
-        for(unsigned int i = 0; i < numObjs; i++) {
-            auto obj = s[i];
-            _solver->log(MeshLogEventType::Destroy, {obj->_objId}, {obj->objType()});
-        }
+    parallel_for(ids.size(), [&this_objs, &ids](int i) -> void { this_objs[ids[i]] = Surface(); } );
+    nr_surfaces -= ids.size();
 
     // remove children
 
@@ -844,90 +872,55 @@ HRESULT Mesh::remove(Body *b) {
 HRESULT Mesh::remove(Body** b, const size_t& numObjs) {
     isDirty = true;
 
-    // check objects, get surfaces and bodies by surface
+    // check objects
 
-    const size_t nObjs = bodies->size();
-    std::vector<HRESULT> statusPool(ThreadPool::size(), S_OK);
-    std::vector<std::unordered_set<Surface*> > surfacesPool(ThreadPool::size());
-    std::vector<std::unordered_set<unsigned int> > idsToMakeAvailPool(ThreadPool::size());
-    std::vector<std::unordered_map<Surface*, std::unordered_set<Body*> > > bodiesBySurfacePool(ThreadPool::size());
-    parallel_for(
-        ThreadPool::size(), 
-        [&b, &numObjs, &nObjs, &statusPool, &surfacesPool, &idsToMakeAvailPool, &bodiesBySurfacePool](int tid) -> void {
-            HRESULT& statusThread = statusPool[tid];
-            std::unordered_set<Surface*>& surfacesThread = surfacesPool[tid];
-            std::unordered_set<unsigned int>& idsToMakeAvailThread = idsToMakeAvailPool[tid];
-            std::unordered_map<Surface*, std::unordered_set<Body*> >& bodiesBySurfaceThread = bodiesBySurfacePool[tid];
-            for(int i = tid; i < numObjs; i += ThreadPool::size()) {
-                Body* obj = b[i];
-                if(TF_MESH_OBJCHECK(obj) || TF_MESH_OBJINVSIZECHECK(obj, nObjs)) {
-                    statusThread = E_FAIL;
-                    return;
-                }
-                idsToMakeAvailThread.insert(obj->_objId);
-                for(auto& s : obj->getSurfaces()) {
-                    surfacesThread.insert(s);
-                    bodiesBySurfaceThread[s].insert(obj);
-                }
-            }
-        }
-    );
-    for(auto& statusThread : statusPool) 
-        if(statusThread != S_OK) {
-            TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
-            return E_FAIL;
-        }
+    auto& this_objs = *(this->bodies);
+    std::vector<unsigned int> ids;
+    if(Mesh_idsForRemoval(b, numObjs, this_objs.size(), ids) != S_OK) {
+        TF_Log(LOG_ERROR) << TF_INVALIDOBJRM_MSG;
+        return E_FAIL;
+    }
 
-    size_t numSurfaces = 0;
-    for(auto& surfacesThread : surfacesPool) 
-        numSurfaces += surfacesThread.size();
-    std::unordered_set<Surface*> surfaces;
-    surfaces.reserve(numSurfaces);
-    for(auto& surfacesThread : surfacesPool) 
-        surfaces.insert(surfacesThread.begin(), surfacesThread.end());
-    std::vector<Surface*> surfacesVec(surfaces.begin(), surfaces.end());
+    // get affected surfaces
 
-    std::unordered_map<Surface*, std::unordered_set<Body*> > bodiesBySurface;
-    for(auto& bodiesBySurfaceThread : bodiesBySurfacePool) 
-        for(auto& p : bodiesBySurfaceThread) 
-            bodiesBySurface[p.first].insert(p.second.begin(), p.second.end());
+    std::vector<unsigned int> surfaceIds = Mesh_gatherAdjacent(
+        ids, 
+        surfaces->size(), 
+        [&this_objs](const unsigned int& objId, std::vector<unsigned int>& result) -> void {
+            for(auto& s : this_objs[objId].surfaces) 
+                result.push_back(s->_objId);
+        }
+    );
 
     // remove bodies from surfaces
 
+    auto& this_surfaces = *(this->surfaces);
+    auto removed = [&ids](Body* sb) -> bool { return sb && sb->_objId >= 0 && std::binary_search(ids.begin(), ids.end(), (unsigned int)sb->_objId); };
     parallel_for(
-        surfaces.size(), 
-        [&surfacesVec, &bodiesBySurface](int i) -> void {
-            Surface* s = surfacesVec[i];
-            for(auto& b : bodiesBySurface[s]) 
-                s->remove(b);
+        surfaceIds.size(), 
+        [&this_surfaces, &surfaceIds, &removed](int i) -> void {
+            Surface& s = this_surfaces[surfaceIds[i]];
+            if(removed(s.b1)) 
+                s.b1 = NULL;
+            if(removed(s.b2)) 
+                s.b2 = NULL;
         }
     );
 
-    // make ids available
-    
-    for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-        this->bodyIdsAvail.insert(idsToMakeAvailThread.begin(), idsToMakeAvailThread.end());
-
-    // notify quality
+    // make ids available, notify quality and log
 
-    if(_quality) 
-        for(auto& idsToMakeAvailThread : idsToMakeAvailPool) 
-            for(auto& objId : idsToMakeAvailThread) 
-                _quality->includeBody(objId);
+    for(auto& objId : ids) {
+        this->bodyIdsAvail.insert(objId);
+        if(_quality) 
+            _quality->includeBody(objId);
+        if(_solver) 
+            _solver->log(MeshLogEventType::Destroy, {(int)objId}, {this_objs[objId].objType()});
+    }
 
     // clear objects
 
-    auto& this_objs = *(this->bodies);
-    parallel_for(numObjs, [&this_objs, &b](int i) -> void { this_objs[b[i]->_objId] = Body(); } );
-    nr_bodies -= numObjs;
-
-    // log
-
-    if(_solver) 
-        for(unsigned int i = 0; i < numObjs; i++) {
-            auto obj = b[i];
-            _solver->log(MeshLogEventType::Destroy, {obj->_objId}, {obj->objType()});
-        }
+    parallel_for(ids.size(), [&this_objs, &ids](int i) -> void { this_objs[ids[i]] = Body(); } );
+    nr_bodies -= ids.size();
 
     return S_OK;
 }
@@ -215,6 +215,13 @@ namespace TissueForge::models::vertex {
          */
         Vertex *getVertexByPID(const unsigned int &pid) const;
 
+        /**
+         * @brief Update the particle ids of all vertices after the engine renumbers particles
+         * 
+         * @param newIds new id of each particle by previous id
+         */
+        HRESULT renumberParticles(const std::vector<int> &newIds);
+
         /**
          * @brief Get the vertex at a location in the list of vertices
          * 
@@ -41,6 +41,7 @@ namespace TissueForge::models::vertex {
     class Vertex;
     class Surface;
     class Body;
+    struct MeshSolver;
 
     /**
      * @brief Mesh object type enum
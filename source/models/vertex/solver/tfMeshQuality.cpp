@@ -35,6 +35,7 @@
 
 #include <Magnum/Math/Math.h>
 
+#include <algorithm>
 #include <atomic>
 
 
@@ -47,101 +48,11 @@ using namespace TissueForge::models::vertex;
 //////////////////////////
 
 
-HRESULT MeshQualityOperation_checkChain( 
-    MeshQualityOperation *op, 
-    std::vector<MeshQualityOperation*> &ops
-) {
-    for(auto &t : op->targets) {
-        MeshQualityOperation *t_op = ops[t];
-        if(t_op && op != t_op) 
-            op->appendNext(t_op);
-        
-    }
-
-    return S_OK;
-}
-
 MeshQualityOperation::MeshQualityOperation(Mesh *_mesh) : 
     flags{Flag::None}, 
     mesh{_mesh}
 {}
 
-HRESULT MeshQualityOperation::appendNext(MeshQualityOperation *_next) {
-    // Prevent loops
-    std::set<MeshQualityOperation*> us = this->upstreams();
-    if(std::find(us.begin(), us.end(), _next) != us.end()) 
-        return S_OK;
-
-    _next->lock.lock();
-    _next->prev.insert(this);
-    _next->lock.unlock();
-
-    next.insert(_next);
-    
-    return S_OK;
-}
-
-HRESULT MeshQualityOperation::removeNext(MeshQualityOperation *_next) {
-    auto itr = std::find(next.begin(), next.end(), _next);
-    if(itr == next.end()) 
-        return E_FAIL;
-    next.erase(itr);
-
-    itr = std::find(_next->prev.begin(), _next->prev.end(), this);
-    if(itr != _next->prev.end()) {
-        _next->lock.lock();
-        _next->prev.erase(itr);
-        _next->lock.unlock();
-    }
-
-    return S_OK;
-}
-
-static void MeshQuality_upstreams(const MeshQualityOperation *op, std::set<MeshQualityOperation*> &ops) {
-    for(auto *op_u : op->prev) {
-        if(std::find(ops.begin(), ops.end(), op_u) == ops.end()) {
-            ops.insert(op_u);
-            MeshQuality_upstreams(op_u, ops);
-        }
-    }
-}
-
-std::set<MeshQualityOperation*> MeshQualityOperation::upstreams() const {
-    std::set<MeshQualityOperation*> result;
-    MeshQuality_upstreams(this, result);
-    return result;
-}
-
-static void MeshQuality_downstreams(const MeshQualityOperation *op, std::set<MeshQualityOperation*> &ops) {
-    for(auto *op_d : op->next) {
-        if(std::find(ops.begin(), ops.end(), op_d) == ops.end()) {
-            ops.insert(op_d);
-            MeshQuality_downstreams(op_d, ops);
-        }
-    }
-}
-
-std::set<MeshQualityOperation*> MeshQualityOperation::downstreams() const {
-    std::set<MeshQualityOperation*> result;
-    MeshQuality_downstreams(this, result);
-    return result;
-}
-
-template <typename T> 
-std::set<MeshQualityOperation*> MeshQualityOperation_headOperations(const T &ops) {
-    std::set<MeshQualityOperation*> result;
-    for(auto &op : ops) 
-        if(op->prev.empty()) 
-            result.insert(op);
-    return result;
-}
-
-std::set<MeshQualityOperation*> MeshQualityOperation::headOperations() const { 
-    std::set<MeshQualityOperation*> us = upstreams();
-    us.insert(const_cast<MeshQualityOperation*>(this));
-    return MeshQualityOperation_headOperations(std::vector<MeshQualityOperation*>(us.begin(), us.end()));
-}
-
 
 ////////////////
 // Operations //
@@ -179,7 +90,7 @@ struct VertexMergeOperation : MeshQualityOperation {
         MeshSolver::engineUnlock();
 
         if(res == S_OK) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -221,7 +132,7 @@ struct VertexCreateInsertOperation : MeshQualityOperation {
         MeshSolver::engineUnlock();
 
         if(res == S_OK) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -266,7 +177,7 @@ struct VertexInsertOperation : MeshQualityOperation {
         MeshSolver::engineUnlock();
 
         if(res == S_OK) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -302,7 +213,7 @@ struct BodyDemoteOperation : MeshQualityOperation {
         MeshSolver::engineUnlock();
 
         if(res == S_OK) 
-            next.clear();
+            flags |= Flag::Implemented;
         return {};
     };
 };
@@ -344,7 +255,7 @@ struct SurfaceDemoteOperation : MeshQualityOperation {
         MeshSolver::engineUnlock();
 
         if(res == S_OK) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -384,7 +295,7 @@ struct EdgeDemoteOperation : MeshQualityOperation {
         HRESULT res = v->merge(v2);
         MeshSolver::engineUnlock();
         if(res == S_OK) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -435,7 +346,7 @@ struct EdgeInsertOperation : MeshQualityOperation {
 
         MeshSolver::engineUnlock();
 
-        next.clear();
+        flags |= Flag::Implemented;
         return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
     }
 
@@ -542,7 +453,7 @@ struct VertexSplitOperation : MeshQualityOperation {
 
         // Only invalidate if a vertex was created, since some requested configurations are invalid and subsequently ignored
         if(new_v) {
-            next.clear();
+            flags |= Flag::Implemented;
             return std::vector<int>(affectedChildren.begin(), affectedChildren.end());
         }
         return {};
@@ -555,25 +466,14 @@ struct VertexSplitOperation : MeshQualityOperation {
 /////////////////
 
 
-HRESULT MeshQuality_constructChains(std::vector<MeshQualityOperation*> &ops) {
-    auto func = [&ops](int i) -> void {
-        MeshQualityOperation *op = ops[i];
-        if(!op) return;
-        MeshQualityOperation_checkChain(op, ops);
-    };
-    parallel_for(ops.size(), func);
-    return S_OK;
-}
-
 static HRESULT MeshQuality_constructOperationsVertex(
     Mesh *mesh, 
     const std::vector<bool> &passMask, 
     const FloatP_t &edgeSplitDist, 
     const FloatP_t &vertexMergeDist, 
-    std::vector<MeshQualityOperation*> &ops_active, 
-    std::vector<MeshQualityOperation*> &op_heads
+    std::vector<MeshQualityOperation*> &ops
 ) {
-    std::vector<MeshQualityOperation*> ops(mesh->sizeVertices(), 0);
+    ops = std::vector<MeshQualityOperation*>(mesh->sizeVertices(), 0);
     const FloatP_t vertexMergeDist2 = vertexMergeDist * vertexMergeDist;
 
     auto check_verts = [&mesh, &passMask, &ops, edgeSplitDist, vertexMergeDist2](int i) -> void {
@@ -620,20 +520,6 @@ static HRESULT MeshQuality_constructOperationsVertex(
     };
     parallel_for(mesh->sizeVertices(), check_verts);
 
-    if(MeshQuality_constructChains(ops) != S_OK) { 
-        for(size_t i = 0; i < ops.size(); i++) delete ops[i];
-        ops.clear();
-        return E_FAIL;
-    }
-
-    ops_active.clear();
-    ops_active.reserve(ops.size());
-    for(auto &op : ops) 
-        if(op) 
-            ops_active.push_back(op);
-    std::set<MeshQualityOperation*> op_heads_set = MeshQualityOperation_headOperations(ops_active);
-    op_heads = std::vector<MeshQualityOperation*>(op_heads_set.begin(), op_heads_set.end());
-
     return S_OK;
 }
 
@@ -642,10 +528,9 @@ static HRESULT MeshQuality_constructOperationsSurface(
     const std::vector<bool> &passMask, 
     const FloatP_t &surfaceDemoteArea, 
     const bool &collision2D, 
-    std::vector<MeshQualityOperation*> &ops_active, 
-    std::vector<MeshQualityOperation*> &op_heads
+    std::vector<MeshQualityOperation*> &ops
 ) {
-    std::vector<MeshQualityOperation*> ops(mesh->sizeSurfaces(), 0);
+    ops = std::vector<MeshQualityOperation*>(mesh->sizeSurfaces(), 0);
 
     auto check_surfs = [&mesh, &passMask, &ops, surfaceDemoteArea, collision2D](int i) -> void {
         if(passMask[i]) return;
@@ -702,20 +587,6 @@ static HRESULT MeshQuality_constructOperationsSurface(
     };
     parallel_for(mesh->sizeSurfaces(), check_surfs);
     
-    if(MeshQuality_constructChains(ops) != S_OK) { 
-        for(size_t i = 0; i < ops.size(); i++) delete ops[i];
-        ops.clear();
-        return E_FAIL;
-    }
-
-    ops_active.clear();
-    ops_active.reserve(ops.size());
-    for(auto &op : ops) 
-        if(op) 
-            ops_active.push_back(op);
-    std::set<MeshQualityOperation*> op_heads_set = MeshQualityOperation_headOperations(ops_active);
-    op_heads = std::vector<MeshQualityOperation*>(op_heads_set.begin(), op_heads_set.end());
-
     return S_OK;
 }
 
@@ -723,10 +594,9 @@ static HRESULT MeshQuality_constructOperationsBody(
     Mesh *mesh, 
     const std::vector<bool> &passMask, 
     const FloatP_t &bodyDemoteVolume, 
-    std::vector<MeshQualityOperation*> &ops_active, 
-    std::vector<MeshQualityOperation*> &op_heads
+    std::vector<MeshQualityOperation*> &ops
 ) {
-    std::vector<MeshQualityOperation*> ops(mesh->sizeBodies(), 0);
+    ops = std::vector<MeshQualityOperation*>(mesh->sizeBodies(), 0);
 
     auto check_bodys = [&mesh, &passMask, &ops, bodyDemoteVolume](int i) -> void {
         if(passMask[i]) return;
@@ -745,62 +615,20 @@ static HRESULT MeshQuality_constructOperationsBody(
     };
     parallel_for(mesh->sizeBodies(), check_bodys);
     
-    if(MeshQuality_constructChains(ops) != S_OK) { 
-        for(size_t i = 0; i < ops.size(); i++) delete ops[i];
-        ops.clear();
-        return E_FAIL;
-    }
-
-    ops_active.clear();
-    ops_active.reserve(ops.size());
-    for(auto &op : ops) 
-        if(op) 
-            ops_active.push_back(op);
-    std::set<MeshQualityOperation*> op_heads_set = MeshQualityOperation_headOperations(ops_active);
-    op_heads = std::vector<MeshQualityOperation*>(op_heads_set.begin(), op_heads_set.end());
-
-    return S_OK;
-}
-
-static HRESULT MeshQuality_doOperations(MeshQualityOperation *op, std::unordered_set<int> &affectedChildren) {
-    if(!op->check()) { 
-        for(auto &n : op->next) {
-            auto itr = std::find(n->prev.begin(), n->prev.end(), op);
-            if(itr != n->prev.end()) {
-                n->lock.lock();
-                n->prev.erase(itr);
-                n->lock.unlock();
-            }
-        }
-        return S_OK;
-    }
-
-    for(auto &i : op->implement()) 
-        affectedChildren.insert(i);
-
-    for(auto &n : op->next) {
-        auto itr = std::find(n->prev.begin(), n->prev.end(), op);
-        HRESULT res = S_OK;
-
-        n->lock.lock();
-        n->prev.erase(itr);
-        if(n->prev.empty()) 
-            res = MeshQuality_doOperations(n, affectedChildren);
-        n->lock.unlock();
-
-        if(res != S_OK) 
-            return res;
-    }
-
     return S_OK;
 }
 
 static HRESULT MeshQuality_doOperations(
     Mesh *mesh, 
-    std::vector<MeshQualityOperation*> &op_active, 
-    std::vector<MeshQualityOperation*> &op_heads, 
+    std::vector<MeshQualityOperation*> &ops, 
     std::vector<int> &affectedChildren) 
 {
+    std::vector<MeshQualityOperation*> op_active;
+    op_active.reserve(ops.size());
+    for(auto &op : ops) 
+        if(op) 
+            op_active.push_back(op);
+
     std::atomic<size_t> atomic_numNewVertices = 0;
     std::atomic<size_t> atomic_numNewSurfaces = 0;
     std::atomic<size_t> atomic_numNewBodies = 0;
@@ -830,21 +658,83 @@ static HRESULT MeshQuality_doOperations(
     
     parallel_for(op_active.size(), [&op_active](int i) -> void { op_active[i]->prep(); });
 
-    static std::mutex affectedChildrenLock;
-    std::unordered_set<int> affectedChildrenSet;
-    auto func_do = [&op_heads, &affectedChildrenSet](int tid) -> void {
-        std::unordered_set<int> affectedChildren_tid;
-        for(int i = tid; i < op_heads.size();) {
-            MeshQuality_doOperations(op_heads[i], affectedChildren_tid);
-            i += ThreadPool::size();
-        }
-        affectedChildrenLock.lock();
-        for(auto &i : affectedChildren_tid) 
-            affectedChildrenSet.insert(i);
-        affectedChildrenLock.unlock();
+    // Partition operations into independent sets, in order of object id, so that the partition does not depend on threading. 
+    //  Operations conflict when one targets the other, or when they share a target. 
+    //  Each operation is assigned to the first set in which it has no conflicts. 
+
+    const size_t numOps = ops.size();
+    auto opFootprint = [&ops, &numOps](MeshQualityOperation *op, const size_t &opId) -> std::vector<size_t> {
+        std::vector<size_t> result;
+        result.reserve(op->targets.size() + 1);
+        result.push_back(opId);
+        for(auto &t : op->targets) 
+            if(t >= 0 && (size_t)t < numOps) 
+                result.push_back(t);
+        return result;
     };
-    parallel_for(ThreadPool::size(), func_do);
-    affectedChildren = std::vector<int>(affectedChildrenSet.begin(), affectedChildrenSet.end());
+
+    std::vector<std::vector<size_t> > opSets;
+    std::vector<size_t> opRemaining;
+    opRemaining.reserve(op_active.size());
+    for(size_t i = 0; i < numOps; i++) 
+        if(ops[i]) 
+            opRemaining.push_back(i);
+    
+    std::vector<uint8_t> claimed(numOps, 0);
+    while(!opRemaining.empty()) {
+        std::vector<size_t> opSet, opDeferred;
+        for(auto &i : opRemaining) {
+            std::vector<size_t> footprint = opFootprint(ops[i], i);
+            if(std::any_of(footprint.begin(), footprint.end(), [&claimed](const size_t &f) -> bool { return claimed[f]; })) {
+                opDeferred.push_back(i);
+                continue;
+            }
+            for(auto &f : footprint) 
+                claimed[f] = 1;
+            opSet.push_back(i);
+        }
+        for(auto &i : opSet) 
+            for(auto &f : opFootprint(ops[i], i)) 
+                claimed[f] = 0;
+        opSets.push_back(std::move(opSet));
+        opRemaining = std::move(opDeferred);
+    }
+
+    // Implement each independent set concurrently. 
+    //  An operation is skipped when a conflicting operation in a previous set was implemented, 
+    //  whether or not that operation modified the mesh. 
+
+    std::vector<uint8_t> touched(numOps, 0);
+    affectedChildren.clear();
+    for(auto &opSet : opSets) {
+        std::vector<std::vector<int> > opChildren(opSet.size());
+        std::vector<uint8_t> opApplied(opSet.size(), 0);
+
+        auto func_implement = [&ops, &opSet, &opFootprint, &touched, &opChildren, &opApplied](int k) -> void {
+            size_t i = opSet[k];
+            MeshQualityOperation *op = ops[i];
+            for(auto &f : opFootprint(op, i)) 
+                if(touched[f]) 
+                    return;
+            if(!op->check()) 
+                return;
+            opChildren[k] = op->implement();
+            opApplied[k] = 1;
+        };
+        parallel_for(opSet.size(), func_implement);
+
+        for(size_t k = 0; k < opSet.size(); k++) {
+            if(!opApplied[k]) 
+                continue;
+            for(auto &f : opFootprint(ops[opSet[k]], opSet[k])) 
+                touched[f] = 1;
+            for(auto &c : opChildren[k]) 
+                affectedChildren.push_back(c);
+        }
+    }
+
+    std::sort(affectedChildren.begin(), affectedChildren.end());
+    affectedChildren.erase(std::unique(affectedChildren.begin(), affectedChildren.end()), affectedChildren.end());
 
     return S_OK;
 }
@@ -899,7 +789,7 @@ HRESULT MeshQuality::doQuality() {
 
     Mesh *mesh = Mesh::get();
 
-    std::vector<MeshQualityOperation*> op_active, op_heads;
+    std::vector<MeshQualityOperation*> ops;
     std::vector<int> affectedChildren;
     std::vector<bool> passMask;
 
@@ -909,9 +799,9 @@ HRESULT MeshQuality::doQuality() {
     for(auto &i : excludedVertices) 
         if(i < passMask.size()) 
             passMask[i] = true;
-    if(MeshQuality_constructOperationsVertex(mesh, passMask, edgeSplitDist, vertexMergeDist, op_active, op_heads) != S_OK || 
-        MeshQuality_doOperations(mesh, op_active, op_heads, affectedChildren) != S_OK || 
-        MeshQuality_clearOperations(op_active) != S_OK) {
+    if(MeshQuality_constructOperationsVertex(mesh, passMask, edgeSplitDist, vertexMergeDist, ops) != S_OK || 
+        MeshQuality_doOperations(mesh, ops, affectedChildren) != S_OK || 
+        MeshQuality_clearOperations(ops) != S_OK) {
         _working = false;
         return E_FAIL;
     }
@@ -930,9 +820,9 @@ HRESULT MeshQuality::doQuality() {
     for(auto &i : excludedSurfaces) 
         if(i < passMask.size()) 
             passMask[i] = true;
-    if(MeshQuality_constructOperationsSurface(mesh, passMask, surfaceDemoteArea, collision2D, op_active, op_heads) != S_OK || 
-        MeshQuality_doOperations(mesh, op_active, op_heads, affectedChildren) != S_OK || 
-        MeshQuality_clearOperations(op_active) != S_OK) {
+    if(MeshQuality_constructOperationsSurface(mesh, passMask, surfaceDemoteArea, collision2D, ops) != S_OK || 
+        MeshQuality_doOperations(mesh, ops, affectedChildren) != S_OK || 
+        MeshQuality_clearOperations(ops) != S_OK) {
         _working = false;
         return E_FAIL;
     }
@@ -947,9 +837,9 @@ HRESULT MeshQuality::doQuality() {
     for(auto &i : excludedBodies) 
         if(i < passMask.size()) 
             passMask[i] = true;
-    if(MeshQuality_constructOperationsBody(mesh, passMask, bodyDemoteVolume, op_active, op_heads) != S_OK || 
-        MeshQuality_doOperations(mesh, op_active, op_heads, affectedChildren) != S_OK || 
-        MeshQuality_clearOperations(op_active) != S_OK) {
+    if(MeshQuality_constructOperationsBody(mesh, passMask, bodyDemoteVolume, ops) != S_OK || 
+        MeshQuality_doOperations(mesh, ops, affectedChildren) != S_OK || 
+        MeshQuality_clearOperations(ops) != S_OK) {
         _working = false;
         return E_FAIL;
     }
@@ -30,8 +30,6 @@
 
 #include <tf_port.h>
 
-#include <mutex>
-#include <set>
 #include <unordered_set>
 #include <vector>
 
@@ -48,9 +46,10 @@ namespace TissueForge::models::vertex {
     struct MeshQualityOperation {
 
         enum Flag : unsigned int {
-            None    = 0, 
-            Active  = 1 << 0, 
-            Custom  = 1 << 1
+            None        = 0, 
+            Active      = 1 << 0, 
+            Custom      = 1 << 1, 
+            Implemented = 1 << 2
         };
 
         unsigned int flags;
@@ -58,55 +57,17 @@ namespace TissueForge::models::vertex {
         /**
          * @brief Target mesh objects.
          * 
-         * Used to identify dependencies between operations
+         * Used to identify conflicts between operations. 
+         * Operations conflict when they share a target, 
+         * or when one targets the other. 
+         * An operation is skipped when a conflicting operation has already been implemented. 
          */
         std::vector<int> targets;
 
-        /** Upstream operations, if any */
-        std::set<MeshQualityOperation*> prev;
-
-        /** Downstream operations, if any */
-        std::set<MeshQualityOperation*> next;
-
-        /** Lock, for safe modification during concurrent work */
-        std::mutex lock;
-
         MeshQualityOperation(Mesh *_mesh);
 
         virtual ~MeshQualityOperation() {};
 
-        /**
-         * @brief Add an operation to the list of next operations
-         * 
-         * If the operation is already upstream of this operation, 
-         * then the call is ignored
-         * 
-         * @param _next the operation
-         */
-        HRESULT appendNext(MeshQualityOperation *_next);
-
-        /**
-         * @brief Remove an operation to the list of next operations
-         * 
-         * @param _next the operation
-         */
-        HRESULT removeNext(MeshQualityOperation *_next);
-
-        /**
-         * @brief Compute all upstream operations
-         */
-        std::set<MeshQualityOperation*> upstreams() const;
-
-        /**
-         * @brief Compute all downstream operations
-         */
-        std::set<MeshQualityOperation*> downstreams() const;
-
-        /**
-         * @brief Compute all upstream operations that have no dependencies
-         */
-        std::set<MeshQualityOperation*> headOperations() const;
-
         /**
          * @brief Validate this operation
          */
@@ -142,6 +103,8 @@ namespace TissueForge::models::vertex {
         /**
          * @brief Implement this operation
          * 
+         * An operation that modifies the mesh sets @ref Flag::Implemented. 
+         * 
          * @return ids of affected children, if any
          */
         virtual std::vector<int> implement() { return {}; }
@@ -24,6 +24,7 @@
 #include "tfVertexSolverFIO.h"
 
 #include <tfEngine.h>
+#include <tfError.h>
 #include <tf_util.h>
 #include <tfLogger.h>
 #include <tfTaskScheduler.h>
@@ -41,6 +42,7 @@
 
 static std::mutex _meshEngineLock;
 static std::future<std::vector<unsigned int> > fut_surfaceVertexIndices;
+static std::future<void> fut_vertexForces;
 
 
 using namespace TissueForge;
@@ -133,6 +135,7 @@ HRESULT MeshSolver::init() {
 
     _solver->_bufferSize = 1;
     _solver->_forces = (FloatP_t*)malloc(3 * sizeof(FloatP_t));
+    _solver->_positionTolerance = 0;
     _solver->timers.reset();
     _solver->registerEngine();
 
@@ -158,6 +161,11 @@ HRESULT MeshSolver::_compactInst() {
         _forces = (FloatP_t*)malloc(3 * sizeof(FloatP_t));
     }
 
+    _vertexMoved.clear();
+    _vertexMoved.shrink_to_fit();
+    _surfaceUpdated.clear();
+    _surfaceUpdated.shrink_to_fit();
+
     return S_OK;
 }
 
@@ -350,75 +358,148 @@ unsigned int MeshSolver::sizeBodies() {
     return _solver->mesh->sizeBodies();
 }
 
-HRESULT MeshSolver::_positionChangedInst() {
+/** Number of consecutive objects assigned to a thread at a time during geometry updates */
+#define TF_MESHSOLVER_GEOMBLOCKSIZE 64
+
+/** 
+ * Apply a function to each index of an inventory. 
+ * 
+ * Blocks of consecutive indices are interleaved over threads, 
+ * so that work concentrated in one region of an inventory is still shared 
+ * while flags written by different threads do not share cache lines. 
+ */
+template <typename F> 
+static void MeshSolver_geomFor(const size_t &numObjs, F func) {
+    const size_t numThreads = ThreadPool::size();
+    const size_t blockStride = numThreads * TF_MESHSOLVER_GEOMBLOCKSIZE;
+    parallel_for(
+        numThreads, 
+        [&numObjs, &blockStride, &func](int tid) -> void {
+            for(size_t i0 = tid * TF_MESHSOLVER_GEOMBLOCKSIZE; i0 < numObjs; i0 += blockStride) {
+                const size_t i1 = std::min<size_t>(i0 + TF_MESHSOLVER_GEOMBLOCKSIZE, numObjs);
+                for(size_t i = i0; i < i1; i++) 
+                    func(tid, i);
+            }
+        }
+    );
+}
+
+/** Combine a value into a connectivity signature */
+static inline size_t MeshSolver_geomSignature(const size_t &sig, const size_t &val) {
+    return sig ^ (val + 0x9e3779b97f4a7c15ULL + (sig << 6) + (sig >> 2));
+}
+
+/** Initial value of a connectivity signature; never equal to the signature of a new object */
+#define TF_MESHSOLVER_GEOMSIGSEED size_t(0x2545f4914f6cdd1dULL)
+
+HRESULT MeshSolver::_positionChangedInst(const bool &incremental) {
 
     _surfaceVertices = 0;
     _totalVertices = 0;
 
-    // Update vertices
+    // Update vertices and find which vertices moved
+
+    const size_t m_size_vertices = mesh->vertices->size();
+    _vertexMoved.resize(m_size_vertices);
 
-    if(mesh->vertices->size() > 0) {
+    if(m_size_vertices > 0) {
 
         Vertex *m_vertices = &(*mesh->vertices)[0];
-        const size_t m_size_vertices = mesh->vertices->size();
-        const int blockSize = std::ceil(float(m_size_vertices) / ThreadPool::size());
-        auto func_vertices = [&m_vertices, m_size_vertices, blockSize](int tid) -> void {
-            int i0 = tid * blockSize;
-            int i1 = std::min<int>(i0 + blockSize, m_size_vertices);
-            for(int i = i0; i < i1; i++) {
+        uint8_t *vertexMoved = _vertexMoved.data();
+        const FloatP_t tol2 = _positionTolerance * _positionTolerance;
+        MeshSolver_geomFor(
+            m_size_vertices, 
+            [&m_vertices, &vertexMoved, &incremental, &tol2](int tid, size_t i) -> void {
                 Vertex &v = m_vertices[i];
-                if(v.objectId() >= 0) 
-                    v.positionChanged();
+                if(v.objectId() < 0) {
+                    vertexMoved[i] = 0;
+                    return;
+                }
+                v.positionChanged();
+                // Negated so that a NaN reference position counts as moved
+                const FloatP_t dist2 = (v._particlePosition - v._geomPosition).dot();
+                if(!incremental || !(dist2 <= tol2)) {
+                    v._geomPosition = v._particlePosition;
+                    vertexMoved[i] = 1;
+                } 
+                else 
+                    vertexMoved[i] = 0;
             }
-        };
-        parallel_for(ThreadPool::size(), func_vertices);
+        );
         _totalVertices += mesh->numVertices();
 
     }
 
-    // Update surfaces
+    // Update surfaces with moved vertices or changed vertices
+
+    const size_t m_size_surfaces = mesh->surfaces->size();
+    _surfaceUpdated.resize(m_size_surfaces);
 
-    if(mesh->surfaces->size() > 0) {
+    if(m_size_surfaces > 0) {
     
         Surface *m_surfaces = &(*mesh->surfaces)[0];
-        const size_t m_size_surfaces = mesh->surfaces->size();
-        const int blockSize = std::ceil(float(m_size_surfaces) / ThreadPool::size());
-        std::atomic<unsigned int> _surfaceVertices_m = 0;
-        auto func_surfaces = [&m_surfaces, &m_size_surfaces, blockSize, &_surfaceVertices_m](int tid) -> void {
-            int i0 = tid * blockSize;
-            int i1 = std::min<int>(i0 + blockSize, m_size_surfaces);
-            unsigned int _surfaceVertices_local = 0;
-            for(int i = i0; i < i1; i++) { 
+        const uint8_t *vertexMoved = _vertexMoved.data();
+        uint8_t *surfaceUpdated = _surfaceUpdated.data();
+        std::vector<unsigned int> surfaceVerticesPool(ThreadPool::size() + 1, 0);
+        MeshSolver_geomFor(
+            m_size_surfaces, 
+            [&m_surfaces, &vertexMoved, &surfaceUpdated, &incremental, &surfaceVerticesPool](int tid, size_t i) -> void {
                 Surface &s = m_surfaces[i];
-                if(s.objectId() >= 0) {
-                    s.positionChanged();
-                    _surfaceVertices_local += s.getVertices().size();
+                surfaceUpdated[i] = 0;
+                if(s.objectId() < 0) 
+                    return;
+
+                bool moved = !incremental;
+                size_t sig = TF_MESHSOLVER_GEOMSIGSEED;
+                FVector3 velocity(0.f);
+                for(auto &v : s.vertices) {
+                    moved |= (bool)vertexMoved[v->_objId];
+                    sig = MeshSolver_geomSignature(sig, v->_objId);
+                    velocity += v->getVelocity();
                 }
+
+                if(moved || sig != s._geomSignature) {
+                    s.positionChanged();
+                    s._geomSignature = sig;
+                    surfaceUpdated[i] = 1;
+                } 
+                else 
+                    s.velocity = velocity / (FloatP_t)s.vertices.size();
+                surfaceVerticesPool[tid] += s.vertices.size();
             }
-            _surfaceVertices_m.fetch_add(_surfaceVertices_local);
-        };
-        parallel_for(ThreadPool::size(), func_surfaces);
-        _surfaceVertices = _surfaceVertices_m;
+        );
+        for(auto &surfaceVerticesThread : surfaceVerticesPool) 
+            _surfaceVertices += surfaceVerticesThread;
 
     }
 
-    // Update bodies
+    // Update bodies with updated surfaces or changed surfaces
 
     if(mesh->bodies->size() > 0) {
     
         Body *m_bodies = &(*mesh->bodies)[0];
         const size_t m_size_bodies = mesh->bodies->size();
-        const int blockSize = std::ceil(float(m_size_bodies) / ThreadPool::size());
-        auto func_bodies = [&m_bodies, &m_size_bodies, blockSize](int tid) -> void {
-            int i0 = tid * blockSize;
-            int i1 = std::min<int>(i0 + blockSize, m_size_bodies);
-            for(int i = i0; i < i1; i++) {
+        const uint8_t *surfaceUpdated = _surfaceUpdated.data();
+        MeshSolver_geomFor(
+            m_size_bodies, 
+            [&m_bodies, &surfaceUpdated, &incremental](int tid, size_t i) -> void {
                 Body &b = m_bodies[i];
-                if(b.objectId() >= 0) 
+                if(b.objectId() < 0) 
+                    return;
+
+                bool updated = !incremental;
+                size_t sig = TF_MESHSOLVER_GEOMSIGSEED;
+                for(auto &s : b.surfaces) {
+                    updated |= (bool)surfaceUpdated[s->_objId];
+                    sig = MeshSolver_geomSignature(sig, 2 * s->_objId + (s->b1 == &b ? 1 : 0));
+                }
+
+                if(updated || sig != b._geomSignature) {
                     b.positionChanged();
+                    b._geomSignature = sig;
+                }
             }
-        };
-        parallel_for(ThreadPool::size(), func_bodies);
+        );
 
     }
 
@@ -435,6 +516,22 @@ HRESULT MeshSolver::positionChanged() {
     return _solver->_positionChangedInst();
 }
 
+FloatP_t MeshSolver::getPositionTolerance() {
+    TF_MESHSOLVER_CHECKINIT_RET(0)
+
+    return _solver->_positionTolerance;
+}
+
+HRESULT MeshSolver::setPositionTolerance(const FloatP_t &tol) {
+    TF_MESHSOLVER_CHECKINIT
+
+    if(tol < 0) 
+        return tf_error(E_FAIL, "Position tolerance must be non-negative");
+
+    _solver->_positionTolerance = tol;
+    return S_OK;
+}
+
 HRESULT MeshSolver::update(const bool &_force) {
     if(!isDirty() || _force) 
         return S_OK;
@@ -443,27 +540,10 @@ HRESULT MeshSolver::update(const bool &_force) {
     return S_OK;
 }
 
-HRESULT MeshSolver::preStepStart() { 
-    TF_MESHSOLVER_CHECKINIT
-
-    MeshLogger::clear();
-
-    _totalVertices = mesh->sizeVertices();
-
+static void MeshSolver_vertexForces(Mesh *mesh, FloatP_t *v_forces) {
     MeshSolverTimerInstance t(MeshSolverTimers::Section::FORCE);
 
-    if(_totalVertices > _bufferSize) {
-        free(_solver->_forces);
-        _bufferSize = _totalVertices;
-        _solver->_forces = (FloatP_t*)malloc(3 * sizeof(FloatP_t) * _bufferSize);
-    }
-    memset(_solver->_forces, 0.f, 3 * sizeof(FloatP_t) * _bufferSize);
-
-    if(_totalVertices == 0) 
-        return S_OK;
-
     Vertex *m_vertices = &(*mesh->vertices)[0];
-    FloatP_t *v_forces = &_forces[0];
     const size_t m_size_vertices = mesh->vertices->size();
     const int blockSize = std::ceil(float(m_size_vertices) / ThreadPool::size());
     auto func = [&m_vertices, &v_forces, m_size_vertices, blockSize](int tid) -> void {
@@ -478,12 +558,37 @@ HRESULT MeshSolver::preStepStart() {
         }
     };
     parallel_for(ThreadPool::size(), func);
+}
+
+HRESULT MeshSolver::preStepStart() { 
+    TF_MESHSOLVER_CHECKINIT
+
+    MeshLogger::clear();
+
+    _totalVertices = mesh->sizeVertices();
+
+    if(_totalVertices > _bufferSize) {
+        free(_solver->_forces);
+        _bufferSize = _totalVertices;
+        _solver->_forces = (FloatP_t*)malloc(3 * sizeof(FloatP_t) * _bufferSize);
+    }
+    memset(_solver->_forces, 0.f, 3 * sizeof(FloatP_t) * _bufferSize);
+
+    if(_totalVertices == 0) 
+        return S_OK;
+
+    // Vertex forces are accumulated into the solver buffer while the engine evaluates particle forces. 
+    // Particle forces are only updated once the engine joins. 
+    fut_vertexForces = std::async(std::launch::async, MeshSolver_vertexForces, mesh, _forces);
 
     return S_OK;
 }
 
 HRESULT MeshSolver::preStepJoin() {
 
+    if(fut_vertexForces.valid()) 
+        fut_vertexForces.get();
+
     MeshSolverTimerInstance t(MeshSolverTimers::Section::ADVANCE);
 
     if(_totalVertices == 0) 
@@ -530,7 +635,7 @@ HRESULT MeshSolver::postStepStart() {
     {
         MeshSolverTimerInstance t(MeshSolverTimers::Section::UPDATE);
 
-        if(positionChanged() != S_OK) 
+        if(_positionChangedInst(true) != S_OK) 
             return E_FAIL;
     }
     
@@ -540,7 +645,7 @@ HRESULT MeshSolver::postStepStart() {
         if(mesh->hasQuality()) 
             mesh->getQuality().doQuality();
 
-        if(positionChanged() != S_OK) 
+        if(_positionChangedInst(true) != S_OK) 
             return E_FAIL;
     }
 
@@ -551,6 +656,10 @@ HRESULT MeshSolver::postStepJoin() {
     return S_OK;
 }
 
+HRESULT MeshSolver::renumberParticles(const std::vector<int> &newIds) {
+    return mesh ? mesh->renumberParticles(newIds) : S_OK;
+}
+
 std::vector<unsigned int> MeshSolver::_getSurfaceVertexIndicesInst() const {
     TF_MESHSOLVER_CHECKINIT_RET({});
 
@@ -288,6 +288,22 @@ namespace TissueForge::models::vertex {
          */
         static HRESULT positionChanged();
 
+        /**
+         * @brief Get the distance a vertex must move before its surfaces and bodies are updated during simulation. 
+         * 
+         * A value of zero updates the geometry of a surface whenever any of its vertices moves. 
+         */
+        static FloatP_t getPositionTolerance();
+
+        /**
+         * @brief Set the distance a vertex must move before its surfaces and bodies are updated during simulation. 
+         * 
+         * A value of zero updates the geometry of a surface whenever any of its vertices moves. 
+         * 
+         * @param tol position tolerance; must be non-negative
+         */
+        static HRESULT setPositionTolerance(const FloatP_t &tol);
+
         /**
          * @brief Update the solver if dirty
          * 
@@ -299,6 +315,7 @@ namespace TissueForge::models::vertex {
         HRESULT preStepJoin() override;
         HRESULT postStepStart() override;
         HRESULT postStepJoin() override;
+        HRESULT renumberParticles(const std::vector<int> &newIds) override;
 
         /**
          * @brief Get the starting vertex index for each surface
@@ -341,6 +358,9 @@ namespace TissueForge::models::vertex {
         unsigned int _surfaceVertices;
         unsigned int _totalVertices;
         bool _isDirty;
+        FloatP_t _positionTolerance;
+        std::vector<uint8_t> _vertexMoved;
+        std::vector<uint8_t> _surfaceUpdated;
         std::mutex _engineLock;
         std::vector<unsigned int> _surfaceVertexIndices;
 
@@ -383,8 +403,13 @@ namespace TissueForge::models::vertex {
         /** Get the surface type by id */
         SurfaceType *_getSurfaceTypeInst(const unsigned int &typeId) const;
 
-        /** Update internal data due to a change in position */
-        HRESULT _positionChangedInst();
+        /** 
+         * Update internal data due to a change in position. 
+         * 
+         * When incremental, only surfaces with moved vertices or changed connectivity 
+         * and bodies with updated surfaces or changed connectivity are updated. 
+         */
+        HRESULT _positionChangedInst(const bool &incremental=false);
 
         /** Get the starting vertex index for each surface */
         std::vector<unsigned int> _getSurfaceVertexIndicesInst() const;
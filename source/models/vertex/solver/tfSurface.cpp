@@ -87,7 +87,8 @@ Surface::Surface() :
     species1{NULL}, 
     species2{NULL}, 
     style{NULL}, 
-    density{0.f}
+    density{0.f}, 
+    _geomSignature{0}
 {
     MESHOBJ_INITOBJ
 }
@@ -575,35 +576,25 @@ HRESULT Surface::destroy(SurfaceHandle &target) {
 }
 
 HRESULT Surface::destroy(const std::vector<Surface*>& target) {
-    // Filter valid targets and get all vertices, bodies and surface types associated with all removed surfaces
+    // Filter valid targets and get all vertices and bodies associated with all removed surfaces
 
     std::vector<std::unordered_set<Surface*> > surfacesToDestroyPool(ThreadPool::size());
     std::vector<std::unordered_set<Vertex*> > verticesPool(ThreadPool::size());
     std::vector<std::unordered_set<Body*> > bodiesPool(ThreadPool::size());
-    std::vector<std::unordered_set<SurfaceType*> > surfaceTypesPool(ThreadPool::size());
-    std::vector<std::unordered_map<SurfaceType*, std::unordered_set<Surface*> > > surfacesByTypePool(ThreadPool::size());
     parallel_for(
         ThreadPool::size(), 
-        [&target, &surfacesToDestroyPool, &verticesPool, &bodiesPool, &surfaceTypesPool, &surfacesByTypePool](int tid) -> void {
+        [&target, &surfacesToDestroyPool, &verticesPool, &bodiesPool](int tid) -> void {
             std::unordered_set<Surface*>& surfacesToDestroyThread = surfacesToDestroyPool[tid];
             std::unordered_set<Vertex*>& verticesThread = verticesPool[tid];
             std::unordered_set<Body*>& bodiesThread = bodiesPool[tid];
-            std::unordered_set<SurfaceType*>& surfaceTypesThread = surfaceTypesPool[tid];
-            std::unordered_map<SurfaceType*, std::unordered_set<Surface*> >& surfacesByTypeThread = surfacesByTypePool[tid];
             for(int i = tid; i < target.size(); i += ThreadPool::size()) {
                 Surface* s = target[i];
                 if(s && s->_objId >= 0) {
                     surfacesToDestroyThread.insert(s);
                     for(auto& v : s->getVertices()) 
-                        if(v->getSurfaces().size() == 1) 
-                            verticesThread.insert(v);
+                        verticesThread.insert(v);
                     for(auto& b : s->getBodies()) 
                         bodiesThread.insert(b);
-                    if(s->typeId >= 0) {
-                        SurfaceType* stype = s->type();
-                        surfaceTypesThread.insert(stype);
-                        surfacesByTypeThread[stype].insert(s);
-                    }
                 }
             }
         }
@@ -615,7 +606,6 @@ HRESULT Surface::destroy(const std::vector<Surface*>& target) {
     surfacesToDestroy.reserve(numSurfaces);
     for(auto& surfacesToDestroyThread : surfacesToDestroyPool) 
         surfacesToDestroy.insert(surfacesToDestroyThread.begin(), surfacesToDestroyThread.end());
-    std::vector<Surface*> surfacesToDestroyVec(surfacesToDestroy.begin(), surfacesToDestroy.end());
 
     size_t numVertices = 0;
     for(auto& verticesThread : verticesPool) 
@@ -623,8 +613,7 @@ HRESULT Surface::destroy(const std::vector<Surface*>& target) {
     std::unordered_set<Vertex*> vertices;
     vertices.reserve(numVertices);
     for(auto& verticesThread : verticesPool) 
-        for(auto& v : verticesThread) 
-            vertices.insert(v);
+        vertices.insert(verticesThread.begin(), verticesThread.end());
     std::vector<Vertex*> verticesVec(vertices.begin(), vertices.end());
 
     // get all vertices affected by removing the surfaces
@@ -632,24 +621,22 @@ HRESULT Surface::destroy(const std::vector<Surface*>& target) {
     std::vector<std::unordered_set<Vertex*> > affectedVerticesPool(ThreadPool::size());
     parallel_for(
         ThreadPool::size(), 
-        [&verticesVec, &surfacesToDestroyVec, &affectedVerticesPool](int tid) -> void {
+        [&verticesVec, &affectedVerticesPool](int tid) -> void {
             std::unordered_set<Vertex*>& affectedVerticesThread = affectedVerticesPool[tid];
-            for(int i = tid; i < surfacesToDestroyVec.size(); i += ThreadPool::size()) 
-                for(auto& v : surfacesToDestroyVec[i]->getVertices()) 
-                    for(auto& nv : v->connectedVertices()) 
-                        if(std::find(verticesVec.begin(), verticesVec.end(), nv) == verticesVec.end()) 
-                            affectedVerticesThread.insert(nv);
+            for(int i = tid; i < verticesVec.size(); i += ThreadPool::size()) 
+                for(auto& nv : verticesVec[i]->connectedVertices()) 
+                    affectedVerticesThread.insert(nv);
         }
     );
-    numVertices = 0;
+    size_t numAffectedVertices = verticesVec.size();
     for(auto& affectedVerticesThread : affectedVerticesPool) 
-        numVertices += affectedVerticesThread.size();
-    std::unordered_set<Vertex*> affectedVertices;
-    affectedVertices.reserve(numVertices);
+        numAffectedVertices += affectedVerticesThread.size();
+    std::unordered_set<Vertex*> affectedVertices(verticesVec.begin(), verticesVec.end());
+    affectedVertices.reserve(numAffectedVertices);
     for(auto& affectedVerticesThread : affectedVerticesPool) 
         affectedVertices.insert(affectedVerticesThread.begin(), affectedVerticesThread.end());
 
-    // destroy dependent bodies
+    // destroy dependent bodies, which may also destroy some of the surfaces when they are left without a body
 
     size_t numBodies = 0;
     for(auto& bodiesThread : bodiesPool) 
@@ -657,43 +644,58 @@ HRESULT Surface::destroy(const std::vector<Surface*>& target) {
     std::unordered_set<Body*> bodies;
     bodies.reserve(numBodies);
     for(auto& bodiesThread : bodiesPool) 
-        for(auto& b : bodiesThread) 
-            bodies.insert(b);
-    Body::destroy({bodies.begin(), bodies.end()});
-
-    // remove from types
-
-    size_t numSurfaceTypes = 0;
-    for(auto& surfaceTypesThread : surfaceTypesPool) 
-        numSurfaceTypes += surfaceTypesThread.size();
-    std::unordered_set<SurfaceType*> surfaceTypes;
-    surfaceTypes.reserve(numSurfaceTypes);
-    for(auto& surfaceTypesThread : surfaceTypesPool) 
-        surfaceTypes.insert(surfaceTypesThread.begin(), surfaceTypesThread.end());
-    std::unordered_map<SurfaceType*, size_t> numSurfacesByType;
-    for(auto& stype : surfaceTypes) {
-        size_t& nSurfaces = numSurfacesByType[stype];
-        for(auto& surfacesByTypeThread : surfacesByTypePool) 
-            nSurfaces += surfacesByTypeThread[stype].size();
-    }
-    std::unordered_map<SurfaceType*, std::unordered_set<SurfaceHandle> > surfacesByType;
-    for(auto& stype : surfaceTypes) {
-        std::unordered_set<SurfaceHandle>& thisSurfacesByType = surfacesByType[stype];
-        thisSurfacesByType.reserve(numSurfacesByType[stype]);
-        for(auto& surfacesByTypeThread : surfacesByTypePool) 
-            for(auto& s : surfacesByTypeThread[stype]) 
-                thisSurfacesByType.emplace(s->objectId());
-        stype->remove({thisSurfacesByType.begin(), thisSurfacesByType.end()});
-    }
-
-    // destroy the surfaces
-    Mesh::get()->remove(surfacesToDestroyVec.data(), surfacesToDestroyVec.size());
-
-    // destroy the vertices that have no remaining surfaces
-    Mesh::get()->remove(verticesVec.data(), verticesVec.size());
+        bodies.insert(bodiesThread.begin(), bodiesThread.end());
+    if(!bodies.empty()) 
+        Body::destroy({bodies.begin(), bodies.end()});
+
+    std::vector<Surface*> surfacesToDestroyVec;
+    surfacesToDestroyVec.reserve(surfacesToDestroy.size());
+    for(auto& s : surfacesToDestroy) 
+        if(s->_objId >= 0) 
+            surfacesToDestroyVec.push_back(s);
+
+    if(!surfacesToDestroyVec.empty()) {
+
+        // remove from types
+
+        std::unordered_map<SurfaceType*, std::vector<SurfaceHandle> > surfacesByType;
+        for(auto& s : surfacesToDestroyVec) 
+            if(s->typeId >= 0) 
+                surfacesByType[s->type()].emplace_back(s->objectId());
+        for(auto& stypeSurfaces : surfacesByType) 
+            stypeSurfaces.first->remove(stypeSurfaces.second);
+
+        // destroy the surfaces
+
+        Mesh::get()->remove(surfacesToDestroyVec.data(), surfacesToDestroyVec.size());
+    }
+
+    // destroy the vertices, and their particles, that have no remaining surfaces
+
+    std::vector<Vertex*> verticesToDestroyVec;
+    std::vector<int> particleIdsToDestroy;
+    for(auto& v : verticesVec) 
+        if(v->_objId >= 0 && v->getSurfaces().empty()) {
+            verticesToDestroyVec.push_back(v);
+            if(v->pid >= 0) 
+                particleIdsToDestroy.push_back(v->pid);
+        }
+    if(!verticesToDestroyVec.empty()) {
+        Mesh::get()->remove(verticesToDestroyVec.data(), verticesToDestroyVec.size());
+        for(auto& pid : particleIdsToDestroy) 
+            ParticleHandle(pid).destroy();
+        for(auto& v : verticesToDestroyVec) {
+            v->pid = -1;
+            v->_connectedVertices.clear();
+        }
+    }
 
     // update connectedness of the affected vertices
-    std::vector<Vertex*> affectedVerticesVec(affectedVertices.begin(), affectedVertices.end());
+    std::vector<Vertex*> affectedVerticesVec;
+    affectedVerticesVec.reserve(affectedVertices.size());
+    for(auto& v : affectedVertices) 
+        if(v->_objId >= 0) 
+            affectedVerticesVec.push_back(v);
     parallel_for(affectedVerticesVec.size(), [&affectedVerticesVec](int i) -> void { affectedVerticesVec[i]->updateConnectedVertices(); });
 
     return S_OK;
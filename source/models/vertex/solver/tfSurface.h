@@ -104,6 +104,9 @@ namespace TissueForge::models::vertex {
         /** Mass density; only used in 2D simulation */
         FloatP_t density;
 
+        /** Signature of the vertices at the last geometry update */
+        size_t _geomSignature;
+
     public:
 
         /** Object actors */
@@ -615,6 +618,7 @@ namespace TissueForge::models::vertex {
         friend Body;
         friend BodyType;
         friend Mesh;
+        friend MeshSolver;
 
     };
 
@@ -33,6 +33,8 @@
 #include <io/tfIO.h>
 #include <io/tfFIO.h>
 
+#include <algorithm>
+#include <limits>
 #include <unordered_set>
 
 
@@ -189,7 +191,8 @@ HRESULT Vertex::setPosition(const FVector3 &pos, const bool &updateChildren) {
 }
 
 Vertex::Vertex() : 
-    pid{-1}
+    pid{-1}, 
+    _geomPosition{std::numeric_limits<FloatP_t>::quiet_NaN()}
 {
     MESHOBJ_INITOBJ
 }
@@ -496,20 +499,17 @@ HRESULT Vertex::destroy() {
 
 HRESULT Vertex::destroy(const std::vector<Vertex*>& toDestroy) {
 
-    std::vector<std::unordered_set<int> > particleIdsToDestroyPool(ThreadPool::size());
     std::vector<std::unordered_set<Vertex*> > verticesToDestroyPool(ThreadPool::size());
     std::vector<std::unordered_set<Surface*> > surfacesToDestroyPool(ThreadPool::size());
     parallel_for(
         ThreadPool::size(), 
-        [&particleIdsToDestroyPool, &verticesToDestroyPool, &surfacesToDestroyPool, &toDestroy](int tid) -> void {
-            std::unordered_set<int>& particleIdsToDestroyThread = particleIdsToDestroyPool[tid];
+        [&verticesToDestroyPool, &surfacesToDestroyPool, &toDestroy](int tid) -> void {
             std::unordered_set<Vertex*>& verticesToDestroyThread = verticesToDestroyPool[tid];
             std::unordered_set<Surface*>& surfacesToDestroyThread = surfacesToDestroyPool[tid];
             for(int i = tid; i < toDestroy.size(); i += ThreadPool::size()) {
                 Vertex* v = toDestroy[i];
                 if(!v || v->objectId() < 0) 
                     continue;
-                particleIdsToDestroyThread.insert(v->getPartId());
                 verticesToDestroyThread.insert(v);
                 for(auto& s : v->getSurfaces()) 
                     surfacesToDestroyThread.insert(s);
@@ -528,25 +528,29 @@ HRESULT Vertex::destroy(const std::vector<Vertex*>& toDestroy) {
         Surface::destroy(std::vector<Surface*>{surfacesToDestroy.begin(), surfacesToDestroy.end()});
     }
 
+    // Destroying the surfaces also destroys the vertices left without a surface, along with their particles
+
     size_t numVertices = 0;
     for(auto& verticesToDestroyThread : verticesToDestroyPool) 
         numVertices += verticesToDestroyThread.size();
-    std::vector<Vertex*> verticesToDestroyVec;
-    if(numVertices > 0) {
-        std::unordered_set<Vertex*> verticesToDestroy;
-        verticesToDestroy.reserve(numVertices);
-        for(auto& verticesToDestroyThread : verticesToDestroyPool) 
-            verticesToDestroy.insert(verticesToDestroyThread.begin(), verticesToDestroyThread.end());
-        verticesToDestroyVec = std::vector<Vertex*>(verticesToDestroy.begin(), verticesToDestroy.end());
-        Mesh::get()->remove(verticesToDestroyVec.data(), verticesToDestroyVec.size());
-
-        std::unordered_set<int> particleIdsToDestroy;
-        particleIdsToDestroy.reserve(numVertices);
-        for(auto& particleIdsToDestroyThread : particleIdsToDestroyPool) 
-            particleIdsToDestroy.insert(particleIdsToDestroyThread.begin(), particleIdsToDestroyThread.end());
-        for(auto& pid : particleIdsToDestroy) 
-            ParticleHandle(pid).destroy();
-    }
+    std::unordered_set<Vertex*> verticesToDestroy;
+    verticesToDestroy.reserve(numVertices);
+    for(auto& verticesToDestroyThread : verticesToDestroyPool) 
+        for(auto& v : verticesToDestroyThread) 
+            if(v->objectId() >= 0) 
+                verticesToDestroy.insert(v);
+    if(verticesToDestroy.empty()) 
+        return S_OK;
+
+    std::vector<Vertex*> verticesToDestroyVec(verticesToDestroy.begin(), verticesToDestroy.end());
+    std::vector<int> particleIdsToDestroy;
+    particleIdsToDestroy.reserve(verticesToDestroyVec.size());
+    for(auto& v : verticesToDestroyVec) 
+        if(v->pid >= 0) 
+            particleIdsToDestroy.push_back(v->pid);
+    Mesh::get()->remove(verticesToDestroyVec.data(), verticesToDestroyVec.size());
+    for(auto& pid : particleIdsToDestroy) 
+        ParticleHandle(pid).destroy();
 
     parallel_for(
         verticesToDestroyVec.size(), 
@@ -670,35 +674,55 @@ HRESULT Vertex::transferBondsTo(Vertex *other) {
     std::vector<std::pair<uint32_t, int> > dihedralsInfo;
     if(Vertex_destroyOrTransferBonds(this, other, bondsInfo, anglesInfo, dihedralsInfo) != S_OK) 
         return E_FAIL;
+
+    // Endpoints are reassigned while out of the per-particle indices of the engine
     for(auto& p : bondsInfo) {
         uint32_t bid;
         int result;
         std::tie(bid, result) = p;
         BondHandle bh(bid);
-        if(result < 0) bh.destroy();
-        else if(result == 0) bh.get()->i = other->pid;
-        else if(result == 1) bh.get()->j = other->pid;
+        if(result < 0) {
+            bh.destroy();
+            continue;
+        }
+        Bond *b = bh.get();
+        engine_bond_index_remove(&_Engine, bid);
+        if(result == 0) b->i = other->pid;
+        else if(result == 1) b->j = other->pid;
+        engine_bond_index_add(&_Engine, bid);
     }
     for(auto& p : anglesInfo) {
         uint32_t bid;
         int result;
         std::tie(bid, result) = p;
         AngleHandle bh(bid);
-        if(result < 0) bh.destroy();
-        else if(result == 0) bh.get()->i = other->pid;
-        else if(result == 1) bh.get()->j = other->pid;
-        else if(result == 2) bh.get()->k = other->pid;
+        if(result < 0) {
+            bh.destroy();
+            continue;
+        }
+        Angle *a = bh.get();
+        engine_angle_index_remove(&_Engine, bid);
+        if(result == 0) a->i = other->pid;
+        else if(result == 1) a->j = other->pid;
+        else if(result == 2) a->k = other->pid;
+        engine_angle_index_add(&_Engine, bid);
     }
     for(auto& p : dihedralsInfo) {
         uint32_t bid;
         int result;
         std::tie(bid, result) = p;
         DihedralHandle bh(bid);
-        if(result < 0) bh.destroy();
-        else if(result == 0) bh.get()->i = other->pid;
-        else if(result == 1) bh.get()->j = other->pid;
-        else if(result == 2) bh.get()->k = other->pid;
-        else if(result == 3) bh.get()->l = other->pid;
+        if(result < 0) {
+            bh.destroy();
+            continue;
+        }
+        Dihedral *d = bh.get();
+        engine_dihedral_index_remove(&_Engine, bid);
+        if(result == 0) d->i = other->pid;
+        else if(result == 1) d->j = other->pid;
+        else if(result == 2) d->k = other->pid;
+        else if(result == 3) d->l = other->pid;
+        engine_dihedral_index_add(&_Engine, bid);
     }
 
     return S_OK;
@@ -768,53 +792,60 @@ HRESULT Vertex::transferBondsTo(const std::vector<std::pair<Vertex*, Vertex*> >&
                 mf[p.first] = p.second;
         }
 
+    // Endpoints are reassigned while out of the per-particle indices of the engine
     for(auto& m : bondsInfo) {
         const int bid = m.first;
+        BondHandle bh(bid);
+        if(std::any_of(m.second.begin(), m.second.end(), [](const std::pair<const int, int>& p) -> bool { return p.second < 0; })) {
+            bh.destroy();
+            continue;
+        }
+        Bond *b = bh.get();
+        engine_bond_index_remove(&_Engine, bid);
         for(auto& p : m.second) {
             const int vtid = p.first;
             const int result = p.second;
-
-            BondHandle bh(bid);
-            if(result < 0) {
-                bh.destroy();
-                break;
-            }
-            else if(result == 0) bh.get()->i = vtid;
-            else if(result == 1) bh.get()->j = vtid;
+            if(result == 0) b->i = vtid;
+            else if(result == 1) b->j = vtid;
         }
+        engine_bond_index_add(&_Engine, bid);
     }
     for(auto& m : anglesInfo) {
         const int bid = m.first;
+        AngleHandle bh(bid);
+        if(std::any_of(m.second.begin(), m.second.end(), [](const std::pair<const int, int>& p) -> bool { return p.second < 0; })) {
+            bh.destroy();
+            continue;
+        }
+        Angle *a = bh.get();
+        engine_angle_index_remove(&_Engine, bid);
         for(auto& p : m.second) {
             const int vtid = p.first;
             const int result = p.second;
-
-            AngleHandle bh(bid);
-            if(result < 0) {
-                bh.destroy();
-                break;
-            }
-            else if(result == 0) bh.get()->i = vtid;
-            else if(result == 1) bh.get()->j = vtid;
-            else if(result == 2) bh.get()->k = vtid;
+            if(result == 0) a->i = vtid;
+            else if(result == 1) a->j = vtid;
+            else if(result == 2) a->k = vtid;
         }
+        engine_angle_index_add(&_Engine, bid);
     }
     for(auto& m : dihedralsInfo) {
         const int bid = m.first;
+        DihedralHandle bh(bid);
+        if(std::any_of(m.second.begin(), m.second.end(), [](const std::pair<const int, int>& p) -> bool { return p.second < 0; })) {
+            bh.destroy();
+            continue;
+        }
+        Dihedral *d = bh.get();
+        engine_dihedral_index_remove(&_Engine, bid);
         for(auto& p : m.second) {
             const int vtid = p.first;
             const int result = p.second;
-
-            DihedralHandle bh(bid);
-            if(result < 0) {
-                bh.destroy();
-                break;
-            }
-            else if(result == 0) bh.get()->i = vtid;
-            else if(result == 1) bh.get()->j = vtid;
-            else if(result == 2) bh.get()->k = vtid;
-            else if(result == 3) bh.get()->l = vtid;
+            if(result == 0) d->i = vtid;
+            else if(result == 1) d->j = vtid;
+            else if(result == 2) d->k = vtid;
+            else if(result == 3) d->l = vtid;
         }
+        engine_dihedral_index_add(&_Engine, bid);
     }
 
     return S_OK;
@@ -88,6 +88,9 @@ namespace TissueForge::models::vertex {
         /** Cached particle data: velocity */
         FVector3 _particleVelocity;
 
+        /** Position at the last geometry update of connected objects; NaN until the first update */
+        FVector3 _geomPosition;
+
         /** Cached connected vertices */
         std::vector<Vertex*> _connectedVertices;
 
@@ -478,6 +481,7 @@ namespace TissueForge::models::vertex {
         friend Surface;
         friend Body;
         friend Mesh;
+        friend MeshSolver;
 
     };
 
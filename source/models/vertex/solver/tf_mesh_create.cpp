@@ -23,8 +23,10 @@
 
 #include <tfLogger.h>
 #include <tfError.h>
+#include <tfTaskScheduler.h>
 
 #include <map>
+#include <unordered_set>
 
 using namespace TissueForge;
 using namespace TissueForge::models::vertex;
@@ -544,3 +546,166 @@ std::vector<std::vector<std::vector<BodyHandle> > > TissueForge::models::vertex:
 
     return result;
 }
+
+template <typename T> 
+static std::vector<std::vector<T> > createMesh_gather(
+    const std::vector<T> &objs, 
+    const std::vector<std::vector<unsigned int> > &indices, 
+    HRESULT &result) 
+{
+    std::vector<std::vector<T> > gathered(indices.size());
+    std::vector<HRESULT> resultPool(ThreadPool::size(), S_OK);
+    const size_t numObjs = objs.size();
+    parallel_for(
+        ThreadPool::size(), 
+        [&objs, &indices, &gathered, &resultPool, numObjs](int tid) -> void {
+            for(size_t i = tid; i < indices.size(); i += ThreadPool::size()) {
+                const std::vector<unsigned int> &indices_i = indices[i];
+                std::vector<T> &gathered_i = gathered[i];
+                gathered_i.reserve(indices_i.size());
+                for(auto &idx : indices_i) {
+                    if(idx >= numObjs) {
+                        resultPool[tid] = E_FAIL;
+                        return;
+                    }
+                    gathered_i.push_back(objs[idx]);
+                }
+            }
+        }
+    );
+    result = S_OK;
+    for(auto &resultThread : resultPool) 
+        if(resultThread != S_OK) 
+            result = resultThread;
+    return gathered;
+}
+
+/**
+ * @brief Destroy the objects made by a failed mesh creation, along with the particles of its vertices. 
+ * 
+ * Surfaces are destroyed first, which also destroys any bodies that they define, 
+ * so that the remaining vertices have no surfaces when they are destroyed. 
+ */
+static void createMesh_rollback(Mesh *mesh, const std::vector<VertexHandle> &vertices, const std::vector<SurfaceHandle> &surfaces) {
+    // Includes the surfaces of the vertices, in case surface creation failed part way
+    std::unordered_set<Surface*> _surfaces;
+    for(auto &v : vertices) {
+        Vertex *_v = v.id >= 0 ? mesh->getVertex(v.id) : NULL;
+        if(_v) 
+            for(auto &s : _v->getSurfaces()) 
+                _surfaces.insert(s);
+    }
+    for(auto &s : surfaces) {
+        Surface *_s = s.id >= 0 ? mesh->getSurface(s.id) : NULL;
+        if(_s) 
+            _surfaces.insert(_s);
+    }
+    if(!_surfaces.empty()) 
+        Surface::destroy(std::vector<Surface*>(_surfaces.begin(), _surfaces.end()));
+
+    std::vector<Vertex*> _vertices;
+    _vertices.reserve(vertices.size());
+    for(auto &v : vertices) {
+        Vertex *_v = v.id >= 0 ? mesh->getVertex(v.id) : NULL;
+        if(_v) 
+            _vertices.push_back(_v);
+    }
+    if(!_vertices.empty()) 
+        Vertex::destroy(_vertices);
+}
+
+static std::vector<SurfaceHandle> createMesh_surfaces(
+    Mesh *mesh, 
+    SurfaceType *stype, 
+    const std::vector<FVector3> &positions, 
+    const std::vector<std::vector<unsigned int> > &surfaceVertices, 
+    std::vector<VertexHandle> &vertices) 
+{
+    if(mesh->ensureAvailableVertices(positions.size()) != S_OK || mesh->ensureAvailableSurfaces(surfaceVertices.size()) != S_OK) {
+        TF_Log(LOG_ERROR);
+        return {};
+    }
+
+    vertices = Vertex::create(positions);
+    if(vertices.size() != positions.size()) {
+        tf_error(E_FAIL, "Vertices could not be created");
+        createMesh_rollback(mesh, vertices, {});
+        return {};
+    }
+
+    HRESULT result;
+    std::vector<std::vector<VertexHandle> > verticesBySurface = createMesh_gather(vertices, surfaceVertices, result);
+    if(result != S_OK) {
+        tf_error(result, "Invalid vertex index");
+        createMesh_rollback(mesh, vertices, {});
+        return {};
+    }
+
+    std::vector<SurfaceHandle> surfaces = (*stype)(verticesBySurface);
+    if(surfaces.empty()) {
+        tf_error(E_FAIL, "Surfaces could not be created");
+        createMesh_rollback(mesh, vertices, {});
+        return {};
+    }
+
+    return surfaces;
+}
+
+std::vector<SurfaceHandle> TissueForge::models::vertex::createMesh(
+    SurfaceType *stype, 
+    const std::vector<FVector3> &positions, 
+    const std::vector<std::vector<unsigned int> > &surfaceVertices) 
+{
+    Mesh *mesh = Mesh::get();
+    if(!mesh || !stype) {
+        tf_error(E_FAIL, "Invalid mesh or type");
+        return {};
+    }
+    if(surfaceVertices.empty()) 
+        return {};
+
+    std::vector<VertexHandle> vertices;
+    return createMesh_surfaces(mesh, stype, positions, surfaceVertices, vertices);
+}
+
+std::vector<BodyHandle> TissueForge::models::vertex::createMesh(
+    BodyType *btype, 
+    SurfaceType *stype, 
+    const std::vector<FVector3> &positions, 
+    const std::vector<std::vector<unsigned int> > &surfaceVertices, 
+    const std::vector<std::vector<unsigned int> > &bodySurfaces) 
+{
+    Mesh *mesh = Mesh::get();
+    if(!mesh || !btype || !stype) {
+        tf_error(E_FAIL, "Invalid mesh or type");
+        return {};
+    }
+    if(bodySurfaces.empty()) 
+        return {};
+
+    if(mesh->ensureAvailableBodies(bodySurfaces.size()) != S_OK) {
+        TF_Log(LOG_ERROR);
+        return {};
+    }
+
+    std::vector<VertexHandle> vertices;
+    std::vector<SurfaceHandle> surfaces = createMesh_surfaces(mesh, stype, positions, surfaceVertices, vertices);
+    if(surfaces.empty()) 
+        return {};
+
+    HRESULT result;
+    std::vector<std::vector<SurfaceHandle> > surfacesByBody = createMesh_gather(surfaces, bodySurfaces, result);
+    std::vector<BodyHandle> bodies;
+    if(result != S_OK) 
+        tf_error(result, "Invalid surface index");
+    else 
+        bodies = (*btype)(surfacesByBody);
+
+    if(bodies.empty()) {
+        tf_error(E_FAIL, "Bodies could not be created");
+        createMesh_rollback(mesh, vertices, surfaces);
+        return {};
+    }
+
+    return bodies;
+}
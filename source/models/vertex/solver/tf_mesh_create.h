@@ -145,6 +145,48 @@ namespace TissueForge::models::vertex {
         const char *ax_1="x", 
         const char *ax_2="y"
     );
+
+    /**
+     * @brief Populate the mesh with surfaces from vertex positions and indices. 
+     * 
+     * Requires an initialized solver. 
+     * 
+     * All vertices, and their particles, are created in one batch, 
+     * and surface connectivity is built in parallel. 
+     * 
+     * @param stype surface type
+     * @param positions vertex positions
+     * @param surfaceVertices indices of the vertices of each surface, in order
+     * @return constructed surfaces
+     */
+    CPPAPI_FUNC(std::vector<SurfaceHandle>) createMesh(
+        SurfaceType *stype, 
+        const std::vector<FVector3> &positions, 
+        const std::vector<std::vector<unsigned int> > &surfaceVertices
+    );
+
+    /**
+     * @brief Populate the mesh with bodies from vertex positions and indices. 
+     * 
+     * Requires an initialized solver. 
+     * 
+     * All vertices, and their particles, are created in one batch, 
+     * and surface and body connectivity is built in parallel. 
+     * 
+     * @param btype body type
+     * @param stype surface type
+     * @param positions vertex positions
+     * @param surfaceVertices indices of the vertices of each surface, in order
+     * @param bodySurfaces indices of the surfaces of each body
+     * @return constructed bodies
+     */
+    CPPAPI_FUNC(std::vector<BodyHandle>) createMesh(
+        BodyType *btype, 
+        SurfaceType *stype, 
+        const std::vector<FVector3> &positions, 
+        const std::vector<std::vector<unsigned int> > &surfaceVertices, 
+        const std::vector<std::vector<unsigned int> > &bodySurfaces
+    );
     
 };
 
@@ -114,6 +114,7 @@ struct discretizationGridData{
 
 static inline void render_discretization_grid(
     TissueForge::uiVector3 nr_cells, 
+    fVector3 grid_origin, 
     fVector3 grid_dim, 
     GL::Buffer *discretizationGridBuffer, 
     GL::Mesh *discretizationGridMesh, 
@@ -129,11 +130,11 @@ static inline void render_discretization_grid(
     Containers::Array<discretizationGridData> _discretizationGridData;
     Corrade::Containers::arrayResize(_discretizationGridData, 0);
     for(unsigned int i = 0; i < nr_cells.x(); i++) {
-        float ox = cell_dim_x * i;
+        float ox = grid_origin.x() + cell_dim_x * i;
         for(unsigned int j = 0; j < nr_cells.y(); j++) {
-            float oy = cell_dim_y * j;
+            float oy = grid_origin.y() + cell_dim_y * j;
             for(unsigned int k = 0; k < nr_cells.z(); k++) {
-                float oz = cell_dim_z * k;
+                float oz = grid_origin.z() + cell_dim_z * k;
                 Vector3 cell_origin{ox, oy, oz};
                 Vector3 cell_center = cell_origin + cell_hdim;
                 Matrix4 tm = Matrix4::translation(cell_center) * Matrix4::scaling(cell_hdim);
@@ -260,7 +261,7 @@ rendering::UniverseRenderer::UniverseRenderer(const Simulator::Config &conf, ren
     FVector3 origin = engine_origin();
     FVector3 dim = Universe::dim();
 
-    center = (dim + origin) / 2.;
+    center = origin + dim / 2.;
 
     sideLength = dim.max();
     
@@ -334,7 +335,7 @@ rendering::UniverseRenderer::UniverseRenderer(const Simulator::Config &conf, ren
         Shaders::Flat3D::TransformationMatrix{}, 
         Shaders::Flat3D::Color3{}
     );
-    render_discretization_grid(uiVector3(conf.universeConfig.spaceGridSize), dim, &discretizationGridBuffer, &discretizationGridMesh, _discretizationGridColor);
+    render_discretization_grid(uiVector3(conf.universeConfig.spaceGridSize), origin, dim, &discretizationGridBuffer, &discretizationGridMesh, _discretizationGridColor);
 
     // Set up subrenderers and finish
 
@@ -538,6 +539,7 @@ rendering::UniverseRenderer& rendering::UniverseRenderer::setDiscretizationGridC
     _discretizationGridColor = color;
     render_discretization_grid(
         uiVector3(iVector3::from(_Engine.s.cdim)), 
+        fVector3(FVector3::from(_Engine.s.origin)), 
         fVector3(FVector3::from(_Engine.s.dim)), 
         &discretizationGridBuffer, 
         &discretizationGridMesh, 
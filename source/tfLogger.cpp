@@ -20,7 +20,12 @@
 #include "tfLogger.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 using namespace TissueForge;
@@ -51,6 +56,80 @@ static std::ostream *fileStream = NULL;
 
 static LoggerCallback callback = NULL;
 
+/** Serializes writing to, and changing of, output streams */
+static std::mutex writeLock;
+
+static std::atomic<unsigned int> rateLimit{0};
+
+static const std::chrono::steady_clock::time_point logEpoch = std::chrono::steady_clock::now();
+
+
+/** A message queued for asynchronous writing */
+struct LogRecord {
+    int level;
+    std::string msg;
+    const char *func;
+    const char *file;
+    int line;
+    unsigned int thread;
+    uint64_t time;
+};
+
+/** Lock-free single-producer, single-consumer queue of the messages of one thread */
+struct LogQueue {
+    std::vector<LogRecord> records;
+    size_t mask;
+
+    /** Next record to write; only changed by the writing thread */
+    std::atomic<size_t> head{0};
+
+    /** Next free slot; only changed by the owning thread */
+    std::atomic<size_t> tail{0};
+
+    std::atomic<size_t> dropped{0};
+
+    /** Flag signaling that the owning thread has exited */
+    std::atomic<bool> orphaned{false};
+
+    unsigned int thread;
+};
+
+/** State of asynchronous logging */
+struct LogAsyncState {
+    std::atomic<bool> enabled{false};
+    size_t capacity = 0;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::thread worker;
+    bool stopping = false;
+    std::atomic<bool> wake{false};
+    uint64_t flushRequested = 0;
+    uint64_t flushCompleted = 0;
+
+    std::mutex queuesLock;
+    std::vector<LogQueue*> queues;
+    std::atomic<unsigned int> numThreads{0};
+
+    ~LogAsyncState();
+};
+
+static LogAsyncState asyncState;
+
+/** Marks the queue of a thread when the thread exits */
+struct LogQueueHandle {
+    LogQueue *queue = NULL;
+
+    ~LogQueueHandle() {
+        if(queue) 
+            queue->orphaned.store(true, std::memory_order_release);
+    }
+};
+
+static thread_local LogQueueHandle localQueue;
+
+static bool Logger_enqueue(int level, std::string &&msg, const char *func, const char *file, int line);
+
 
 
 class FakeLogger {
@@ -70,8 +149,27 @@ static FakeLogger& getLogger() {
     return logger;
 }
 
-LoggingBuffer::LoggingBuffer(int level, const char* func, const char *file, int line):
-                func(func), file(file), line(line)
+LogSite *LogSite::admit(int level)
+{
+    const unsigned int limit = rateLimit.load(std::memory_order_relaxed);
+    if(limit == 0 || level <= LOG_ERROR) 
+        return this;
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - logEpoch).count();
+    int64_t current = window.load(std::memory_order_relaxed);
+    if(current != now && window.compare_exchange_strong(current, now, std::memory_order_relaxed)) 
+        count.store(0, std::memory_order_relaxed);
+
+    if(count.fetch_add(1, std::memory_order_relaxed) < limit) 
+        return this;
+
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return NULL;
+}
+
+LoggingBuffer::LoggingBuffer(int level, const char* func, const char *file, int line, LogSite *site):
+                func(func), file(file), line(line), 
+                suppressed(site ? site->suppressed.exchange(0, std::memory_order_relaxed) : 0)
 {
     if (level >= Message::PRIO_FATAL && level <= Message::PRIO_TRACE)
     {
@@ -86,6 +184,17 @@ LoggingBuffer::LoggingBuffer(int level, const char* func, const char *file, int
 
 LoggingBuffer::~LoggingBuffer()
 {
+    if(suppressed > 0) 
+        buffer << " (" << suppressed << " similar messages suppressed)";
+
+    // Errors and higher are written immediately, after everything already queued
+    if(level > Message::PRIO_ERROR) {
+        if(Logger_enqueue(level, buffer.str(), func, file, line)) 
+            return;
+    }
+    else if(Logger::isAsync()) 
+        Logger::flush();
+
     FakeLogger &logger = getLogger();
     switch (level)
     {
@@ -147,7 +256,10 @@ void Logger::disableLogging()
 
 void Logger::disableConsoleLogging()
 {
-    consoleStream = NULL;
+    {
+        std::lock_guard<std::mutex> lock(writeLock);
+        consoleStream = NULL;
+    }
     if(callback) callback(LOG_OUTPUTSTREAM_CHANGED, consoleStream);
 }
 
@@ -155,7 +267,10 @@ void Logger::enableConsoleLogging(int level)
 {
     setLevel(level);
 
-    consoleStream = &std::cout;
+    {
+        std::lock_guard<std::mutex> lock(writeLock);
+        consoleStream = &std::cout;
+    }
 
     if(callback) {
         callback(LOG_OUTPUTSTREAM_CHANGED, consoleStream);
@@ -168,10 +283,13 @@ void Logger::enableFileLogging(const std::string &fileName, int level)
 
     disableFileLogging();
 
-    outputFileName = fileName;
-    outputFile.open(fileName, std::ios_base::out|std::ios_base::ate);
-    if(outputFile.is_open()) {
-        fileStream = &outputFile;
+    {
+        std::lock_guard<std::mutex> lock(writeLock);
+        outputFileName = fileName;
+        outputFile.open(fileName, std::ios_base::out|std::ios_base::ate);
+        if(outputFile.is_open()) {
+            fileStream = &outputFile;
+        }
     }
 
     if(callback) {
@@ -183,9 +301,12 @@ void Logger::disableFileLogging()
 {
     if (outputFileName.size() == 0) return;
 
-    outputFile.close();
-    outputFileName = "";
-    fileStream = NULL;
+    {
+        std::lock_guard<std::mutex> lock(writeLock);
+        outputFile.close();
+        outputFileName = "";
+        fileStream = NULL;
+    }
 
     if(callback) {
         callback(LOG_OUTPUTSTREAM_CHANGED, fileStream);
@@ -281,6 +402,13 @@ LogLevel Logger::stringToLevel(const std::string &str)
 
 void Logger::log(LogLevel l, const std::string &msg)
 {
+    if(l > LOG_ERROR && l <= LOG_TRACE) {
+        if(Logger_enqueue(l, std::string(msg), "", "", 0)) 
+            return;
+    }
+    else if(Logger::isAsync()) 
+        Logger::flush();
+
     FakeLogger &logger = getLogger();
 
     Message::Priority level = (Message::Priority)(l);
@@ -319,7 +447,10 @@ void Logger::log(LogLevel l, const std::string &msg)
 
 void Logger::setConsoleStream(std::ostream *os)
 {
-    consoleStream = os;
+    {
+        std::lock_guard<std::mutex> lock(writeLock);
+        consoleStream = os;
+    }
 
     if(callback) callback(LOG_OUTPUTSTREAM_CHANGED, consoleStream);
 }
@@ -344,6 +475,7 @@ static void write_log(const char* kind, const std::string &fmt, const char* func
 
 static void write_log(const char* kind, const std::string &fmt, const char* func, const char *file, const int line) {
     
+    std::lock_guard<std::mutex> lock(writeLock);
     if(consoleStream) write_log(kind, fmt, func, file, line, consoleStream);
     if(fileStream) write_log(kind, fmt, func, file, line, fileStream);
 }
@@ -395,3 +527,220 @@ void FakeLogger::trace(const std::string &fmt, const char* func, const char *fil
 {
     write_log("TRACE", fmt, func, file, line);
 }
+
+static const char *Logger_kind(int level) {
+    switch(level) {
+        case Message::PRIO_FATAL:       return "FATAL";
+        case Message::PRIO_CRITICAL:    return "CRITICAL";
+        case Message::PRIO_ERROR:       return "ERROR";
+        case Message::PRIO_WARNING:     return "WARNING";
+        case Message::PRIO_NOTICE:      return "NOTICE";
+        case Message::PRIO_INFORMATION: return "INFO";
+        case Message::PRIO_DEBUG:       return "DEBUG";
+        case Message::PRIO_TRACE:       return "TRACE";
+        default:                        return "ERROR";
+    }
+}
+
+static void write_log(const LogRecord &record, std::ostream *os) {
+    
+    *os << Logger_kind(record.level) << ": " << record.msg;
+    if(record.func) { *os << ", func: " << record.func;}
+    if(record.file) {*os << ", file:" << record.file;}
+    if(record.line >= 0) {*os << ",lineno:" << record.line;}
+    *os << ",thread:" << record.thread << ",time:" << 1.0E-9 * record.time;
+    *os << std::endl;
+}
+
+static bool Logger_enqueue(int level, std::string &&msg, const char *func, const char *file, int line) {
+    if(!asyncState.enabled.load(std::memory_order_acquire)) 
+        return false;
+
+    LogQueue *queue = localQueue.queue;
+    if(!queue) {
+        queue = new LogQueue();
+        queue->thread = asyncState.numThreads.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(asyncState.queuesLock);
+        queue->records.resize(asyncState.capacity);
+        queue->mask = asyncState.capacity - 1;
+        asyncState.queues.push_back(queue);
+        localQueue.queue = queue;
+    }
+
+    const size_t tail = queue->tail.load(std::memory_order_relaxed);
+    const size_t head = queue->head.load(std::memory_order_acquire);
+    if(tail - head > queue->mask) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    LogRecord &record = queue->records[tail & queue->mask];
+    record.level = level;
+    record.msg = std::move(msg);
+    record.func = func;
+    record.file = file;
+    record.line = line;
+    record.thread = queue->thread;
+    record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - logEpoch).count();
+    queue->tail.store(tail + 1, std::memory_order_release);
+
+    // Wake the writer early when a queue is half full
+    if(2 * (tail + 1 - head) > queue->mask && !asyncState.wake.exchange(true)) 
+        asyncState.cv.notify_one();
+
+    return true;
+}
+
+/** Write all queued messages in order of logging. Only one thread drains at a time. */
+static void Logger_drain(std::vector<LogRecord> &records) {
+    std::vector<std::pair<unsigned int, size_t> > dropped;
+
+    {
+        std::lock_guard<std::mutex> lock(asyncState.queuesLock);
+
+        for(auto itr = asyncState.queues.begin(); itr != asyncState.queues.end();) {
+            LogQueue *queue = *itr;
+
+            // Read before the tail, so that all records of an exited thread are taken
+            const bool orphaned = queue->orphaned.load(std::memory_order_acquire);
+            const size_t head = queue->head.load(std::memory_order_relaxed);
+            const size_t tail = queue->tail.load(std::memory_order_acquire);
+            for(size_t i = head; i < tail; i++) 
+                records.push_back(std::move(queue->records[i & queue->mask]));
+            queue->head.store(tail, std::memory_order_release);
+
+            const size_t numDropped = queue->dropped.exchange(0, std::memory_order_relaxed);
+            if(numDropped > 0) 
+                dropped.push_back({queue->thread, numDropped});
+
+            if(orphaned) {
+                delete queue;
+                itr = asyncState.queues.erase(itr);
+            } 
+            else 
+                ++itr;
+        }
+    }
+
+    if(records.empty() && dropped.empty()) 
+        return;
+
+    std::stable_sort(
+        records.begin(), records.end(), 
+        [](const LogRecord &a, const LogRecord &b) -> bool { return a.time < b.time; }
+    );
+
+    std::lock_guard<std::mutex> lock(writeLock);
+    for(auto &record : records) {
+        if(consoleStream) write_log(record, consoleStream);
+        if(fileStream) write_log(record, fileStream);
+    }
+    for(auto &d : dropped) {
+        const std::string msg = std::to_string(d.second) + " messages dropped from full log queue of thread " + std::to_string(d.first);
+        if(consoleStream) write_log("WARNING", msg, NULL, NULL, -1, consoleStream);
+        if(fileStream) write_log("WARNING", msg, NULL, NULL, -1, fileStream);
+    }
+    records.clear();
+}
+
+static void Logger_work() {
+    std::vector<LogRecord> records;
+
+    std::unique_lock<std::mutex> lock(asyncState.lock);
+    while(true) {
+        asyncState.cv.wait_for(
+            lock, 
+            std::chrono::milliseconds(10), 
+            []() -> bool { 
+                return asyncState.stopping || asyncState.wake.load() || asyncState.flushRequested > asyncState.flushCompleted; 
+            }
+        );
+        asyncState.wake.store(false);
+        const uint64_t target = asyncState.flushRequested;
+        const bool stopping = asyncState.stopping;
+        lock.unlock();
+
+        Logger_drain(records);
+
+        lock.lock();
+        asyncState.flushCompleted = target;
+        asyncState.cv.notify_all();
+        if(stopping) 
+            return;
+    }
+}
+
+LogAsyncState::~LogAsyncState() {
+    Logger::disableAsync();
+
+    for(auto &queue : queues) 
+        delete queue;
+    queues.clear();
+}
+
+void Logger::enableAsync(unsigned int capacity)
+{
+    std::lock_guard<std::mutex> lock(asyncState.lock);
+    if(asyncState.worker.joinable()) 
+        return;
+
+    {
+        // Applies to queues of threads that have not yet logged asynchronously
+        std::lock_guard<std::mutex> queuesLock(asyncState.queuesLock);
+        size_t _capacity = 2;
+        while(_capacity < capacity) 
+            _capacity <<= 1;
+        asyncState.capacity = _capacity;
+    }
+
+    asyncState.stopping = false;
+    asyncState.worker = std::thread(Logger_work);
+    asyncState.enabled.store(true, std::memory_order_release);
+}
+
+void Logger::disableAsync()
+{
+    asyncState.enabled.store(false, std::memory_order_release);
+
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(asyncState.lock);
+        if(!asyncState.worker.joinable()) 
+            return;
+        asyncState.stopping = true;
+        asyncState.cv.notify_all();
+        worker = std::move(asyncState.worker);
+    }
+    worker.join();
+
+    // Take anything queued while the writer was stopping
+    std::vector<LogRecord> records;
+    Logger_drain(records);
+}
+
+bool Logger::isAsync()
+{
+    return asyncState.enabled.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    std::unique_lock<std::mutex> lock(asyncState.lock);
+    if(!asyncState.worker.joinable() || std::this_thread::get_id() == asyncState.worker.get_id()) 
+        return;
+
+    const uint64_t target = ++asyncState.flushRequested;
+    asyncState.cv.notify_all();
+    asyncState.cv.wait(lock, [target]() -> bool { return asyncState.flushCompleted >= target; });
+}
+
+void Logger::setRateLimit(unsigned int messagesPerSecond)
+{
+    rateLimit.store(messagesPerSecond, std::memory_order_relaxed);
+}
+
+unsigned int Logger::getRateLimit()
+{
+    return rateLimit.load(std::memory_order_relaxed);
+}
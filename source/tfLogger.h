@@ -26,16 +26,43 @@
 #define _SOURCE_TFLOGGER_H_
 
 #include <tf_port.h>
+#include <atomic>
+#include <cstdint>
 #include <sstream>
 
 
 namespace TissueForge {
 
 
+    /**
+     * Logging state of a call site, for rate limiting. 
+     */
+    struct CAPI_EXPORT LogSite
+    {
+        /** Current one-second window */
+        std::atomic<int64_t> window{-1};
+
+        /** Number of messages in the current window */
+        std::atomic<unsigned int> count{0};
+
+        /** Number of suppressed messages not yet reported */
+        std::atomic<unsigned int> suppressed{0};
+
+        /**
+         * @brief Admit a message from this site under the current rate limit. 
+         * 
+         * Messages at level LOG_ERROR and higher are always admitted. 
+         * 
+         * @param level logging level of the message
+         * @return this site if admitted, otherwise NULL
+         */
+        LogSite *admit(int level);
+    };
+
     class CAPI_EXPORT LoggingBuffer
     {
     public:
-        LoggingBuffer(int level, const char* func, const char* file, int line);
+        LoggingBuffer(int level, const char* func, const char* file, int line, LogSite *site=NULL);
 
         /**
          * dump the contents of the stringstream to the log.
@@ -53,6 +80,7 @@ namespace TissueForge {
         const char* func;
         const char* file;
         int line;
+        unsigned int suppressed;
     };
 
     enum LogLevel
@@ -183,12 +211,54 @@ namespace TissueForge {
 
         static void setCallback(LoggerCallback);
 
+        /**
+         * @brief Enable asynchronous logging. 
+         * 
+         * Messages are queued on the logging thread and written by a background thread. 
+         * Each thread has its own lock-free queue, and messages logged when a queue is full are dropped and counted. 
+         * Messages at level LOG_ERROR and higher are always written immediately, after all queued messages. 
+         * 
+         * @param capacity number of messages held by each thread queue; rounded up to a power of two
+         */
+        static void enableAsync(unsigned int capacity = 4096);
+
+        /**
+         * @brief Disable asynchronous logging, after writing all queued messages. 
+         */
+        static void disableAsync();
+
+        /**
+         * @brief Test whether asynchronous logging is enabled. 
+         */
+        static bool isAsync();
+
+        /**
+         * @brief Write all queued messages. 
+         */
+        static void flush();
+
+        /**
+         * @brief Set the maximum number of messages logged per second from each call site. 
+         * 
+         * The number of suppressed messages is reported with the next admitted message of a site. 
+         * Messages at level LOG_ERROR and higher are never suppressed. 
+         * 
+         * @param messagesPerSecond maximum number of messages; 0 disables rate limiting
+         */
+        static void setRateLimit(unsigned int messagesPerSecond);
+
+        /**
+         * @brief Get the maximum number of messages logged per second from each call site; 0 if unlimited. 
+         */
+        static unsigned int getRateLimit();
+
     };
 
 };
 
 #define TF_Log(level) \
     if (level > TissueForge::Logger::getLevel()) { ; } \
-    else TissueForge::LoggingBuffer(level, TF_FUNCTION, __FILE__, __LINE__).stream()
+    else if (TissueForge::LogSite *_tf_log_site = [](int _tf_log_level) -> TissueForge::LogSite* { static TissueForge::LogSite site; return site.admit(_tf_log_level); }(level); !_tf_log_site) { ; } \
+    else TissueForge::LoggingBuffer(level, TF_FUNCTION, __FILE__, __LINE__, _tf_log_site).stream()
 
 #endif // _SOURCE_TFLOGGER_H_
\ No newline at end of file
@@ -220,6 +220,8 @@ static void parse_kwargs(
         switch (kind) {
             case FORWARD_EULER:
             case RUNGE_KUTTA_4:
+            case VELOCITY_VERLET:
+            case BAOAB:
                 conf.universeConfig.integrator = (EngineIntegrator)kind;
                 break;
             default: {
@@ -636,9 +638,10 @@ HRESULT TissueForge::universe_init(const UniverseConfig &conf ) {
 
     int nr_runners = conf.threads;
 
-    FloatP_t _origin[] = {0.0, 0.0, 0.0};
+    FloatP_t _origin[3];
     FloatP_t _dim[3];
     for(int i = 0; i < 3; ++i) {
+        _origin[i] = conf.origin[i];
         _dim[i] = conf.dim[i];
     }
 
@@ -649,11 +652,22 @@ HRESULT TissueForge::universe_init(const UniverseConfig &conf ) {
             conf.maxTypes , engine_flag_none, conf.nr_fluxsteps ) != S_OK ) 
         return tf_error(E_FAIL, errs_err_msg[MDCERR_engine]);
 
+    if(conf.cellOrder != space_cellorder_rowmajor && space_set_cellorder(&_Engine.s, conf.cellOrder) != S_OK) 
+        return tf_error(E_FAIL, errs_err_msg[MDCERR_space]);
+    _Engine.renumber_period = conf.renumberPeriod;
+    _Engine.pids_compaction = conf.pidCompaction;
+    _Engine.regrid_period = conf.regridPeriod;
+    _Engine.regrid_occupancy = conf.regridOccupancy;
+    _Engine.expand_margin = conf.expandMargin;
+
     _Engine.dt = conf.dt;
     _Engine.dt_flux = conf.dt / conf.nr_fluxsteps;
     _Engine.time = conf.start_step;
     _Engine.temperature = conf.temp;
     _Engine.integrator = conf.integrator;
+    _Engine.langevin_friction = conf.langevinFriction;
+    _Engine.respa_steps = conf.respaSteps;
+    _Engine.flux_integrator = conf.fluxIntegrator;
 
     _Engine.timers_mask = conf.timers_mask;
     _Engine.timer_output_period = conf.timer_output_period;
@@ -674,9 +688,17 @@ HRESULT TissueForge::universe_init(const UniverseConfig &conf ) {
     case EngineIntegrator::RUNGE_KUTTA_4:
         inte = "Ruge-Kutta-4";
         break;
+    case EngineIntegrator::VELOCITY_VERLET:
+        inte = "Velocity Verlet";
+        break;
+    case EngineIntegrator::BAOAB:
+        inte = "BAOAB Langevin";
+        break;
     }
 
     TF_Log(LOG_INFORMATION) << "engine integrator: " << inte;
+    if(_Engine.integrator == EngineIntegrator::VELOCITY_VERLET && _Engine.respa_steps > 1) 
+        TF_Log(LOG_INFORMATION) << "engine integrator inner steps: " << _Engine.respa_steps;
     TF_Log(LOG_INFORMATION) << "engine: n_cells: " << _Engine.s.nr_cells << ", cell width set to " << cutoff;
     TF_Log(LOG_INFORMATION) << "engine: cell dimensions = [" << _Engine.s.cdim[0] << ", " << _Engine.s.cdim[1] << ", " << _Engine.s.cdim[2] << "]";
     TF_Log(LOG_INFORMATION) << "engine: cell size = [" << _Engine.s.h[0]  << ", " <<_Engine.s.h[1] << ", " << _Engine.s.h[2] << "]";
@@ -943,6 +965,7 @@ namespace TissueForge::io {
     HRESULT toFile(const Simulator &dataElement, const MetaData &metaData, IOElement &fileElement) {
 
         TF_IOTOEASY(fileElement, metaData, "dim", FVector3::from(_Engine.s.dim));
+        TF_IOTOEASY(fileElement, metaData, "origin", FVector3::from(_Engine.s.origin));
         TF_IOTOEASY(fileElement, metaData, "cutoff", _Engine.s.cutoff);
         TF_IOTOEASY(fileElement, metaData, "cells", iVector3::from(_Engine.s.cdim));
         TF_IOTOEASY(fileElement, metaData, "integrator", (int)_Engine.integrator);
@@ -989,6 +1012,14 @@ namespace TissueForge::io {
         TF_IOFROMEASY(fileElement, metaData, "dim", &dim);
         dataElement->universeConfig.dim = FVector3(dim);
 
+        IOChildMap fec = IOElement::children(fileElement);
+
+        if(fec.find("origin") != fec.end()) {
+            FVector3 origin(0.);
+            TF_IOFROMEASY(fileElement, metaData, "origin", &origin);
+            dataElement->universeConfig.origin = origin;
+        }
+
         TF_IOFROMEASY(fileElement, metaData, "cutoff", &dataElement->universeConfig.cutoff);
 
         iVector3 cells(0);
@@ -1012,8 +1043,6 @@ namespace TissueForge::io {
         TF_IOFROMEASY(fileElement, metaData, "seed", &seed);
         dataElement->setSeed(seed);
 
-        IOChildMap fec = IOElement::children(fileElement);
-
         if(fec.find("nr_fluxsteps") != fec.end()) {
             unsigned int nr_fluxsteps;
             TF_IOFROMEASY(fileElement, metaData, "nr_fluxsteps", &nr_fluxsteps);
@@ -128,7 +128,9 @@ namespace TissueForge {
         // Of the available integrator types, these are supported by Simulator
         enum class EngineIntegrator : int {
             FORWARD_EULER = TissueForge::EngineIntegrator::FORWARD_EULER,
-            RUNGE_KUTTA_4 = TissueForge::EngineIntegrator::RUNGE_KUTTA_4
+            RUNGE_KUTTA_4 = TissueForge::EngineIntegrator::RUNGE_KUTTA_4,
+            VELOCITY_VERLET = TissueForge::EngineIntegrator::VELOCITY_VERLET,
+            BAOAB = TissueForge::EngineIntegrator::BAOAB
         };
 
         enum Key {
@@ -101,6 +101,9 @@ namespace TissueForge {
         void parallel_for(std::size_t size, std::function<void(std::size_t)>&& func) {
             const auto nWorkers = _workerThreads.size();
             if(nWorkers > 0) {
+                /* Serialize callers from different threads, e.g., subengines working alongside the engine */
+                std::lock_guard<std::mutex> forLock(_forMutex);
+
                 _numBusyThreads = int(nWorkers);
                 
                 const std::size_t chunkSize = std::size_t(Magnum::Math::ceil(float(size)/ float(nWorkers + 1)));
@@ -155,6 +158,7 @@ namespace TissueForge {
         
         std::vector<std::function<void()>> _tasks;
         std::mutex _taskMutex;
+        std::mutex _forMutex;
         std::condition_variable _condition;
         bool _bStop = false;
     };
@@ -94,6 +94,7 @@ struct engine* TissueForge::engine_get()
 
 UniverseConfig::UniverseConfig() :
     dim {10, 10, 10},
+    origin {0, 0, 0},
     spaceGridSize {4, 4, 4},
     cutoff{1},
     flags{0},
@@ -105,10 +106,19 @@ UniverseConfig::UniverseConfig() :
     threads{ThreadPool::hardwareThreadSize()},
     nr_fluxsteps{1},
     integrator{EngineIntegrator::FORWARD_EULER},
+    fluxIntegrator{FLUX_INTEGRATOR_EXPLICIT},
     boundaryConditionsPtr{new BoundaryConditionsArgsContainer()},
     max_distance{-1},
     timers_mask {0},
-    timer_output_period {-1}
+    timer_output_period {-1}, 
+    cellOrder {space_cellorder_rowmajor}, 
+    renumberPeriod {0}, 
+    pidCompaction {0}, 
+    regridPeriod {0}, 
+    regridOccupancy {engine_regrid_occupancy}, 
+    expandMargin {0}, 
+    langevinFriction {1}, 
+    respaSteps {1}
 {
 }
 
@@ -209,6 +219,12 @@ void Universe::resetSpecies() {
     TF_UNIVERSE_FINALLY();
 }
 
+HRESULT Universe::reserve(const unsigned int &nr_parts) {
+    TF_UNIVERSE_TRY();
+    return engine_reserve_parts(&_Engine, nr_parts);
+    TF_UNIVERSE_FINALLY(E_FAIL);
+}
+
 std::vector<std::vector<std::vector<ParticleList> > > Universe::grid(iVector3 shape) {
     TF_UNIVERSE_TRY();
     return metrics::particleGrid(shape);
@@ -292,18 +308,69 @@ FloatP_t Universe::getKineticEnergy() {
     TF_UNIVERSE_FINALLY(0);
 }
 
+FloatP_t Universe::getEnergyDrift() {
+    TF_UNIVERSE_TRY();
+    return engine_energy_drift(&_Engine);
+    TF_UNIVERSE_FINALLY(0);
+}
+
+HRESULT Universe::resetEnergyDrift() {
+    TF_UNIVERSE_TRY();
+    return engine_energy_drift_reset(&_Engine);
+    TF_UNIVERSE_FINALLY(E_FAIL);
+}
+
 int Universe::getNumTypes() {
     TF_UNIVERSE_TRY();
     return _Engine.nr_types;
     TF_UNIVERSE_FINALLY(0);
 }
 
+int Universe::getNumEvents() {
+    TF_UNIVERSE_TRY();
+    return _Universe.events->numEvents();
+    TF_UNIVERSE_FINALLY(0);
+}
+
 FloatP_t Universe::getCutoff() {
     TF_UNIVERSE_TRY();
     return _Engine.s.cutoff;
     TF_UNIVERSE_FINALLY(0);
 }
 
+iVector3 Universe::getGridSize() {
+    TF_UNIVERSE_TRY();
+    return iVector3::from(_Engine.s.cdim);
+    TF_UNIVERSE_FINALLY(iVector3());
+}
+
+HRESULT Universe::regrid() {
+    TF_UNIVERSE_TRY();
+    return engine_regrid_auto(&_Engine, true);
+    TF_UNIVERSE_FINALLY(E_FAIL);
+}
+
+HRESULT Universe::regrid(const iVector3 &cells) {
+    TF_UNIVERSE_TRY();
+    return engine_regrid(&_Engine, cells.data());
+    TF_UNIVERSE_FINALLY(E_FAIL);
+}
+
+HRESULT Universe::expand(const iVector3 &lower, const iVector3 &upper) {
+    TF_UNIVERSE_TRY();
+    return engine_expand(&_Engine, lower.data(), upper.data());
+    TF_UNIVERSE_FINALLY(E_FAIL);
+}
+
+int Universe::minimize(const FloatP_t &ftol, const FloatP_t &etol, const int &maxSteps, const FloatP_t &dtMax) {
+    TF_UNIVERSE_TRY();
+    int result;
+    if(engine_minimize(&_Engine, ftol, etol, maxSteps, dtMax, &result) != S_OK) 
+        return -1;
+    return result;
+    TF_UNIVERSE_FINALLY(-1);
+}
+
 unsigned int Universe::getNumFluxSteps() {
     TF_UNIVERSE_TRY();
     return _Engine.nr_fluxsteps;
@@ -317,6 +384,12 @@ FVector3 Universe::dim()
     TF_UNIVERSE_FINALLY(FVector3());
 }
 
+FVector3 Universe::getOrigin() {
+    TF_UNIVERSE_TRY();
+    return engine_origin();
+    TF_UNIVERSE_FINALLY(FVector3());
+}
+
 FloatP_t Universe::volume() {
     TF_UNIVERSE_TRY();
     return FVector3::from(_Engine.s.dim).product();
@@ -72,6 +72,13 @@ namespace TissueForge {
          */
         static FVector3 dim();
 
+        /**
+         * @brief Gets the origin of the universe
+         * 
+         * @return FVector3 
+         */
+        static FVector3 getOrigin();
+
         /**
          * @brief Gets the volume of the universe
          * 
@@ -149,6 +156,15 @@ namespace TissueForge {
          */
         static void resetSpecies();
 
+        /**
+         * @brief Reserve storage for a total number of particles. 
+         * 
+         * Reserving before creating many particles avoids repeated reallocation. 
+         * 
+         * @param nr_parts total number of particles
+         */
+        static HRESULT reserve(const unsigned int &nr_parts);
+
         /**
          * @brief Gets a three-dimesional array of particle lists, of all the particles in the system. 
          * 
@@ -201,16 +217,77 @@ namespace TissueForge {
          */
         static FloatP_t getKineticEnergy();
 
+        /**
+         * @brief Get the relative drift of total energy since the first step, or since the last reset
+         */
+        static FloatP_t getEnergyDrift();
+
+        /**
+         * @brief Restart tracking of total energy drift at the next step
+         */
+        static HRESULT resetEnergyDrift();
+
         /**
          * @brief Get the current number of registered particle types
          */
         static int getNumTypes();
 
+        /**
+         * @brief Get the current number of registered events
+         */
+        static int getNumEvents();
+
         /**
          * @brief Get the global interaction cutoff distance
          */
         static FloatP_t getCutoff();
 
+        /**
+         * @brief Get the dimensions in cells of the grid of the space
+         */
+        static iVector3 getGridSize();
+
+        /**
+         * @brief Re-size the grid of cells of the space to the current particles. 
+         * 
+         * Cells are sized by the particle density and cutoff. 
+         */
+        static HRESULT regrid();
+
+        /**
+         * @brief Replace the grid of cells of the space. 
+         * 
+         * @param cells dimensions in cells
+         */
+        static HRESULT regrid(const iVector3 &cells);
+
+        /**
+         * @brief Add or remove layers of cells on the faces of the universe. 
+         * 
+         * Cells keep their dimensions, and particles keep their positions. 
+         * Boundary conditions move with the faces of the universe. 
+         * Only non-periodic dimensions can be resized, and only empty layers can be removed. 
+         * 
+         * @param lower number of layers to add to each lower face; negative to remove layers
+         * @param upper number of layers to add to each upper face; negative to remove layers
+         */
+        static HRESULT expand(const iVector3 &lower, const iVector3 &upper);
+
+        /**
+         * @brief Relax the particles to a local minimum of potential energy. 
+         * 
+         * Forces are evaluated as in a time step, including bonded interactions and subengines, 
+         * and particles are moved with the FIRE algorithm until a convergence criterion is met. 
+         * Simulation time does not advance, and particles are at rest afterwards. 
+         * 
+         * @param ftol convergence tolerance on the magnitude of the force on any particle
+         * @param etol convergence tolerance on the relative change in potential energy of an iteration; disabled when zero
+         * @param maxSteps maximum number of iterations
+         * @param dtMax maximum time step of an iteration; ten times the time step when non-positive
+         * @return number of iterations until convergence, or -1 if not converged
+         */
+        static int minimize(const FloatP_t &ftol=1e-3, const FloatP_t &etol=0, const int &maxSteps=10000, const FloatP_t &dtMax=0);
+
         /**
          * @brief Get the number of flux steps per simulation step
         */
@@ -244,6 +321,9 @@ namespace TissueForge {
         /** Dimensions of the universe */
         FVector3 dim;
 
+        /** Origin of the universe */
+        FVector3 origin;
+
         /** Discretization of the universe */
         iVector3 spaceGridSize;
 
@@ -268,6 +348,9 @@ namespace TissueForge {
 
         /** Type of integrator */
         EngineIntegrator integrator;
+
+        /** Type of integrator of flux substeps, one of FluxIntegrator */
+        int fluxIntegrator;
         
         // pointer to boundary conditions ctor data
         // these objects are parsed initializing the engine.
@@ -279,6 +362,30 @@ namespace TissueForge {
         uint32_t timers_mask;
         
         long timer_output_period;
+
+        /** Ordering of the traversal of cells, one of SpaceCellOrder */
+        int cellOrder;
+
+        /** Period, in steps, of renumbering particles by cell. Disabled when not positive */
+        int renumberPeriod;
+
+        /** Fraction of recycled particle ids above which particles are renumbered. Disabled when not positive */
+        FloatP_t pidCompaction;
+
+        /** Period, in steps, of re-sizing the grid of cells to the particle density. Disabled when not positive */
+        int regridPeriod;
+
+        /** Target mean number of particles per cell when re-sizing the grid of cells */
+        FloatP_t regridOccupancy;
+
+        /** Number of empty layers of cells kept between the particles and each non-periodic face of the universe. Disabled when not positive */
+        int expandMargin;
+
+        /** Friction coefficient of the BAOAB integrator */
+        FloatP_t langevinFriction;
+
+        /** Number of inner steps of multiple-time-step velocity-Verlet integration. Disabled when less than two */
+        int respaSteps;
         
         UniverseConfig();
         
@@ -79,7 +79,8 @@ HRESULT universe_bind_potential(Potential *p, BoundaryConditions *bcs, ParticleT
 HRESULT universe_bind_potential(Potential *p, BoundaryCondition *bc, ParticleType *t) {
     TF_Log(LOG_DEBUG) << p->name << ", " << t->name;
     bc->set_potential(t, p);
-    return S_OK;
+    // The condition may be of a boundary of arbitrary geometry, whose cells depend on its potentials
+    return boundary_sdf_flag_cells(&_Engine.s, _Engine.boundary_sdfs);
 }
 
 HRESULT universe_bind_force(Force *force, ParticleType *a_type, const std::string* coupling_symbol) {
@@ -991,7 +991,8 @@ std::vector<std::vector<std::vector<ParticleList> > > metrics::particleGrid(cons
             shape[1], std::vector<ParticleList>(
                 shape[2], ParticleList())));
     
-    FVector3 dim = {_Engine.s.dim[0], _Engine.s.dim[1], _Engine.s.dim[2]};
+    FVector3 origin = engine_origin();
+    FVector3 dim = engine_dimensions();
     
     FVector3 scale = {shape[0] / dim[0], shape[1] / dim[1], shape[2] / dim[2]};
     
@@ -1000,7 +1001,7 @@ std::vector<std::vector<std::vector<ParticleList> > > metrics::particleGrid(cons
         for (int pid = 0 ; pid < cell->count ; pid++ ) {
             Particle *part  = &cell->parts[pid];
             
-            FVector3 pos = part->global_position();
+            FVector3 pos = part->global_position() - origin;
             // relative position of part in universe, scaled from 0-1, then
             // scaled to index in array
             int i = std::floor(pos[0] * scale[0]);
@@ -1018,7 +1019,7 @@ std::vector<std::vector<std::vector<ParticleList> > > metrics::particleGrid(cons
     for (int pid = 0 ; pid < _Engine.s.largeparts.count ; pid++ ) {
         Particle *part  = &_Engine.s.largeparts.parts[pid];
         
-        FVector3 pos = part->global_position();
+        FVector3 pos = part->global_position() - origin;
         // relative position of part in universe, scaled from 0-1, then
         // scaled to index in array
         int i = std::floor(pos[0] * scale[0]);
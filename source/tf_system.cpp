@@ -1400,6 +1400,26 @@ std::string system::performanceCounters() {
     return ss.str();
 }
 
+HRESULT system::startTrace(const unsigned int &capacity) {
+    return trace::start(capacity);
+}
+
+HRESULT system::stopTrace() {
+    return trace::stop();
+}
+
+HRESULT system::clearTrace() {
+    return trace::clear();
+}
+
+bool system::isTracing() {
+    return trace::isActive();
+}
+
+HRESULT system::exportTrace(const std::string &filePath) {
+    return trace::toFile(filePath);
+}
+
 std::unordered_map<std::string, bool> system::cpu_info() {
     return util::getFeaturesMap();
 }
@@ -28,6 +28,7 @@
 #include "TissueForge_private.h"
 #include "tf_util.h"
 #include "tfLogger.h"
+#include <tfTrace.h>
 #include "rendering/tfGlInfo.h"
 #include "rendering/tfEglInfo.h"
 #include "rendering/tfUniverseRenderer.h"
@@ -657,6 +658,48 @@ namespace TissueForge::system {
 
     CPPAPI_FUNC(std::string) performanceCounters();
 
+    /**
+     * @brief Start tracing engine phases, runner tasks, subengines, events and I/O. 
+     * 
+     * Each thread records into its own ring buffer, which retains the most recent events. 
+     * Previously recorded events are discarded. 
+     * 
+     * @param capacity number of events retained per thread
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) startTrace(const unsigned int &capacity=TF_TRACE_CAPACITY_DEFAULT);
+
+    /**
+     * @brief Stop tracing. Recorded events are retained for export. 
+     * 
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) stopTrace();
+
+    /**
+     * @brief Discard all recorded trace events
+     * 
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) clearTrace();
+
+    /**
+     * @brief Test whether tracing is active
+     * 
+     * @return true if tracing
+     */
+    CPPAPI_FUNC(bool) isTracing();
+
+    /**
+     * @brief Export recorded trace events to file in Chrome trace event JSON format. 
+     * 
+     * The file can be viewed with chrome://tracing or the Perfetto UI. 
+     * 
+     * @param filePath path of the file
+     * @return HRESULT 
+     */
+    CPPAPI_FUNC(HRESULT) exportTrace(const std::string &filePath);
+
     /**
      * @brief Get CPU info
      * 
@@ -24,6 +24,7 @@
 
 #include "tf_util.h"
 #include "tfThreadPool.h"
+#include "tfTaskScheduler.h"
 #include "tfLogger.h"
 #include "tfError.h"
 
@@ -490,6 +491,187 @@ static std::vector<FVector3> points_sphere(int n) {
     return result;
 }
 
+/** Counter-based generator, so that sampled points do not depend on the order of sampling */
+static inline uint64_t points_splitmix64(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline FloatP_t points_uniform01(uint64_t &state) {
+    return FloatP_t((points_splitmix64(state) >> 11) * (1.0 / 9007199254740992.0));
+}
+
+/** Number of samples drawn in a cell of the background grid before leaving it empty */
+#define POINTS_POISSON_TRIES 30
+
+/**
+ * @brief Poisson-disk sampling of a region on a background grid. 
+ * 
+ * Grid cells are small enough to hold at most one point, 
+ * and cells that are three cells apart are sampled in parallel, 
+ * since points sampled in them cannot be closer than the minimum distance. 
+ * Dimensions of the region with no extent are not sampled. 
+ * 
+ * @param lower lower corner of the bounding box of the region
+ * @param upper upper corner of the bounding box of the region
+ * @param inside test of whether a point is in the region
+ * @param distance minimum distance between points
+ * @param n number of points, selected at random from the sampled points; all sampled points when negative
+ * @param seed seed of the sampling
+ */
+template<typename Inside> 
+static std::vector<FVector3> points_poisson(
+    const FVector3 &lower, 
+    const FVector3 &upper, 
+    Inside inside, 
+    const FloatP_t &distance, 
+    const int &n, 
+    const uint64_t &seed) 
+{
+    if(distance <= 0) 
+        throw std::range_error("Minimum distance between points must be positive");
+
+    int ndim = 0;
+    bool active[3];
+    for(int k = 0; k < 3; k++) {
+        active[k] = upper[k] > lower[k];
+        if(active[k]) 
+            ndim++;
+    }
+    if(ndim == 0) 
+        return std::vector<FVector3>(n == 0 ? 0 : 1, lower);
+
+    const FloatP_t h = distance / std::sqrt(FloatP_t(ndim));
+    const FloatP_t distance2 = distance * distance;
+    int cdim[3];
+    size_t nr_cells = 1;
+    for(int k = 0; k < 3; k++) {
+        cdim[k] = active[k] ? std::max(1, (int)std::ceil((upper[k] - lower[k]) / h)) : 1;
+        nr_cells *= cdim[k];
+    }
+    if(nr_cells > (size_t)std::numeric_limits<int32_t>::max()) 
+        throw std::range_error("Too many points for the minimum distance between points");
+
+    std::vector<FVector3> cell_points(nr_cells);
+    std::vector<uint8_t> cell_full(nr_cells, 0);
+    auto cell_id = [&cdim](const int &i, const int &j, const int &k) -> size_t {
+        return (size_t)i + (size_t)cdim[0] * ((size_t)j + (size_t)cdim[1] * (size_t)k);
+    };
+
+    // phases of cells that are sampled in parallel, in random order
+    const int nr_phase[3] = {active[0] ? 3 : 1, active[1] ? 3 : 1, active[2] ? 3 : 1};
+    const int reach[3] = {active[0] ? 2 : 0, active[1] ? 2 : 0, active[2] ? 2 : 0};
+    std::vector<std::array<int, 3> > phases;
+    for(int a = 0; a < nr_phase[0]; a++) 
+        for(int b = 0; b < nr_phase[1]; b++) 
+            for(int c = 0; c < nr_phase[2]; c++) 
+                phases.push_back({a, b, c});
+    uint64_t state = seed;
+    for(size_t i = phases.size() - 1; i > 0; i--) 
+        std::swap(phases[i], phases[points_splitmix64(state) % (i + 1)]);
+
+    for(auto &phase : phases) {
+        int pdim[3];
+        for(int k = 0; k < 3; k++) 
+            pdim[k] = (cdim[k] - phase[k] + nr_phase[k] - 1) / nr_phase[k];
+        
+        auto func_sample = [&](int pid) -> void {
+            int loc[3];
+            loc[0] = phase[0] + nr_phase[0] * (pid % pdim[0]);
+            loc[1] = phase[1] + nr_phase[1] * ((pid / pdim[0]) % pdim[1]);
+            loc[2] = phase[2] + nr_phase[2] * (pid / (pdim[0] * pdim[1]));
+            const size_t cid = cell_id(loc[0], loc[1], loc[2]);
+            uint64_t cell_state = seed ^ ((uint64_t)cid * 0xD1B54A32D192ED03ULL);
+
+            for(int t = 0; t < POINTS_POISSON_TRIES; t++) {
+                FVector3 x = lower;
+                for(int k = 0; k < 3; k++) 
+                    if(active[k]) 
+                        x[k] += (loc[k] + points_uniform01(cell_state)) * h;
+                if(!inside(x)) 
+                    continue;
+
+                bool accept = true;
+                for(int i = std::max(0, loc[0] - reach[0]); accept && i <= std::min(cdim[0] - 1, loc[0] + reach[0]); i++) 
+                    for(int j = std::max(0, loc[1] - reach[1]); accept && j <= std::min(cdim[1] - 1, loc[1] + reach[1]); j++) 
+                        for(int k = std::max(0, loc[2] - reach[2]); accept && k <= std::min(cdim[2] - 1, loc[2] + reach[2]); k++) {
+                            size_t nid = cell_id(i, j, k);
+                            if(cell_full[nid] && (cell_points[nid] - x).dot() < distance2) 
+                                accept = false;
+                        }
+                if(accept) {
+                    cell_points[cid] = x;
+                    cell_full[cid] = 1;
+                    return;
+                }
+            }
+        };
+        parallel_for(pdim[0] * pdim[1] * pdim[2], func_sample);
+    }
+
+    std::vector<FVector3> result;
+    for(size_t cid = 0; cid < nr_cells; cid++) 
+        if(cell_full[cid]) 
+            result.push_back(cell_points[cid]);
+
+    if(n >= 0) {
+        if((size_t)n > result.size()) {
+            TF_Log(LOG_WARNING) << "Only " << result.size() << " of " << n << " points fit with minimum distance " << distance;
+        }
+        else {
+            for(size_t i = 0; i < (size_t)n; i++) 
+                std::swap(result[i], result[i + points_splitmix64(state) % (result.size() - i)]);
+            result.resize(n);
+        }
+    }
+
+    return result;
+}
+
+static uint64_t points_seed(const unsigned int *seed) {
+    if(seed) 
+        return *seed;
+    return randomEngine()();
+}
+
+std::vector<FVector3> TissueForge::poissonDiskPoints(
+    const PointsType &kind, 
+    const FloatP_t &distance, 
+    const int &n, 
+    const unsigned int *seed) 
+{
+    try {
+        uint64_t _seed = points_seed(seed);
+
+        switch(kind) {
+        case PointsType::SolidCube: {
+            auto inside = [](const FVector3 &x) -> bool {
+                return std::abs(x[0]) <= 0.5 && std::abs(x[1]) <= 0.5 && std::abs(x[2]) <= 0.5;
+            };
+            return points_poisson(FVector3(-0.5), FVector3(0.5), inside, distance, n, _seed);
+        }
+        case PointsType::SolidSphere: {
+            auto inside = [](const FVector3 &x) -> bool { return x.dot() <= 1.0; };
+            return points_poisson(FVector3(-1.0), FVector3(1.0), inside, distance, n, _seed);
+        }
+        case PointsType::Disk: {
+            auto inside = [](const FVector3 &x) -> bool { return x.dot() <= 1.0; };
+            return points_poisson(FVector3(-1.0, -1.0, 0.0), FVector3(1.0, 1.0, 0.0), inside, distance, n, _seed);
+        }
+        default:
+            tf_exp(std::runtime_error("invalid kind"));
+            return std::vector<FVector3>();
+        }
+    }
+    catch (const std::exception& e) {
+        tf_exp(e);
+    }
+
+    return std::vector<FVector3>();
+}
+
 FVector3 TissueForge::randomPoint(
     const PointsType &kind, 
     const FloatP_t &dr, 
@@ -602,7 +784,33 @@ std::vector<FVector3> TissueForge::filledCubeUniform(
     return result;
 }
 
-std::vector<FVector3> TissueForge::filledCubeRandom(const FVector3 &corner1, const FVector3 &corner2, const int &nParticles) {
+std::vector<FVector3> TissueForge::filledCubeRandom(
+    const FVector3 &corner1, 
+    const FVector3 &corner2, 
+    const int &nParticles, 
+    const FloatP_t &distance) 
+{
+    if(distance > 0) {
+        try {
+            FVector3 lower, upper;
+            for(int k = 0; k < 3; k++) {
+                lower[k] = std::min(corner1[k], corner2[k]);
+                upper[k] = std::max(corner1[k], corner2[k]);
+            }
+            auto inside = [&lower, &upper](const FVector3 &x) -> bool {
+                for(int k = 0; k < 3; k++) 
+                    if(x[k] < lower[k] || x[k] > upper[k]) 
+                        return false;
+                return true;
+            };
+            return points_poisson(lower, upper, inside, distance, nParticles, points_seed(NULL));
+        }
+        catch (const std::exception& e) {
+            tf_exp(e);
+        }
+        return std::vector<FVector3>();
+    }
+
     std::vector<FVector3> result;
 
     std::uniform_real_distribution<FloatP_t> disx(corner1[0], corner2[0]);
@@ -1014,8 +1222,55 @@ FVector3 TissueForge::randomUnitVector() {
     return FVector3{x, y, z};
 }
 
+/** Uniform grid of points, for finding the points near a point without visiting all points */
+struct EnergyPointGrid {
+    FVector3 origin;
+    FloatP_t h;
+    int cdim[3];
+
+    /** Points of each cell are cell_parts[cell_start[cid]:cell_start[cid + 1]] */
+    std::vector<int32_t> cell_start, cell_parts;
+
+    EnergyPointGrid(std::vector<FVector3> const &points, const FloatP_t &_h) : h{_h} {
+        FVector3 upper = points.empty() ? FVector3(0.0) : points[0];
+        origin = upper;
+        for(auto &p : points) 
+            for(int k = 0; k < 3; k++) {
+                origin[k] = std::min(origin[k], p[k]);
+                upper[k] = std::max(upper[k], p[k]);
+            }
+        size_t nr_cells = 1;
+        for(int k = 0; k < 3; k++) {
+            cdim[k] = std::max(1, std::min(1024, (int)std::ceil((upper[k] - origin[k]) / h)));
+            nr_cells *= cdim[k];
+        }
+
+        std::vector<int32_t> pcells(points.size());
+        cell_start.assign(nr_cells + 1, 0);
+        for(size_t i = 0; i < points.size(); i++) {
+            pcells[i] = cellid(points[i]);
+            cell_start[pcells[i] + 1]++;
+        }
+        for(size_t cid = 0; cid < nr_cells; cid++) 
+            cell_start[cid + 1] += cell_start[cid];
+        cell_parts.resize(points.size());
+        std::vector<int32_t> cell_next(cell_start.begin(), cell_start.end() - 1);
+        for(size_t i = 0; i < points.size(); i++) 
+            cell_parts[cell_next[pcells[i]]++] = i;
+    }
+
+    int loc(const FVector3 &x, const int &k) const {
+        return std::max(0, std::min(cdim[k] - 1, (int)std::floor((x[k] - origin[k]) / h)));
+    }
+
+    int32_t cellid(const FVector3 &x) const {
+        return loc(x, 0) + cdim[0] * (loc(x, 1) + cdim[1] * loc(x, 2));
+    }
+};
+
 static void energy_find_neighborhood(
     std::vector<FVector3> const &points,
+    EnergyPointGrid const &grid, 
     const int part,
     FloatP_t r,
     std::vector<int32_t> &nbor_inds,
@@ -1029,17 +1284,29 @@ static void energy_find_neighborhood(
     FloatP_t br2 = 4 * r * r;
     
     FVector3 pt = points[part];
-    for(int i = 0; i < points.size(); ++i) {
-
-        FVector3 dx = pt - points[i];
-        FloatP_t dx2 = dx.dot();
-        if(dx2 <= r2) {
-            nbor_inds.push_back(i);
-        }
-        if(dx2 > r2 && dx2 <= br2) {
-            boundary_inds.push_back(i);
-        }
-    }
+    int lower[3], upper[3];
+    for(int k = 0; k < 3; k++) {
+        lower[k] = grid.loc(pt - FVector3(2 * r), k);
+        upper[k] = grid.loc(pt + FVector3(2 * r), k);
+    }
+
+    for(int ci = lower[0]; ci <= upper[0]; ci++) 
+        for(int cj = lower[1]; cj <= upper[1]; cj++) 
+            for(int ck = lower[2]; ck <= upper[2]; ck++) {
+                int32_t cid = ci + grid.cdim[0] * (cj + grid.cdim[1] * ck);
+                for(int32_t j = grid.cell_start[cid]; j < grid.cell_start[cid + 1]; j++) {
+                    int32_t i = grid.cell_parts[j];
+
+                    FVector3 dx = pt - points[i];
+                    FloatP_t dx2 = dx.dot();
+                    if(dx2 <= r2) {
+                        nbor_inds.push_back(i);
+                    }
+                    if(dx2 > r2 && dx2 <= br2) {
+                        boundary_inds.push_back(i);
+                    }
+                }
+            }
 }
 
 FloatP_t energy_minimize_neighborhood(
@@ -1101,9 +1368,11 @@ void energy_minimize(EnergyMinimizer *p, std::vector<FVector3> &points) {
     int i = 0;
     
     do {
+        // points move little in an iteration, so the grid of the iteration is close enough
+        EnergyPointGrid grid(points, 2 * p->cutoff);
         for(int k = 0; k < points.size(); ++k) {
             int32_t partId = k;
-            energy_find_neighborhood(points, partId, p->cutoff, nindices, bindices);
+            energy_find_neighborhood(points, grid, partId, p->cutoff, nindices, bindices);
             etot[i] = energy_minimize_neighborhood(p, nindices, bindices, points, forces);
         }
         i = (i + 1) % 3;
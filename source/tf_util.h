@@ -136,6 +136,30 @@ namespace TissueForge {
         const FloatP_t &phi1=M_PI
     );
 
+    /**
+     * @brief Get the coordinates of random points in a kind of shape 
+     * that are no closer to each other than a distance. 
+     * 
+     * Points are generated by Poisson-disk sampling on a background grid, 
+     * in parallel and in time proportional to the number of points. 
+     * When a number of points is given, points are selected at random from a filled shape. 
+     * Generated points only depend on the seed, and not on the number of threads. 
+     * 
+     * Currently supports disk, solid cube and solid sphere. 
+     * 
+     * @param kind kind of shape
+     * @param distance minimum distance between points
+     * @param n number of points; fills the shape when negative
+     * @param seed seed of the sampling; drawn from the pseudo-random number generator when NULL
+     * @return std::vector<FVector3> 
+     */
+    CPPAPI_FUNC(std::vector<FVector3>) poissonDiskPoints(
+        const PointsType &kind, 
+        const FloatP_t &distance, 
+        const int &n=-1, 
+        const unsigned int *seed=NULL
+    );
+
     /**
      * @brief Get the coordinates of uniform points in a kind of shape. 
      * 
@@ -168,12 +192,20 @@ namespace TissueForge {
     /**
      * @brief Get the coordinates of a randomly filled cube. 
      * 
+     * When a minimum distance is given, points are generated by Poisson-disk sampling. 
+     * 
      * @param corner1 first corner of cube
      * @param corner2 second corner of cube
      * @param nParticles number of points in the cube
+     * @param distance minimum distance between points; ignored when not positive
      * @return std::vector<FVector3> 
      */
-    CPPAPI_FUNC(std::vector<FVector3>) filledCubeRandom(const FVector3 &corner1, const FVector3 &corner2, const int &nParticles);
+    CPPAPI_FUNC(std::vector<FVector3>) filledCubeRandom(
+        const FVector3 &corner1, 
+        const FVector3 &corner2, 
+        const int &nParticles, 
+        const FloatP_t &distance=0
+    );
 
     /**
      * @brief Get the coordinates of an icosphere. 
@@ -0,0 +1,85 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+from tissue_forge.models.vertex import solver as tfv
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+tfv.init()
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+
+pot = tf.Potential.harmonic(k=1.0, r0=0.5)
+
+beads = [Bead([2.0 + 0.5 * i, 5.0, 5.0]) for i in range(6)]
+bonds = [tf.Bond.create(pot, beads[i], beads[i + 1]) for i in range(5)]
+angles = [tf.Angle.create(pot, beads[i], beads[i + 1], beads[i + 2]) for i in range(4)]
+dihedrals = [tf.Dihedral.create(pot, beads[i], beads[i + 1], beads[i + 2], beads[i + 3]) for i in range(3)]
+
+# destroy an interior bond and particle, and reuse the freed slots
+bonds[2].destroy()
+beads[4].destroy()
+extra = Bead([8.0, 5.0, 5.0])
+tf.Bond.create(pot, beads[0], extra)
+
+# transfer the bonds of a vertex to another vertex, then destroy the source
+v_src = tfv.Vertex.create(tf.FVector3(3.0, 7.0, 5.0))
+v_dst = tfv.Vertex.create(tf.FVector3(3.2, 7.0, 5.0))
+anchor_transfer = Bead([5.0, 7.0, 5.0])
+bond_transfer = tf.Bond.create(pot, v_src.particle(), anchor_transfer)
+v_src.transfer_bonds_to(v_dst)
+src_bonds_transferred = len(v_src.particle().bonds)
+dst_bonds_transferred = len(v_dst.particle().bonds)
+v_src.destroy()
+
+# merge two vertices, which transfers the bonds of the removed vertex
+v_keep = tfv.Vertex.create(tf.FVector3(3.0, 3.0, 5.0))
+v_remove = tfv.Vertex.create(tf.FVector3(3.2, 3.0, 5.0))
+anchor_merge = Bead([5.0, 3.0, 5.0])
+bond_merge = tf.Bond.create(pot, v_remove.particle(), anchor_merge)
+v_keep.merge(v_remove)
+
+
+def test_pass():
+    assert sorted([ph.id for ph in beads[0].bonded_neighbors]) == sorted([beads[1].id, extra.id])
+    assert len(beads[0].bonds) == 2
+    assert len(beads[2].bonds) == 1
+    assert len(beads[3].bonds) == 0
+    assert len(beads[5].bonds) == 0
+    assert len(beads[1].angles) == 2
+    assert len(beads[3].angles) == 1
+    assert len(beads[2].dihedrals) == 1
+    assert len(beads[5].dihedrals) == 0
+    assert len(extra.angles) == 0 and len(extra.dihedrals) == 0
+
+    assert src_bonds_transferred == 0
+    assert dst_bonds_transferred == 1
+    assert bond_transfer.check()
+    assert [b.id for b in v_dst.particle().bonds] == [bond_transfer.id]
+    assert [ph.id for ph in anchor_transfer.bonded_neighbors] == [v_dst.pid]
+    assert bond_merge.check()
+    assert [b.id for b in v_keep.particle().bonds] == [bond_merge.id]
+    assert [ph.id for ph in anchor_merge.bonded_neighbors] == [v_keep.pid]
@@ -0,0 +1,54 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+import numpy as np
+
+tf.init(dim=[10., 10., 10.], cutoff=2.0, windowless=True)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+
+pot = tf.Potential.harmonic(k=1, r0=0.5, max=3)
+
+# a pair separated across the periodic x-boundary, and a pair too far apart to bond
+beads = [Bead([0.2, 5.0, 5.0]), Bead([9.8, 5.0, 5.0]), Bead([5.0, 2.0, 5.0]), Bead([5.0, 8.0, 5.0])]
+
+# randomly placed beads, bonded against a brute-force minimum image count
+rand_beads = [Bead(pos.tolist()) for pos in np.random.uniform(low=0.0, high=10.0, size=(300, 3))]
+rand_pos = np.asarray([ph.position for ph in rand_beads])
+dx = rand_pos[:, None, :] - rand_pos[None, :, :]
+dx -= 10.0 * np.round(dx / 10.0)
+r = np.sqrt(np.sum(dx * dx, axis=2))
+num_expected = int(np.sum(np.triu(r <= 1.0, k=1)))
+
+bonds = tf.bind.bonds(pot, beads, 1)
+rand_bonds = tf.bind.bonds(pot, rand_beads, 1)
+
+
+def test_pass():
+    assert len(bonds) == 1
+    assert sorted([ph.id for ph in bonds[0].parts]) == sorted([beads[0].id, beads[1].id])
+    assert len(rand_bonds) == num_expected
@@ -0,0 +1,89 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+import numpy as np
+
+tf.init(dim=[10., 10., 10.], cutoff=1.0, cells=[10, 10, 10], windowless=True)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+# spherical well of radius 4 at the center of the domain
+spacing = 0.25
+samples = np.arange(41) * spacing
+xx, yy, zz = np.meshgrid(samples, samples, samples, indexing='ij')
+well = tf.BoundarySDF.create([0., 0., 0.], spacing, 4.0 - np.sqrt((xx - 5) ** 2 + (yy - 5) ** 2 + (zz - 5) ** 2))
+well.set_potential(Bead, tf.Potential.harmonic(k=100, r0=0.5, min=0.0, max=0.5))
+
+bead_wall = Bead([8.8, 5.0, 5.0])
+bead_center = Bead([5.0, 5.0, 5.0])
+
+tf.step()
+
+pos_wall = bead_wall.position
+pos_center = bead_center.position
+
+dist_wall = well.distance(tf.FVector3(8.0, 5.0, 5.0))
+normal_wall = well.normal(tf.FVector3(8.0, 5.0, 5.0))
+
+# unit cube obstacle, and the same cube as a container
+cube_vertices = [[x, y, z] for x in [4., 6.] for y in [4., 6.] for z in [4., 6.]]
+cube_triangles = [[0, 1, 3], [0, 3, 2], [4, 6, 7], [4, 7, 5],
+                  [0, 4, 5], [0, 5, 1], [2, 3, 7], [2, 7, 6],
+                  [0, 2, 6], [0, 6, 4], [1, 5, 7], [1, 7, 3]]
+cube = tf.BoundarySDF.from_mesh(cube_vertices, cube_triangles, 0.1, 0.5)
+cube_inverted = tf.BoundarySDF.from_mesh(cube_vertices, cube_triangles, 0.1, 0.5, invert=True)
+
+num_sdfs = len(tf.BoundarySDF.all())
+
+dist_cube_in = cube.distance(tf.FVector3(5.0, 5.0, 5.0))
+dist_cube_out = cube.distance(tf.FVector3(6.3, 5.0, 5.0))
+dist_inverted_in = cube_inverted.distance(tf.FVector3(5.0, 5.0, 5.0))
+
+# distances extend beyond the band, so the wall keeps a direction deep inside
+normal_cube_deep = cube.normal(tf.FVector3(5.3, 5.0, 5.0))
+
+cube.destroy()
+cube_inverted.destroy()
+
+
+def test_pass():
+    # the wall pushes a nearby particle toward the center and leaves distant particles alone
+    assert pos_wall[0] < 8.8
+    assert np.isclose(pos_wall[1], 5.0) and np.isclose(pos_wall[2], 5.0)
+    assert np.allclose([pos_center[i] for i in range(3)], [5.0, 5.0, 5.0])
+
+    assert abs(dist_wall - 1.0) < 1E-2
+    assert normal_wall[0] < -0.99
+
+    assert num_sdfs == 3
+    assert dist_cube_in < 0 < dist_cube_out
+    assert abs(dist_cube_out - 0.3) < 0.05
+    assert abs(dist_cube_in + 1.0) < 0.05
+    assert normal_cube_deep[0] > 0.9
+    assert dist_inverted_in > 0
+    assert len(tf.BoundarySDF.all()) == 1
@@ -0,0 +1,70 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.1)
+
+counts = {'periodic': 0, 'dormant': 0, 'removed': 0, 'finished': 0}
+
+
+def counter(name):
+    def invoke(event):
+        counts[name] += 1
+        return 0
+    return invoke
+
+
+periodic = tf.event.on_time(period=0.2, invoke_method=counter('periodic'))
+dormant = tf.event.on_time(period=1.0, invoke_method=counter('dormant'), start_time=100.0)
+finished = tf.event.on_time(period=0.1, invoke_method=counter('finished'), end_time=0.35)
+
+
+
+# An event removed by another event due in the same step is not evaluated
+def remover(event):
+    removed.remove()
+    event.remove()
+    return 0
+
+
+tf.event.on_time(period=0.3, invoke_method=remover)
+removed = tf.event.on_time(period=0.3, invoke_method=counter('removed'))
+
+num_events_initial = tf.Universe.num_events
+tf.step(1.0)
+num_events_stepped = tf.Universe.num_events
+counts_finished = counts['finished']
+
+# Dormant events and events that can no longer fire are removed on the next step
+dormant.remove()
+finished.remove()
+tf.step(tf.Universe.dt)
+num_events_removed = tf.Universe.num_events
+
+
+def test_pass():
+    assert num_events_initial == 5
+    assert counts['periodic'] > 0
+    assert counts['removed'] == 0
+    assert counts['dormant'] == 0
+    assert 0 < counts_finished == counts['finished']
+    assert num_events_stepped == 3
+    assert num_events_removed == 1
@@ -0,0 +1,70 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+import numpy as np
+
+# keep two to four empty layers of cells around the particles along x and y
+tf.init(dim=[12., 12., 12.], cutoff=1.0, cells=[12, 12, 12], windowless=True, expand_margin=2,
+        bc={'x': 'noslip', 'y': 'noslip', 'z': 'periodic'})
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+beads = [Bead(pos.tolist()) for pos in np.random.uniform(low=5.2, high=6.8, size=(200, 3))]
+pos_before = np.asarray([ph.position for ph in beads])
+
+# adding layers on a lower face moves the origin
+tf.Universe.expand([3, 0, 0], [0, 3, 0])
+origin_explicit = [tf.Universe.origin[i] for i in range(3)]
+dim_explicit = [tf.Universe.dim[i] for i in range(3)]
+pos_after = np.asarray([ph.position for ph in beads])
+
+tf.step(5 * tf.Universe.dt)
+
+origin_auto = np.asarray([tf.Universe.origin[i] for i in range(3)])
+dim_auto = np.asarray([tf.Universe.dim[i] for i in range(3)])
+pos_auto = np.asarray([ph.position for ph in beads])
+num_parts = len(tf.Universe.particles)
+
+# particles created without a position are placed inside the moved domain
+pos_default = np.asarray([Bead().position for _ in range(50)])
+
+
+def test_pass():
+    assert np.allclose(origin_explicit, [-3.0, 0.0, 0.0])
+    assert np.allclose(dim_explicit, [15.0, 15.0, 12.0])
+    assert np.allclose(pos_before, pos_after)
+
+    # the empty space along x and y shrinks, while the periodic z is unchanged
+    assert dim_auto[0] < 12.0 and dim_auto[1] < 12.0
+    assert np.isclose(dim_auto[2], 12.0) and np.isclose(origin_auto[2], 0.0)
+    for k in range(2):
+        assert pos_auto[:, k].min() - origin_auto[k] >= 2.0
+        assert origin_auto[k] + dim_auto[k] - pos_auto[:, k].max() >= 2.0
+    assert num_parts == len(beads)
+
+    assert np.all(pos_default >= origin_auto)
+    assert np.all(pos_default <= origin_auto + dim_auto)
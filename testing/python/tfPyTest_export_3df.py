@@ -0,0 +1,101 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import json
+import os
+import struct
+import tempfile
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+
+
+class AType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+class BType(tf.ParticleTypeSpec):
+    radius = 0.2
+
+
+A = AType.get()
+B = BType.get()
+
+parts_a = [A(position=tf.FVector3(2.0 + i, 5.0, 5.0)) for i in range(5)]
+parts_b = [B(position=tf.FVector3(5.0, 2.0 + i, 5.0)) for i in range(3)]
+positions = {p.id: p.position for p in parts_a + parts_b}
+
+fp_dir = tempfile.mkdtemp()
+
+fp_glb = os.path.join(fp_dir, 'particles.glb')
+tf.io.toFile3DFInstanced(fp_glb)
+with open(fp_glb, 'rb') as f:
+    glb = f.read()
+
+fp_ply = os.path.join(fp_dir, 'particles.ply')
+tf.io.toFile3DFPointCloud(fp_ply, False)
+with open(fp_ply, 'r') as f:
+    ply_lines = f.read().splitlines()
+
+
+def test_pass():
+    # Instances of a shared sphere
+    magic, version, length = struct.unpack('<4sII', glb[:12])
+    assert magic == b'glTF' and version == 2 and length == len(glb)
+    json_len, json_type = struct.unpack('<I4s', glb[12:20])
+    assert json_type == b'JSON'
+    scene = json.loads(glb[20:20 + json_len])
+    bin_len, bin_type = struct.unpack('<I4s', glb[20 + json_len:28 + json_len])
+    assert bin_type == b'BIN\0'
+    assert bin_len == scene['buffers'][0]['byteLength']
+    binary = glb[28 + json_len:]
+    assert len(binary) == bin_len
+
+    assert len(scene['meshes']) == 2
+    assert all(m['primitives'][0]['attributes']['POSITION'] == 0 for m in scene['meshes'])
+
+    translations = {}
+    for node in scene['nodes']:
+        attrs = node['extensions']['EXT_mesh_gpu_instancing']['attributes']
+        acc_t, acc_s = scene['accessors'][attrs['TRANSLATION']], scene['accessors'][attrs['SCALE']]
+        view = scene['bufferViews'][acc_t['bufferView']]
+        radius = A.radius if node['name'] == A.name else B.radius
+        for i in range(acc_t['count']):
+            offset = view['byteOffset'] + i * view['byteStride']
+            t = struct.unpack('<3f', binary[offset:offset + 12])
+            s = struct.unpack('<3f', binary[offset + acc_s['byteOffset']:offset + acc_s['byteOffset'] + 12])
+            assert all(abs(sk - radius) < 1E-6 for sk in s)
+            translations.setdefault(node['name'], []).append(t)
+    assert len(translations[A.name]) == len(parts_a)
+    assert len(translations[B.name]) == len(parts_b)
+
+    # Point cloud
+    assert ply_lines[0] == 'ply'
+    assert 'element vertex 8' in ply_lines
+    header_end = ply_lines.index('end_header')
+    points = [line.split() for line in ply_lines[header_end + 1:]]
+    assert len(points) == len(positions)
+    for pt in points:
+        pid, type_id = int(pt[7]), int(pt[8])
+        pos = positions[pid]
+        assert all(abs(float(pt[k]) - pos[k]) < 1E-4 for k in range(3))
+        assert type_id == (A.id if pid in [p.id for p in parts_a] else B.id)
+        assert abs(float(pt[3]) - (A.radius if type_id == A.id else B.radius)) < 1E-6
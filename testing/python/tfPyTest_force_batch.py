@@ -0,0 +1,77 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import numpy as np
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.01)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    mass = 1.0
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+class OtherType(tf.ParticleTypeSpec):
+    mass = 1.0
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+Other = OtherType.get()
+
+beads = [Bead(position=tf.FVector3(5.0, 2.0 + i, 5.0), velocity=tf.FVector3(0.0)) for i in range(6)]
+other = Other(position=tf.FVector3(2.0, 5.0, 5.0), velocity=tf.FVector3(0.0))
+x0 = {p.id: p.position for p in beads + [other]}
+
+calls = []
+
+
+def push(ids, positions):
+    # Particles with even ids are pushed along +x, and the rest along -x
+    calls.append((set(ids.tolist()), positions.shape))
+    forces = np.zeros_like(positions)
+    forces[:, 0] = np.where(ids % 2 == 0, 1.0, -1.0)
+    return forces
+
+
+force = tf.CustomForceBatch(push)
+tf.bind.force(force, Bead)
+
+tf.step(20 * tf.Universe.dt)
+
+
+def test_pass():
+    assert len(calls) > 0
+    bead_ids = {b.id for b in beads}
+    for ids, shape in calls:
+        assert ids == bead_ids
+        assert shape == (len(beads), 3)
+
+    for b in beads:
+        dx = b.position - x0[b.id]
+        assert (dx[0] > 0) == (b.id % 2 == 0)
+        assert abs(dx[0]) > 1E-3
+        assert abs(dx[1]) < 1E-6 and abs(dx[2]) < 1E-6
+
+    # Particles of types without the force are not moved
+    assert (other.position - x0[other.id]).length() < 1E-6
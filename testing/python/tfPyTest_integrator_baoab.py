@@ -0,0 +1,55 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+
+import tissue_forge as tf
+
+# free particles thermalize at the universe temperature, which is 1 by default
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.01, seed=1,
+        integrator=tf.EngineIntegratorTypes.baoab.value, langevin_friction=2.0)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    mass = 2.0
+
+
+Bead = BeadType.get()
+
+beads = [Bead(velocity=tf.FVector3(0.0)) for _ in range(200)]
+
+
+def kinetic_temperature():
+    return sum(b.mass * b.velocity.length() ** 2 for b in beads) / (3 * len(beads))
+
+
+# equilibrate over several relaxation times of the thermostat, then sample
+tf.step(5.0)
+temperatures = []
+for _ in range(20):
+    tf.step(0.5)
+    temperatures.append(kinetic_temperature())
+
+temperature_mean = sum(temperatures) / len(temperatures)
+
+
+def test_pass():
+    assert abs(temperature_mean - tf.Universe.temperature) < 0.1 * tf.Universe.temperature
@@ -0,0 +1,53 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+
+# evaluate stiff bonds at four inner steps per step
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.01,
+        integrator=tf.EngineIntegratorTypes.velocity_verlet.value, respa_steps=4)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    mass = 1.0
+
+
+Bead = BeadType.get()
+
+pot = tf.Potential.harmonic(k=100.0, r0=1.0, min=0.0, max=5.0, tol=1E-4)
+
+b0 = Bead(position=tf.FVector3(4.4, 5.0, 5.0), velocity=tf.FVector3(0.0))
+b1 = Bead(position=tf.FVector3(5.6, 5.0, 5.0), velocity=tf.FVector3(0.0))
+tf.Bond.create(pot, b0, b1)
+
+tf.step()
+tf.Universe.reset_energy_drift()
+
+drifts = []
+for _ in range(10):
+    tf.step(0.5)
+    drifts.append(tf.Universe.energy_drift)
+
+
+def test_pass():
+    assert all(abs(d) < 0.05 for d in drifts)
+    # the pair oscillates about the rest length
+    assert abs(b0.distance(b1) - 1.0) < 0.3
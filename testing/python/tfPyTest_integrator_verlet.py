@@ -0,0 +1,56 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.01, integrator=tf.EngineIntegratorTypes.velocity_verlet.value)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    mass = 1.0
+
+
+Bead = BeadType.get()
+
+k, r0 = 1.0, 1.0
+pot = tf.Potential.harmonic(k=k, r0=r0, min=0.0, max=5.0, tol=1E-4)
+
+b0 = Bead(position=tf.FVector3(4.25, 5.0, 5.0), velocity=tf.FVector3(0.0))
+b1 = Bead(position=tf.FVector3(5.75, 5.0, 5.0), velocity=tf.FVector3(0.0))
+tf.Bond.create(pot, b0, b1)
+
+
+def total_energy():
+    r = b0.distance(b1)
+    ke = 0.5 * b0.mass * b0.velocity.length() ** 2 + 0.5 * b1.mass * b1.velocity.length() ** 2
+    return ke + k * (r - r0) ** 2
+
+
+e0 = total_energy()
+energies = []
+for _ in range(20):
+    tf.step(0.5)
+    energies.append(total_energy())
+
+
+def test_pass():
+    # velocity-Verlet conserves energy of an oscillating pair without drift
+    assert all(abs(e - e0) < 0.01 * e0 for e in energies)
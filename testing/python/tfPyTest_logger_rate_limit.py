@@ -0,0 +1,53 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+
+import os
+import tempfile
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+
+log_dir = tempfile.mkdtemp()
+log_file = os.path.join(log_dir, 'tfPyTest_logger_rate_limit.log')
+
+num_errors = 10
+
+# errors are logged from one call site, which is rate limited to one message per second
+tf.Logger.setRateLimit(1)
+tf.Logger.enableFileLogging(log_file, tf.Logger.ERROR)
+
+parts = tf.ParticleList()
+for _ in range(num_errors):
+    parts.item(5)
+
+tf.Logger.flush()
+tf.Logger.disableFileLogging()
+tf.Logger.setRateLimit(0)
+tf.err_clear()
+
+with open(log_file, 'r') as f:
+    num_logged = len([line for line in f.readlines() if 'index out of range' in line])
+
+
+def test_pass():
+    assert num_logged == num_errors
@@ -0,0 +1,80 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+import numpy as np
+
+# multiple time stepping caches forces between steps
+tf.init(dim=[10., 10., 10.], cutoff=2.0, cells=[5, 5, 5], windowless=True,
+        integrator=tf.EngineIntegratorTypes.velocity_verlet.value, respa_steps=4)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.25
+    dynamics = tf.Overdamped
+
+
+class LinkType(tf.ParticleTypeSpec):
+    radius = 0.25
+
+
+Bead = BeadType.get()
+Link = LinkType.get()
+
+# overlapping beads repel each other within a unit distance
+tf.bind.types(tf.Potential.harmonic(k=10.0, r0=1.0, min=0.0, max=1.0), Bead, Bead)
+beads = [Bead(pos.tolist()) for pos in np.random.uniform(low=3.5, high=6.5, size=(20, 3))]
+
+# a bonded pair relaxes to the rest length of its bond
+k, r0 = 10.0, 1.0
+l0 = Link([2.0, 2.0, 2.0])
+l1 = Link([3.6, 2.0, 2.0])
+tf.Bond.create(tf.Potential.harmonic(k=k, r0=r0, min=0.0, max=5.0), l0, l1)
+
+ftol = 1E-4
+time_before = tf.Universe.time
+nr_steps = tf.Universe.minimize(ftol=ftol, max_steps=20000)
+time_after = tf.Universe.time
+
+pos = np.asarray([ph.position for ph in beads])
+dist_min = min([np.linalg.norm(pos[i] - pos[j]) for i in range(len(beads)) for j in range(i + 1, len(beads))])
+dist_bond = l0.distance(l1)
+speed_max = max([ph.velocity.length() for ph in beads + [l0, l1]])
+
+# nothing left to relax
+nr_steps_relaxed = tf.Universe.minimize(ftol=ftol)
+
+# forces cached before relaxing do not carry into the next step
+l1.position = l0.position + tf.FVector3(4.5, 0.0, 0.0)
+tf.step()
+tf.Universe.minimize(ftol=ftol, max_steps=20000)
+tf.step()
+speed_stepped_max = max([ph.velocity.length() for ph in [l0, l1]])
+
+
+def test_pass():
+    assert nr_steps > 0
+    assert time_after == time_before
+    assert dist_min > 1.0 - ftol / k * 10
+    assert abs(dist_bond - r0) < ftol / k * 10
+    assert speed_max == 0.0
+    assert nr_steps_relaxed == 0
+    assert speed_stepped_max < 1E-3
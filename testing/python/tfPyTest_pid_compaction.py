@@ -0,0 +1,63 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+
+# compact particle ids once more than a quarter of them are recycled
+tf.init(dim=[10., 10., 10.], windowless=True, pid_compaction=0.25)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+beads = [Bead() for _ in range(100)]
+freed_ids = [b.id for b in beads[:50:2]]
+for b in beads[:50:2]:
+    b.destroy()
+
+# recycled ids are reused before new ids are issued
+reborn = [Bead() for _ in range(5)]
+reborn_ids = [b.id for b in reborn]
+
+# bulk creation uses the remaining recycled ids, then reserves new ids
+batch_ids = list(Bead.factory(nr_parts=30))
+live_ids = [b.id for b in beads[1:50:2]] + [b.id for b in beads[50:]] + reborn_ids
+
+for b in beads[50::2]:
+    b.destroy()
+
+num_parts = len(tf.Universe.particles)
+
+tf.step()
+
+
+def test_pass():
+    assert all(pid in freed_ids for pid in reborn_ids)
+    assert len(set(reborn_ids)) == len(reborn_ids)
+    assert len(set(batch_ids)) == len(batch_ids)
+    assert not set(batch_ids).intersection(live_ids)
+    assert len([pid for pid in batch_ids if pid in freed_ids]) == len(freed_ids) - len(reborn_ids)
+    ids = sorted([ph.id for ph in tf.Universe.particles])
+    assert ids == list(range(num_parts))
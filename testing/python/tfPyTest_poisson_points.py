@@ -0,0 +1,69 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+import numpy as np
+
+tf.init(windowless=True)
+
+
+def as_array(points):
+    return np.asarray([[p[0], p[1], p[2]] for p in points])
+
+
+def min_distance(x):
+    d2 = np.sum((x[:, None, :] - x[None, :, :]) ** 2, axis=2)
+    np.fill_diagonal(d2, np.inf)
+    return np.sqrt(d2.min())
+
+
+dist = 0.15
+ball = as_array(tf.poisson_disk_points(tf.PointsType.SolidSphere.value, dist, seed=1))
+ball_again = as_array(tf.poisson_disk_points(tf.PointsType.SolidSphere.value, dist, seed=1))
+ball_other = as_array(tf.poisson_disk_points(tf.PointsType.SolidSphere.value, dist, seed=2))
+
+disk = as_array(tf.poisson_disk_points(tf.PointsType.Disk.value, 0.1, n=50, seed=1))
+
+box = as_array(tf.filled_cube_random([0., 0., 0.], [2., 2., 2.], 100, 0.2))
+
+sphere = tf.random_points(tf.PointsType.Sphere.value, 200)
+
+
+def test_pass():
+    # the ball is filled, and no points are too close
+    assert len(ball) > 500
+    assert np.all(np.linalg.norm(ball, axis=1) <= 1.0 + 1E-6)
+    assert min_distance(ball) >= dist * (1 - 1E-5)
+
+    # sampling is reproducible
+    assert np.array_equal(ball, ball_again)
+    assert not np.array_equal(ball, ball_other)
+
+    assert disk.shape == (50, 3)
+    assert np.all(disk[:, 2] == 0.0)
+    assert np.all(np.linalg.norm(disk, axis=1) <= 1.0 + 1E-6)
+    assert min_distance(disk) >= 0.1 * (1 - 1E-5)
+
+    assert box.shape == (100, 3)
+    assert np.all(box >= 0.0) and np.all(box <= 2.0)
+    assert min_distance(box) >= 0.2 * (1 - 1E-5)
+
+    assert len(sphere) == 200
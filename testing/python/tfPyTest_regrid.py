@@ -0,0 +1,53 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+import numpy as np
+
+# re-size the grid of cells to the particle density every 10 steps
+tf.init(dim=[20., 20., 20.], cutoff=1.0, cells=[4, 4, 4], windowless=True, regrid_period=10)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+beads = [Bead(pos.tolist()) for pos in np.random.uniform(low=1.0, high=19.0, size=(4000, 3))]
+pos_before = np.asarray([ph.position for ph in beads])
+
+# an explicit grid keeps particles in place
+tf.Universe.regrid([5, 6, 7])
+grid_explicit = [tf.Universe.grid_size[i] for i in range(3)]
+pos_after = np.asarray([ph.position for ph in beads])
+
+tf.step(20 * tf.Universe.dt)
+
+grid_auto = [tf.Universe.grid_size[i] for i in range(3)]
+
+
+def test_pass():
+    assert grid_explicit == [5, 6, 7]
+    assert np.allclose(pos_before, pos_after)
+    assert grid_auto != [5, 6, 7]
+    assert all(20.0 / g >= tf.Universe.cutoff for g in grid_auto)
+    assert len(tf.Universe.particles) == len(beads)
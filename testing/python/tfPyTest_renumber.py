@@ -0,0 +1,57 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import tissue_forge as tf
+import numpy as np
+
+# order cells along a Hilbert curve and renumber particles every 10 steps
+tf.init(dim=[20., 20., 20.], cutoff=2.0, windowless=True, cell_order=2, renumber_period=10)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.2
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+pot_bond = tf.Potential.harmonic(k=0.4, r0=0.2, max=2)
+tf.bind.force(tf.Force.random(mean=0, std=0.1), Bead)
+
+beads = [Bead(pos.tolist()) for pos in np.random.uniform(low=2.0, high=18.0, size=(200, 3))]
+for i in range(0, len(beads) - 1, 2):
+    tf.Bond.create(pot_bond, beads[i], beads[i + 1])
+
+# leave holes in the particle ids
+for b in beads[1::4]:
+    b.destroy()
+
+num_parts = len(tf.Universe.particles)
+num_bonds = len(tf.Universe.bonds)
+
+tf.step(15 * tf.Universe.dt)
+
+
+def test_pass():
+    ids = sorted([ph.id for ph in tf.Universe.particles])
+    assert ids == list(range(num_parts))
+    assert len(tf.Universe.bonds) == num_bonds
+    for bh in tf.Universe.bonds:
+        assert all(ph.id in ids for ph in bh.parts)
@@ -0,0 +1,103 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import os
+import struct
+import tempfile
+
+import numpy as np
+import tissue_forge as tf
+
+# renumber particles every 5 steps
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.01, renumber_period=5)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+    dynamics = tf.Overdamped
+
+
+Bead = BeadType.get()
+
+beads = [Bead(position=pos.tolist(), velocity=[0., 0., 0.]) for pos in np.random.uniform(low=1.0, high=9.0, size=(60, 3))]
+
+# leave holes in the particle ids
+for b in beads[::3]:
+    b.destroy()
+beads = [b for i, b in enumerate(beads) if i % 3 != 0]
+
+# tag each particle by its radius
+for i, b in enumerate(beads):
+    b.radius = 0.1 + 0.001 * i
+
+ids_initial = [b.id for b in beads]
+x_initial = [b.position for b in beads]
+copies = {ph.id: ph for ph in tf.Universe.particles}
+
+
+# forces are only evaluated once, and must follow their particles when renumbered
+def push(ids, positions):
+    forces = np.zeros_like(positions)
+    forces[:, 0] = np.where(ids % 2 == 0, 1.0, -1.0)
+    return forces
+
+
+force = tf.CustomForceBatch(push, period=1E6)
+tf.bind.force(force, Bead)
+
+fp = os.path.join(tempfile.mkdtemp(), 'trajectory.tft')
+tf.io.TrajectoryWriter.start(fp, tf.io.TRAJECTORY_POSITION)
+tf.step(12 * tf.Universe.dt)
+tf.io.TrajectoryWriter.stop()
+
+with open(fp, 'rb') as f:
+    f.seek(-16, os.SEEK_END)
+    index_offset, = struct.unpack('<Q', f.read(8))
+    f.seek(index_offset + 4)
+    num_frames, = struct.unpack('<Q', f.read(8))
+    offsets = struct.unpack(f'<{num_frames}Q', f.read(8 * num_frames))
+    f.seek(offsets[-1] + 12)
+    _, _, _, num_written, _, _ = struct.unpack('<QdIIII', f.read(32))
+    written_ids = struct.unpack(f'<{num_written}i', f.read(4 * num_written))
+    written_pos = struct.unpack(f'<{3 * num_written}f', f.read(12 * num_written))
+
+
+def test_pass():
+    ids = [b.id for b in beads]
+    assert ids != ids_initial
+    assert sorted(ids) == list(range(len(beads)))
+
+    for i, b in enumerate(beads):
+        # handles held across renumbering still refer to their particle
+        assert abs(b.radius - (0.1 + 0.001 * i)) < 1E-6
+
+        # so do copies of handles
+        assert abs(copies[ids_initial[i]].radius - b.radius) < 1E-6
+        assert copies[ids_initial[i]].id == b.id
+
+        # batched forces follow their particle
+        dx = b.position[0] - x_initial[i][0]
+        assert (dx > 0) == (ids_initial[i] % 2 == 0)
+
+    # trajectories keep the ids of particles
+    assert sorted(written_ids) == sorted(ids_initial)
+    for k, wid in enumerate(written_ids):
+        b = beads[ids_initial.index(wid)]
+        assert all(abs(written_pos[3 * k + j] - b.position[j]) < 1E-4 for j in range(3))
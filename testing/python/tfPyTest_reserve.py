@@ -0,0 +1,50 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+
+num_parts = 1000
+tf.Universe.reserve(num_parts)
+
+# create one at a time, then remove every third
+beads = [Bead() for _ in range(num_parts)]
+removed = beads[::3]
+kept = [b for i, b in enumerate(beads) if i % 3 != 0]
+removed_ids = [b.id for b in removed]
+for b in removed:
+    b.destroy()
+
+type_parts = Bead.parts
+
+
+def test_pass():
+    assert len(type_parts) == len(kept)
+    assert all(b.id in type_parts for b in kept)
+    assert not any(pid in type_parts for pid in removed_ids)
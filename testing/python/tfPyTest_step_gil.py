@@ -0,0 +1,69 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import threading
+
+import numpy as np
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True, dt=0.001)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+pot = tf.Potential.harmonic(k=1.0, r0=0.2, min=0.0, max=1.0)
+tf.bind.types(pot, Bead, Bead)
+for pos in np.random.uniform(low=0.0, high=10.0, size=(5000, 3)):
+    Bead(position=tf.FVector3(pos))
+
+# A python thread counts while the engine steps, which is only possible
+# while the engine does not hold the GIL
+counter = [0]
+stop = threading.Event()
+
+
+def count():
+    while not stop.is_set():
+        counter[0] += 1
+
+
+samples = []
+
+
+def sample(event):
+    samples.append(counter[0])
+    return 0
+
+
+tf.event.on_time(period=100 * tf.Universe.dt, invoke_method=sample)
+
+thread = threading.Thread(target=count)
+thread.start()
+tf.step(300 * tf.Universe.dt)
+stop.set()
+thread.join()
+
+
+def test_pass():
+    assert len(samples) >= 2
+    assert samples[-1] - samples[0] > 1000
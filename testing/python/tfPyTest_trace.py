@@ -0,0 +1,64 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+import json
+import os
+import tempfile
+
+import tissue_forge as tf
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+
+pot = tf.Potential.harmonic(k=1.0, r0=1.0, min=0.0, max=5.0)
+beads = [Bead(position=tf.FVector3(4.0 + i, 5.0, 5.0)) for i in range(4)]
+for i in range(3):
+    tf.Bond.create(pot, beads[i], beads[i + 1])
+
+tf.system.start_trace()
+tracing = tf.system.is_tracing()
+for _ in range(5):
+    tf.step()
+tf.system.stop_trace()
+
+fp = os.path.join(tempfile.mkdtemp(), 'trace.json')
+tf.system.export_trace(fp)
+with open(fp, 'r') as f:
+    trace = json.load(f)
+
+
+def test_pass():
+    assert tracing
+    assert not tf.system.is_tracing()
+
+    events = [e for e in trace['traceEvents'] if e['ph'] == 'X']
+    assert len([e for e in events if e['name'] == 'step']) == 5
+    assert all(e['dur'] >= 0 for e in events)
+    categories = {e['cat'] for e in events}
+    assert 'engine' in categories
+    assert 'runner' in categories
+    assert 'bonded' in categories
+    assert any(e['name'] == 'pair' and 'cid_j' in e['args'] for e in events)
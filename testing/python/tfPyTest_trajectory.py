@@ -0,0 +1,132 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+import os
+import struct
+import tempfile
+
+import tissue_forge as tf
+
+# renumber particles every 20 steps, after the first trajectory
+tf.init(dim=[10., 10., 10.], windowless=True, renumber_period=20)
+
+
+class BeadType(tf.ParticleTypeSpec):
+    radius = 0.1
+
+
+Bead = BeadType.get()
+
+pot = tf.Potential.harmonic(k=1.0, r0=1.0, min=0.0, max=5.0)
+beads = [Bead(position=tf.FVector3(4.0 + i, 5.0, 5.0)) for i in range(4)]
+for i in range(3):
+    tf.Bond.create(pot, beads[i], beads[i + 1])
+
+fp = os.path.join(tempfile.mkdtemp(), 'trajectory.tft')
+fields = tf.io.TRAJECTORY_POSITION | tf.io.TRAJECTORY_TYPE | tf.io.TRAJECTORY_BONDS
+tf.io.TrajectoryWriter.start(fp, fields, 2)
+for _ in range(10):
+    tf.step()
+num_captured = tf.io.TrajectoryWriter.num_frames()
+tf.io.TrajectoryWriter.stop()
+final_positions = {b.id: b.position for b in beads}
+
+# destroy and create a particle after renumbering, which recycles the id of the destroyed particle
+
+extras = [Bead(position=tf.FVector3(8.0, 8.0, 8.0)), Bead(position=tf.FVector3(8.0, 2.0, 8.0))]
+extras[0].destroy()
+
+fp_renumbered = os.path.join(os.path.dirname(fp), 'trajectory_renumbered.tft')
+tf.io.TrajectoryWriter.start(fp_renumbered, tf.io.TRAJECTORY_POSITION | tf.io.TRAJECTORY_TYPE, 5)
+for _ in range(10):
+    tf.step()
+extras[1].destroy()
+recycled = Bead(position=tf.FVector3(2.0, 2.0, 2.0))
+for _ in range(5):
+    tf.step()
+tf.io.TrajectoryWriter.stop()
+
+
+def read_frame(f):
+    assert f.read(4) == b'FRME'
+    struct.unpack('<Q', f.read(8))
+    step, time, frame_fields, num_parts, num_species, num_bonds = struct.unpack('<QdIIII', f.read(32))
+    ids = struct.unpack(f'<{num_parts}i', f.read(4 * num_parts))
+    type_ids = struct.unpack(f'<{num_parts}i', f.read(4 * num_parts))
+    positions = struct.unpack(f'<{3 * num_parts}f', f.read(12 * num_parts))
+    bonds = struct.unpack(f'<{2 * num_bonds}i', f.read(8 * num_bonds))
+    return step, ids, type_ids, positions, bonds
+
+
+def read_trajectory(path):
+    with open(path, 'rb') as f:
+        assert f.read(8) == b'TFTRAJ01'
+        version, file_fields = struct.unpack('<II', f.read(8))
+
+        f.seek(-16, os.SEEK_END)
+        index_offset, = struct.unpack('<Q', f.read(8))
+        assert f.read(8) == b'TFTRAJIX'
+        f.seek(index_offset)
+        assert f.read(4) == b'INDX'
+        num_frames, = struct.unpack('<Q', f.read(8))
+        offsets = struct.unpack(f'<{num_frames}Q', f.read(8 * num_frames))
+
+        frames = []
+        for offset in offsets:
+            f.seek(offset)
+            frames.append(read_frame(f))
+    return file_fields, num_frames, frames
+
+
+file_fields, num_frames, frames = read_trajectory(fp)
+_, _, frames_renumbered = read_trajectory(fp_renumbered)
+
+
+def written_id_at(frame, pos):
+    step, ids, type_ids, positions, bonds = frame
+    for i, pid in enumerate(ids):
+        if all(abs(positions[3 * i + k] - pos[k]) < 1E-4 for k in range(3)):
+            return pid
+    return None
+
+
+def test_pass():
+    assert file_fields == fields
+    assert num_captured == num_frames == 5
+    assert [fr[0] for fr in frames] == [2, 4, 6, 8, 10]
+
+    step, ids, type_ids, positions, bonds = frames[-1]
+    assert sorted(ids) == sorted(final_positions.keys())
+    assert all(t == Bead.id for t in type_ids)
+    assert len(bonds) == 6
+    for i, pid in enumerate(ids):
+        pos = final_positions[pid]
+        assert all(abs(positions[3 * i + k] - pos[k]) < 1E-4 for k in range(3))
+
+    # particles keep their written id through renumbering, and a recycled id is written as a new particle
+    assert [fr[0] for fr in frames_renumbered] == [15, 20, 25]
+    ids_before = frames_renumbered[1][1]
+    ids_after = frames_renumbered[2][1]
+    destroyed_id = written_id_at(frames_renumbered[1], [8.0, 2.0, 8.0])
+    recycled_id = written_id_at(frames_renumbered[2], [2.0, 2.0, 2.0])
+    assert destroyed_id is not None and recycled_id is not None
+    assert recycled_id not in ids_before
+    assert sorted(ids_after) == sorted([pid for pid in ids_before if pid != destroyed_id] + [recycled_id])
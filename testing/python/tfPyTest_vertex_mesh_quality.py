@@ -0,0 +1,75 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+
+import tissue_forge as tf
+from tissue_forge.models.vertex import solver as tfv
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+tfv.init()
+
+
+class CellSurfaceType(tfv.SurfaceTypeSpec):
+    pass
+
+
+stype = CellSurfaceType.get()
+
+merge_dist = 0.1
+eps = 0.2 * merge_dist
+
+# a row of three quads, where the three bottom vertices to the right form a chain of edges shorter than the merge distance
+positions = [tf.FVector3(4., 4., 5.), tf.FVector3(5., 4., 5.), tf.FVector3(5. + eps, 4., 5.), tf.FVector3(5. + 2 * eps, 4., 5.),
+             tf.FVector3(4., 5., 5.), tf.FVector3(5., 5., 5.), tf.FVector3(6., 5., 5.), tf.FVector3(7., 5., 5.)]
+quads = tfv.create_surface_mesh(stype, positions, [[0, 1, 5, 4], [1, 2, 6, 5], [2, 3, 7, 6]])
+
+quality: tfv.Quality = tfv.MeshSolver.get_mesh().quality
+quality.vertex_merge_distance = merge_dist
+quality.collision_2d = False
+
+
+def mesh_valid():
+    return all(s.surface.validate() for s in quads if s.surface is not None) and \
+        all(v.vertex.validate() for s in quads if s.surface is not None for v in s.vertices)
+
+
+num_vertices_initial = tfv.MeshSolver.num_vertices()
+
+# merging either edge of the chain conflicts with merging the other, so only one is merged per pass
+result_first = quality.do_quality()
+num_vertices_first = tfv.MeshSolver.num_vertices()
+valid_first = mesh_valid()
+
+result_second = quality.do_quality()
+num_vertices_second = tfv.MeshSolver.num_vertices()
+valid_second = mesh_valid()
+
+result_third = quality.do_quality()
+num_vertices_third = tfv.MeshSolver.num_vertices()
+valid_third = mesh_valid()
+
+
+def test_pass():
+    assert num_vertices_initial == 8
+    assert result_first == 0 and num_vertices_first == 7 and valid_first
+    assert result_second == 0 and num_vertices_second == 6 and valid_second
+    assert result_third == 0 and num_vertices_third == 6 and valid_third
+    assert tfv.MeshSolver.num_surfaces() == 3
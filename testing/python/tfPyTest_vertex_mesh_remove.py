@@ -0,0 +1,134 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+
+import tissue_forge as tf
+from tissue_forge.models.vertex import solver as tfv
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+tfv.init()
+
+
+class CellSurfaceType(tfv.SurfaceTypeSpec):
+    pass
+
+
+class CellBodyType(tfv.BodyTypeSpec):
+    pass
+
+
+stype = CellSurfaceType.get()
+btype = CellBodyType.get()
+
+# outward-oriented faces of a unit cube, by corner index x + 2 * y + 4 * z
+cube_faces = [[0, 2, 3, 1], [4, 5, 7, 6], [0, 1, 5, 4], [1, 3, 7, 5], [3, 2, 6, 7], [2, 0, 4, 6]]
+
+
+def create_cubes(num_cubes, offset):
+    """Create a row of cubes along x, where neighboring cubes share a face"""
+    nx = num_cubes + 1
+    positions = [tf.FVector3(offset[0] + x, offset[1] + y, offset[2] + z)
+                 for z in [0., 1.] for y in [0., 1.] for x in range(nx)]
+    surfaces, surface_indices, bodies = [], {}, []
+    for c in range(num_cubes):
+        body = []
+        for face in cube_faces:
+            verts = [c + (i % 2) + nx * ((i // 2) % 2) + 2 * nx * (i // 4) for i in face]
+            key = frozenset(verts)
+            if key not in surface_indices:
+                surface_indices[key] = len(surfaces)
+                surfaces.append(verts)
+            body.append(surface_indices[key])
+        bodies.append(body)
+    return tfv.create_body_mesh(btype, stype, positions, surfaces, bodies)
+
+
+def create_quads(num_quads, offset):
+    """Create a row of quads along x, where neighboring quads share an edge"""
+    nx = num_quads + 1
+    positions = [tf.FVector3(offset[0] + x, offset[1] + y, offset[2]) for y in [0., 1.] for x in range(nx)]
+    return tfv.create_surface_mesh(stype, positions, [[q, q + 1, nx + q + 1, nx + q] for q in range(num_quads)])
+
+
+def mesh_counts():
+    return (tfv.MeshSolver.num_vertices(), tfv.MeshSolver.num_surfaces(), tfv.MeshSolver.num_bodies(),
+            len(tf.Universe.particles))
+
+
+# remove the outer cubes of a row in one batch, with a duplicate; both neighbor the middle cube
+
+b_left, b_middle, b_right = create_cubes(3, [2., 4.5, 4.5])
+counts_cubes = mesh_counts()
+
+middle_surface_ids = {s.id for s in b_middle.surfaces}
+middle_vertex_ids = {v.id for v in b_middle.vertices}
+freed_body_ids = {b_left.id, b_right.id}
+freed_surface_ids = {s.id for b in [b_left, b_right] for s in b.surfaces} - middle_surface_ids
+freed_vertex_ids = {v.id for b in [b_left, b_right] for v in b.vertices} - middle_vertex_ids
+
+result_bodies = tfv.Body.destroy_c([b_left, b_left, b_right])
+counts_bodies = mesh_counts()
+
+middle_surface_bodies = [[b.id for b in s.bodies] for s in b_middle.surfaces]
+middle_vertex_surfaces = [{s.id for s in v.surfaces} for v in b_middle.vertices]
+middle_valid = b_middle.body.validate()
+
+# removed ids are reused
+
+cube = create_cubes(1, [2., 1., 1.])[0]
+counts_reuse = mesh_counts()
+cube_surface_ids = {s.id for s in cube.surfaces}
+cube_vertex_ids = {v.id for v in cube.vertices}
+
+# remove the outer quads of a row in one batch, with a duplicate; both neighbor the middle quad
+
+q_left, q_middle, q_right = create_quads(3, [2., 1., 6.])
+counts_quads = mesh_counts()
+
+result_surfaces = tfv.Surface.destroy_c([q_left, q_left, q_right])
+counts_surfaces = mesh_counts()
+
+middle_quad_vertex_surfaces = [[s.id for s in v.surfaces] for v in q_middle.vertices]
+middle_quad_valid = q_middle.surface.validate()
+
+
+def test_pass():
+    assert counts_cubes == (16, 16, 3, 16)
+
+    # the surfaces and vertices left without a body or surface go with the removed bodies
+    assert result_bodies == 0
+    assert counts_bodies == (8, 6, 1, 8)
+    assert all(ids == [b_middle.id] for ids in middle_surface_bodies)
+    assert all(len(ids) == 3 and ids <= middle_surface_ids for ids in middle_vertex_surfaces)
+    assert middle_valid
+
+    assert counts_reuse == (16, 12, 2, 16)
+    assert cube.id in freed_body_ids
+    assert cube_surface_ids <= freed_surface_ids
+    assert cube_vertex_ids == freed_vertex_ids
+
+    assert counts_quads == (24, 15, 2, 24)
+
+    # vertices shared with the middle quad remain
+    assert result_surfaces == 0
+    assert counts_surfaces == (20, 13, 2, 20)
+    assert all(ids == [q_middle.id] for ids in middle_quad_vertex_surfaces)
+    assert middle_quad_valid
@@ -0,0 +1,71 @@
+# ******************************************************************************
+# This file is part of Tissue Forge.
+# Copyright (c) 2022-2024 T.J. Sego
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published
+# by the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# 
+# ******************************************************************************
+
+
+
+
+import tissue_forge as tf
+from tissue_forge.models.vertex import solver as tfv
+
+tf.init(dim=[10., 10., 10.], windowless=True)
+tfv.init()
+
+
+class CellSurfaceType(tfv.SurfaceTypeSpec):
+    pass
+
+
+class CellBodyType(tfv.BodyTypeSpec):
+    pass
+
+
+stype = CellSurfaceType.get()
+btype = CellBodyType.get()
+
+positions = [tf.FVector3(4.5 + x, 4.5 + y, 4.5 + z) for z in [0., 1.] for y in [0., 1.] for x in [0., 1.]]
+cube_surfaces = [[0, 2, 3, 1], [4, 5, 7, 6], [0, 1, 5, 4], [1, 3, 7, 5], [3, 2, 6, 7], [2, 0, 4, 6]]
+
+
+def mesh_counts():
+    return (tfv.MeshSolver.num_vertices(), tfv.MeshSolver.num_surfaces(), tfv.MeshSolver.num_bodies(),
+            len(tf.Universe.particles))
+
+
+counts_initial = mesh_counts()
+
+# each failed creation destroys everything that it created
+bad_vertex_index = tfv.create_body_mesh(btype, stype, positions, cube_surfaces[:-1] + [[2, 0, 4, 99]], [list(range(6))])
+counts_bad_vertex_index = mesh_counts()
+
+bad_surface_index = tfv.create_body_mesh(btype, stype, positions, cube_surfaces, [[0, 1, 2, 3, 4, 99]])
+counts_bad_surface_index = mesh_counts()
+
+too_few_surfaces = tfv.create_body_mesh(btype, stype, positions, cube_surfaces, [[0, 1, 2]])
+counts_too_few_surfaces = mesh_counts()
+
+cube = tfv.create_body_mesh(btype, stype, positions, cube_surfaces, [list(range(6))])
+counts_cube = mesh_counts()
+
+
+def test_pass():
+    assert counts_initial == (0, 0, 0, 0)
+    assert len(bad_vertex_index) == 0 and counts_bad_vertex_index == counts_initial
+    assert len(bad_surface_index) == 0 and counts_bad_surface_index == counts_initial
+    assert len(too_few_surfaces) == 0 and counts_too_few_surfaces == counts_initial
+    assert len(cube) == 1 and counts_cube == (8, 6, 1, 8)
@@ -155,6 +155,16 @@ HRESULT tfVertexSolverPositionChanged() {
     return MeshSolver::positionChanged();
 }
 
+HRESULT tfVertexSolverGetPositionTolerance(tfFloatP_t *tol) {
+    TFC_PTRCHECK(tol);
+    *tol = MeshSolver::getPositionTolerance();
+    return S_OK;
+}
+
+HRESULT tfVertexSolverSetPositionTolerance(tfFloatP_t tol) {
+    return MeshSolver::setPositionTolerance(tol);
+}
+
 HRESULT tfVertexSolverUpdate(bool force) {
     return MeshSolver::update(force);
 }
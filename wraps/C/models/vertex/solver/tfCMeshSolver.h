@@ -128,6 +128,20 @@ HRESULT tfVertexSolverNumSurfaceTypes(int *numTypes);
  */
 HRESULT tfVertexSolverPositionChanged();
 
+/**
+ * @brief Get the distance a vertex must move before its surfaces and bodies are updated during simulation
+ * 
+ * @param tol position tolerance
+ */
+HRESULT tfVertexSolverGetPositionTolerance(tfFloatP_t *tol);
+
+/**
+ * @brief Set the distance a vertex must move before its surfaces and bodies are updated during simulation
+ * 
+ * @param tol position tolerance; must be non-negative
+ */
+HRESULT tfVertexSolverSetPositionTolerance(tfFloatP_t tol);
+
 /**
  * @brief Update the solver if dirty
  * 
@@ -216,3 +216,89 @@ HRESULT tfVertexSolverCreateHex3DMesh(
         return E_FAIL;
     return tfVertexSolverCreate_returnBodyArrayRegular(_result, result);
 }
+
+static std::vector<std::vector<unsigned int> > tfVertexSolverCreate_unflattenIndices(
+    unsigned int *indices, 
+    unsigned int *numIndices, 
+    unsigned int num
+) {
+    std::vector<std::vector<unsigned int> > result(num);
+    unsigned int offset = 0;
+    for(unsigned int i = 0; i < num; i++) {
+        result[i] = std::vector<unsigned int>(&indices[offset], &indices[offset + numIndices[i]]);
+        offset += numIndices[i];
+    }
+    return result;
+}
+
+static std::vector<FVector3> tfVertexSolverCreate_unflattenPositions(tfFloatP_t *positions, unsigned int numVertices) {
+    std::vector<FVector3> result(numVertices);
+    for(unsigned int i = 0; i < numVertices; i++) 
+        result[i] = FVector3::from(&positions[3 * i]);
+    return result;
+}
+
+HRESULT tfVertexSolverCreateSurfaceMesh(
+    struct tfVertexSolverSurfaceTypeHandle *stype, 
+    tfFloatP_t *positions, 
+    unsigned int numVertices, 
+    unsigned int *surfaceVertices, 
+    unsigned int *numSurfaceVertices, 
+    unsigned int numSurfaces, 
+    struct tfVertexSolverSurfaceHandleHandle **result
+) {
+    TFC_MESHCREATE_GETSURFACETYPE(stype, _stype);
+    TFC_PTRCHECK(positions);
+    TFC_PTRCHECK(surfaceVertices);
+    TFC_PTRCHECK(numSurfaceVertices);
+    TFC_PTRCHECK(result);
+    std::vector<SurfaceHandle> _result = createMesh(
+        _stype, 
+        tfVertexSolverCreate_unflattenPositions(positions, numVertices), 
+        tfVertexSolverCreate_unflattenIndices(surfaceVertices, numSurfaceVertices, numSurfaces)
+    );
+    if(_result.size() == 0) 
+        return E_FAIL;
+    *result = (tfVertexSolverSurfaceHandleHandle*)malloc(sizeof(tfVertexSolverSurfaceHandleHandle) * _result.size());
+    for(size_t i = 0; i < _result.size(); i++) 
+        if(tfVertexSolverSurfaceHandle_init(&(*result)[i], _result[i].id) != S_OK) 
+            return E_FAIL;
+    return S_OK;
+}
+
+HRESULT tfVertexSolverCreateBodyMesh(
+    struct tfVertexSolverBodyTypeHandle *btype, 
+    struct tfVertexSolverSurfaceTypeHandle *stype, 
+    tfFloatP_t *positions, 
+    unsigned int numVertices, 
+    unsigned int *surfaceVertices, 
+    unsigned int *numSurfaceVertices, 
+    unsigned int numSurfaces, 
+    unsigned int *bodySurfaces, 
+    unsigned int *numBodySurfaces, 
+    unsigned int numBodies, 
+    struct tfVertexSolverBodyHandleHandle **result
+) {
+    TFC_MESHCREATE_GETBODYTYPE(btype, _btype);
+    TFC_MESHCREATE_GETSURFACETYPE(stype, _stype);
+    TFC_PTRCHECK(positions);
+    TFC_PTRCHECK(surfaceVertices);
+    TFC_PTRCHECK(numSurfaceVertices);
+    TFC_PTRCHECK(bodySurfaces);
+    TFC_PTRCHECK(numBodySurfaces);
+    TFC_PTRCHECK(result);
+    std::vector<BodyHandle> _result = createMesh(
+        _btype, 
+        _stype, 
+        tfVertexSolverCreate_unflattenPositions(positions, numVertices), 
+        tfVertexSolverCreate_unflattenIndices(surfaceVertices, numSurfaceVertices, numSurfaces), 
+        tfVertexSolverCreate_unflattenIndices(bodySurfaces, numBodySurfaces, numBodies)
+    );
+    if(_result.size() == 0) 
+        return E_FAIL;
+    *result = (tfVertexSolverBodyHandleHandle*)malloc(sizeof(tfVertexSolverBodyHandleHandle) * _result.size());
+    for(size_t i = 0; i < _result.size(); i++) 
+        if(tfVertexSolverBodyHandle_init(&(*result)[i], _result[i].id) != S_OK) 
+            return E_FAIL;
+    return S_OK;
+}
@@ -155,4 +155,58 @@ CAPI_FUNC(HRESULT) tfVertexSolverCreateHex3DMesh(
     struct tfVertexSolverBodyHandleHandle **result
 );
 
+/**
+ * @brief Populate the mesh with surfaces from vertex positions and indices. 
+ * 
+ * Requires an initialized solver. 
+ * 
+ * @param stype surface type
+ * @param positions vertex positions, flattened
+ * @param numVertices number of vertices
+ * @param surfaceVertices indices of the vertices of all surfaces, in order and concatenated
+ * @param numSurfaceVertices number of vertices of each surface
+ * @param numSurfaces number of surfaces
+ * @param result constructed surfaces
+ */
+CAPI_FUNC(HRESULT) tfVertexSolverCreateSurfaceMesh(
+    struct tfVertexSolverSurfaceTypeHandle *stype, 
+    tfFloatP_t *positions, 
+    unsigned int numVertices, 
+    unsigned int *surfaceVertices, 
+    unsigned int *numSurfaceVertices, 
+    unsigned int numSurfaces, 
+    struct tfVertexSolverSurfaceHandleHandle **result
+);
+
+/**
+ * @brief Populate the mesh with bodies from vertex positions and indices. 
+ * 
+ * Requires an initialized solver. 
+ * 
+ * @param btype body type
+ * @param stype surface type
+ * @param positions vertex positions, flattened
+ * @param numVertices number of vertices
+ * @param surfaceVertices indices of the vertices of all surfaces, in order and concatenated
+ * @param numSurfaceVertices number of vertices of each surface
+ * @param numSurfaces number of surfaces
+ * @param bodySurfaces indices of the surfaces of all bodies, concatenated
+ * @param numBodySurfaces number of surfaces of each body
+ * @param numBodies number of bodies
+ * @param result constructed bodies
+ */
+CAPI_FUNC(HRESULT) tfVertexSolverCreateBodyMesh(
+    struct tfVertexSolverBodyTypeHandle *btype, 
+    struct tfVertexSolverSurfaceTypeHandle *stype, 
+    tfFloatP_t *positions, 
+    unsigned int numVertices, 
+    unsigned int *surfaceVertices, 
+    unsigned int *numSurfaceVertices, 
+    unsigned int numSurfaces, 
+    unsigned int *bodySurfaces, 
+    unsigned int *numBodySurfaces, 
+    unsigned int numBodies, 
+    struct tfVertexSolverBodyHandleHandle **result
+);
+
 #endif // _WRAPS_C_VERTEX_SOLVER_TFC_MESH_CREATE_H_
\ No newline at end of file
@@ -43,6 +43,10 @@ namespace TissueForge {
         return castC<BoundaryConditionsArgsContainer, tfBoundaryConditionsArgsContainerHandle>(handle);
     }
 
+    BoundarySDF *castC(struct tfBoundarySDFHandle *handle) {
+        return castC<BoundarySDF, tfBoundarySDFHandle>(handle);
+    }
+
 }
 
 #define TFC_BOUNDARYCONDITIONHANDLE_GET(handle, varname) \
@@ -57,6 +61,10 @@ namespace TissueForge {
     BoundaryConditionsArgsContainer *varname = TissueForge::castC<BoundaryConditionsArgsContainer, tfBoundaryConditionsArgsContainerHandle>(handle); \
     TFC_PTRCHECK(varname);
 
+#define TFC_BOUNDARYSDFHANDLE_GET(handle, varname) \
+    BoundarySDF *varname = TissueForge::castC<BoundarySDF, tfBoundarySDFHandle>(handle); \
+    TFC_PTRCHECK(varname);
+
 
 ////////////////////////////////
 // BoundaryConditionSpaceKind //
@@ -219,6 +227,91 @@ HRESULT tfBoundaryConditions_boundedPosition(tfFloatP_t* position) {
 }
 
 
+/////////////////
+// BoundarySDF //
+/////////////////
+
+
+HRESULT tfBoundarySDF_create(
+    struct tfBoundarySDFHandle *handle, 
+    tfFloatP_t *origin, 
+    tfFloatP_t spacing, 
+    int *shape, 
+    tfFloatP_t *values, 
+    const char *name) 
+{
+    TFC_PTRCHECK(handle);
+    TFC_PTRCHECK(origin);
+    TFC_PTRCHECK(shape);
+    TFC_PTRCHECK(values);
+    TFC_PTRCHECK(name);
+    if(shape[0] < 1 || shape[1] < 1 || shape[2] < 1) 
+        return E_FAIL;
+    std::vector<FPTYPE> _values(values, values + shape[0] * shape[1] * shape[2]);
+    BoundarySDF *sdf = BoundarySDF::create(FVector3::from(origin), spacing, iVector3::from(shape), _values, name);
+    TFC_PTRCHECK(sdf);
+    handle->tfObj = (void*)sdf;
+    return S_OK;
+}
+
+HRESULT tfBoundarySDF_fromMesh(
+    struct tfBoundarySDFHandle *handle, 
+    tfFloatP_t *vertices, 
+    unsigned int numVertices, 
+    int *triangles, 
+    unsigned int numTriangles, 
+    tfFloatP_t spacing, 
+    tfFloatP_t band, 
+    bool invert, 
+    const char *name) 
+{
+    TFC_PTRCHECK(handle);
+    TFC_PTRCHECK(vertices);
+    TFC_PTRCHECK(triangles);
+    TFC_PTRCHECK(name);
+    std::vector<FVector3> _vertices;
+    _vertices.reserve(numVertices);
+    for(unsigned int i = 0; i < numVertices; i++) 
+        _vertices.push_back(FVector3::from(&vertices[3 * i]));
+    std::vector<iVector3> _triangles;
+    _triangles.reserve(numTriangles);
+    for(unsigned int i = 0; i < numTriangles; i++) 
+        _triangles.push_back(iVector3::from(&triangles[3 * i]));
+    BoundarySDF *sdf = BoundarySDF::fromMesh(_vertices, _triangles, spacing, band, invert, name);
+    TFC_PTRCHECK(sdf);
+    handle->tfObj = (void*)sdf;
+    return S_OK;
+}
+
+HRESULT tfBoundarySDF_destroy(struct tfBoundarySDFHandle *handle) {
+    TFC_BOUNDARYSDFHANDLE_GET(handle, sdf);
+    handle->tfObj = NULL;
+    return sdf->destroy();
+}
+
+HRESULT tfBoundarySDF_getCondition(struct tfBoundarySDFHandle *handle, struct tfBoundaryConditionHandle *bchandle) {
+    TFC_BOUNDARYSDFHANDLE_GET(handle, sdf);
+    TFC_PTRCHECK(bchandle);
+    bchandle->tfObj = (void*)&sdf->condition;
+    return S_OK;
+}
+
+HRESULT tfBoundarySDF_setPotential(struct tfBoundarySDFHandle *handle, struct tfParticleTypeHandle *partHandle, struct tfPotentialHandle *potHandle) {
+    TFC_BOUNDARYSDFHANDLE_GET(handle, sdf);
+    TFC_PTRCHECK(partHandle); TFC_PTRCHECK(partHandle->tfObj);
+    TFC_PTRCHECK(potHandle); TFC_PTRCHECK(potHandle->tfObj);
+    return sdf->set_potential((ParticleType*)partHandle->tfObj, (Potential*)potHandle->tfObj);
+}
+
+HRESULT tfBoundarySDF_getDistance(struct tfBoundarySDFHandle *handle, tfFloatP_t *position, tfFloatP_t *distance) {
+    TFC_BOUNDARYSDFHANDLE_GET(handle, sdf);
+    TFC_PTRCHECK(position);
+    TFC_PTRCHECK(distance);
+    *distance = sdf->distance(FVector3::from(position));
+    return S_OK;
+}
+
+
 /////////////////////////////////////
 // BoundaryConditionsArgsContainer //
 /////////////////////////////////////
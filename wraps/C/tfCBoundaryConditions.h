@@ -81,6 +81,14 @@ struct CAPI_EXPORT tfBoundaryConditionsArgsContainerHandle {
     void *tfObj;
 };
 
+/**
+ * @brief Handle to a @ref BoundarySDF instance
+ * 
+ */
+struct CAPI_EXPORT tfBoundarySDFHandle {
+    void *tfObj;
+};
+
 
 ////////////////////////////////
 // BoundaryConditionSpaceKind //
@@ -276,6 +284,99 @@ CAPI_FUNC(HRESULT) tfBoundaryConditions_setPotential(struct tfBoundaryConditions
 CAPI_FUNC(HRESULT) tfBoundaryConditions_boundedPosition(tfFloatP_t* position);
 
 
+/////////////////
+// BoundarySDF //
+/////////////////
+
+
+/**
+ * @brief Create a boundary from samples of a signed distance field. 
+ * 
+ * The signed distance is positive in the simulation domain and negative in the wall. 
+ * 
+ * @param handle handle to populate
+ * @param origin position of the first sample
+ * @param spacing distance between samples
+ * @param shape number of samples along each direction
+ * @param values signed distance at each sample, with the first index varying fastest
+ * @param name name of the boundary
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_create(
+    struct tfBoundarySDFHandle *handle, 
+    tfFloatP_t *origin, 
+    tfFloatP_t spacing, 
+    int *shape, 
+    tfFloatP_t *values, 
+    const char *name
+);
+
+/**
+ * @brief Create a boundary from a closed triangle mesh. 
+ * 
+ * The wall is the interior of the mesh, or its exterior when inverted. 
+ * 
+ * @param handle handle to populate
+ * @param vertices mesh vertex positions, as consecutive coordinates
+ * @param numVertices number of mesh vertices
+ * @param triangles vertex indices of each mesh triangle, as consecutive triplets
+ * @param numTriangles number of mesh triangles
+ * @param spacing distance between samples
+ * @param band width of the band of exact distances; larger than the sample spacing
+ * @param invert flag to make the exterior of the mesh the wall
+ * @param name name of the boundary
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_fromMesh(
+    struct tfBoundarySDFHandle *handle, 
+    tfFloatP_t *vertices, 
+    unsigned int numVertices, 
+    int *triangles, 
+    unsigned int numTriangles, 
+    tfFloatP_t spacing, 
+    tfFloatP_t band, 
+    bool invert, 
+    const char *name
+);
+
+/**
+ * @brief Remove a boundary from the simulation and destroy it
+ * 
+ * @param handle populated handle
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_destroy(struct tfBoundarySDFHandle *handle);
+
+/**
+ * @brief Get the condition of a boundary, which holds its potentials and radius
+ * 
+ * @param handle populated handle
+ * @param bchandle handle to populate
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_getCondition(struct tfBoundarySDFHandle *handle, struct tfBoundaryConditionHandle *bchandle);
+
+/**
+ * @brief Set the potential of a boundary for a particle type
+ * 
+ * @param handle populated handle
+ * @param partHandle particle type
+ * @param potHandle boundary potential
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_setPotential(struct tfBoundarySDFHandle *handle, struct tfParticleTypeHandle *partHandle, struct tfPotentialHandle *potHandle);
+
+/**
+ * @brief Get the signed distance of a boundary at a position
+ * 
+ * @param handle populated handle
+ * @param position position
+ * @param distance signed distance
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfBoundarySDF_getDistance(struct tfBoundarySDFHandle *handle, tfFloatP_t *position, tfFloatP_t *distance);
+
+
 /////////////////////////////////////
 // BoundaryConditionsArgsContainer //
 /////////////////////////////////////
@@ -95,3 +95,35 @@ HRESULT tfLogger_log(unsigned int level, const char *msg) {
     Logger::log((LogLevel)level, msg);
     return S_OK;
 }
+
+HRESULT tfLogger_enableAsync(unsigned int capacity) {
+    Logger::enableAsync(capacity);
+    return S_OK;
+}
+
+HRESULT tfLogger_disableAsync() {
+    Logger::disableAsync();
+    return S_OK;
+}
+
+HRESULT tfLogger_isAsync(bool *isAsync) {
+    TFC_PTRCHECK(isAsync);
+    *isAsync = Logger::isAsync();
+    return S_OK;
+}
+
+HRESULT tfLogger_flush() {
+    Logger::flush();
+    return S_OK;
+}
+
+HRESULT tfLogger_setRateLimit(unsigned int messagesPerSecond) {
+    Logger::setRateLimit(messagesPerSecond);
+    return S_OK;
+}
+
+HRESULT tfLogger_getRateLimit(unsigned int *messagesPerSecond) {
+    TFC_PTRCHECK(messagesPerSecond);
+    *messagesPerSecond = Logger::getRateLimit();
+    return S_OK;
+}
@@ -131,4 +131,53 @@ CAPI_FUNC(HRESULT) tfLogger_getFileName(char **str, unsigned int *numChars);
  */
 CAPI_FUNC(HRESULT) tfLogger_log(unsigned int level, const char *msg);
 
+/**
+ * @brief Enable asynchronous logging. 
+ * 
+ * Messages are queued on the logging thread and written by a background thread. 
+ * Messages at level LOG_ERROR and higher are always written immediately. 
+ * 
+ * @param capacity number of messages held by each thread queue
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_enableAsync(unsigned int capacity);
+
+/**
+ * @brief Disable asynchronous logging, after writing all queued messages. 
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_disableAsync();
+
+/**
+ * @brief Test whether asynchronous logging is enabled. 
+ * 
+ * @param isAsync flag signaling whether asynchronous logging is enabled
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_isAsync(bool *isAsync);
+
+/**
+ * @brief Write all queued messages. 
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_flush();
+
+/**
+ * @brief Set the maximum number of messages logged per second from each call site. 
+ * 
+ * @param messagesPerSecond maximum number of messages; 0 disables rate limiting
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_setRateLimit(unsigned int messagesPerSecond);
+
+/**
+ * @brief Get the maximum number of messages logged per second from each call site; 0 if unlimited. 
+ * 
+ * @param messagesPerSecond maximum number of messages
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfLogger_getRateLimit(unsigned int *messagesPerSecond);
+
 #endif // _WRAPS_C_TFCLOGGER_H_
\ No newline at end of file
@@ -57,6 +57,8 @@ HRESULT tfSimulatorEngineIntegrator_init(struct tfSimulatorEngineIntegratorHandl
     TFC_PTRCHECK(handle);
     handle->FORWARD_EULER = (int)Simulator::EngineIntegrator::FORWARD_EULER;
     handle->RUNGE_KUTTA_4 = (int)Simulator::EngineIntegrator::RUNGE_KUTTA_4;
+    handle->VELOCITY_VERLET = (int)Simulator::EngineIntegrator::VELOCITY_VERLET;
+    handle->BAOAB = (int)Simulator::EngineIntegrator::BAOAB;
     return S_OK;
 }
 
@@ -34,6 +34,8 @@
 struct CAPI_EXPORT tfSimulatorEngineIntegratorHandle {
     int FORWARD_EULER;
     int RUNGE_KUTTA_4;
+    int VELOCITY_VERLET;
+    int BAOAB;
 };
 
 /**
@@ -174,6 +174,47 @@ HRESULT tfUniverse_resetSpecies() {
     return S_OK;
 }
 
+HRESULT tfUniverse_reserve(unsigned int nr_parts) {
+    TFC_UNIVERSE_STATIC_GET()
+    return univ->reserve(nr_parts);
+}
+
+HRESULT tfUniverse_getGridSize(int **cells) {
+    TFC_UNIVERSE_STATIC_GET()
+    TFC_PTRCHECK(cells);
+    auto c = univ->getGridSize();
+    TFC_VECTOR3_COPYFROM(c, (*cells));
+    return S_OK;
+}
+
+HRESULT tfUniverse_regrid(int *cells) {
+    TFC_UNIVERSE_STATIC_GET()
+    if(!cells) 
+        return univ->regrid();
+    return univ->regrid(iVector3::from(cells));
+}
+
+HRESULT tfUniverse_getOrigin(tfFloatP_t **origin) {
+    TFC_UNIVERSE_STATIC_GET()
+    TFC_PTRCHECK(origin);
+    auto o = univ->getOrigin();
+    TFC_VECTOR3_COPYFROM(o, (*origin));
+    return S_OK;
+}
+
+HRESULT tfUniverse_expand(int *lower, int *upper) {
+    TFC_UNIVERSE_STATIC_GET()
+    TFC_PTRCHECK(lower);
+    TFC_PTRCHECK(upper);
+    return univ->expand(iVector3::from(lower), iVector3::from(upper));
+}
+
+HRESULT tfUniverse_minimize(tfFloatP_t ftol, tfFloatP_t etol, int maxSteps, tfFloatP_t dtMax, int *nr_steps) {
+    TFC_UNIVERSE_STATIC_GET()
+    TFC_PTRCHECK(nr_steps);
+    return engine_minimize(&_Engine, ftol, etol, maxSteps, dtMax, nr_steps);
+}
+
 HRESULT tfUniverse_getTemperature(tfFloatP_t *temperature) {
     TFC_UNIVERSE_STATIC_GET()
     TFC_PTRCHECK(temperature);
@@ -211,6 +252,18 @@ HRESULT tfUniverse_getKineticEnergy(tfFloatP_t *ke) {
     return S_OK;
 }
 
+HRESULT tfUniverse_getEnergyDrift(tfFloatP_t *drift) {
+    TFC_UNIVERSE_STATIC_GET()
+    TFC_PTRCHECK(drift);
+    *drift = univ->getEnergyDrift();
+    return S_OK;
+}
+
+HRESULT tfUniverse_resetEnergyDrift() {
+    TFC_UNIVERSE_STATIC_GET()
+    return univ->resetEnergyDrift();
+}
+
 HRESULT tfUniverse_getNumTypes(int *numTypes) {
     TFC_UNIVERSE_STATIC_GET()
     TFC_PTRCHECK(numTypes);
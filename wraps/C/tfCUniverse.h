@@ -183,6 +183,65 @@ CAPI_FUNC(HRESULT) tfUniverse_reset();
  */
 CAPI_FUNC(HRESULT) tfUniverse_resetSpecies();
 
+/**
+ * @brief Reserve storage for a total number of particles
+ * 
+ * @param nr_parts total number of particles
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_reserve(unsigned int nr_parts);
+
+/**
+ * @brief Get the dimensions in cells of the grid of the space
+ * 
+ * @param cells dimensions in cells
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_getGridSize(int **cells);
+
+/**
+ * @brief Re-size the grid of cells of the space. 
+ * 
+ * When no dimensions are given, cells are sized by the particle density and cutoff. 
+ * 
+ * @param cells dimensions in cells, or NULL
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_regrid(int *cells);
+
+/**
+ * @brief Get the origin of the universe
+ * 
+ * @param origin 3-element allocated array
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_getOrigin(tfFloatP_t **origin);
+
+/**
+ * @brief Add or remove layers of cells on the faces of the universe. 
+ * 
+ * Only non-periodic dimensions can be resized, and only empty layers can be removed. 
+ * 
+ * @param lower number of layers to add to each lower face; negative to remove layers
+ * @param upper number of layers to add to each upper face; negative to remove layers
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_expand(int *lower, int *upper);
+
+/**
+ * @brief Relax the particles to a local minimum of potential energy with the FIRE algorithm. 
+ * 
+ * Simulation time does not advance, and particles are at rest afterwards. 
+ * 
+ * @param ftol convergence tolerance on the magnitude of the force on any particle
+ * @param etol convergence tolerance on the relative change in potential energy of an iteration; disabled when zero
+ * @param maxSteps maximum number of iterations
+ * @param dtMax maximum time step of an iteration; ten times the time step when non-positive
+ * @param nr_steps number of iterations until convergence, or -1 if not converged
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_minimize(tfFloatP_t ftol, tfFloatP_t etol, int maxSteps, tfFloatP_t dtMax, int *nr_steps);
+
 /**
  * @brief Get the universe temperature. 
  * 
@@ -229,6 +288,21 @@ CAPI_FUNC(HRESULT) tfUniverse_getBoundaryConditions(struct tfBoundaryConditionsH
  */
 CAPI_FUNC(HRESULT) tfUniverse_getKineticEnergy(tfFloatP_t *ke);
 
+/**
+ * @brief Get the relative drift of total energy since the first step, or since the last reset
+ * 
+ * @param drift 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_getEnergyDrift(tfFloatP_t *drift);
+
+/**
+ * @brief Restart tracking of total energy drift at the next step
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfUniverse_resetEnergyDrift();
+
 /**
  * @brief Get the current number of registered particle types
  * 
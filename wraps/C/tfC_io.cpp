@@ -25,6 +25,7 @@
 #include <io/tfIO.h>
 #include <io/tfFIO.h>
 #include <io/tfThreeDFStructure.h>
+#include <io/tfTrajectory.h>
 
 
 using namespace TissueForge;
@@ -1383,6 +1384,16 @@ HRESULT tfIo_toFile3DF(const char *format, const char *filePath, unsigned int pR
     return io::toFile3DF(format, filePath, pRefinements);
 }
 
+HRESULT tfIo_toFile3DFInstanced(const char *filePath, unsigned int pRefinements) {
+    TFC_PTRCHECK(filePath);
+    return io::toFile3DFInstanced(filePath, pRefinements);
+}
+
+HRESULT tfIo_toFile3DFPointCloud(const char *filePath, bool binary) {
+    TFC_PTRCHECK(filePath);
+    return io::toFile3DFPointCloud(filePath, binary);
+}
+
 HRESULT tfIo_toFile(const char *saveFilePath) {
     TFC_PTRCHECK(saveFilePath);
     return io::toFile(saveFilePath);
@@ -1391,3 +1402,42 @@ HRESULT tfIo_toFile(const char *saveFilePath) {
 HRESULT tfIo_toString(char **str, unsigned int *numChars) {
     return TissueForge::capi::str2Char(io::toString(), str, numChars);
 }
+
+HRESULT tfIoTrajectoryField_init(struct tfIoTrajectoryFieldHandle *handle) {
+    TFC_PTRCHECK(handle);
+    handle->POSITION = io::TRAJECTORY_POSITION;
+    handle->VELOCITY = io::TRAJECTORY_VELOCITY;
+    handle->TYPE = io::TRAJECTORY_TYPE;
+    handle->SPECIES = io::TRAJECTORY_SPECIES;
+    handle->BONDS = io::TRAJECTORY_BONDS;
+    return S_OK;
+}
+
+HRESULT tfIo_trajectoryStart(const char *filePath, unsigned int fields, unsigned int stride, unsigned int numBuffers) {
+    TFC_PTRCHECK(filePath);
+    return io::TrajectoryWriter::start(filePath, fields, stride, numBuffers);
+}
+
+HRESULT tfIo_trajectoryStop() {
+    return io::TrajectoryWriter::stop();
+}
+
+HRESULT tfIo_trajectoryFlush() {
+    return io::TrajectoryWriter::flush();
+}
+
+HRESULT tfIo_trajectoryCapture() {
+    return io::TrajectoryWriter::capture();
+}
+
+HRESULT tfIo_trajectoryIsWriting(bool *isWriting) {
+    TFC_PTRCHECK(isWriting);
+    *isWriting = io::TrajectoryWriter::isWriting();
+    return S_OK;
+}
+
+HRESULT tfIo_trajectoryNumFrames(unsigned int *numFrames) {
+    TFC_PTRCHECK(numFrames);
+    *numFrames = io::TrajectoryWriter::numFrames();
+    return S_OK;
+}
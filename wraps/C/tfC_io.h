@@ -38,6 +38,14 @@ struct CAPI_EXPORT tfIoMetaDataHandle {
     unsigned int versionPatch;
 };
 
+struct CAPI_EXPORT tfIoTrajectoryFieldHandle {
+    unsigned int POSITION;
+    unsigned int VELOCITY;
+    unsigned int TYPE;
+    unsigned int SPECIES;
+    unsigned int BONDS;
+};
+
 struct CAPI_EXPORT tfIoFIOStorageKeysHandle {
     char *KEY_TYPE;
     char *KEY_VALUE;
@@ -1649,6 +1657,24 @@ CAPI_FUNC(HRESULT) tfIo_fromFile3DF(const char *filePath, struct tfIoThreeDFStru
  */
 CAPI_FUNC(HRESULT) tfIo_toFile3DF(const char *format, const char *filePath, unsigned int pRefinements);
 
+/**
+ * @brief Export particles to a binary glTF file as instances of one shared sphere mesh
+ * 
+ * @param filePath path of file
+ * @param pRefinements refinements of the shared sphere mesh
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfIo_toFile3DFInstanced(const char *filePath, unsigned int pRefinements);
+
+/**
+ * @brief Export particles to a PLY file as a point cloud with per-point radius and color
+ * 
+ * @param filePath path of file
+ * @param binary flag to write binary data; otherwise writes ASCII data
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfIo_toFile3DFPointCloud(const char *filePath, bool binary);
+
 /**
  * @brief Save a simulation to file
  * 
@@ -1666,4 +1692,60 @@ CAPI_FUNC(HRESULT) tfIo_toFile(const char *saveFilePath);
  */
 CAPI_FUNC(HRESULT) tfIo_toString(char **str, unsigned int *numChars);
 
+/**
+ * @brief Populate trajectory field flags
+ * 
+ * @param handle handle to populate
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIoTrajectoryField_init(struct tfIoTrajectoryFieldHandle *handle);
+
+/**
+ * @brief Start writing a trajectory
+ * 
+ * @param filePath path of file; an existing file is overwritten
+ * @param fields written per-particle data; a combination of flags of ::tfIoTrajectoryFieldHandle
+ * @param stride number of steps between frames
+ * @param numBuffers number of pooled snapshot buffers; at least two
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryStart(const char *filePath, unsigned int fields, unsigned int stride, unsigned int numBuffers);
+
+/**
+ * @brief Write all pending trajectory frames, write the index and close the file
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryStop();
+
+/**
+ * @brief Wait until all pending trajectory frames are written
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryFlush();
+
+/**
+ * @brief Capture a trajectory frame of the current state now, regardless of the stride
+ * 
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryCapture();
+
+/**
+ * @brief Test whether a trajectory is being written
+ * 
+ * @param isWriting flag signifying whether a trajectory is being written
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryIsWriting(bool *isWriting);
+
+/**
+ * @brief Get the number of frames captured since the trajectory started
+ * 
+ * @param numFrames number of frames
+ * @return S_OK on success
+ */
+CAPI_FUNC(HRESULT) tfIo_trajectoryNumFrames(unsigned int *numFrames);
+
 #endif // _WRAPS_C_TFC_IO_H_
\ No newline at end of file
@@ -484,6 +484,29 @@ HRESULT tfSystem_viewReshape(int sizex, int sizey) {
     return system::viewReshape({sizex, sizey});
 }
 
+HRESULT tfSystem_startTrace(unsigned int capacity) {
+    return system::startTrace(capacity);
+}
+
+HRESULT tfSystem_stopTrace() {
+    return system::stopTrace();
+}
+
+HRESULT tfSystem_clearTrace() {
+    return system::clearTrace();
+}
+
+HRESULT tfSystem_isTracing(bool *tracing) {
+    TFC_PTRCHECK(tracing);
+    *tracing = system::isTracing();
+    return S_OK;
+}
+
+HRESULT tfSystem_exportTrace(const char *filePath) {
+    TFC_PTRCHECK(filePath);
+    return system::exportTrace(filePath);
+}
+
 HRESULT tfSystem_getCPUInfo(char ***names, bool **flags, unsigned int *numNames) {
     TFC_PTRCHECK(names);
     TFC_PTRCHECK(flags);
@@ -647,6 +647,47 @@ CAPI_FUNC(HRESULT) tfSystem_setDiscretizationColor(float *color);
  */
 CAPI_FUNC(HRESULT) tfSystem_viewReshape(int sizex, int sizey);
 
+/**
+ * @brief Start tracing engine phases, runner tasks, subengines, events and I/O. 
+ * 
+ * Each thread records into its own ring buffer, which retains the most recent events. 
+ * Previously recorded events are discarded. 
+ * 
+ * @param capacity number of events retained per thread
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfSystem_startTrace(unsigned int capacity);
+
+/**
+ * @brief Stop tracing. Recorded events are retained for export. 
+ * 
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfSystem_stopTrace();
+
+/**
+ * @brief Discard all recorded trace events
+ * 
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfSystem_clearTrace();
+
+/**
+ * @brief Test whether tracing is active
+ * 
+ * @param tracing flag signaling whether tracing is active
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfSystem_isTracing(bool *tracing);
+
+/**
+ * @brief Export recorded trace events to file in Chrome trace event JSON format
+ * 
+ * @param filePath path of the file
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfSystem_exportTrace(const char *filePath);
+
 /**
  * @brief Get CPU info
  * 
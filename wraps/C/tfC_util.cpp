@@ -110,6 +110,13 @@ HRESULT tfRandomPoints(unsigned int kind, int n, tfFloatP_t dr, tfFloatP_t phi0,
     return pv.size() > 0 ? TissueForge::capi::copyVecVecs3_2Arr(pv, x) : S_OK;
 }
 
+HRESULT tfPoissonDiskPoints(unsigned int kind, tfFloatP_t distance, int n, unsigned int *seed, tfFloatP_t **x, unsigned int *numPoints) {
+    TFC_PTRCHECK(numPoints);
+    auto pv = poissonDiskPoints((PointsType)kind, distance, n, seed);
+    *numPoints = pv.size();
+    return pv.size() > 0 ? TissueForge::capi::copyVecVecs3_2Arr(pv, x) : S_OK;
+}
+
 HRESULT tfPoints(unsigned int kind, int n, tfFloatP_t **x) {
     auto pv = points((PointsType)kind, n);
     return pv.size() > 0 ? TissueForge::capi::copyVecVecs3_2Arr(pv, x) : S_OK;
@@ -136,6 +143,15 @@ HRESULT tfFilledCubeRandom(tfFloatP_t *corner1, tfFloatP_t *corner2, int nPartic
     return pv.size() > 0 ? TissueForge::capi::copyVecVecs3_2Arr(pv, x) : S_OK;
 }
 
+HRESULT tfFilledCubeRandomPoisson(tfFloatP_t *corner1, tfFloatP_t *corner2, int nParticles, tfFloatP_t distance, tfFloatP_t **x, unsigned int *numPoints) {
+    TFC_PTRCHECK(corner1);
+    TFC_PTRCHECK(corner2);
+    TFC_PTRCHECK(numPoints);
+    auto pv = filledCubeRandom(FVector3::from(corner1), FVector3::from(corner2), nParticles, distance);
+    *numPoints = pv.size();
+    return pv.size() > 0 ? TissueForge::capi::copyVecVecs3_2Arr(pv, x) : S_OK;
+}
+
 HRESULT tfIcosphere(
     unsigned int subdivisions, 
     tfFloatP_t phi0, 
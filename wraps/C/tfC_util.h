@@ -130,6 +130,25 @@ CAPI_FUNC(HRESULT) tfRandomPoint(unsigned int kind, tfFloatP_t dr, tfFloatP_t ph
  */
 CAPI_FUNC(HRESULT) tfRandomPoints(unsigned int kind, int n, tfFloatP_t dr, tfFloatP_t phi0, tfFloatP_t phi1, tfFloatP_t **x);
 
+/**
+ * @brief Get the coordinates of random points in a kind of shape 
+ * that are no closer to each other than a distance. 
+ * 
+ * Points are generated by Poisson-disk sampling on a background grid. 
+ * When a number of points is given, points are selected at random from a filled shape. 
+ * 
+ * Currently supports disk, solid cube and solid sphere. 
+ * 
+ * @param kind kind of shape
+ * @param distance minimum distance between points
+ * @param n number of points; fills the shape when negative
+ * @param seed seed of the sampling; drawn from the pseudo-random number generator when NULL
+ * @param x coordinates of random points
+ * @param numPoints number of points
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfPoissonDiskPoints(unsigned int kind, tfFloatP_t distance, int n, unsigned int *seed, tfFloatP_t **x, unsigned int *numPoints);
+
 /**
  * @brief Get the coordinates of uniform points in a kind of shape. 
  * 
@@ -173,6 +192,19 @@ CAPI_FUNC(HRESULT) tfFilledCubeUniform(
  */
 CAPI_FUNC(HRESULT) tfFilledCubeRandom(tfFloatP_t *corner1, tfFloatP_t *corner2, int nParticles, tfFloatP_t **x);
 
+/**
+ * @brief Get the coordinates of a randomly filled cube with a minimum distance between points. 
+ * 
+ * @param corner1 first corner of cube
+ * @param corner2 second corner of cube
+ * @param nParticles number of points in the cube
+ * @param distance minimum distance between points
+ * @param x coordinates of points
+ * @param numPoints number of points
+ * @return S_OK on success 
+ */
+CAPI_FUNC(HRESULT) tfFilledCubeRandomPoisson(tfFloatP_t *corner1, tfFloatP_t *corner2, int nParticles, tfFloatP_t distance, tfFloatP_t **x, unsigned int *numPoints);
+
 /**
  * @brief Get the coordinates of an icosphere. 
  * 
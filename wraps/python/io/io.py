@@ -24,11 +24,15 @@ from tissue_forge.tissue_forge import _io_ThreeDFMeshData
 from tissue_forge.tissue_forge import _io_ThreeDFStructure
 from tissue_forge.tissue_forge import _io_fromFile3DF as fromFile3DF
 from tissue_forge.tissue_forge import _io_toFile3DF as toFile3DF
+from tissue_forge.tissue_forge import _io_toFile3DFInstanced as toFile3DFInstanced
+from tissue_forge.tissue_forge import _io_toFile3DFPointCloud as toFile3DFPointCloud
 from tissue_forge.tissue_forge import _io_toFile as toFile
 from tissue_forge.tissue_forge import _io_toString as toString
 from tissue_forge.tissue_forge import _io_mapImportParticleId as mapImportParticleId
 from tissue_forge.tissue_forge import _io_mapImportParticleTypeId as mapImportParticleTypeId
 from tissue_forge.tissue_forge import _io_ThreeDFRenderData
+from tissue_forge.tissue_forge import _io_TrajectoryWriter
+from tissue_forge.tissue_forge import TRAJECTORY_POSITION, TRAJECTORY_VELOCITY, TRAJECTORY_TYPE, TRAJECTORY_SPECIES, TRAJECTORY_BONDS
 
 class ThreeDFVertexData(_io_ThreeDFVertexData):
     pass
@@ -48,3 +52,5 @@ class ThreeDFStructure(_io_ThreeDFStructure):
 class ThreeDFRenderData(_io_ThreeDFRenderData):
     pass
 
+class TrajectoryWriter(_io_TrajectoryWriter):
+    pass
@@ -27,6 +27,7 @@
 #include <io/tfIO.h>
 #include <io/tfFIO.h>
 #include <io/tf_io.h>
+#include <io/tfTrajectory.h>
 
 %}
 
@@ -51,11 +52,18 @@
 %rename(_io_ThreeDFStructure) ThreeDFStructure;
 %rename(_io_fromFile3DF) TissueForge::io::fromFile3DF;
 %rename(_io_toFile3DF) TissueForge::io::toFile3DF;
+%rename(_io_toFile3DFInstanced) TissueForge::io::toFile3DFInstanced;
+%rename(_io_toFile3DFPointCloud) TissueForge::io::toFile3DFPointCloud;
 %rename(_io_toFile) TissueForge::io::toFile;
 %rename(_io_toString) TissueForge::io::toString;
 %rename(_io_mapImportParticleId) TissueForge::io::mapImportParticleId;
 %rename(_io_mapImportParticleTypeId) TissueForge::io::mapImportParticleTypeId;
 %rename(_io_ThreeDFRenderData) TissueForge::io::ThreeDFRenderData;
+%rename(_io_TrajectoryWriter) TissueForge::io::TrajectoryWriter;
+%rename(is_writing) TissueForge::io::TrajectoryWriter::isWriting;
+%rename(num_frames) TissueForge::io::TrajectoryWriter::numFrames;
+%ignore TissueForge::io::TrajectoryWriter::postStepJoin;
+%ignore TissueForge::io::TrajectoryWriter::finalize;
 
 %include <io/tfThreeDFRenderData.h>
 %include "tfThreeDFVertexData.i"
@@ -65,3 +73,4 @@
 %include "tfThreeDFStructure.i"
 %include <io/tfIO.h>
 %include <io/tfFIO.h>
+%include <io/tfTrajectory.h>
@@ -28,10 +28,18 @@
 %rename(bounded_position) TissueForge::BoundaryConditions::boundedPosition;
 
 %ignore apply_boundary_particle_crossing;
+%ignore boundary_sdf_flag_cells;
+%ignore TissueForge::BoundarySDF::interpolate;
+%ignore TissueForge::BoundarySDF::values;
+%rename(_from_mesh) TissueForge::BoundarySDF::fromMesh;
+%rename(_create) TissueForge::BoundarySDF::create;
+%rename(_all) TissueForge::BoundarySDF::all;
 
 %include <tfBoundaryConditions.h>
 %include <langs/py/tfBoundaryConditionsPy.h>
 
+%template(vectorBoundarySDF) std::vector<TissueForge::BoundarySDF*>;
+
 %extend TissueForge::BoundaryCondition {
     %pythoncode %{
         def __str__(self) -> str:
@@ -57,6 +65,63 @@
     %}
 }
 
+%extend TissueForge::BoundarySDF {
+    %pythoncode %{
+        @property
+        def name(self) -> str:
+            """
+            Name of the boundary
+            """
+            return self.condition.name
+
+        @staticmethod
+        def create(origin, spacing: float, values, name: str = "sdf"):
+            """
+            Create a boundary from samples of a signed distance field. 
+
+            The signed distance is positive in the simulation domain and negative in the wall. 
+
+            :param origin: position of the first sample
+            :param spacing: distance between samples
+            :param values: three-dimensional array of signed distances, indexed by x, y and z
+            :param name: name of the boundary
+            :return: new boundary
+            """
+            import numpy as np
+            arr = np.asarray(values, dtype=float)
+            if arr.ndim != 3:
+                raise ValueError('Signed distances must be a three-dimensional array')
+            return BoundarySDF._create(FVector3(origin), spacing, iVector3(list(arr.shape)), arr.flatten(order='F').tolist(), name)
+
+        @staticmethod
+        def from_mesh(vertices, triangles, spacing: float, band: float, invert: bool = False, name: str = "sdf"):
+            """
+            Create a boundary from a closed triangle mesh. 
+
+            The wall is the interior of the mesh, or its exterior when inverted. 
+            Distances are computed exactly within a band about the mesh surface, 
+            and are propagated between neighboring samples beyond it. 
+            The band should be no smaller than the range of the potentials of the boundary. 
+
+            :param vertices: mesh vertex positions
+            :param triangles: vertex indices of each mesh triangle
+            :param spacing: distance between samples
+            :param band: width of the band of exact distances; larger than the sample spacing
+            :param invert: flag to make the exterior of the mesh the wall
+            :param name: name of the boundary
+            :return: new boundary
+            """
+            return BoundarySDF._from_mesh([FVector3(v) for v in vertices], [iVector3(t) for t in triangles], spacing, band, invert, name)
+
+        @staticmethod
+        def all() -> list:
+            """
+            Get all boundaries of arbitrary geometry of the simulation
+            """
+            return list(BoundarySDF._all())
+    %}
+}
+
 %pythoncode %{
     from enum import Enum as EnumPy
 
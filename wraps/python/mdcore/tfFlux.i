@@ -25,6 +25,8 @@
 
 
 %ignore Fluxes_integrate;
+%ignore Fluxes_stencil_build;
+%ignore Fluxes_stencil_step;
 %ignore TissueForge::Fluxes::fluxes;
 
 %include "tfFlux.h"
@@ -27,6 +27,8 @@
 
 %rename(_CustomForce) TissueForge::CustomForce;
 %rename(CustomForce) TissueForge::py::CustomForcePy;
+%rename(_CustomForceBatch) TissueForge::py::CustomForceBatchPy;
+%ignore TissueForge::py::CustomForceBatchPy::forces;
 
 %include "tfForce.h"
 %include <langs/py/tfForcePy.h>
@@ -91,3 +93,42 @@
             self.setPeriod(period)
     %}
 }
+
+%extend TissueForge::py::CustomForceBatchPy {
+    %pythoncode %{
+        @property
+        def period(self):
+            """Period of the force"""
+            return self.getPeriod()
+
+        @period.setter
+        def period(self, period):
+            self.setPeriod(period)
+    %}
+}
+
+%pythoncode %{
+    class CustomForceBatch(_CustomForceBatch):
+        """
+        A custom force with a value per particle, evaluated in batches by a Python function. 
+
+        The function is called once per update with a NumPy array of the ids of all particles 
+        of the types to which the force is bound, and a NumPy array of their positions with shape (N, 3). 
+        It returns the forces on the particles as an array-like with shape (N, 3). 
+        Forces are updated at the end of a step and applied during subsequent steps. 
+        """
+
+        def __init__(self, func, period: float = 0.0):
+            """
+            :param func: function that takes particle ids and positions and returns particle forces
+            :param period: period at which the force is updated; updates every step by default
+            """
+            import numpy as np
+
+            def _func(ids, positions):
+                pos = np.asarray(positions)
+                result = func(np.array(ids), np.array(pos))
+                return np.ascontiguousarray(result, dtype=pos.dtype).reshape(-1, 3)
+
+            super().__init__(_func, period)
+%}
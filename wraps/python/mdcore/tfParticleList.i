@@ -31,6 +31,8 @@
 %template(vector2ParticleList_p) std::vector<std::vector<TissueForge::ParticleList*>>;
 %template(vector3ParticleList_p) std::vector<std::vector<std::vector<TissueForge::ParticleList*>>>;
 
+%ignore TissueForge::ParticleList::slots;
+
 %include "tfParticleList.h"
 
 %extend TissueForge::ParticleList {
@@ -51,6 +51,8 @@ from tissue_forge.tissue_forge import _vertex_solver__createQuadMesh as create_q
 from tissue_forge.tissue_forge import _vertex_solver__createPLPDMesh as create_plpd_mesh
 from tissue_forge.tissue_forge import _vertex_solver__createHex2DMesh as create_hex2d_mesh
 from tissue_forge.tissue_forge import _vertex_solver__createHex3DMesh as create_hex3d_mesh
+from tissue_forge.tissue_forge import _vertex_solver__createSurfaceMesh as create_surface_mesh
+from tissue_forge.tissue_forge import _vertex_solver__createBodyMesh as create_body_mesh
 
 __all__ = ['bind']
 
@@ -45,6 +45,7 @@ vertex_solver_MeshObj_prep_py(TissueForge::models::vertex::Body)
 
 %rename(_destroy_o) TissueForge::models::vertex::Body::destroy(Body*);
 %rename(_destroy_h) TissueForge::models::vertex::Body::destroy(BodyHandle&);
+%rename(_destroy_v) TissueForge::models::vertex::Body::destroy(const std::vector<Body*>&);
 
 ////////////////
 // BodyHandle //
@@ -161,13 +162,15 @@ vertex_solver_MeshObjType_extend_py(TissueForge::models::vertex::BodyType)
         @classmethod
         def destroy_c(cls, b):
             """
-            Destroy a body. 
+            Destroy a body, or bodies in one batch. 
             
             Any resulting surfaces without a body are also destroyed. 
 
-            :param b: body to destroy or its handle
+            :param b: body to destroy or its handle, or a list of bodies
             """
-            if isinstance(b, _vertex_solver_Body):
+            if isinstance(b, (list, tuple)):
+                return cls._destroy_v([o if isinstance(o, _vertex_solver_Body) else o.body for o in b])
+            elif isinstance(b, _vertex_solver_Body):
                 return cls._destroy_o(b)
             elif isinstance(b, _vertex_solver_BodyHandle):
                 return cls._destroy_h(b)
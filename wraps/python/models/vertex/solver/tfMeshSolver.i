@@ -46,6 +46,8 @@
 %rename(size_surfaces) TissueForge::models::vertex::MeshSolver::sizeSurfaces;
 %rename(size_bodies) TissueForge::models::vertex::MeshSolver::sizeBodies;
 %rename(position_changed) TissueForge::models::vertex::MeshSolver::positionChanged;
+%rename(get_position_tolerance) TissueForge::models::vertex::MeshSolver::getPositionTolerance;
+%rename(set_position_tolerance) TissueForge::models::vertex::MeshSolver::setPositionTolerance;
 %rename(get_log) TissueForge::models::vertex::MeshSolver::getLog;
 %rename(is_3d) TissueForge::models::vertex::MeshSolver::is3D;
 
@@ -50,6 +50,7 @@ vertex_solver_MeshObj_prep_py(TissueForge::models::vertex::Surface)
 %rename(_neighborSurfaces) TissueForge::models::vertex::Surface::neighborSurfaces;
 %rename(_destroy_o) TissueForge::models::vertex::Surface::destroy(Surface*);
 %rename(_destroy_h) TissueForge::models::vertex::Surface::destroy(SurfaceHandle&);
+%rename(_destroy_v) TissueForge::models::vertex::Surface::destroy(const std::vector<Surface*>&);
 %rename(_sew_o1) TissueForge::models::vertex::Surface::sew(Surface*, Surface*, const FloatP_t&);
 %rename(_sew_o2) TissueForge::models::vertex::Surface::sew(const std::vector<Surface*>&, const FloatP_t&);
 %rename(_sew_h1) TissueForge::models::vertex::Surface::sew(const SurfaceHandle&, const SurfaceHandle&, const FloatP_t&);
@@ -208,14 +209,16 @@ vertex_solver_MeshObjType_extend_py(TissueForge::models::vertex::SurfaceType)
         @classmethod
         def destroy_c(cls, s):
             """
-            Destroy a surface. 
+            Destroy a surface, or surfaces in one batch. 
             
             Any resulting vertices without a surface are also destroyed. 
 
-            :param s: surface to destroy or its handle
+            :param s: surface to destroy or its handle, or a list of surfaces
             """
 
-            if isinstance(s, _vertex_solver_Surface):
+            if isinstance(s, (list, tuple)):
+                return cls._destroy_v([o if isinstance(o, _vertex_solver_Surface) else o.surface for o in s])
+            elif isinstance(s, _vertex_solver_Surface):
                 return cls._destroy_o(s)
             elif isinstance(s, _vertex_solver_SurfaceHandle):
                 return cls._destroy_h(s)
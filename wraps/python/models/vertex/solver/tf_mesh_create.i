@@ -27,4 +27,9 @@
 %rename(_vertex_solver__createHex2DMesh) TissueForge::models::vertex::createHex2DMesh(SurfaceType*, const FVector3&, const unsigned int&, const unsigned int&, const FloatP_t&, const char*, const char*);
 %rename(_vertex_solver__createHex3DMesh) TissueForge::models::vertex::createHex3DMesh(BodyType*, SurfaceType*, const FVector3&, const unsigned int&, const unsigned int&, const unsigned int&, const FloatP_t&, const FloatP_t&, const char*, const char*);
 
+%rename(_vertex_solver__createSurfaceMesh) TissueForge::models::vertex::createMesh(SurfaceType*, const std::vector<FVector3>&, const std::vector<std::vector<unsigned int> >&);
+%rename(_vertex_solver__createBodyMesh) TissueForge::models::vertex::createMesh(BodyType*, SurfaceType*, const std::vector<FVector3>&, const std::vector<std::vector<unsigned int> >&, const std::vector<std::vector<unsigned int> >&);
+
+%template(vectorvectorMeshIndex) std::vector<std::vector<unsigned int> >;
+
 %include <models/vertex/solver/tf_mesh_create.h>
@@ -106,6 +106,11 @@ from tissue_forge.tissue_forge import _system_get_discretizationColor as get_dis
 from tissue_forge.tissue_forge import _system_set_discretizationColor as set_discretizationColor
 from tissue_forge.tissue_forge import _system_view_reshape as view_reshape
 from tissue_forge.tissue_forge import _system_performance_counters as performance_counters
+from tissue_forge.tissue_forge import _system_start_trace as start_trace
+from tissue_forge.tissue_forge import _system_stop_trace as stop_trace
+from tissue_forge.tissue_forge import _system_clear_trace as clear_trace
+from tissue_forge.tissue_forge import _system_is_tracing as is_tracing
+from tissue_forge.tissue_forge import _system_export_trace as export_trace
 from tissue_forge.tissue_forge import _system_compile_flags as compile_flags
 from tissue_forge.tissue_forge import _system_egl_info as egl_info
 from tissue_forge.tissue_forge import _system_image_data as image_data
@@ -23,6 +23,7 @@
 
 %}
 
+%ignore TissueForge::LogSite;
 
 %include "tfLogger.h"
 
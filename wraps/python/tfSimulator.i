@@ -117,4 +117,6 @@
     class EngineIntegratorTypes(EnumPy):
         forward_euler = _tissue_forge._Simulator_EngineIntegrator_FORWARD_EULER
         runge_kutta4 = _tissue_forge._Simulator_EngineIntegrator_RUNGE_KUTTA_4
+        velocity_verlet = _tissue_forge._Simulator_EngineIntegrator_VELOCITY_VERLET
+        baoab = _tissue_forge._Simulator_EngineIntegrator_BAOAB
 %}
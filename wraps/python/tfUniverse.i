@@ -20,6 +20,7 @@
 %{
 
 #include "tfUniverse.h"
+#include <langs/py/tfUniversePy.h>
 
 %}
 
@@ -32,6 +33,10 @@
 
 %include "tfUniverse.h"
 
+%rename(_universe_step) TissueForge::py::universe_step;
+
+%include <langs/py/tfUniversePy.h>
+
 %pythoncode %{
     class UniverseInterface:
 
@@ -70,6 +75,15 @@
             """
             return _tfUniverse.getKineticEnergy()
 
+        @property
+        def energy_drift(self) -> float:
+            """
+            Relative drift of total energy since the first step, or since the last reset
+
+            Drift is absolute when the reference total energy is less than one in magnitude
+            """
+            return _tfUniverse.getEnergyDrift()
+
         @property
         def center(self) -> fVector3:
             """
@@ -84,6 +98,13 @@
             """
             return _tfUniverse.getNumTypes()
 
+        @property
+        def num_events(self) -> int:
+            """
+            Number of registered events
+            """
+            return _tfUniverse.getNumEvents()
+
         @property
         def cutoff(self) -> float:
             """
@@ -91,6 +112,13 @@
             """
             return _tfUniverse.getCutoff()
 
+        @property
+        def grid_size(self) -> iVector3:
+            """
+            Dimensions in cells of the grid of the space
+            """
+            return _tfUniverse.getGridSize()
+
         @property
         def flux_steps(self) -> int:
             """
@@ -105,6 +133,13 @@
             """
             return _tfUniverse.dim()
 
+        @property
+        def origin(self) -> fVector3:
+            """
+            Universe origin
+            """
+            return _tfUniverse.getOrigin()
+
         @property
         def volume(self) -> float:
             """
@@ -143,10 +178,13 @@
             """
             Performs a single time step of the universe if no arguments are 
             given. Optionally runs until ``until``.
+
+            The GIL is released while the universe is integrated, and is only 
+            re-acquired when calling back into Python (events, custom forces). 
             
             :param until: period to execute, in units of simulation time (default executes one time step).
             """
-            return _tfUniverse.step(until, 0)
+            return _universe_step(until, 0)
 
         def stop(self):
             """
@@ -178,6 +216,63 @@
             """
             return _tfUniverse.resetSpecies()
 
+        def reserve(self, nr_parts: int):
+            """
+            Reserve storage for a total number of particles. 
+
+            Reserving before creating many particles avoids repeated reallocation. 
+
+            :param nr_parts: total number of particles
+            """
+            return _tfUniverse.reserve(nr_parts)
+
+        def regrid(self, cells=None):
+            """
+            Re-size the grid of cells of the space. 
+
+            When no dimensions are given, cells are sized by the particle density and cutoff. 
+
+            :param cells: optional dimensions in cells
+            """
+            if cells is None:
+                return _tfUniverse.regrid()
+            return _tfUniverse.regrid(iVector3(cells))
+
+        def expand(self, lower, upper):
+            """
+            Add or remove layers of cells on the faces of the universe. 
+
+            Cells keep their dimensions, and particles keep their positions. 
+            Boundary conditions move with the faces of the universe. 
+            Only non-periodic dimensions can be resized, and only empty layers can be removed. 
+
+            :param lower: number of layers to add to each lower face; negative to remove layers
+            :param upper: number of layers to add to each upper face; negative to remove layers
+            """
+            return _tfUniverse.expand(iVector3(lower), iVector3(upper))
+
+        def minimize(self, ftol: float = 1E-3, etol: float = 0.0, max_steps: int = 10000, dt_max: float = 0.0) -> int:
+            """
+            Relax the particles to a local minimum of potential energy. 
+
+            Forces are evaluated as in a time step, including bonded interactions and subengines, 
+            and particles are moved with the FIRE algorithm until a convergence criterion is met. 
+            Simulation time does not advance, and particles are at rest afterwards. 
+
+            :param ftol: convergence tolerance on the magnitude of the force on any particle
+            :param etol: convergence tolerance on the relative change in potential energy of an iteration; disabled when zero
+            :param max_steps: maximum number of iterations
+            :param dt_max: maximum time step of an iteration; ten times the time step when non-positive
+            :return: number of iterations until convergence, or -1 if not converged
+            """
+            return _tfUniverse.minimize(ftol, etol, max_steps, dt_max)
+
+        def reset_energy_drift(self):
+            """
+            Restart tracking of total energy drift at the next step
+            """
+            return _tfUniverse.resetEnergyDrift()
+
         def grid(self, shape):
             """
             Gets a three-dimesional array of particle lists, of all the particles in the system. 
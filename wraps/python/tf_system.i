@@ -116,6 +116,11 @@
 %rename(_system_set_discretizationColor) TissueForge::py::set_discretizationColor;
 %rename(_system_view_reshape) TissueForge::py::view_reshape;
 %rename(_system_performance_counters) TissueForge::py::performance_counters;
+%rename(_system_start_trace) TissueForge::py::start_trace;
+%rename(_system_stop_trace) TissueForge::py::stop_trace;
+%rename(_system_clear_trace) TissueForge::py::clear_trace;
+%rename(_system_is_tracing) TissueForge::py::is_tracing;
+%rename(_system_export_trace) TissueForge::py::export_trace;
 %rename(_system_egl_info) TissueForge::py::egl_info;
 %rename(_system_image_data) TissueForge::py::image_data;
 %rename(_system_is_terminal_interactive) TissueForge::py::is_terminal_interactive;
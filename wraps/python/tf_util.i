@@ -129,6 +129,29 @@
                     args.append(phi1)
         return list(randomPoints(*args))
 
+    def poisson_disk_points(kind: int, distance: float, n: int = -1, seed: int = None):
+        """
+        Get the coordinates of random points in a kind of shape that are no closer to each other than a distance.
+
+        Points are generated by Poisson-disk sampling on a background grid, 
+        in parallel and in time proportional to the number of points. 
+        When a number of points is given, points are selected at random from a filled shape. 
+        Generated points only depend on the seed, and not on the number of threads. 
+    
+        Currently supports :attr:`PointsType.Disk`, :attr:`PointsType.SolidCube` and :attr:`PointsType.SolidSphere`.
+    
+        :param kind: kind of shape
+        :param distance: minimum distance between points
+        :param n: number of points; fills the shape when negative
+        :param seed: seed of the sampling; drawn from the pseudo-random number generator when not given
+        :return: coordinates of random points
+        :rtype: list of :class:`FVector3`
+        """
+
+        if seed is None:
+            return list(poissonDiskPoints(kind, distance, n))
+        return list(poissonDiskPoints(kind, distance, n, seed))
+
     def filled_cube_uniform(corner1,
                             corner2,
                             num_parts_x: int = 2,
@@ -150,20 +173,23 @@
     
         return list(filledCubeUniform(FVector3(corner1), FVector3(corner2), num_parts_x, num_parts_y, num_parts_z))
 
-    def filled_cube_random(corner1, corner2, num_particles: int):
+    def filled_cube_random(corner1, corner2, num_particles: int, distance: float = 0.0):
         """
         Get the coordinates of a randomly filled cube.
+
+        When a minimum distance is given, points are generated by Poisson-disk sampling.
     
         :param corner1: first corner of cube
         :type corner1: list of float or :class:`FVector3`
         :param corner2: second corner of cube
         :type corner2: list of float or :class:`FVector3`
         :param num_particles: number of particles
+        :param distance: minimum distance between points; ignored when not positive
         :return: coordinates of random points
         :rtype: list of :class:`FVector3`
         """
     
-        return list(filledCubeUniform(FVector3(corner1), FVector3(corner2), num_particles))
+        return list(filledCubeRandom(FVector3(corner1), FVector3(corner2), num_particles, distance))
 
     def icosphere(subdivisions: int, phi0: float, phi1: float):
         """
@@ -190,7 +190,13 @@
 
                 flux_steps: (int) number of flux steps per simulation step; default is 1
 
-                integrator: (int) simulation integrator; default is FORWARD_EULER
+                integrator: (int) simulation integrator; one of FORWARD_EULER, RUNGE_KUTTA_4, VELOCITY_VERLET and BAOAB; default is FORWARD_EULER
+
+                langevin_friction: (float) friction coefficient of the BAOAB integrator; default is 1
+
+                respa_steps: (int) number of inner steps of the VELOCITY_VERLET integrator, during which bonded forces are evaluated; default is 1, which disables multiple time stepping
+
+                flux_integrator: (int) integrator of flux steps; default is FLUX_INTEGRATOR_EXPLICIT
 
                 dt: (float) time discretization; default is 0.01
 
@@ -206,6 +212,18 @@
 
                 logger_level: (int) logger level; default is no logging
 
+                cell_order: (int) ordering of the traversal of cells; 0 is row-major, 1 is Morton and 2 is Hilbert; default is 0
+
+                renumber_period: (int) period, in steps, of renumbering particles by cell; default is 0, which disables renumbering. Renumbering changes particle ids. Particle handles, events, forces and trajectories follow their particles, but stored particle ids and particle lists do not
+
+                pid_compaction: (float) fraction of recycled particle ids above which particles are renumbered; default is 0, which disables compaction. Compaction renumbers particles like renumber_period
+
+                regrid_period: (int) period, in steps, of re-sizing the grid of cells to the particle density; default is 0, which disables re-sizing
+
+                regrid_occupancy: (float) target mean number of particles per cell when re-sizing the grid of cells; default is 8
+
+                expand_margin: (int) number of empty layers of cells kept between the particles and each non-periodic face of the universe, growing and shrinking the universe as needed; default is 0, which disables resizing
+
                 clip_planes: (list of tuple of (FVector3, FVector3)) list of point-normal pairs of clip planes; default is no planes
         """
         return SimulatorPy_init(args, kwargs)